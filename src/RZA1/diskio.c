@@ -228,6 +228,47 @@ DRESULT disk_read_without_streaming_first(BYTE pdrv, /* Physical drive nmuber to
     }
 }
 
+/*-----------------------------------------------------------------------*/
+/* Read Sectors into several buffers with one multiple-block read        */
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_read_scatter(BYTE pdrv, /* Physical drive nmuber to identify the drive */
+    BYTE* const* buffs,              /* Data buffers to store read data, each sectorsPerBuff long */
+    UINT sectorsPerBuff,             /* Number of sectors per buffer - the last one may get fewer */
+    LBA_t sector,                    /* Sector address in LBA */
+    UINT count,                      /* Total number of sectors to read */
+    void (*buffFilled)(int, void*),  /* Called as each buffer is filled, while the next is transferred */
+    void* context)
+{
+
+    logAudioAction("disk_read_scatter");
+
+    if (currentlyAccessingCard)
+    {
+        if (ALPHA_OR_BETA_VERSION)
+        {
+            FREEZE_WITH_ERROR("E456");
+        }
+    }
+
+    SD_SCATTER scatter = {buffs, sectorsPerBuff, buffFilled, context};
+
+    currentlyAccessingCard = 1;
+
+    BYTE err = sd_read_sect_scatter(SD_PORT, &scatter, sector, count);
+
+    currentlyAccessingCard = 0;
+
+    if (err == 0)
+    {
+        return RES_OK;
+    }
+    else
+    {
+        return RES_ERROR;
+    }
+}
+
 /*-----------------------------------------------------------------------*/
 /* Write Sector(s)                                                       */
 /*-----------------------------------------------------------------------*/
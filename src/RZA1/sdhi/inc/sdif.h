@@ -236,6 +236,15 @@ extern "C" {
 #define SD_CLR_PWD                0x02
 #define SD_SET_PWD                0x01
 
+/* ---- buffers for sd_read_sect_scatter() to fill, one after another ---- */
+typedef struct {
+	unsigned char * const *buffs;	/* each quadlet aligned, for DMA */
+	long sectors_per_buff;			/* the last buffer may be given fewer */
+	/* if not NULL, called as each buffer is filled - and with DMA, while the next one's transfer is underway */
+	void (*buff_filled)(int buff_index, void *context);
+	void *context;
+} SD_SCATTER;
+
 /* ==== API prototype ===== */
 /* ---- access library I/F ---- */
 int sd_init(int sd_port, unsigned long base, void *workarea, int cd_port);
@@ -245,6 +254,7 @@ int sd_format(int sd_port, int mode,int (*callback)(unsigned long,unsigned long)
 int sd_format2(int sd_port, int mode,unsigned long volserial,int (*callback)(unsigned long,unsigned long));
 int sd_mount(int sd_port, unsigned long mode,unsigned long voltage);
 int sd_read_sect(int sd_port, unsigned char *buff,unsigned long psn,long cnt);
+int sd_read_sect_scatter(int sd_port, SD_SCATTER const *scatter,unsigned long psn,long cnt);
 int sd_write_sect(int sd_port, unsigned char const *buff,unsigned long psn,long cnt,int writemode);
 int sd_get_type(int sd_port, unsigned char *type,unsigned char *speed,unsigned char *capa);
 int sd_get_size(int sd_port, unsigned long *user,unsigned long *protect);
@@ -106,6 +106,88 @@ int doActualReadRohan(int sd_port, SDHNDL *hndl, unsigned char *buff, long cnt,
 	return ret;
 }
 
+/* Like doActualReadRohan(), but into each of the scatter buffers in turn. The card carries on with the same multiple
+   block read throughout - it just waits, with the clock stopped, while we set up the transfer to the next buffer. */
+static int doActualReadScatter(int sd_port, SDHNDL *hndl, SD_SCATTER const *scatter, long cnt, int mode, int dma_64) {
+
+	int ret = SD_OK;
+	int b;
+	long done, num;
+
+	/* ---- disable RespEnd and ILA ---- */
+	_sd_clear_int_mask(hndl,SD_INFO1_MASK_RESP,SD_INFO2_MASK_ILA);
+
+	if(mode == SD_MODE_SW){	/* ==== PIO ==== */
+		/* enable All end, BRE and errors */
+		_sd_set_int_mask(hndl,SD_INFO1_MASK_DATA_TRNS,SD_INFO2_MASK_BRE);
+		for(b=0,done=0; done < cnt; b++,done+=num){
+			num = cnt - done;
+			if(num > scatter->sectors_per_buff){
+				num = scatter->sectors_per_buff;
+			}
+			/* software data transfer */
+			ret =_sd_software_trans(hndl,scatter->buffs[b],num,SD_TRANS_READ);
+			if(ret != SD_OK){
+				return ret;
+			}
+			if(scatter->buff_filled){
+				scatter->buff_filled(b,scatter->context);
+			}
+		}
+		return ret;
+	}
+
+	/* ==== DMA ==== */
+	/* disable card ins&rem interrupt for FIFO */
+	unsigned short info1_back = (unsigned short)(hndl->int_info1_mask & SD_INFO1_MASK_DET_CD);
+	_sd_clear_int_mask(hndl,SD_INFO1_MASK_DET_CD,0);
+
+	/* enable All end and errors */
+	_sd_set_int_mask(hndl,SD_INFO1_MASK_DATA_TRNS,SD_INFO2_MASK_ERR);
+
+	unsigned long reg_base_here = hndl->reg_base;
+	if(TARGET_RZ_A1 != 1 || dma_64 != SD_MODE_DMA_64) /* SD_CMD Address for 64byte transfer */
+		reg_base_here += SD_BUF0;
+
+	for(b=0,done=0; done < cnt; b++,done+=num){
+		unsigned char *buff = scatter->buffs[b];
+		num = cnt - done;
+		if(num > scatter->sectors_per_buff){
+			num = scatter->sectors_per_buff;
+		}
+
+		/* invalidate before as well as after - see doActualReadRohan() */
+		v7_dma_inv_range((intptr_t)buff, (intptr_t)(buff + num * 512));
+
+		if(sddev_init_dma(sd_port, (unsigned long)buff, reg_base_here, num*512, SD_TRANS_READ) != SD_OK){
+			_sd_set_err(hndl,SD_ERR_CPU_IF);
+			ret = SD_ERR_CPU_IF;
+			break;
+		}
+
+		/* the previous buffer can be dealt with while this one is transferred */
+		if(b > 0 && scatter->buff_filled){
+			scatter->buff_filled(b - 1,scatter->context);
+		}
+
+		ret =_sd_dma_trans(hndl,num);
+		if(ret != SD_OK){
+			break;
+		}
+
+		v7_dma_inv_range((intptr_t)buff, (intptr_t)(buff + num * 512));
+	}
+
+	sd_outp(hndl,CC_EXT_MODE,(unsigned short)(sd_inp(hndl,CC_EXT_MODE) & ~CC_EXT_MODE_DMASDRW));
+	_sd_set_int_mask(hndl,info1_back,0);
+
+	if(ret == SD_OK && scatter->buff_filled){
+		scatter->buff_filled(b - 1,scatter->context);
+	}
+
+	return ret;
+}
+
 /*****************************************************************************
  * ID           :
  * Summary      : read sector data from card
@@ -124,7 +206,38 @@ int doActualReadRohan(int sd_port, SDHNDL *hndl, unsigned char *buff, long cnt,
  *              : SD_ERR: end of error
  * Remark       : 
  *****************************************************************************/
+static int _sd_read_sect(int sd_port, unsigned char *buff,unsigned long psn,long cnt,
+	SD_SCATTER const *scatter);
+
 int sd_read_sect(int sd_port, unsigned char *buff,unsigned long psn,long cnt)
+{
+	return _sd_read_sect(sd_port,buff,psn,cnt,0);
+}
+
+/*****************************************************************************
+ * ID           :
+ * Summary      : read sector data from card into several buffers
+ * Include      : 
+ * Declaration  : int sd_read_sect_scatter(int sd_port, SD_SCATTER const *scatter,
+ *              : unsigned long psn,long cnt);
+ * Functions    : as sd_read_sect(), but filling each of scatter->buffs in turn
+ *              : with a single multiple block transfer, so cnt must be more
+ *              : than 2 and no more than can be transferred in one go
+ *              : 
+ * Argument     : SD_SCATTER const *scatter : buffers to read into
+ *              : unsigned long psn : read physical sector number
+ *              : long cnt : number of read sectors
+ * Return       : SD_OK : end of succeed
+ *              : SD_ERR: end of error
+ * Remark       : 
+ *****************************************************************************/
+int sd_read_sect_scatter(int sd_port, SD_SCATTER const *scatter,unsigned long psn,long cnt)
+{
+	return _sd_read_sect(sd_port,scatter->buffs[0],psn,cnt,scatter);
+}
+
+static int _sd_read_sect(int sd_port, unsigned char *buff,unsigned long psn,long cnt,
+	SD_SCATTER const *scatter)
 {
 	
 	SDHNDL *hndl;
@@ -175,8 +288,20 @@ int sd_read_sect(int sd_port, unsigned char *buff,unsigned long psn,long cnt)
 		return hndl->error;	/* out of area */
 	}
 
+	/* a scatter read has to be one multiple block transfer */
+	if(scatter && (cnt <= 2 || cnt > TRANS_SECTORS)){
+		_sd_set_err(hndl,SD_ERR);
+		return hndl->error;
+	}
+
 	/* if DMA transfer, buffer boundary is quadlet unit */
-	if((hndl->trans_mode & SD_MODE_DMA) && ((unsigned long)buff & 0x03u) == 0){
+	unsigned long buff_alignment = (unsigned long)buff;
+	if(scatter){
+		for(i=0; i*scatter->sectors_per_buff < cnt; i++){
+			buff_alignment |= (unsigned long)scatter->buffs[i];
+		}
+	}
+	if((hndl->trans_mode & SD_MODE_DMA) && (buff_alignment & 0x03u) == 0){
 		mode = SD_MODE_DMA;	/* set DMA mode */
 
 	#if		(TARGET_RZ_A1 == 1)
@@ -288,7 +413,12 @@ int sd_read_sect(int sd_port, unsigned char *buff,unsigned long psn,long cnt)
 			}
 		}
 
-		ret = doActualReadRohan(sd_port, hndl, buff, cnt, mode, dma_64);
+		if(scatter){
+			ret = doActualReadScatter(sd_port, hndl, scatter, cnt, mode, dma_64);
+		}
+		else{
+			ret = doActualReadRohan(sd_port, hndl, buff, cnt, mode, dma_64);
+		}
 
 		if(ret != SD_OK){
 			goto ErrExit;
@@ -309,7 +439,7 @@ int sd_read_sect(int sd_port, unsigned char *buff,unsigned long psn,long cnt)
 			goto ErrExit;
 		}
 
-		if (mode != SD_MODE_SW) {
+		if (mode != SD_MODE_SW && !scatter) { // A scatter read does this for each buffer as it goes
 			// Invalidate ram
 			v7_dma_inv_range((uintptr_t)buff, (uintptr_t)(buff + cnt * 512));
 		}
@@ -611,6 +611,8 @@ enum class MIDITransposeControlMethod : uint8_t {
 constexpr auto kNumMIDITransposeControlMethods = util::to_underlying(MIDITransposeControlMethod::CHORD) + 1;
 
 constexpr int32_t kNumClustersLoadedAhead = 2;
+/// How many Clusters beyond those kNumClustersLoadedAhead get loaded in advance of a note the sequencer knows is coming
+constexpr int32_t kNumClustersPrefetchedAhead = 2;
 
 enum class InputMonitoringMode : uint8_t {
 	SMART,
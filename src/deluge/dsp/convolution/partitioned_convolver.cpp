@@ -0,0 +1,290 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "dsp/convolution/partitioned_convolver.h"
+#include "dsp/fft/fft_config_manager.h"
+#include "memory/memory_allocator_interface.h"
+#include "util/fixedpoint.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// The inverse FFT is done at a quarter of the final level, so the partial sums inside it can't overflow
+constexpr int32_t kHeadroomBits = 2;
+
+// The impulse response is turned down by this much more, which is exactly enough that even the biggest possible
+// spectra can't overflow the accumulators once every partition's product is summed: a partition of full-scale input
+// has bins of at most 2^30 after the FFT's scaling, and a partition of impulse response at most 2^26, and 64 of those
+// products are 2^62
+constexpr int32_t kImpulseResponseHeadroomBits = 4;
+constexpr int32_t kBiggestInputBinMagnitude =
+    31 - PartitionedConvolver::kFFTSizeMagnitude + PartitionedConvolver::kPartitionSizeMagnitude;
+constexpr int32_t kBiggestImpulseResponseBinMagnitude = kBiggestInputBinMagnitude - kImpulseResponseHeadroomBits;
+static_assert(kBiggestInputBinMagnitude + kBiggestImpulseResponseBinMagnitude
+                  + PartitionedConvolver::kMaxNumPartitionsMagnitude
+              <= 62);
+
+// The forward FFTs are scaled down by their size, so this undoes that and the impulse response's headroom, leaving
+// the inverse FFT's
+constexpr int32_t kAccumulatorShift =
+    31 - PartitionedConvolver::kFFTSizeMagnitude - kImpulseResponseHeadroomBits + kHeadroomBits;
+
+void forwardFFT(ne10_fft_cpx_int32_t* out, int32_t* in, ne10_fft_r2c_cfg_int32_t config) {
+#if defined(__ARM_NEON)
+	ne10_fft_r2c_1d_int32_neon(out, in, config, true);
+#else
+	ne10_fft_r2c_1d_int32_c(out, in, config, true);
+#endif
+}
+
+void inverseFFT(int32_t* out, ne10_fft_cpx_int32_t* in, ne10_fft_r2c_cfg_int32_t config) {
+#if defined(__ARM_NEON)
+	ne10_fft_c2r_1d_int32_neon(out, in, config, false);
+#else
+	ne10_fft_c2r_1d_int32_c(out, in, config, false);
+#endif
+}
+
+[[gnu::always_inline]] inline int32_t saturate(int64_t value) {
+	return (int32_t)std::clamp<int64_t>(value, std::numeric_limits<int32_t>::min(),
+	                                    std::numeric_limits<int32_t>::max());
+}
+
+} // namespace
+
+Error PartitionedConvolver::getPeakGain(std::span<int32_t const> impulseResponse, float* peakGain) {
+	int32_t magnitude = kFFTSizeMagnitude;
+	while (((size_t)1 << magnitude) < impulseResponse.size()) {
+		magnitude++;
+	}
+	int32_t fftSize = 1 << magnitude;
+
+	ne10_fft_r2c_cfg_int32_t config = FFTConfigManager::getConfig(magnitude);
+	int32_t numBins = (fftSize >> 1) + 1;
+	int32_t* timeDomain =
+	    config ? (int32_t*)allocLowSpeed(fftSize * sizeof(int32_t) + numBins * sizeof(ne10_fft_cpx_int32_t)) : nullptr;
+	if (!timeDomain) {
+		return Error::INSUFFICIENT_RAM;
+	}
+	auto* spectrum = (ne10_fft_cpx_int32_t*)&timeDomain[fftSize];
+
+	std::copy(impulseResponse.begin(), impulseResponse.end(), timeDomain);
+	std::fill(&timeDomain[impulseResponse.size()], &timeDomain[fftSize], 0);
+	forwardFFT(spectrum, timeDomain, config);
+
+	float peakSquared = 0;
+	for (int32_t k = 0; k < numBins; k++) {
+		float real = spectrum[k].r;
+		float imaginary = spectrum[k].i;
+		peakSquared = std::max(peakSquared, real * real + imaginary * imaginary);
+	}
+	delugeDealloc(timeDomain);
+
+	// The FFT was scaled down by its size
+	*peakGain = std::sqrt(peakSquared) * (float)fftSize / ONE_Q31f;
+	return Error::NONE;
+}
+
+PartitionedConvolver::Buffers* PartitionedConvolver::allocate(int32_t numPartitions,
+                                                              int32_t numImpulseResponseChannels) {
+	size_t spectraSize = (size_t)numPartitions * kNumBins * sizeof(ne10_fft_cpx_int32_t);
+	size_t size = sizeof(Buffers) + (numImpulseResponseChannels + 2) * spectraSize;
+	void* memory = allocLowSpeed(size);
+	if (memory) {
+		memset(memory, 0, size);
+	}
+	return (Buffers*)memory;
+}
+
+void PartitionedConvolver::adopt(Buffers* buffers, int32_t numPartitions, int32_t numImpulseResponseChannels) {
+	Buffers* oldBuffers = buffers_;
+
+	auto* spectra = (ne10_fft_cpx_int32_t*)(buffers + 1);
+	buffers_ = buffers;
+	impulseResponseSpectra_ = spectra;
+	historySpectra_ = &spectra[numImpulseResponseChannels * numPartitions * kNumBins];
+	numPartitions_ = numPartitions;
+	numImpulseResponseChannels_ = numImpulseResponseChannels;
+	newestHistorySlot_ = 0;
+	posInPartition_ = 0;
+
+	if (oldBuffers) {
+		delugeDealloc(oldBuffers);
+	}
+}
+
+Error PartitionedConvolver::setImpulseResponse(std::span<int32_t const> left, std::span<int32_t const> right) {
+	if (left.empty()) {
+		clear();
+		return Error::NONE;
+	}
+
+	std::span<int32_t const> channels[2] = {left.first(std::min<size_t>(left.size(), kMaxLength)),
+	                                        right.first(std::min<size_t>(right.size(), kMaxLength))};
+	int32_t numImpulseResponseChannels = right.empty() ? 1 : 2;
+	size_t length = std::max(channels[0].size(), channels[1].size());
+	int32_t numPartitions = ((length - 1) >> kPartitionSizeMagnitude) + 1;
+
+	ne10_fft_r2c_cfg_int32_t fftConfig = FFTConfigManager::getConfig(kFFTSizeMagnitude);
+	if (!fftConfig) {
+		return Error::INSUFFICIENT_RAM;
+	}
+
+	// Both sides get turned down by the same amount, so a stereo impulse response keeps its balance
+	float peakGain = 0;
+	for (int32_t channel = 0; channel < numImpulseResponseChannels; channel++) {
+		float peakGainThisChannel;
+		Error error = getPeakGain(channels[channel], &peakGainThisChannel);
+		if (error != Error::NONE) {
+			return error;
+		}
+		peakGain = std::max(peakGain, peakGainThisChannel);
+	}
+	if (peakGain <= 0) {
+		peakGain = 1; // Silent, so it doesn't matter
+	}
+
+	// The audio routine may get called while we're doing all this, so the new one gets set up completely before it
+	// replaces the old one
+	Buffers* buffers = allocate(numPartitions, numImpulseResponseChannels);
+	if (!buffers) {
+		return Error::INSUFFICIENT_RAM;
+	}
+	auto* spectra = (ne10_fft_cpx_int32_t*)(buffers + 1);
+
+	// No sample can be bigger than the peak gain, so after this none is bigger than full scale turned down by the
+	// headroom
+	float scale = 1.f / ((float)(1 << kImpulseResponseHeadroomBits) * peakGain);
+	for (int32_t channel = 0; channel < numImpulseResponseChannels; channel++) {
+		std::span<int32_t const> impulseResponse = channels[channel];
+		for (int32_t p = 0; p < numPartitions; p++) {
+			size_t start = std::min<size_t>(p * kPartitionSize, impulseResponse.size());
+			size_t end = std::min<size_t>(start + kPartitionSize, impulseResponse.size());
+			int32_t* timeDomainEnd = std::transform(&impulseResponse[start], &impulseResponse[end], buffers->timeDomain,
+			                                        [scale](int32_t sample) { return (int32_t)(sample * scale); });
+			std::fill(timeDomainEnd, &buffers->timeDomain[kFFTSize], 0);
+			forwardFFT(&spectra[(channel * numPartitions + p) * kNumBins], buffers->timeDomain, fftConfig);
+		}
+	}
+	memset(buffers->timeDomain, 0, sizeof(buffers->timeDomain));
+
+	fftConfig_ = fftConfig;
+	adopt(buffers, numPartitions, numImpulseResponseChannels);
+	return Error::NONE;
+}
+
+Error PartitionedConvolver::copyImpulseResponseFrom(PartitionedConvolver const& other) {
+	if (!other.hasImpulseResponse()) {
+		clear();
+		return Error::NONE;
+	}
+
+	Buffers* buffers = allocate(other.numPartitions_, other.numImpulseResponseChannels_);
+	if (!buffers) {
+		return Error::INSUFFICIENT_RAM;
+	}
+	memcpy(buffers + 1, other.impulseResponseSpectra_,
+	       (size_t)other.numImpulseResponseChannels_ * other.numPartitions_ * kNumBins * sizeof(ne10_fft_cpx_int32_t));
+
+	fftConfig_ = other.fftConfig_;
+	adopt(buffers, other.numPartitions_, other.numImpulseResponseChannels_);
+	return Error::NONE;
+}
+
+void PartitionedConvolver::clear() {
+	if (buffers_) {
+		delugeDealloc(buffers_);
+	}
+	buffers_ = nullptr;
+	impulseResponseSpectra_ = nullptr;
+	historySpectra_ = nullptr;
+	numPartitions_ = 0;
+	numImpulseResponseChannels_ = 0;
+}
+
+void PartitionedConvolver::reset() {
+	if (!buffers_) {
+		return;
+	}
+	memset(buffers_, 0, sizeof(Buffers));
+	memset(historySpectra_, 0, (size_t)2 * numPartitions_ * kNumBins * sizeof(ne10_fft_cpx_int32_t));
+	newestHistorySlot_ = 0;
+	posInPartition_ = 0;
+}
+
+void PartitionedConvolver::process(std::span<StereoSample> buffer, q31_t dryLevel, q31_t wetLevel) {
+	if (!buffers_) {
+		return;
+	}
+
+	Buffers& b = *buffers_;
+	for (StereoSample& sample : buffer) {
+		b.input[0][posInPartition_] = sample.l;
+		b.input[1][posInPartition_] = sample.r;
+		sample.l = (multiply_32x32_rshift32(sample.l, dryLevel) << 1)
+		           + (multiply_32x32_rshift32(b.output[0][posInPartition_], wetLevel) << 1);
+		sample.r = (multiply_32x32_rshift32(sample.r, dryLevel) << 1)
+		           + (multiply_32x32_rshift32(b.output[1][posInPartition_], wetLevel) << 1);
+
+		if (++posInPartition_ == kPartitionSize) {
+			processPartition();
+			posInPartition_ = 0;
+		}
+	}
+}
+
+void PartitionedConvolver::processPartition() {
+	Buffers& b = *buffers_;
+
+	// The oldest input partition's spectrum has just stopped being needed, so the newest takes its place
+	newestHistorySlot_ = (newestHistorySlot_ + 1 == numPartitions_) ? 0 : newestHistorySlot_ + 1;
+
+	for (int32_t channel = 0; channel < 2; channel++) {
+		memcpy(b.timeDomain, b.input[channel], sizeof(b.input[channel]));
+		memset(&b.timeDomain[kPartitionSize], 0, kPartitionSize * sizeof(int32_t));
+		forwardFFT(getHistorySpectrum(channel, newestHistorySlot_), b.timeDomain, fftConfig_);
+
+		// Each partition of impulse response, times the input from that many partitions ago, all summed
+		memset(b.accumulators, 0, sizeof(b.accumulators));
+		int32_t impulseResponseChannel = (numImpulseResponseChannels_ == 2) ? channel : 0;
+		int32_t slot = newestHistorySlot_;
+		for (int32_t p = 0; p < numPartitions_; p++) {
+			ne10_fft_cpx_int32_t const* x = getHistorySpectrum(channel, slot);
+			ne10_fft_cpx_int32_t const* h = getImpulseResponseSpectrum(impulseResponseChannel, p);
+			for (int32_t k = 0; k < kNumBins; k++) {
+				b.accumulators[k][0] += (int64_t)x[k].r * h[k].r - (int64_t)x[k].i * h[k].i;
+				b.accumulators[k][1] += (int64_t)x[k].r * h[k].i + (int64_t)x[k].i * h[k].r;
+			}
+			slot = (slot == 0) ? numPartitions_ - 1 : slot - 1;
+		}
+
+		for (int32_t k = 0; k < kNumBins; k++) {
+			b.spectrum[k].r = saturate(b.accumulators[k][0] >> kAccumulatorShift);
+			b.spectrum[k].i = saturate(b.accumulators[k][1] >> kAccumulatorShift);
+		}
+		inverseFFT(b.timeDomain, b.spectrum, fftConfig_);
+
+		// The first half finishes off what the last partition started, and the second half is the start of the next
+		for (int32_t n = 0; n < kPartitionSize; n++) {
+			b.output[channel][n] = saturate(((int64_t)b.timeDomain[n] + b.overlap[channel][n]) << kHeadroomBits);
+		}
+		memcpy(b.overlap[channel], &b.timeDomain[kPartitionSize], sizeof(b.overlap[channel]));
+	}
+}
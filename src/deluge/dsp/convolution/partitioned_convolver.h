@@ -0,0 +1,110 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "NE10.h"
+#include "definitions_cxx.hpp"
+#include "dsp/stereo_sample.h"
+#include <cstdint>
+#include <span>
+
+/// Uniformly partitioned overlap-add convolution, for impulse responses far too long for ImpulseResponseProcessor's
+/// direct-form FIR - real cabinets and rooms.
+///
+/// The impulse response is cut into partitions the size of the audio engine's biggest render window, and each is kept
+/// as a spectrum. Each time a partition's worth of input has come in, it gets one forward FFT, is multiplied against
+/// every partition's spectrum, and one inverse FFT gives the next partition's worth of output. So the cost per sample
+/// depends only on how many partitions there are, never on how the audio engine happens to be windowing things, and
+/// the price is kPartitionSize samples of latency on the wet signal.
+///
+/// Everything's in fixed point, using NE10's int32 real FFTs from FFTConfigManager. All memory is allocated in one go
+/// when an impulse response is set, so one that hasn't got one costs nothing but its own few members.
+class PartitionedConvolver {
+public:
+	static constexpr int32_t kPartitionSizeMagnitude = 7;
+	static constexpr int32_t kPartitionSize = 1 << kPartitionSizeMagnitude;
+	static_assert(kPartitionSize == SSI_TX_BUFFER_NUM_SAMPLES, "A partition should be one full render window");
+
+	/// Twice the partition, so a partition of input convolved with a partition of impulse response doesn't wrap round
+	static constexpr int32_t kFFTSizeMagnitude = kPartitionSizeMagnitude + 1;
+	static constexpr int32_t kFFTSize = 1 << kFFTSizeMagnitude;
+	static constexpr int32_t kNumBins = (kFFTSize >> 1) + 1;
+
+	/// This is what caps the cost. 64 partitions is 186ms at 44.1kHz - plenty for any cabinet and for small rooms
+	static constexpr int32_t kMaxNumPartitionsMagnitude = 6;
+	static constexpr int32_t kMaxNumPartitions = 1 << kMaxNumPartitionsMagnitude;
+	static constexpr int32_t kMaxLength = kPartitionSize * kMaxNumPartitions;
+
+	PartitionedConvolver() = default;
+	PartitionedConvolver(PartitionedConvolver const&) = delete;
+	PartitionedConvolver& operator=(PartitionedConvolver const&) = delete;
+	~PartitionedConvolver() { clear(); }
+
+	/// Takes either one channel of impulse response, to be used for both sides, or one for each side. Anything past
+	/// kMaxLength gets cut off. It's scaled so that its loudest frequency comes out at unity gain, since impulse
+	/// response files vary wildly in level. Anything that had been played through the previous one is forgotten.
+	Error setImpulseResponse(std::span<int32_t const> left, std::span<int32_t const> right = {});
+
+	/// Take a copy of the impulse response another one is using, without needing the original file again
+	Error copyImpulseResponseFrom(PartitionedConvolver const& other);
+
+	void clear();
+	[[nodiscard]] bool hasImpulseResponse() const { return buffers_ != nullptr; }
+	[[nodiscard]] int32_t getNumPartitions() const { return numPartitions_; }
+
+	/// Forget everything that's been played in, so nothing rings on
+	void reset();
+
+	/// Mixes the wet signal, which comes kPartitionSize samples late, in with the dry one. A cabinet will usually want
+	/// no dry at all, and a room some of each
+	void process(std::span<StereoSample> buffer, q31_t dryLevel, q31_t wetLevel);
+
+private:
+	struct Buffers {
+		int64_t accumulators[kNumBins][2];
+		ne10_fft_cpx_int32_t spectrum[kNumBins];
+		int32_t timeDomain[kFFTSize];
+		int32_t input[2][kPartitionSize];
+		int32_t output[2][kPartitionSize];
+		int32_t overlap[2][kPartitionSize];
+	};
+
+	/// How much the impulse response boosts its loudest frequency by, where 1 is unity gain
+	static Error getPeakGain(std::span<int32_t const> impulseResponse, float* peakGain);
+	/// All of the memory, zeroed: the Buffers, then the impulse response's spectra, then the history
+	static Buffers* allocate(int32_t numPartitions, int32_t numImpulseResponseChannels);
+	/// Start using memory from allocate(), freeing what was being used before
+	void adopt(Buffers* buffers, int32_t numPartitions, int32_t numImpulseResponseChannels);
+	void processPartition();
+
+	[[nodiscard]] ne10_fft_cpx_int32_t* getImpulseResponseSpectrum(int32_t channel, int32_t partition) const {
+		return &impulseResponseSpectra_[(channel * numPartitions_ + partition) * kNumBins];
+	}
+	[[nodiscard]] ne10_fft_cpx_int32_t* getHistorySpectrum(int32_t channel, int32_t slot) const {
+		return &historySpectra_[(channel * numPartitions_ + slot) * kNumBins];
+	}
+
+	Buffers* buffers_ = nullptr;
+	ne10_fft_cpx_int32_t* impulseResponseSpectra_ = nullptr;
+	ne10_fft_cpx_int32_t* historySpectra_ = nullptr; ///< The last numPartitions_ input partitions' spectra, per channel
+	ne10_fft_r2c_cfg_int32_t fftConfig_ = nullptr;
+	int32_t numPartitions_ = 0;
+	int32_t numImpulseResponseChannels_ = 0;
+	int32_t newestHistorySlot_ = 0;
+	int32_t posInPartition_ = 0;
+};
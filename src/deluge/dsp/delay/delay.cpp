@@ -26,6 +26,10 @@
 #include <cstdlib>
 #include <ranges>
 
+#if defined(__ARM_NEON)
+#include "arm_neon_shim.h"
+#endif
+
 extern int32_t spareRenderingBuffer[][SSI_TX_BUFFER_NUM_SAMPLES];
 
 void Delay::informWhetherActive(bool newActive, int32_t userDelayRate) {
@@ -221,6 +225,30 @@ void Delay::initializeSecondaryBuffer(int32_t newNativeRate, bool makeNativeRate
 	sizeLeftUntilBufferSwap = secondaryBuffer.size() + 5;
 }
 
+// The digital feedback gain, leaving more headroom than the analog one, because making it clip sounds bad with pure
+// digital
+static void applyDigitalFeedback(std::span<StereoSample> buffer, int32_t feedbackAmount) {
+	int32_t* values = (int32_t*)buffer.data();
+	size_t numValues = buffer.size() * 2;
+	size_t i = 0;
+
+#if defined(__ARM_NEON)
+	int32x2_t amount = vdup_n_s32(feedbackAmount);
+	int32x4_t max = vdupq_n_s32((1 << 28) - 1); // signed_saturate<32 - 3>()
+	int32x4_t min = vdupq_n_s32(-(1 << 28));
+	for (; i + 4 <= numValues; i += 4) {
+		int32x4_t input = vld1q_s32(&values[i]);
+		int32x4_t multiplied = vcombine_s32(vshrn_n_s64(vmull_s32(vget_low_s32(input), amount), 32),
+		                                    vshrn_n_s64(vmull_s32(vget_high_s32(input), amount), 32));
+		vst1q_s32(&values[i], vshlq_n_s32(vminq_s32(vmaxq_s32(multiplied, min), max), 2));
+	}
+#endif
+
+	for (; i < numValues; i++) {
+		values[i] = signed_saturate<32 - 3>(multiply_32x32_rshift32(values[i], feedbackAmount)) << 2;
+	}
+}
+
 void Delay::process(std::span<StereoSample> buffer, const State& delayWorkingState) {
 	if (!delayWorkingState.doDelay) {
 		return;
@@ -292,37 +320,12 @@ void Delay::process(std::span<StereoSample> buffer, const State& delayWorkingSta
 
 		// Native read
 		if (primaryBuffer.isNative()) {
-			for (StereoSample& sample : working_buffer) {
-				wrapped = primaryBuffer.clearAndMoveOn() || wrapped;
-				sample = primaryBuffer.current();
-			}
+			wrapped = primaryBuffer.clearAndReadNative(working_buffer);
 		}
 
 		// Or, resampling read
 		else {
-
-			for (StereoSample& sample : working_buffer) {
-				// Move forward, and clear buffer as we go
-				int32_t primaryStrength2 = primaryBuffer.advance([&] {
-					wrapped = primaryBuffer.clearAndMoveOn() || wrapped; //<
-				});
-
-				int32_t primaryStrength1 = 65536 - primaryStrength2;
-
-				StereoSample* nextPos = &primaryBuffer.current() + 1;
-				if (nextPos == primaryBuffer.end()) {
-					nextPos = primaryBuffer.begin();
-				}
-				StereoSample fromDelay1 = primaryBuffer.current();
-				StereoSample fromDelay2 = *nextPos;
-
-				sample.l = (multiply_32x32_rshift32(fromDelay1.l, primaryStrength1 << 14)
-				            + multiply_32x32_rshift32(fromDelay2.l, primaryStrength2 << 14))
-				           << 2;
-				sample.r = (multiply_32x32_rshift32(fromDelay1.r, primaryStrength1 << 14)
-				            + multiply_32x32_rshift32(fromDelay2.r, primaryStrength2 << 14))
-				           << 2;
-			}
+			wrapped = primaryBuffer.clearAndReadResampled(working_buffer);
 		}
 	}
 
@@ -346,13 +349,7 @@ void Delay::process(std::span<StereoSample> buffer, const State& delayWorkingSta
 	}
 
 	else {
-		for (StereoSample& sample : working_buffer) {
-			// Leave more headroom, because making it clip sounds bad with pure digital
-			sample.l = signed_saturate<32 - 3>(multiply_32x32_rshift32(sample.l, delayWorkingState.delayFeedbackAmount))
-			           << 2;
-			sample.r = signed_saturate<32 - 3>(multiply_32x32_rshift32(sample.r, delayWorkingState.delayFeedbackAmount))
-			           << 2;
-		}
+		applyDigitalFeedback(working_buffer, delayWorkingState.delayFeedbackAmount);
 	}
 
 	// HPF on delay output, to stop it "farting out". Corner frequency is somewhere around 40Hz after many
@@ -394,10 +391,7 @@ void Delay::process(std::span<StereoSample> buffer, const State& delayWorkingSta
 			if (writePos < primaryBuffer.begin()) {
 				writePos += primaryBuffer.sizeIncludingExtra;
 			}
-
-			for (StereoSample sample : working_buffer) {
-				primaryBuffer.writeNativeAndMoveOn(sample, &writePos);
-			}
+			primaryBuffer.writeNative(working_buffer, writePos);
 		}
 
 		// Resampling
@@ -407,13 +401,9 @@ void Delay::process(std::span<StereoSample> buffer, const State& delayWorkingSta
 			primaryBuffer.lastShortPos = primaryBufferOldLastShortPos;
 
 			for (StereoSample sample : working_buffer) {
-				// Move forward
-				int32_t primaryStrength2 = primaryBuffer.advance([&] {
-					primaryBuffer.moveOn(); //<
-				});
-				int32_t primaryStrength1 = 65536 - primaryStrength2;
-
-				primaryBuffer.writeResampled(sample, primaryStrength1, primaryStrength2);
+				DelayBuffer::Step step = primaryBuffer.nextStep();
+				primaryBuffer.moveOn(step.numPositions);
+				primaryBuffer.writeResampled(sample, 65536 - step.strength2, step.strength2);
 			}
 		}
 	}
@@ -427,29 +417,20 @@ void Delay::process(std::span<StereoSample> buffer, const State& delayWorkingSta
 
 		// Native
 		if (secondaryBuffer.isNative()) {
-			for (StereoSample sample : working_buffer) {
-				wrapped = secondaryBuffer.clearAndMoveOn() || wrapped;
-				sizeLeftUntilBufferSwap--;
-
-				// Write to secondary buffer
-				secondaryBuffer.writeNative(sample);
-			};
+			wrapped = secondaryBuffer.clearAndWriteNative(working_buffer);
+			sizeLeftUntilBufferSwap -= working_buffer.size();
 		}
 
 		// Resampled
 		else {
-
 			for (StereoSample sample : working_buffer) {
 				// Move forward, and clear buffer as we go
-				int32_t secondaryStrength2 = secondaryBuffer.advance([&] {
-					wrapped = secondaryBuffer.clearAndMoveOn() || wrapped; //<
-					sizeLeftUntilBufferSwap--;
-				});
-
-				int32_t secondaryStrength1 = 65536 - secondaryStrength2;
+				DelayBuffer::Step step = secondaryBuffer.nextStep();
+				wrapped = secondaryBuffer.clearAndMoveOn(step.numPositions) || wrapped;
+				sizeLeftUntilBufferSwap -= step.numPositions;
 
 				// Write to secondary buffer
-				secondaryBuffer.writeResampled(sample, secondaryStrength1, secondaryStrength2);
+				secondaryBuffer.writeResampled(sample, 65536 - step.strength2, step.strength2);
 			}
 		}
 
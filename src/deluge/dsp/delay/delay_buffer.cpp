@@ -19,9 +19,14 @@
 #include "dsp/stereo_sample.h"
 #include "mem_functions.h"
 #include "memory/memory_allocator_interface.h"
+#include <array>
 #include <cmath>
 #include <optional>
 
+#if defined(__ARM_NEON)
+#include "arm_neon_shim.h"
+#endif
+
 // Returns error status
 Error DelayBuffer::init(uint32_t rate, uint32_t failIfThisSize, bool includeExtraSpace) {
 
@@ -189,3 +194,104 @@ void DelayBuffer::setupForRender(int32_t rate) {
 	    .writeSizeAdjustment = writeSizeAdjustment,
 	};
 }
+
+bool DelayBuffer::clearAndReadNative(std::span<StereoSample> output) {
+	bool wrapped = false;
+	while (!output.empty()) {
+		size_t numSamples = std::min(output.size(), maxSamplesPerPass());
+
+		// Each sample is read from one position after the one just cleared
+		StereoSample* readPos = (current_ + 1 == end_) ? start_ : current_ + 1;
+		auto outputPos = output.begin();
+		forEachSpan(readPos, numSamples, [&](std::span<StereoSample> span) {
+			outputPos = std::ranges::copy(span, outputPos).out; //<
+		});
+
+		wrapped = clearAndMoveOn(numSamples) || wrapped;
+		output = output.subspan(numSamples);
+	}
+	return wrapped;
+}
+
+void DelayBuffer::writeNative(std::span<StereoSample const> input, StereoSample* writePos) {
+	forEachSpan(writePos, input.size(), [&](std::span<StereoSample> span) {
+		std::ranges::copy(input.first(span.size()), span.begin());
+		input = input.subspan(span.size());
+	});
+}
+
+bool DelayBuffer::clearAndWriteNative(std::span<StereoSample const> input) {
+	bool wrapped = false;
+	while (!input.empty()) {
+		size_t numSamples = std::min(input.size(), maxSamplesPerPass());
+		wrapped = clearAndMoveOn(numSamples) || wrapped;
+
+		// The first sample goes where writeNative() would have put it, after the first move on
+		StereoSample* writePos = current_ - numSamples + 1 - delaySpaceBetweenReadAndWrite;
+		while (writePos < start_) {
+			writePos += sizeIncludingExtra;
+		}
+		writeNative(input.first(numSamples), writePos);
+		input = input.subspan(numSamples);
+	}
+	return wrapped;
+}
+
+bool DelayBuffer::clearAndReadResampled(std::span<StereoSample> output) {
+	// The positions to read from can only be found a sample at a time, but once they're gathered, the interpolation
+	// between them can be done for a bunch of samples together
+	constexpr size_t kNumSamplesPerGather = 32;
+	std::array<StereoSample, kNumSamplesPerGather> nextSamples;
+	alignas(16) std::array<int32_t, kNumSamplesPerGather * 2> strengths2; // Once for each channel
+
+	bool wrapped = false;
+	while (!output.empty()) {
+		size_t numSamples = std::min(output.size(), kNumSamplesPerGather);
+
+		for (size_t i = 0; i < numSamples; i++) {
+			Step step = nextStep();
+			wrapped = clearAndMoveOn(step.numPositions) || wrapped;
+			output[i] = *current_;
+			nextSamples[i] = (current_ + 1 == end_) ? *start_ : *(current_ + 1);
+			strengths2[i * 2] = step.strength2;
+			strengths2[i * 2 + 1] = step.strength2;
+		}
+
+#if defined(__ARM_NEON)
+		// Two stereo samples per vector. Doubling multiplies by the strengths << 13 come out the same as
+		// multiply_32x32_rshift32() by the strengths << 14
+		int32_t* samples = (int32_t*)output.data();
+		int32_t const* next = (int32_t const*)nextSamples.data();
+		int32x4_t full = vdupq_n_s32(65536 << 13);
+		size_t numValues = numSamples * 2;
+		size_t i = 0;
+		for (; i + 4 <= numValues; i += 4) {
+			int32x4_t strength2 = vshlq_n_s32(vld1q_s32(&strengths2[i]), 13);
+			int32x4_t strength1 = vsubq_s32(full, strength2);
+			int32x4_t sum = vaddq_s32(vqdmulhq_s32(vld1q_s32(&samples[i]), strength1),
+			                          vqdmulhq_s32(vld1q_s32(&next[i]), strength2));
+			vst1q_s32(&samples[i], vshlq_n_s32(sum, 2));
+		}
+		for (; i < numValues; i++) {
+			int32_t strength2 = strengths2[i];
+			samples[i] = (multiply_32x32_rshift32(samples[i], (65536 - strength2) << 14)
+			              + multiply_32x32_rshift32(next[i], strength2 << 14))
+			             << 2;
+		}
+#else
+		for (size_t i = 0; i < numSamples; i++) {
+			int32_t strength2 = strengths2[i * 2];
+			int32_t strength1 = 65536 - strength2;
+			output[i].l = (multiply_32x32_rshift32(output[i].l, strength1 << 14)
+			               + multiply_32x32_rshift32(nextSamples[i].l, strength2 << 14))
+			              << 2;
+			output[i].r = (multiply_32x32_rshift32(output[i].r, strength1 << 14)
+			               + multiply_32x32_rshift32(nextSamples[i].r, strength2 << 14))
+			              << 2;
+		}
+#endif
+
+		output = output.subspan(numSamples);
+	}
+	return wrapped;
+}
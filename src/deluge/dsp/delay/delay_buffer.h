@@ -19,9 +19,11 @@
 
 #include "definitions_cxx.hpp"
 #include "dsp/stereo_sample.h"
+#include <algorithm>
 #include <cstdint>
 #include <expected>
 #include <optional>
+#include <span>
 
 class StereoSample;
 
@@ -46,18 +48,29 @@ public:
 
 	void discard();
 
-	template <typename C>
-	[[gnu::always_inline]] constexpr int32_t advance(C callback) {
+	/// Where the next output sample falls, when resampling
+	struct Step {
+		/// How many positions the buffer needs to move on by to get there
+		uint8_t numPositions;
+		/// And how far it is from there to the position after, 65536 being all the way
+		int32_t strength2;
+	};
+
+	[[gnu::always_inline]] constexpr Step nextStep() {
 		longPos += resample_config_.value().actualSpinRate;
 		uint8_t newShortPos = longPos >> 24;
 		uint8_t shortPosDiff = newShortPos - lastShortPos;
 		lastShortPos = newShortPos;
+		return {shortPosDiff, (int32_t)((longPos >> 8) & 65535)};
+	}
 
-		while (shortPosDiff > 0) {
+	template <typename C>
+	[[gnu::always_inline]] constexpr int32_t advance(C callback) {
+		Step step = nextStep();
+		for (uint8_t i = 0; i < step.numPositions; i++) {
 			callback();
-			shortPosDiff--;
 		}
-		return (longPos >> 8) & 65535;
+		return step.strength2;
 	}
 
 	void setupForRender(int32_t rate);
@@ -81,6 +94,37 @@ public:
 		return wrapped;
 	}
 
+	/// moveOn() numPositions times, in one go
+	inline bool moveOn(size_t numPositions) {
+		current_ += numPositions;
+		bool wrapped = false;
+		while (current_ >= end_) {
+			current_ -= sizeIncludingExtra;
+			wrapped = true;
+		}
+		return wrapped;
+	}
+
+	/// clearAndMoveOn() numPositions times, clearing each contiguous span in one go
+	inline bool clearAndMoveOn(size_t numPositions) {
+		forEachSpan(current_, numPositions, clearSpan);
+		return moveOn(numPositions);
+	}
+
+	// Block versions of the per-sample reads and writes, for a whole render window. Rather than checking for the wrap
+	// at every sample, these work out which contiguous spans of the buffer the window covers, split where the buffer
+	// wraps, and copy or clear each span in one go. Each returns whether the buffer wrapped, like clearAndMoveOn().
+
+	/// clearAndMoveOn() and then read current(), for each sample of output
+	bool clearAndReadNative(std::span<StereoSample> output);
+	/// writeNativeAndMoveOn() for each sample of input
+	void writeNative(std::span<StereoSample const> input, StereoSample* writePos);
+	/// clearAndMoveOn() and then writeNative(), for each sample of input
+	bool clearAndWriteNative(std::span<StereoSample const> input);
+	/// advance() with clearAndMoveOn(), and then interpolate between current() and the position after, for each sample
+	/// of output
+	bool clearAndReadResampled(std::span<StereoSample> output);
+
 	inline void writeNative(StereoSample toDelay) {
 		StereoSample* writePos = current_ - delaySpaceBetweenReadAndWrite;
 		if (writePos < start_) {
@@ -272,6 +316,28 @@ private:
 
 	void setupResample();
 
+	static void clearSpan(std::span<StereoSample> span) { std::ranges::fill(span, StereoSample{0, 0}); }
+
+	/// Calls function with each contiguous span of the numPositions positions starting from `from`
+	template <typename F>
+	[[gnu::always_inline]] void forEachSpan(StereoSample* from, size_t numPositions, F function) const {
+		while (numPositions) {
+			size_t spanSize = std::min<size_t>(numPositions, end_ - from);
+			function(std::span<StereoSample>{from, spanSize});
+			from += spanSize;
+			if (from == end_) {
+				from = start_;
+			}
+			numPositions -= spanSize;
+		}
+	}
+
+	/// The most samples the block functions can do in one pass, without reading or writing anywhere they've already
+	/// cleared in that pass
+	[[nodiscard]] constexpr size_t maxSamplesPerPass() const {
+		return std::max<ptrdiff_t>(1, sizeIncludingExtra - delaySpaceBetweenReadAndWrite - 1);
+	}
+
 	uint32_t native_rate_ = 0;
 
 	StereoSample* start_ = nullptr;
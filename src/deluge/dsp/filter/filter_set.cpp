@@ -66,6 +66,18 @@ q31_t tempRenderBuffer[SSI_TX_BUFFER_NUM_SAMPLES * 2]; // * 2 to accomodate ster
 		}
 	}
 }
+SVFilter* FilterSet::getLoneSVF() {
+	// Parallel routing mixes in the dry signal as the missing HPF's output, which the batch doesn't
+	if (!LPFOn || HPFOn || routing_ == FilterRoute::PARALLEL
+	    || (lpfMode_ != FilterMode::SVF_BAND && lpfMode_ != FilterMode::SVF_NOTCH)) {
+		return nullptr;
+	}
+	if (lpfilter.svf.dryFade >= 0.001) {
+		return nullptr;
+	}
+	return &lpfilter.svf;
+}
+
 [[gnu::hot]] void FilterSet::renderLong(q31_t* startSample, q31_t* endSample, int32_t numSamples,
                                         int32_t sampleIncrememt) {
 	switch (routing_) {
@@ -58,6 +58,10 @@ public:
 	inline bool isHPFOn() { return HPFOn; }
 	inline bool isOn() { return HPFOn || LPFOn; }
 
+	/// The low pass SVF, if that's the only filter renderLong() would run - so dsp::VoiceBatch can run it alongside
+	/// other voices' instead. nullptr if there's anything else to do, including fading in from dry
+	SVFilter* getLoneSVF();
+
 private:
 	FilterMode lpfMode_;
 	FilterMode lastLPFMode_;
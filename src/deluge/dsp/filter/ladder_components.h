@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "dsp/filter/q31x2.h"
 #include "util/fixedpoint.h"
 #include <cstdint>
 namespace deluge::dsp::filter {
@@ -48,4 +49,37 @@ public:
 
 	q31_t memory = 0;
 };
+
+/// BasicFilterComponent, for the left and right channels at once
+class StereoFilterComponent {
+public:
+	StereoFilterComponent() = default;
+	StereoFilterComponent(BasicFilterComponent const& l, BasicFilterComponent const& r)
+	    : memory(Q31x2::of(l.memory, r.memory)) {}
+
+	[[gnu::always_inline]] inline Q31x2 doFilter(Q31x2 input, Q31x2 moveability) {
+		Q31x2 a = multiply_32x32_rshift32_rounded(input - memory, moveability).shiftLeft<1>();
+		Q31x2 b = a + memory;
+		memory = b + a;
+		return b;
+	}
+	[[gnu::always_inline]] inline Q31x2 doAPF(Q31x2 input, Q31x2 moveability) {
+		Q31x2 a = multiply_32x32_rshift32_rounded(input - memory, moveability).shiftLeft<1>();
+		Q31x2 b = a + memory;
+		memory = a + b;
+		return b.shiftLeft<1>() - input;
+	}
+	[[gnu::always_inline]] inline Q31x2 getFeedbackOutput(int32_t feedbackAmount) {
+		return multiply_32x32_rshift32_rounded(memory, Q31x2::both(feedbackAmount)).shiftLeft<2>();
+	}
+	[[gnu::always_inline]] inline Q31x2 getFeedbackOutputWithoutLshift(int32_t feedbackAmount) {
+		return multiply_32x32_rshift32_rounded(memory, Q31x2::both(feedbackAmount));
+	}
+	void storeTo(BasicFilterComponent& l, BasicFilterComponent& r) const {
+		l.memory = memory.l();
+		r.memory = memory.r();
+	}
+
+	Q31x2 memory;
+};
 } // namespace deluge::dsp::filter
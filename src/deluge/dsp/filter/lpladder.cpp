@@ -240,16 +240,19 @@ q31_t LpLadderFilter::setConfig(q31_t lpfFrequency, q31_t lpfResonance, FilterMo
 	}
 }
 [[gnu::hot]] void LpLadderFilter::doFilterStereo(q31_t* startSample, q31_t* endSample) {
+	// Both channels go through together, with their state in lanes. Each channel's noise is still drawn in the order
+	// it would be if they were done one after the other, so the result is exactly the same
+	StereoLpLadderState state(l, r);
 
 	// Half ladder
 	if (lpfMode == FilterMode::TRANSISTOR_12DB) {
 
 		q31_t* currentSample = startSample;
 		do {
-			*currentSample = do12dBLPFOnSample(*currentSample, l);
-			currentSample += 1;
-			*currentSample = do12dBLPFOnSample(*currentSample, r);
-			currentSample += 1;
+			q31_t noiseL = getNoise() >> 2;
+			q31_t noiseR = getNoise() >> 2;
+			do12dBLPFOnSample(Q31x2::load(currentSample), Q31x2::of(noiseL, noiseR), state).store(currentSample);
+			currentSample += 2;
 		} while (currentSample < endSample);
 	}
 
@@ -257,12 +260,10 @@ q31_t LpLadderFilter::setConfig(q31_t lpfFrequency, q31_t lpfResonance, FilterMo
 	else if (lpfMode == FilterMode::TRANSISTOR_24DB) {
 		q31_t* currentSample = startSample;
 		do {
-			*currentSample = do24dBLPFOnSample(*currentSample, l);
-
-			currentSample += 1;
-			*currentSample = do24dBLPFOnSample(*currentSample, r);
-
-			currentSample += 1;
+			q31_t noiseL = getNoise() >> 2;
+			q31_t noiseR = getNoise() >> 2;
+			do24dBLPFOnSample(Q31x2::load(currentSample), Q31x2::of(noiseL, noiseR), state).store(currentSample);
+			currentSample += 2;
 		} while (currentSample < endSample);
 	}
 
@@ -271,58 +272,37 @@ q31_t LpLadderFilter::setConfig(q31_t lpfFrequency, q31_t lpfResonance, FilterMo
 		if (doOversampling) {
 			q31_t* currentSample = startSample;
 			do {
-				// Linear interpolation works surprisingly well here - it doesn't lead to audible aliasing. But its big
-				// problem is that it kills the highest frequencies, which is especially noticeable when resonance is
-				// low. This is because it'll turn all your high sine waves into triangles whose fundamental is lower in
-				// amplitude. Now, if we immediately downsampled that again with no filtering, no problem, because those
-				// new really high harmonics that make it triangular are still there. But after running it through the
-				// ladder filter, those get doubly filtered out, leaving just the reduced-amplitude (fundamental) sine
-				// waves where our old ones were. So instead, we need to do just a little bit more and take one extra,
-				// previous sample into account in our interpolation. This is enough to make the HF loss inaudible
-				// - although we can still see it on the spectrum analysis.
-
-				// Insanely just doubling up our input values to oversample works better than fancy 3-sample
-				// interpolation. And even, making our "interpolated" sample just a 0 and doubling the amplitude of the
-				// actual sample works very nearly as well as this, but gives a little bit more aliasing on high notes
-				// fed in.
-
-				doDriveLPFOnSample(*currentSample, l);
-
-				// Crude downsampling - just take every second sample, with no anti-aliasing filter. Works fine cos the
-				// ladder LPF filter takes care of lots of those high harmonics!
-				q31_t outputSampleToKeep = doDriveLPFOnSample(*currentSample, l);
-
-				// Only perform the final saturation stage on this one sample, which we want to keep
-				*currentSample = getTanHUnknown(outputSampleToKeep, 4);
-
-				currentSample += 1;
-				doDriveLPFOnSample(*currentSample, r);
-
-				// Crude downsampling - just take every second sample, with no anti-aliasing filter. Works fine cos the
-				// ladder LPF filter takes care of lots of those high harmonics!
-				outputSampleToKeep = doDriveLPFOnSample(*currentSample, r);
+				// See doFilter() for why this oversampling is so crude, and why it still works
+				q31_t noiseL1 = getNoise() >> 2;
+				q31_t noiseL2 = getNoise() >> 2;
+				q31_t noiseR1 = getNoise() >> 2;
+				q31_t noiseR2 = getNoise() >> 2;
+				Q31x2 input = Q31x2::load(currentSample);
+				doDriveLPFOnSample(input, Q31x2::of(noiseL1, noiseR1), state);
+				Q31x2 outputSampleToKeep = doDriveLPFOnSample(input, Q31x2::of(noiseL2, noiseR2), state);
 
 				// Only perform the final saturation stage on this one sample, which we want to keep
-				*currentSample = getTanHUnknown(outputSampleToKeep, 4);
+				getTanHUnknown(outputSampleToKeep, 4).store(currentSample);
 
-				currentSample += 1;
+				currentSample += 2;
 			} while (currentSample < endSample);
 		}
 
 		else {
 			q31_t* currentSample = startSample;
 			do {
-				q31_t outputSampleToKeep = doDriveLPFOnSample(*currentSample, l);
-				*currentSample = getTanHUnknown(outputSampleToKeep, 4);
+				q31_t noiseL = getNoise() >> 2;
+				q31_t noiseR = getNoise() >> 2;
+				Q31x2 outputSampleToKeep =
+				    doDriveLPFOnSample(Q31x2::load(currentSample), Q31x2::of(noiseL, noiseR), state);
+				getTanHUnknown(outputSampleToKeep, 4).store(currentSample);
 
-				currentSample += 1;
-				outputSampleToKeep = doDriveLPFOnSample(*currentSample, r);
-				*currentSample = getTanHUnknown(outputSampleToKeep, 4);
-
-				currentSample += 1;
+				currentSample += 2;
 			} while (currentSample < endSample);
 		}
 	}
+
+	state.storeTo(l, r);
 }
 [[gnu::always_inline]] inline q31_t LpLadderFilter::do12dBLPFOnSample(q31_t input, LpLadderState& state) {
 	// For drive filter, apply some heavily lowpassed noise to the filter frequency, to add analog-ness
@@ -409,4 +389,61 @@ q31_t LpLadderFilter::setConfig(q31_t lpfFrequency, q31_t lpfResonance, FilterMo
 
 	return d;
 }
+
+[[gnu::always_inline]] inline Q31x2 LpLadderFilter::getNoisyMoveability(Q31x2 noise, StereoLpLadderState& state) {
+	Q31x2 distanceToGo = noise - state.noiseLastValue;
+	state.noiseLastValue = state.noiseLastValue + distanceToGo.shiftRight<7>();
+	Q31x2 moveabilityBoth = Q31x2::both(moveability);
+	return moveabilityBoth + multiply_32x32_rshift32(moveabilityBoth, state.noiseLastValue);
+}
+
+[[gnu::always_inline]] inline Q31x2 LpLadderFilter::do12dBLPFOnSample(Q31x2 input, Q31x2 noise,
+                                                                      StereoLpLadderState& state) {
+	Q31x2 noisy_m = getNoisyMoveability(noise, state);
+
+	Q31x2 feedbacksSum = state.lpfLPF1.getFeedbackOutput(lpf1Feedback) + state.lpfLPF2.getFeedbackOutput(lpf2Feedback)
+	                     + state.lpfLPF3.getFeedbackOutput(divideBy1PlusTannedFrequency);
+	Q31x2 x = scaleInput(input, feedbacksSum);
+
+	return state.lpfLPF3.doAPF(state.lpfLPF2.doFilter(state.lpfLPF1.doFilter(x, noisy_m), noisy_m), noisy_m)
+	    .shiftLeft<1>();
+}
+
+[[gnu::always_inline]] inline Q31x2 LpLadderFilter::do24dBLPFOnSample(Q31x2 input, Q31x2 noise,
+                                                                      StereoLpLadderState& state) {
+	Q31x2 noisy_m = getNoisyMoveability(noise, state);
+
+	Q31x2 feedbacksSum = (state.lpfLPF1.getFeedbackOutputWithoutLshift(lpf1Feedback)
+	                      + state.lpfLPF2.getFeedbackOutputWithoutLshift(lpf2Feedback)
+	                      + state.lpfLPF3.getFeedbackOutputWithoutLshift(lpf3Feedback)
+	                      + state.lpfLPF4.getFeedbackOutputWithoutLshift(divideBy1PlusTannedFrequency))
+	                         .shiftLeft<2>();
+	Q31x2 x = scaleInput(input, feedbacksSum);
+
+	return state.lpfLPF4
+	    .doFilter(
+	        state.lpfLPF3.doFilter(state.lpfLPF2.doFilter(state.lpfLPF1.doFilter(x, noisy_m), noisy_m), noisy_m),
+	        noisy_m)
+	    .shiftLeft<1>();
+}
+
+[[gnu::always_inline]] inline Q31x2 LpLadderFilter::doDriveLPFOnSample(Q31x2 input, Q31x2 noise,
+                                                                       StereoLpLadderState& state) {
+	Q31x2 noisy_m = getNoisyMoveability(noise, state);
+
+	Q31x2 feedbacksSum = (state.lpfLPF1.getFeedbackOutputWithoutLshift(lpf1Feedback)
+	                      + state.lpfLPF2.getFeedbackOutputWithoutLshift(lpf2Feedback)
+	                      + state.lpfLPF3.getFeedbackOutputWithoutLshift(lpf3Feedback)
+	                      + state.lpfLPF4.getFeedbackOutputWithoutLshift(divideBy1PlusTannedFrequency))
+	                         .shiftLeft<2>();
+
+	// Saturate feedback
+	feedbacksSum = getTanHUnknown(feedbacksSum, 7);
+	Q31x2 x = scaleInput(input, feedbacksSum);
+
+	Q31x2 a = state.lpfLPF1.doFilter(x, noisy_m);
+	Q31x2 b = state.lpfLPF2.doFilter(a, noisy_m);
+	Q31x2 c = state.lpfLPF3.doFilter(b, noisy_m);
+	return state.lpfLPF4.doFilter(c, noisy_m).shiftLeft<1>();
+}
 } // namespace deluge::dsp::filter
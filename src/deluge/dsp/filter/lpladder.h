@@ -68,9 +68,45 @@ private:
 
 		return temp;
 	}
+	/// Both channels' LpLadderState, in lanes
+	struct StereoLpLadderState {
+		StereoLpLadderState(LpLadderState const& l, LpLadderState const& r)
+		    : noiseLastValue(Q31x2::of(l.noiseLastValue, r.noiseLastValue)), lpfLPF1(l.lpfLPF1, r.lpfLPF1),
+		      lpfLPF2(l.lpfLPF2, r.lpfLPF2), lpfLPF3(l.lpfLPF3, r.lpfLPF3), lpfLPF4(l.lpfLPF4, r.lpfLPF4) {}
+		void storeTo(LpLadderState& l, LpLadderState& r) const {
+			l.noiseLastValue = noiseLastValue.l();
+			r.noiseLastValue = noiseLastValue.r();
+			lpfLPF1.storeTo(l.lpfLPF1, r.lpfLPF1);
+			lpfLPF2.storeTo(l.lpfLPF2, r.lpfLPF2);
+			lpfLPF3.storeTo(l.lpfLPF3, r.lpfLPF3);
+			lpfLPF4.storeTo(l.lpfLPF4, r.lpfLPF4);
+		}
+		Q31x2 noiseLastValue;
+		StereoFilterComponent lpfLPF1;
+		StereoFilterComponent lpfLPF2;
+		StereoFilterComponent lpfLPF3;
+		StereoFilterComponent lpfLPF4;
+	};
+	[[gnu::always_inline]] inline Q31x2 scaleInput(Q31x2 input, Q31x2 feedbacksSum) {
+		Q31x2 temp = multiply_32x32_rshift32_rounded(
+		                 input - multiply_32x32_rshift32_rounded(feedbacksSum, Q31x2::both(processedResonance))
+		                             .shiftLeft<3>(),
+		                 Q31x2::both(divideByTotalMoveabilityAndProcessedResonance))
+		                 .shiftLeft<2>();
+		if (morph > 0 || processedResonance > 510000000) {
+			Q31x2 extra = multiply_32x32_rshift32(input, Q31x2::both(morph)).shiftLeft<1>();
+			temp = getTanHUnknown(temp + extra, 2);
+		}
+		return temp;
+	}
 	[[gnu::always_inline]] inline q31_t do24dBLPFOnSample(q31_t input, LpLadderState& state);
 	[[gnu::always_inline]] inline q31_t do12dBLPFOnSample(q31_t input, LpLadderState& state);
 	[[gnu::always_inline]] inline q31_t doDriveLPFOnSample(q31_t input, LpLadderState& state);
+	// The stereo versions take each channel's noise, so the caller can draw it in the same order the mono ones would
+	[[gnu::always_inline]] inline Q31x2 getNoisyMoveability(Q31x2 noise, StereoLpLadderState& state);
+	[[gnu::always_inline]] inline Q31x2 do24dBLPFOnSample(Q31x2 input, Q31x2 noise, StereoLpLadderState& state);
+	[[gnu::always_inline]] inline Q31x2 do12dBLPFOnSample(Q31x2 input, Q31x2 noise, StereoLpLadderState& state);
+	[[gnu::always_inline]] inline Q31x2 doDriveLPFOnSample(Q31x2 input, Q31x2 noise, StereoLpLadderState& state);
 	// all ladders are in this class to share the basic components
 	// this differentiates between them
 	FilterMode lpfMode;
@@ -0,0 +1,161 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "util/fixedpoint.h"
+#include "util/functions.h"
+#include <cstdint>
+
+#if defined(__ARM_NEON)
+#include "arm_neon_shim.h"
+#endif
+
+namespace deluge::dsp::filter {
+
+/// A left and a right q31_t, side by side in one NEON register, so a stereo filter can step both channels' state at
+/// once. Every operation gives exactly what the scalar function it's named after does to each channel - so a kernel
+/// written with these sounds identical to running the mono one twice. Without NEON it's just two q31_ts, which is
+/// also what lets the kernels be checked against the scalar ones on a computer.
+class Q31x2 {
+public:
+#if defined(__ARM_NEON)
+	using Lanes = int32x2_t;
+#else
+	struct Lanes {
+		q31_t l;
+		q31_t r;
+	};
+#endif
+
+	Q31x2() = default;
+	constexpr Q31x2(Lanes lanes) : lanes_(lanes) {}
+
+	[[gnu::always_inline]] static Q31x2 both(q31_t value) {
+#if defined(__ARM_NEON)
+		return vdup_n_s32(value);
+#else
+		return Lanes{value, value};
+#endif
+	}
+	[[gnu::always_inline]] static Q31x2 of(q31_t l, q31_t r) {
+#if defined(__ARM_NEON)
+		return vset_lane_s32(r, vdup_n_s32(l), 1);
+#else
+		return Lanes{l, r};
+#endif
+	}
+	/// An interleaved stereo sample
+	[[gnu::always_inline]] static Q31x2 load(q31_t const* sample) {
+#if defined(__ARM_NEON)
+		return vld1_s32(sample);
+#else
+		return Lanes{sample[0], sample[1]};
+#endif
+	}
+	[[gnu::always_inline]] void store(q31_t* sample) const {
+#if defined(__ARM_NEON)
+		vst1_s32(sample, lanes_);
+#else
+		sample[0] = lanes_.l;
+		sample[1] = lanes_.r;
+#endif
+	}
+	[[gnu::always_inline]] q31_t l() const {
+#if defined(__ARM_NEON)
+		return vget_lane_s32(lanes_, 0);
+#else
+		return lanes_.l;
+#endif
+	}
+	[[gnu::always_inline]] q31_t r() const {
+#if defined(__ARM_NEON)
+		return vget_lane_s32(lanes_, 1);
+#else
+		return lanes_.r;
+#endif
+	}
+
+	// Wrapping, like the int32 arithmetic in the scalar filters
+	[[gnu::always_inline]] friend Q31x2 operator+(Q31x2 a, Q31x2 b) {
+#if defined(__ARM_NEON)
+		return vadd_s32(a.lanes_, b.lanes_);
+#else
+		return Lanes{(q31_t)((uint32_t)a.lanes_.l + (uint32_t)b.lanes_.l),
+		             (q31_t)((uint32_t)a.lanes_.r + (uint32_t)b.lanes_.r)};
+#endif
+	}
+	[[gnu::always_inline]] friend Q31x2 operator-(Q31x2 a, Q31x2 b) {
+#if defined(__ARM_NEON)
+		return vsub_s32(a.lanes_, b.lanes_);
+#else
+		return Lanes{(q31_t)((uint32_t)a.lanes_.l - (uint32_t)b.lanes_.l),
+		             (q31_t)((uint32_t)a.lanes_.r - (uint32_t)b.lanes_.r)};
+#endif
+	}
+	template <int32_t kShift>
+	[[gnu::always_inline]] Q31x2 shiftLeft() const {
+#if defined(__ARM_NEON)
+		return vshl_n_s32(lanes_, kShift);
+#else
+		return Lanes{(q31_t)((uint32_t)lanes_.l << kShift), (q31_t)((uint32_t)lanes_.r << kShift)};
+#endif
+	}
+	template <int32_t kShift>
+	[[gnu::always_inline]] Q31x2 shiftRight() const {
+#if defined(__ARM_NEON)
+		return vshr_n_s32(lanes_, kShift);
+#else
+		return Lanes{lanes_.l >> kShift, lanes_.r >> kShift};
+#endif
+	}
+
+	[[gnu::always_inline]] friend Q31x2 multiply_32x32_rshift32(Q31x2 a, Q31x2 b) {
+#if defined(__ARM_NEON)
+		return vshrn_n_s64(vmull_s32(a.lanes_, b.lanes_), 32);
+#else
+		return Lanes{::multiply_32x32_rshift32(a.lanes_.l, b.lanes_.l),
+		             ::multiply_32x32_rshift32(a.lanes_.r, b.lanes_.r)};
+#endif
+	}
+	[[gnu::always_inline]] friend Q31x2 multiply_32x32_rshift32_rounded(Q31x2 a, Q31x2 b) {
+#if defined(__ARM_NEON)
+		return vrshrn_n_s64(vmull_s32(a.lanes_, b.lanes_), 32);
+#else
+		return Lanes{::multiply_32x32_rshift32_rounded(a.lanes_.l, b.lanes_.l),
+		             ::multiply_32x32_rshift32_rounded(a.lanes_.r, b.lanes_.r)};
+#endif
+	}
+	[[gnu::always_inline]] friend Q31x2 multiply_accumulate_32x32_rshift32_rounded(Q31x2 sum, Q31x2 a, Q31x2 b) {
+#if defined(__ARM_NEON)
+		return vadd_s32(sum.lanes_, vrshrn_n_s64(vmull_s32(a.lanes_, b.lanes_), 32));
+#else
+		return Lanes{::multiply_accumulate_32x32_rshift32_rounded(sum.lanes_.l, a.lanes_.l, b.lanes_.l),
+		             ::multiply_accumulate_32x32_rshift32_rounded(sum.lanes_.r, a.lanes_.r, b.lanes_.r)};
+#endif
+	}
+
+	/// A table lookup, so there's nothing to gain from doing the lanes together
+	[[gnu::always_inline]] friend Q31x2 getTanHUnknown(Q31x2 input, uint32_t saturationAmount) {
+		return of(::getTanHUnknown(input.l(), saturationAmount), ::getTanHUnknown(input.r(), saturationAmount));
+	}
+
+private:
+	Lanes lanes_;
+};
+
+} // namespace deluge::dsp::filter
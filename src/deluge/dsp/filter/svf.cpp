@@ -27,15 +27,38 @@ namespace deluge::dsp::filter {
 	} while (currentSample < endSample);
 }
 [[gnu::hot]] void SVFilter::doFilterStereo(q31_t* startSample, q31_t* endSample) {
+	// Both channels' state goes into lanes for the whole buffer, and back out at the end
+	StereoSVFState state{Q31x2::of(l.low, r.low), Q31x2::of(l.band, r.band)};
+	LaneCoefficients const coefficients{Q31x2::both(fc),    Q31x2::both(q),      Q31x2::both(in),
+	                                    Q31x2::both(c_low), Q31x2::both(c_band), Q31x2::both(c_high)};
 	q31_t* currentSample = startSample;
 	do {
-		q31_t outs = doSVF(*currentSample, l);
-
-		*currentSample = outs;
-		q31_t outs2 = doSVF(*(currentSample + 1), r);
-		*(currentSample + 1) = outs2;
+		doSVFLanes(Q31x2::load(currentSample), state, coefficients, band_mode).store(currentSample);
 		currentSample += 2;
 	} while (currentSample < endSample);
+	l = {state.low.l(), state.band.l()};
+	r = {state.low.r(), state.band.r()};
+}
+[[gnu::hot]] void SVFilter::doFilterPair(SVFilter& a, q31_t* bufferA, SVFilter& b, q31_t* bufferB,
+                                         int32_t numSamples) {
+	if (a.band_mode != b.band_mode) [[unlikely]] {
+		a.doFilter(bufferA, bufferA + numSamples, 1);
+		b.doFilter(bufferB, bufferB + numSamples, 1);
+		return;
+	}
+
+	// Only the (mono) left channel of each filter is used, so a's goes in the left lane and b's in the right
+	StereoSVFState state{Q31x2::of(a.l.low, b.l.low), Q31x2::of(a.l.band, b.l.band)};
+	LaneCoefficients const coefficients{Q31x2::of(a.fc, b.fc),       Q31x2::of(a.q, b.q),
+	                                    Q31x2::of(a.in, b.in),       Q31x2::of(a.c_low, b.c_low),
+	                                    Q31x2::of(a.c_band, b.c_band), Q31x2::of(a.c_high, b.c_high)};
+	for (int32_t i = 0; i < numSamples; i++) {
+		Q31x2 output = doSVFLanes(Q31x2::of(bufferA[i], bufferB[i]), state, coefficients, a.band_mode);
+		bufferA[i] = output.l();
+		bufferB[i] = output.r();
+	}
+	a.l = {state.low.l(), state.band.l()};
+	b.l = {state.low.r(), state.band.r()};
 }
 
 q31_t SVFilter::setConfig(q31_t freq, q31_t res, FilterMode lpfMode, q31_t lpfMorph, q31_t filterGain) {
@@ -130,4 +153,52 @@ q31_t SVFilter::setConfig(q31_t freq, q31_t res, FilterMode lpfMode, q31_t lpfMo
 
 	return result;
 }
+
+// doSVF(), on both lanes at once
+[[gnu::always_inline]] inline Q31x2 SVFilter::doSVFLanes(Q31x2 input, StereoSVFState& state,
+                                                         LaneCoefficients const& coefficients, bool bandMode) {
+	Q31x2 const fc = coefficients.fc;
+	Q31x2 const q = coefficients.q;
+	Q31x2 low = state.low;
+	Q31x2 band = state.band;
+
+	input = multiply_32x32_rshift32(coefficients.in, input);
+
+	low = low + multiply_32x32_rshift32(band, fc).shiftLeft<1>();
+	Q31x2 high = input - low;
+	high = high - multiply_32x32_rshift32(band, q).shiftLeft<1>();
+	band = multiply_32x32_rshift32(high, fc).shiftLeft<1>() + band;
+
+	// saturate band feedback
+	band = getTanHUnknown(band, 3);
+
+	Q31x2 lowi = low;
+	Q31x2 highi = high;
+	Q31x2 bandi = band;
+	// double sample to increase the cutoff frequency
+	low = low + multiply_32x32_rshift32(band, fc).shiftLeft<1>();
+	high = input - low;
+	high = high - multiply_32x32_rshift32(band, q).shiftLeft<1>();
+	band = multiply_32x32_rshift32(high, fc).shiftLeft<1>() + band;
+
+	lowi = lowi + low;
+	highi = highi + high;
+	bandi = bandi + band;
+
+	Q31x2 result = multiply_32x32_rshift32_rounded(lowi, coefficients.c_low);
+	result = multiply_accumulate_32x32_rshift32_rounded(result, highi, coefficients.c_high);
+	if (bandMode) {
+		result = multiply_accumulate_32x32_rshift32_rounded(result, bandi, coefficients.c_band);
+	}
+
+	// saturate band feedback
+	band = getTanHUnknown(band, 3);
+	// compensate for division by two on each multiply, then multiply by 1.5 to match ladders
+	result = result.shiftLeft<1>() + result;
+
+	state.low = low;
+	state.band = band;
+
+	return result;
+}
 } // namespace deluge::dsp::filter
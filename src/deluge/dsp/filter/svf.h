@@ -18,6 +18,7 @@
 #pragma once
 
 #include "dsp/filter/filter.h"
+#include "dsp/filter/q31x2.h"
 #include "util/fixedpoint.h"
 
 namespace deluge::dsp::filter {
@@ -29,6 +30,10 @@ public:
 	q31_t setConfig(q31_t hpfFrequency, q31_t hpfResonance, FilterMode lpfMode, q31_t lpfMorph, q31_t filterGain);
 	void doFilter(q31_t* startSample, q31_t* endSample, int32_t sampleIncrememt);
 	void doFilterStereo(q31_t* startSample, q31_t* endSample);
+	/// Runs two voices' filters over their own mono buffers at once, one per lane, for dsp::VoiceBatch. Each keeps its
+	/// own coefficients and state and comes out just as doFilter() would have left it. If they're in different modes
+	/// they just take turns
+	static void doFilterPair(SVFilter& a, q31_t* bufferA, SVFilter& b, q31_t* bufferB, int32_t numSamples);
 	void resetFilter() {
 		l = (SVFState){0, 0};
 		r = (SVFState){0, 0};
@@ -39,7 +44,22 @@ private:
 		q31_t low;
 		q31_t band;
 	};
+	struct StereoSVFState {
+		Q31x2 low;
+		Q31x2 band;
+	};
+	/// The coefficients for each lane - the same in both for a stereo voice, or one voice's in each for a pair
+	struct LaneCoefficients {
+		Q31x2 fc;
+		Q31x2 q;
+		Q31x2 in;
+		Q31x2 c_low;
+		Q31x2 c_band;
+		Q31x2 c_high;
+	};
 	[[gnu::always_inline]] inline q31_t doSVF(q31_t input, SVFState& state);
+	[[gnu::always_inline]] static inline Q31x2 doSVFLanes(Q31x2 input, StereoSVFState& state,
+	                                                      LaneCoefficients const& coefficients, bool bandMode);
 	SVFState l;
 	SVFState r;
 
@@ -0,0 +1,104 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "dsp/interpolation/sinc_resampler.h"
+#include "util/lookuptables/lookuptables.h"
+
+#if defined(__ARM_NEON)
+#include "arm_neon_shim.h"
+#endif
+
+namespace deluge::dsp {
+
+// The kernel table has 16 lines (plus one) per source sample, each 16 taps, and the line for each output is
+// interpolated from the two nearest - see interpolate.h
+static constexpr int32_t kNumBitsInTableSize = 8;
+static constexpr int32_t kLineShift = 24 + kInterpolationMaxNumSamplesMagnitude - kNumBitsInTableSize;
+static constexpr int32_t kStrengthShift = 24 + kInterpolationMaxNumSamplesMagnitude - 16 - kNumBitsInTableSize + 1;
+
+static_assert(SincResampler::kNumTaps == 16, "The kernel table's lines are 16 taps");
+
+#if defined(__ARM_NEON)
+
+void SincResampler::renderBlock(int32_t (*output)[kBlockSize], int32_t numChannels, int32_t whichKernel) {
+	// Any outputs not marked just render a copy of the last one, which is quicker than stopping early
+	for (int32_t k = numOutputs_; k < kBlockSize; k++) {
+		windowStarts_[k] = windowStarts_[numOutputs_ - 1];
+		positions_[k] = positions_[numOutputs_ - 1];
+	}
+
+	int16x8_t kernels[kBlockSize][2];
+	for (int32_t k = 0; k < kBlockSize; k++) {
+		uint32_t oscPos = positions_[k];
+		int16_t strength2 = (oscPos >> kStrengthShift) & 32767;
+		int16_t const* line = &windowedSincKernel[whichKernel][oscPos >> kLineShift][0];
+		for (int32_t i = 0; i < 2; i++) {
+			int16x8_t value1 = vld1q_s16(line + (i << 3));
+			int16x8_t value2 = vld1q_s16(line + kNumTaps + (i << 3));
+			int16x8_t difference = vsubq_s16(value2, value1);
+			kernels[k][i] = vaddq_s16(value1, vqdmulhq_n_s16(difference, strength2));
+		}
+	}
+
+	for (int32_t c = 0; c < numChannels; c++) {
+		int32x2_t sums[kBlockSize];
+		for (int32_t k = 0; k < kBlockSize; k++) {
+			int16_t const* window = &buffer_[c][windowStarts_[k]];
+			int16x8_t samples0 = vld1q_s16(window);
+			int16x8_t samples1 = vld1q_s16(window + 8);
+			int32x4_t multiplied = vmull_s16(vget_low_s16(kernels[k][0]), vget_low_s16(samples0));
+			multiplied = vmlal_s16(multiplied, vget_high_s16(kernels[k][0]), vget_high_s16(samples0));
+			multiplied = vmlal_s16(multiplied, vget_low_s16(kernels[k][1]), vget_low_s16(samples1));
+			multiplied = vmlal_s16(multiplied, vget_high_s16(kernels[k][1]), vget_high_s16(samples1));
+			sums[k] = vadd_s32(vget_low_s32(multiplied), vget_high_s32(multiplied));
+		}
+
+		// Finish all the outputs' sums together
+		int32x4_t results = vcombine_s32(vpadd_s32(sums[0], sums[1]), vpadd_s32(sums[2], sums[3]));
+		vst1q_s32(output[c], results);
+	}
+}
+
+#else
+
+void SincResampler::renderBlock(int32_t (*output)[kBlockSize], int32_t numChannels, int32_t whichKernel) {
+	for (int32_t k = 0; k < numOutputs_; k++) {
+		uint32_t oscPos = positions_[k];
+		int32_t strength2 = (oscPos >> kStrengthShift) & 32767;
+		int16_t const* line = &windowedSincKernel[whichKernel][oscPos >> kLineShift][0];
+
+		// Wrapping and rounding just as the NEON does
+		int16_t kernel[kNumTaps];
+		for (int32_t i = 0; i < kNumTaps; i++) {
+			int16_t difference = line[kNumTaps + i] - line[i];
+			kernel[i] = line[i] + (int16_t)((difference * strength2 * 2) >> 16);
+		}
+
+		for (int32_t c = 0; c < numChannels; c++) {
+			int16_t const* window = &buffer_[c][windowStarts_[k]];
+			uint32_t sum = 0;
+			for (int32_t i = 0; i < kNumTaps; i++) {
+				sum += (uint32_t)(kernel[i] * window[i]);
+			}
+			output[c][k] = (int32_t)sum;
+		}
+	}
+}
+
+#endif
+
+} // namespace deluge::dsp
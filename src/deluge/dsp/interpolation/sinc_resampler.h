@@ -0,0 +1,92 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "definitions_cxx.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace deluge::dsp {
+
+/// Windowed sinc interpolation of 16-bit source audio, kBlockSize output samples at a time - the same kernels, and
+/// the same result, as SampleLowLevelReader::interpolate().
+///
+/// That one keeps the last kNumTaps source samples in a fixed window, shifted along by however many source samples
+/// each output sample moves forward. Here the source samples are instead written backwards into one longer buffer,
+/// newest first, so that every output's window is just a read starting wherever the newest sample was when that
+/// output was marked. The buffer only gets moved back to its end once per several blocks, and the kernels for a whole
+/// block are applied in one pass.
+class SincResampler {
+public:
+	static constexpr int32_t kNumTaps = kInterpolationMaxNumSamples;
+	static constexpr int32_t kBlockSize = 4;
+	static constexpr int32_t kMaxNumChannels = 2;
+
+	/// Start from a window of kNumTaps samples, newest first - the layout of SampleLowLevelReader's
+	/// interpolationBuffer
+	void loadHistory(int16_t const* newestFirst, int32_t channel) {
+		memcpy(&buffer_[channel][newest_], newestFirst, kNumTaps * sizeof(int16_t));
+	}
+	/// And put the latest window back there afterwards
+	void storeHistory(int16_t* newestFirst, int32_t channel) const {
+		memcpy(newestFirst, &buffer_[channel][newest_], kNumTaps * sizeof(int16_t));
+	}
+
+	/// Call before marking each block's outputs. There's then room for up to kNumTaps new source samples per output -
+	/// any further back than that doesn't affect the kernel anyway
+	void beginBlock() {
+		numOutputs_ = 0;
+		if (newest_ < kNumTaps * kBlockSize) [[unlikely]] {
+			for (int32_t c = 0; c < kMaxNumChannels; c++) {
+				memmove(&buffer_[c][kBufferSize - kNumTaps], &buffer_[c][newest_], kNumTaps * sizeof(int16_t));
+			}
+			newest_ = kBufferSize - kNumTaps;
+		}
+	}
+
+	[[gnu::always_inline]] void pushSample(int16_t sample) { buffer_[0][--newest_] = sample; }
+	[[gnu::always_inline]] void pushSample(int16_t sampleL, int16_t sampleR) {
+		newest_--;
+		buffer_[0][newest_] = sampleL;
+		buffer_[1][newest_] = sampleR;
+	}
+
+	/// The next output is interpolated between the newest sample pushed so far and the one before it, at oscPos - a
+	/// 24-bit fraction, as in SampleLowLevelReader
+	[[gnu::always_inline]] void markOutput(uint32_t oscPos) {
+		windowStarts_[numOutputs_] = newest_;
+		positions_[numOutputs_] = oscPos;
+		numOutputs_++;
+	}
+
+	/// Renders the outputs marked since beginBlock(), into output[channel][i]
+	void renderBlock(int32_t (*output)[kBlockSize], int32_t numChannels, int32_t whichKernel);
+
+private:
+	static constexpr int32_t kBufferSize = kNumTaps * (kBlockSize + 4);
+
+	std::array<std::array<int16_t, kBufferSize>, kMaxNumChannels> buffer_;
+	int32_t newest_ = kBufferSize - kNumTaps;
+
+	std::array<int32_t, kBlockSize> windowStarts_;
+	std::array<uint32_t, kBlockSize> positions_;
+	int32_t numOutputs_ = 0;
+};
+
+} // namespace deluge::dsp
@@ -0,0 +1,72 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "dsp/osc_kernels.h"
+#include <array>
+#include <utility>
+
+namespace deluge::dsp {
+
+namespace {
+
+constexpr std::array kDirectOscTypes{OscType::TRIANGLE, OscType::SAW, OscType::SQUARE};
+
+// Every combination, indexed by wave, then sync, then amplitude
+template <size_t kIndex>
+constexpr DirectOscKernel getInstance() {
+	return &renderDirectOsc<kDirectOscTypes[kIndex >> 2], (bool)(kIndex & 2), (bool)(kIndex & 1)>;
+}
+
+template <size_t... kIndices>
+constexpr std::array<DirectOscKernel, sizeof...(kIndices)> makeTable(std::index_sequence<kIndices...>) {
+	return {getInstance<kIndices>()...};
+}
+
+constexpr auto kDirectOscKernels = makeTable(std::make_index_sequence<kDirectOscTypes.size() << 2>{});
+
+DirectOscKernel getDirectOscKernel(OscType type, bool sync, bool applyAmplitude) {
+	int32_t wave;
+	switch (type) {
+	case OscType::TRIANGLE:
+		wave = 0;
+		break;
+	case OscType::SAW:
+	case OscType::ANALOG_SAW_2:
+		wave = 1;
+		break;
+	case OscType::SQUARE:
+		wave = 2;
+		break;
+	default:
+		return nullptr;
+	}
+	return kDirectOscKernels[(wave << 2) | (sync << 1) | applyAmplitude];
+}
+
+} // namespace
+
+OscKernels getOscKernels(OscType type, bool applyAmplitude, int32_t numUnison) {
+	return {
+	    .type = type,
+	    .direct = {getDirectOscKernel(type, false, applyAmplitude), getDirectOscKernel(type, true, applyAmplitude)},
+	    .unisonWave = numUnison > 1 && applyAmplitude
+	                  && (type == OscType::SAW || type == OscType::SQUARE || type == OscType::ANALOG_SAW_2
+	                      || type == OscType::ANALOG_SQUARE),
+	};
+}
+
+} // namespace deluge::dsp
@@ -0,0 +1,123 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "definitions_cxx.hpp"
+#include "util/fixedpoint.h"
+#include "util/waves.h"
+#include <cstdint>
+
+namespace deluge::dsp {
+
+/// Everything renderDirectOsc() needs besides the buffer and the phase
+struct DirectOscParams {
+	uint32_t phaseIncrement;
+	/// Only used by the square
+	uint32_t pulseWidth;
+	/// Only used when applying amplitude
+	int32_t amplitude;
+	int32_t amplitudeIncrement;
+	/// Only used when syncing - see Voice::renderOsc()
+	uint32_t resetterPhase;
+	uint32_t resetterPhaseIncrement;
+	int32_t resetterDivideByPhaseIncrement;
+	uint32_t retriggerPhase;
+};
+
+/// The oscillators Voice::renderOsc() can work out straight from the phase, with no table: the triangle below a
+/// certain pitch, and the saw and square when they're pitched low enough (or the CPU is busy enough) for their aliasing
+/// not to matter. Whether the oscillator is synced and whether amplitude is applied - rather than the wave being
+/// written out at a fixed level for ring modulation - are fixed for a whole window, so each combination gets its own
+/// loop with nothing to decide per sample.
+///
+/// @return the phase after the last sample
+template <OscType kType, bool kSync, bool kApplyAmplitude>
+[[gnu::hot]] uint32_t renderDirectOsc(int32_t* __restrict__ buffer, int32_t numSamples, uint32_t phase,
+                                      DirectOscParams const& params) {
+	static_assert(kType == OscType::TRIANGLE || kType == OscType::SAW || kType == OscType::SQUARE,
+	              "Only these waves can be rendered without a table");
+
+	// getTriangleSmall() only covers half the range, so it gets twice the amplitude
+	constexpr int32_t kAmplitudeShift = (kType == OscType::TRIANGLE) ? 1 : 0;
+	int32_t amplitude = params.amplitude << kAmplitudeShift;
+	int32_t amplitudeIncrement = params.amplitudeIncrement << kAmplitudeShift;
+	uint32_t resetterPhase = params.resetterPhase;
+
+	for (int32_t i = 0; i < numSamples; i++) {
+		phase += params.phaseIncrement;
+
+		if constexpr (kSync) {
+			resetterPhase += params.resetterPhaseIncrement;
+			if (resetterPhase < params.resetterPhaseIncrement) {
+				phase = (multiply_32x32_rshift32(multiply_32x32_rshift32(resetterPhase, params.phaseIncrement),
+				                                 params.resetterDivideByPhaseIncrement)
+				         << 17)
+				        + 1 + params.retriggerPhase;
+			}
+		}
+
+		if constexpr (kApplyAmplitude) {
+			int32_t value;
+			if constexpr (kType == OscType::TRIANGLE) {
+				value = getTriangleSmall(phase);
+			}
+			else if constexpr (kType == OscType::SAW) {
+				value = (int32_t)phase;
+			}
+			else {
+				value = getSquare(phase, params.pulseWidth);
+			}
+			amplitude += amplitudeIncrement;
+			// Using multiply_accumulate saves 10-20% over multiplying and adding
+			buffer[i] = multiply_accumulate_32x32_rshift32_rounded(buffer[i], value, amplitude);
+		}
+		else {
+			if constexpr (kType == OscType::TRIANGLE) {
+				buffer[i] = getTriangleSmall(phase) << 1;
+			}
+			else if constexpr (kType == OscType::SAW) {
+				buffer[i] = (int32_t)phase >> 1;
+			}
+			else {
+				buffer[i] = getSquareSmall(phase, params.pulseWidth);
+			}
+		}
+	}
+	return phase;
+}
+
+using DirectOscKernel = uint32_t (*)(int32_t* buffer, int32_t numSamples, uint32_t phase,
+                                     DirectOscParams const& params);
+
+/// Which kernels a Source's oscillator uses, for its Sound's current configuration. Sound::getOscKernels() keeps one
+/// of these per source, so Voice::renderOsc() doesn't have to work them out for every voice every window.
+struct OscKernels {
+	/// The osc type these were chosen for
+	OscType type;
+	/// renderDirectOsc() for this wave, indexed by whether it's synced, or nullptr if it always needs a table. The
+	/// analog saw gets the digital saw's, which Voice::renderOsc() swaps in when the CPU load is dire
+	DirectOscKernel direct[2];
+	/// Whether Voice::renderUnisonWave() can take on the whole unison stack, given no pulse width
+	bool unisonWave;
+};
+
+/// Picks the kernels for an oscillator. applyAmplitude is false only for ring modulation, which multiplies the
+/// oscillators together at a fixed level and applies amplitude afterwards
+OscKernels getOscKernels(OscType type, bool applyAmplitude, int32_t numUnison);
+
+} // namespace deluge::dsp
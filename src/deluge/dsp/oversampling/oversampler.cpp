@@ -0,0 +1,174 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "dsp/oversampling/oversampler.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(__ARM_NEON)
+#include "arm_neon_shim.h"
+#endif
+
+namespace deluge::dsp {
+
+namespace {
+
+// Kaiser-windowed (beta 6) sinc, normalised so each branch has unity gain at DC
+template <int32_t kNumTaps>
+constexpr std::array<q31_t, kNumTaps> kCoefficients{};
+
+template <>
+constexpr std::array<q31_t, 16> kCoefficients<16>{
+    -1355445,   7592296,    -22371344,  51492629,  -104157626, 200098469, -408000474, 1350443320,
+    1350443320, -408000474, 200098469,  -104157626, 51492629,   -22371344, 7592296,    -1355445,
+};
+
+template <>
+constexpr std::array<q31_t, 8> kCoefficients<8>{
+    -2902027, 54572940, -269207203, 1291278115, 1291278115, -269207203, 54572940, -2902027,
+};
+
+constexpr int32_t kBlockSize = SSI_TX_BUFFER_NUM_SAMPLES;
+
+// The history, followed by the block's new samples, so the taps can run straight along them
+q31_t tapInput[16 - 1 + kBlockSize];
+q31_t delayInput[16 / 2 - 1 + kBlockSize];
+q31_t betweenStages[SSI_TX_BUFFER_NUM_SAMPLES * Oversampler::kMaxNumChannels];
+
+// The symmetrical taps, on the kNumTaps samples from window onwards. Exact, in 64 bits, with the coefficients in q31
+template <int32_t kNumTaps>
+[[gnu::always_inline]] inline int64_t applyTaps(q31_t const* window) {
+	std::array<q31_t, kNumTaps> const& coefficients = kCoefficients<kNumTaps>;
+#if defined(__ARM_NEON)
+	int64x2_t sum = vdupq_n_s64(0);
+	for (int32_t t = 0; t < kNumTaps; t += 4) {
+		int32x4_t samples = vld1q_s32(&window[t]);
+		int32x4_t taps = vld1q_s32(&coefficients[t]);
+		sum = vmlal_s32(sum, vget_low_s32(samples), vget_low_s32(taps));
+		sum = vmlal_s32(sum, vget_high_s32(samples), vget_high_s32(taps));
+	}
+	return vgetq_lane_s64(sum, 0) + vgetq_lane_s64(sum, 1);
+#else
+	int64_t sum = 0;
+	for (int32_t t = 0; t < kNumTaps; t++) {
+		sum += (int64_t)window[t] * coefficients[t];
+	}
+	return sum;
+#endif
+}
+
+[[gnu::always_inline]] inline q31_t saturateToQ31(int64_t value) {
+	return std::clamp<int64_t>(value, std::numeric_limits<q31_t>::min(), std::numeric_limits<q31_t>::max());
+}
+
+} // namespace
+
+template <int32_t kNumTaps>
+void HalfBand<kNumTaps>::reset() {
+	upHistory_.fill(0);
+	downHistory_.fill(0);
+	downDelay_.fill(0);
+}
+
+template <int32_t kNumTaps>
+void HalfBand<kNumTaps>::upsample(q31_t const* input, int32_t inputStride, int32_t numInput, q31_t* output,
+                                  int32_t outputStride) {
+	while (numInput > 0) {
+		int32_t blockSize = std::min(numInput, kBlockSize);
+
+		std::copy(upHistory_.begin(), upHistory_.end(), tapInput);
+		for (int32_t i = 0; i < blockSize; i++) {
+			tapInput[kNumTaps - 1 + i] = input[i * inputStride];
+		}
+
+		for (int32_t i = 0; i < blockSize; i++) {
+			q31_t const* window = &tapInput[i]; // Ends with input i
+			output[(i << 1) * outputStride] = saturateToQ31((applyTaps<kNumTaps>(window) + (1 << 30)) >> 31);
+			output[((i << 1) + 1) * outputStride] = window[kNumTaps - 1 - kDelay];
+		}
+
+		std::copy(&tapInput[blockSize], &tapInput[blockSize + kNumTaps - 1], upHistory_.begin());
+		input += blockSize * inputStride;
+		output += (blockSize << 1) * outputStride;
+		numInput -= blockSize;
+	}
+}
+
+template <int32_t kNumTaps>
+void HalfBand<kNumTaps>::downsample(q31_t const* input, int32_t inputStride, int32_t numOutput, q31_t* output,
+                                    int32_t outputStride) {
+	while (numOutput > 0) {
+		int32_t blockSize = std::min(numOutput, kBlockSize);
+
+		std::copy(downHistory_.begin(), downHistory_.end(), tapInput);
+		std::copy(downDelay_.begin(), downDelay_.end(), delayInput);
+		for (int32_t i = 0; i < blockSize; i++) {
+			delayInput[kDelay + i] = input[(i << 1) * inputStride];
+			tapInput[kNumTaps - 1 + i] = input[((i << 1) + 1) * inputStride];
+		}
+
+		// Half of each branch
+		for (int32_t i = 0; i < blockSize; i++) {
+			int64_t sum = applyTaps<kNumTaps>(&tapInput[i]) + ((int64_t)delayInput[i] << 31);
+			output[i * outputStride] = saturateToQ31((sum + ((int64_t)1 << 31)) >> 32);
+		}
+
+		std::copy(&tapInput[blockSize], &tapInput[blockSize + kNumTaps - 1], downHistory_.begin());
+		std::copy(&delayInput[blockSize], &delayInput[blockSize + kDelay], downDelay_.begin());
+		input += (blockSize << 1) * inputStride;
+		output += blockSize * outputStride;
+		numOutput -= blockSize;
+	}
+}
+
+template class HalfBand<16>;
+template class HalfBand<8>;
+
+void Oversampler::reset() {
+	for (int32_t c = 0; c < kMaxNumChannels; c++) {
+		firstStages_[c].reset();
+		secondStages_[c].reset();
+	}
+}
+
+void Oversampler::upsample(q31_t const* input, int32_t numSamples, int32_t numChannels, int32_t magnitude,
+                           q31_t* output) {
+	for (int32_t c = 0; c < numChannels; c++) {
+		if (magnitude == 1) {
+			firstStages_[c].upsample(&input[c], numChannels, numSamples, &output[c], numChannels);
+		}
+		else {
+			firstStages_[c].upsample(&input[c], numChannels, numSamples, &betweenStages[c], numChannels);
+			secondStages_[c].upsample(&betweenStages[c], numChannels, numSamples << 1, &output[c], numChannels);
+		}
+	}
+}
+
+void Oversampler::downsample(q31_t const* input, int32_t numSamples, int32_t numChannels, int32_t magnitude,
+                             q31_t* output) {
+	for (int32_t c = 0; c < numChannels; c++) {
+		if (magnitude == 1) {
+			firstStages_[c].downsample(&input[c], numChannels, numSamples, &output[c], numChannels);
+		}
+		else {
+			secondStages_[c].downsample(&input[c], numChannels, numSamples << 1, &betweenStages[c], numChannels);
+			firstStages_[c].downsample(&betweenStages[c], numChannels, numSamples, &output[c], numChannels);
+		}
+	}
+}
+
+} // namespace deluge::dsp
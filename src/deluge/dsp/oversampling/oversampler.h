@@ -0,0 +1,78 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "definitions_cxx.hpp"
+#include "util/fixedpoint.h"
+#include <array>
+#include <cstdint>
+
+namespace deluge::dsp {
+
+/// One 2x stage of oversampling, for one channel: a half-band lowpass, split into its two polyphase branches. Every
+/// other tap of a half-band filter is zero apart from the middle one, which is a half - so one branch is just a delay,
+/// and the other is kNumTaps symmetrical taps.
+template <int32_t kNumTaps>
+class HalfBand {
+public:
+	static_assert(kNumTaps % 4 == 0, "The taps are done 4 at a time with NEON");
+
+	void reset();
+
+	/// Doubles the sample rate. Reads numInput samples, each inputStride apart, and writes twice that many
+	void upsample(q31_t const* input, int32_t inputStride, int32_t numInput, q31_t* output, int32_t outputStride);
+
+	/// Halves the sample rate. Reads twice numOutput samples, each inputStride apart, and writes numOutput
+	void downsample(q31_t const* input, int32_t inputStride, int32_t numOutput, q31_t* output, int32_t outputStride);
+
+private:
+	/// How far the delay branch lags behind the newest input
+	static constexpr int32_t kDelay = kNumTaps / 2 - 1;
+
+	std::array<q31_t, kNumTaps - 1> upHistory_{};
+	std::array<q31_t, kNumTaps - 1> downHistory_{}; ///< The odd input samples, which go through the taps
+	std::array<q31_t, kDelay> downDelay_{};         ///< The even input samples, which are just delayed
+};
+
+/// 2x or 4x oversampling for one or two interleaved channels, so that nonlinear processing can be done at a higher
+/// sample rate and the harmonics it creates above the normal Nyquist frequency get filtered out rather than aliasing
+/// back down. The first 2x stage passes up to 16kHz and stops everything from 28kHz by at least 60dB. The second only
+/// has to clean up what's left between those, so it's half the length.
+class Oversampler {
+public:
+	static constexpr int32_t kMaxMagnitude = 2;
+	static constexpr int32_t kMaxNumChannels = 2;
+
+	/// The most samples at the normal rate that can be upsampled in one go, so that the result still fits in a render
+	/// window's worth of stereo buffer
+	static constexpr int32_t getMaxNumSamples(int32_t magnitude) { return SSI_TX_BUFFER_NUM_SAMPLES >> magnitude; }
+
+	void reset();
+
+	/// Writes numSamples << magnitude samples per channel to output, interleaved the same way as input
+	void upsample(q31_t const* input, int32_t numSamples, int32_t numChannels, int32_t magnitude, q31_t* output);
+
+	/// Takes numSamples << magnitude samples per channel from input, and writes numSamples to output
+	void downsample(q31_t const* input, int32_t numSamples, int32_t numChannels, int32_t magnitude, q31_t* output);
+
+private:
+	std::array<HalfBand<16>, kMaxNumChannels> firstStages_;
+	std::array<HalfBand<8>, kMaxNumChannels> secondStages_;
+};
+
+} // namespace deluge::dsp
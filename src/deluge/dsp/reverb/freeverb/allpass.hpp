@@ -23,6 +23,7 @@
 
 #pragma once
 #include "util/functions.h"
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <span>
@@ -54,7 +55,28 @@ public:
 		return output;
 	}
 
+	/// Same as calling process() on each sample in turn, so long as there aren't more of them than the delay length.
+	/// Nothing written to the delay line in a block is read back within it, so this vectorises
+	void processBlock(std::span<int32_t> samples) {
+		size_t first = std::min(samples.size(), buffer_.size() - bufidx_);
+		processSegment(samples.data(), &buffer_[bufidx_], first);
+		processSegment(samples.data() + first, buffer_.data(), samples.size() - first);
+		bufidx_ += samples.size();
+		if (bufidx_ >= buffer_.size()) {
+			bufidx_ -= buffer_.size();
+		}
+	}
+
 private:
+	static void processSegment(int32_t* __restrict__ samples, int32_t* __restrict__ delayed, size_t n) {
+		for (size_t s = 0; s < n; s++) {
+			int32_t input = samples[s];
+			int32_t bufout = delayed[s];
+			samples[s] = -input + bufout;
+			delayed[s] = input + (bufout >> 1);
+		}
+	}
+
 	int32_t feedback_;
 	std::span<int32_t> buffer_;
 	int32_t bufidx_{0};
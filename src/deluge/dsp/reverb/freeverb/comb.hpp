@@ -24,6 +24,7 @@
 #pragma once
 
 #include "util/fixedpoint.h"
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <span>
@@ -64,6 +65,39 @@ public:
 		return output;
 	}
 
+	// For processing a block at a time - see Freeverb::processCombs(). The block mustn't be longer than the delay
+
+	/// Write out what the next n calls to process() would return, stride apart
+	void readBlock(int32_t* out, size_t n, size_t stride) const {
+		size_t first = std::min(n, buffer_.size() - bufidx_);
+		for (size_t s = 0; s < first; s++) {
+			out[s * stride] = buffer_[bufidx_ + s];
+		}
+		for (size_t s = first; s < n; s++) {
+			out[s * stride] = buffer_[s - first];
+		}
+	}
+
+	/// Store what those n calls would have written into the delay line, stride apart, and move on past them
+	void writeBlock(int32_t const* in, size_t n, size_t stride) {
+		size_t first = std::min(n, buffer_.size() - bufidx_);
+		for (size_t s = 0; s < first; s++) {
+			buffer_[bufidx_ + s] = in[s * stride];
+		}
+		for (size_t s = first; s < n; s++) {
+			buffer_[s - first] = in[s * stride];
+		}
+		bufidx_ += n;
+		if (bufidx_ >= buffer_.size()) {
+			bufidx_ -= buffer_.size();
+		}
+	}
+
+	[[nodiscard]] constexpr int32_t getFilterStore() const { return filterstore_; }
+	constexpr void setFilterStore(int32_t value) { filterstore_ = value; }
+	[[nodiscard]] constexpr int32_t getDamp1() const { return damp1_; }
+	[[nodiscard]] constexpr int32_t getDamp2() const { return damp2_; }
+
 private:
 	int32_t feedback_;
 	int32_t filterstore_{0};
@@ -24,8 +24,27 @@
 #include "dsp/reverb/freeverb/freeverb.hpp"
 #include <limits>
 
+#if defined(__ARM_NEON)
+#include "arm_neon_shim.h"
+#endif
+
 namespace deluge::dsp::reverb {
 
+#if defined(__ARM_NEON)
+// multiply_32x32_rshift32_rounded(), for 4 lanes at once
+[[gnu::always_inline]] static inline int32x4_t multiplyRounded(int32x4_t a, int32x4_t b) {
+	int64x2_t low = vmull_s32(vget_low_s32(a), vget_low_s32(b));
+	int64x2_t high = vmull_s32(vget_high_s32(a), vget_high_s32(b));
+	return vcombine_s32(vrshrn_n_s64(low, 32), vrshrn_n_s64(high, 32));
+}
+
+[[gnu::always_inline]] static inline int32_t addAcross(int32x4_t a, int32x4_t b) {
+	int32x4_t sum = vaddq_s32(a, b);
+	int32x2_t pairs = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+	return vget_lane_s32(vpadd_s32(pairs, pairs), 0);
+}
+#endif
+
 Freeverb::Freeverb() {
 	// Tie the components to their buffers
 	combL[0].setBuffer(bufcombL1);
@@ -83,6 +102,117 @@ void Freeverb::mute() {
 	}
 }
 
+[[gnu::hot]] void Freeverb::processBlock(std::span<int32_t const> input, std::span<StereoSample> output) {
+	size_t numSamples = input.size();
+
+	for (int32_t i = 0; i < numcombs; i++) {
+		combL[i].readBlock(&combLanes[i], numSamples, kNumCombLanes);
+		combR[i].readBlock(&combLanes[numcombs + i], numSamples, kNumCombLanes);
+	}
+
+	std::array<int32_t, kMaxBlockSize> outL;
+	std::array<int32_t, kMaxBlockSize> outR;
+	processCombs(input, outL.data(), outR.data());
+
+	for (int32_t i = 0; i < numcombs; i++) {
+		combL[i].writeBlock(&combLanes[i], numSamples, kNumCombLanes);
+		combR[i].writeBlock(&combLanes[numcombs + i], numSamples, kNumCombLanes);
+	}
+
+	// Feed through allpasses in series
+	for (int32_t i = 0; i < numallpasses; i++) {
+		allpassL[i].processBlock({outL.data(), numSamples});
+		allpassR[i].processBlock({outR.data(), numSamples});
+	}
+
+	for (size_t frame = 0; frame < numSamples; frame++) {
+		// Calculate output
+		int32_t out_l = (outL[frame] + multiply_32x32_rshift32_rounded(outR[frame], wet2)) << 1;
+		int32_t out_r = (outR[frame] + multiply_32x32_rshift32_rounded(out_l, wet2)) << 1;
+
+		// Mix output
+		output[frame].l += multiply_32x32_rshift32_rounded(out_l, this->getPanLeft());
+		output[frame].r += multiply_32x32_rshift32_rounded(out_r, this->getPanRight());
+	}
+}
+
+// The combs' outputs for the block are already in combLanes, since none of them read anything written during it. So
+// only each comb's damping filter has to go a sample at a time - and that can be done for 4 combs at once.
+void Freeverb::processCombs(std::span<int32_t const> input, int32_t* outL, int32_t* outR) {
+	std::array<int32_t, kNumCombLanes> filterStores;
+	std::array<int32_t, kNumCombLanes> damp1s;
+	std::array<int32_t, kNumCombLanes> damp2s;
+	std::array<int32_t, kNumCombLanes> feedbacks;
+	auto loadLane = [&](size_t lane, freeverb::Comb const& comb) {
+		filterStores[lane] = comb.getFilterStore();
+		damp1s[lane] = comb.getDamp1();
+		damp2s[lane] = comb.getDamp2();
+		feedbacks[lane] = comb.getFeedback();
+	};
+	for (int32_t i = 0; i < numcombs; i++) {
+		loadLane(i, combL[i]);
+		loadLane(numcombs + i, combR[i]);
+	}
+
+#if defined(__ARM_NEON)
+	constexpr size_t kNumVectors = kNumCombLanes / 4;
+	int32x4_t filterStoreVectors[kNumVectors];
+	int32x4_t damp1Vectors[kNumVectors];
+	int32x4_t damp2Vectors[kNumVectors];
+	int32x4_t feedbackVectors[kNumVectors];
+	for (size_t v = 0; v < kNumVectors; v++) {
+		filterStoreVectors[v] = vld1q_s32(&filterStores[v * 4]);
+		damp1Vectors[v] = vld1q_s32(&damp1s[v * 4]);
+		damp2Vectors[v] = vld1q_s32(&damp2s[v * 4]);
+		feedbackVectors[v] = vld1q_s32(&feedbacks[v * 4]);
+	}
+
+	for (size_t s = 0; s < input.size(); s++) {
+		int32_t* lanes = &combLanes[s * kNumCombLanes];
+		int32x4_t inputVector = vdupq_n_s32(input[s]);
+		int32x4_t outputs[kNumVectors];
+		for (size_t v = 0; v < kNumVectors; v++) {
+			outputs[v] = vld1q_s32(&lanes[v * 4]);
+
+			filterStoreVectors[v] = vshlq_n_s32(vaddq_s32(multiplyRounded(outputs[v], damp2Vectors[v]),
+			                                              multiplyRounded(filterStoreVectors[v], damp1Vectors[v])),
+			                                    1);
+
+			vst1q_s32(&lanes[v * 4],
+			          vaddq_s32(inputVector, vshlq_n_s32(multiplyRounded(filterStoreVectors[v], feedbackVectors[v]), 1)));
+		}
+		outL[s] = addAcross(outputs[0], outputs[1]);
+		outR[s] = addAcross(outputs[2], outputs[3]);
+	}
+
+	for (size_t v = 0; v < kNumVectors; v++) {
+		vst1q_s32(&filterStores[v * 4], filterStoreVectors[v]);
+	}
+#else
+	for (size_t s = 0; s < input.size(); s++) {
+		int32_t* lanes = &combLanes[s * kNumCombLanes];
+		int32_t sumL = 0;
+		int32_t sumR = 0;
+		for (size_t lane = 0; lane < kNumCombLanes; lane++) {
+			int32_t output = lanes[lane];
+			(lane < numcombs ? sumL : sumR) += output;
+
+			filterStores[lane] = (multiply_32x32_rshift32_rounded(output, damp2s[lane]) + //<
+			                      multiply_32x32_rshift32_rounded(filterStores[lane], damp1s[lane]))
+			                     << 1;
+			lanes[lane] = input[s] + (multiply_32x32_rshift32_rounded(filterStores[lane], feedbacks[lane]) << 1);
+		}
+		outL[s] = sumL;
+		outR[s] = sumR;
+	}
+#endif
+
+	for (int32_t i = 0; i < numcombs; i++) {
+		combL[i].setFilterStore(filterStores[i]);
+		combR[i].setFilterStore(filterStores[numcombs + i]);
+	}
+}
+
 void Freeverb::update() {
 	// Recalculate internal values after parameter change
 
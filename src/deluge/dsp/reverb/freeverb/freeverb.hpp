@@ -27,6 +27,8 @@
 #include "dsp/reverb/freeverb/allpass.hpp"
 #include "dsp/reverb/freeverb/comb.hpp"
 #include "dsp/reverb/freeverb/tuning.h"
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <span>
 
@@ -70,6 +72,7 @@ public:
 
 	[[nodiscard]] constexpr float getWidth() const override { return width; }
 
+	/// One sample at a time. This is the reference that process(), which works on whole blocks, must match bit for bit
 	[[gnu::always_inline]] void ProcessOne(int32_t input, StereoSample& output_sample) {
 		int32_t out_l = 0;
 		int32_t out_r = 0;
@@ -96,12 +99,17 @@ public:
 	}
 
 	[[gnu::always_inline]] void process(std::span<int32_t> input, std::span<StereoSample> output) override {
-		// HPF on reverb input, cos if it has DC offset, the reverb magnifies that, and the sound farts out
-		for (int32_t& reverb_sample : input) {
-			int32_t distance_to_go_l = reverb_sample - reverb_send_post_lpf_;
-			reverb_send_post_lpf_ += distance_to_go_l >> 11;
-			reverb_sample -= reverb_send_post_lpf_;
+		filterInput(input);
+
+		for (size_t start = 0; start < input.size(); start += kMaxBlockSize) {
+			size_t blockSize = std::min(kMaxBlockSize, input.size() - start);
+			processBlock(input.subspan(start, blockSize), output.subspan(start, blockSize));
 		}
+	}
+
+	/// process(), but done the original way: one sample at a time through ProcessOne()
+	void processSampleBySample(std::span<int32_t> input, std::span<StereoSample> output) {
+		filterInput(input);
 
 		for (size_t frame = 0; frame < input.size(); frame++) {
 			ProcessOne(input[frame], output[frame]);
@@ -109,6 +117,27 @@ public:
 	}
 
 private:
+	/// Comb and allpass delay lines must all be at least this long, so that nothing written into one during a block is
+	/// read back out within that block
+	static constexpr size_t kMaxBlockSize = 128;
+	static_assert(kMaxBlockSize <= std::min({allpasstuningL1, allpasstuningL2, allpasstuningL3, allpasstuningL4}));
+	static_assert(kMaxBlockSize <= combtuningL1);
+
+	/// The L combs, then the R combs
+	static constexpr size_t kNumCombLanes = numcombs * 2;
+
+	// HPF on reverb input, cos if it has DC offset, the reverb magnifies that, and the sound farts out
+	[[gnu::always_inline]] void filterInput(std::span<int32_t> input) {
+		for (int32_t& reverb_sample : input) {
+			int32_t distance_to_go_l = reverb_sample - reverb_send_post_lpf_;
+			reverb_send_post_lpf_ += distance_to_go_l >> 11;
+			reverb_sample -= reverb_send_post_lpf_;
+		}
+	}
+
+	void processBlock(std::span<int32_t const> input, std::span<StereoSample> output);
+	void processCombs(std::span<int32_t const> input, int32_t* outL, int32_t* outR);
+
 	void update();
 
 	int32_t gain;
@@ -161,5 +190,9 @@ private:
 	std::array<int32_t, allpasstuningR4> bufallpassR4;
 
 	int32_t reverb_send_post_lpf_ = 0;
+
+	/// Each comb's output for each sample of the block - and then what gets written back into it - with all the combs'
+	/// values for one sample together, so that 4 combs' worth can be worked on in a NEON register at once
+	std::array<int32_t, kMaxBlockSize * kNumCombLanes> combLanes;
 };
 } // namespace deluge::dsp::reverb
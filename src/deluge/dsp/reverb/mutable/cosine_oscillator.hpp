@@ -3,10 +3,45 @@
 // CPU use. Fixed frequency.
 
 #pragma once
-#include "argon.hpp"
 #include <cmath>
 #include <initializer_list>
 
+#if defined(__ARM_NEON)
+#include "argon.hpp"
+using FloatPair = argon::Neon64<float>;
+#else
+#include <algorithm>
+#include <array>
+
+// Host builds (tests and benchmarks) don't have argon. Just the bits of argon::Neon64<float> used here
+class FloatPair {
+public:
+	constexpr FloatPair() = default;
+	constexpr FloatPair(float value) : lanes_{value, value} {}
+	constexpr FloatPair(std::initializer_list<float> values) {
+		std::copy_n(values.begin(), lanes_.size(), lanes_.begin());
+	}
+
+	constexpr float& operator[](size_t i) { return lanes_[i]; }
+	constexpr float operator[](size_t i) const { return lanes_[i]; }
+	[[nodiscard]] static constexpr size_t size() { return 2; }
+
+	template <typename F>
+	constexpr void each_lane(F f) {
+		for (size_t i = 0; i < size(); i++) {
+			f(lanes_[i], i);
+		}
+	}
+
+	friend constexpr FloatPair operator+(FloatPair a, FloatPair b) { return {a[0] + b[0], a[1] + b[1]}; }
+	friend constexpr FloatPair operator-(FloatPair a, FloatPair b) { return {a[0] - b[0], a[1] - b[1]}; }
+	friend constexpr FloatPair operator*(FloatPair a, FloatPair b) { return {a[0] * b[0], a[1] * b[1]}; }
+
+private:
+	std::array<float, 2> lanes_{};
+};
+#endif
+
 class DualCosineOscillator {
 public:
 	enum class Mode { APPROX, EXACT };
@@ -24,8 +59,8 @@ public:
 	}
 
 	inline void InitApproximate() {
-		argon::Neon64<float> sign = 16.0f;
-		argon::Neon64<float> frequencies = frequencies_;
+		FloatPair sign = 16.0f;
+		FloatPair frequencies = frequencies_;
 		frequencies.each_lane([&](float& frequency, int i) {
 			frequency -= 0.25f;
 			if (frequency < 0.0f) {
@@ -47,10 +82,10 @@ public:
 		y_1 = 0.5f;
 	}
 
-	[[nodiscard]] inline argon::Neon64<float> values() const { return y_0 + 0.5f; }
+	[[nodiscard]] inline FloatPair values() const { return y_0 + 0.5f; }
 
-	inline argon::Neon64<float> Next() {
-		argon::Neon64<float> temp = y_1;
+	inline FloatPair Next() {
+		FloatPair temp = y_1;
 		y_1 = iir_coefficient_ * y_1 - y_0;
 		y_0 = temp;
 		return temp + 0.5f;
@@ -71,9 +106,9 @@ private:
 		Start();
 	}
 
-	argon::Neon64<float> frequencies_;
-	argon::Neon64<float> y_0;
-	argon::Neon64<float> y_1;
-	argon::Neon64<float> iir_coefficient_;
-	argon::Neon64<float> initial_amplitude_;
+	FloatPair frequencies_;
+	FloatPair y_0;
+	FloatPair y_1;
+	FloatPair iir_coefficient_;
+	FloatPair initial_amplitude_;
 };
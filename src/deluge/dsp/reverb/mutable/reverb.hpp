@@ -8,7 +8,9 @@
 #include "dsp/util.hpp"
 #include "fx_engine.hpp"
 #include <array>
+#include <cmath>
 #include <limits>
+#include <utility>
 
 namespace deluge::dsp::reverb {
 
@@ -16,100 +18,16 @@ class Mutable : public Base {
 	constexpr static size_t kBufferSize = 32768;
 
 public:
-	Mutable() = default;
+	Mutable() : Mutable(1) {}
 
 	~Mutable() override = default;
 
 	void process(std::span<int32_t> in, std::span<StereoSample> output) override {
-		// This is the Griesinger topology described in the Dattorro paper
-		// (4 AP diffusers on the input, then a loop of 2x 2AP+1Delay).
-		// Modulation is applied in the loop of the first diffuser AP for additional
-		// smearing; and to the two long delays for a slow shimmer/chorus effect.
-		typename FxEngine::AllPass ap1(150);
-		typename FxEngine::AllPass ap2(214);
-		typename FxEngine::AllPass ap3(319);
-		typename FxEngine::AllPass ap4(527);
-
-		typename FxEngine::AllPass dap1a(2182);
-		typename FxEngine::AllPass dap1b(2690);
-		typename FxEngine::AllPass del1(4501);
-
-		typename FxEngine::AllPass dap2a(2525);
-		typename FxEngine::AllPass dap2b(2197);
-		typename FxEngine::AllPass del2(6312);
-
-		typename FxEngine::Context c;
-		FxEngine::ConstructTopology(engine_, //<
-		                            {
-		                                &ap1, &ap2, &ap3, &ap4, //<
-		                                &dap1a, &dap1b, &del1,  //<
-		                                &dap2a, &dap2b, &del2,  //<
-		                            });
-
-		const float kap = diffusion_;
-		const float klp = lp_;
-		const float krt = reverb_time_;
-		const float gain = input_gain_;
-
-		float lp_1 = lp_decay_1_;
-		float lp_2 = lp_decay_2_;
-
 		for (size_t frame = 0; frame < in.size(); frame++) {
-			StereoSample& s = output[frame];
-			float wet = 0;
-			float apout = 0.0f;
-			engine_.Advance();
-
-			// Smear AP1 inside the loop.
-			// c.Interpolate(ap1, 10.0f, LFO_1, 80.0f, 1.0f);
-			// c.Write(ap1, 100, 0.0f);
-
 			const float input_sample = in[frame] / static_cast<float>(std::numeric_limits<int32_t>::max());
-
-			c.Set(input_sample // * gain
-			);
-
-			// Diffuse through 4 allpasses.
-			ap1.Process(c, kap);
-			ap2.Process(c, kap);
-			ap3.Process(c, kap);
-			ap4.Process(c, kap);
-			apout = c.Get();
-
-			// Main reverb loop.
-			c.Set(apout);
-			del2.Interpolate(c, 6261.0f, LFO_2, 50.0f, krt);
-			c.Lp(lp_1, klp);
-			dap1a.Process(c, -kap);
-			dap1b.Process(c, kap);
-			del1.Write(c, 2.0f);
-			wet = c.Get();
-			dsp::OnePole(hp_r_, wet, hp_cutoff_);
-			wet = wet - hp_r_;
-
-			auto output_right =
-			    static_cast<int32_t>(wet * static_cast<float>(std::numeric_limits<uint32_t>::max()) * 0xF);
-
-			c.Set(apout);
-			del1.Interpolate(c, 4460.0f, LFO_1, 40.0f, krt);
-			c.Lp(lp_2, klp);
-			dap2a.Process(c, -kap);
-			dap2b.Process(c, kap);
-			del2.Write(c, 2.0f);
-			wet = c.Get();
-			dsp::OnePole(hp_l_, wet, hp_cutoff_);
-			wet = wet - hp_l_;
-
-			auto output_left =
-			    static_cast<int32_t>(wet * static_cast<float>(std::numeric_limits<uint32_t>::max()) * 0xF);
-
-			// Mix
-			s.l += multiply_32x32_rshift32_rounded(output_left, getPanLeft());
-			s.r += multiply_32x32_rshift32_rounded(output_right, getPanRight());
+			auto [wet_l, wet_r] = processTank(input_sample);
+			mix(output[frame], wet_l, wet_r);
 		}
-
-		lp_decay_1_ = lp_1;
-		lp_decay_2_ = lp_2;
 	}
 
 	inline void Clear() { engine_.Clear(); }
@@ -129,7 +47,8 @@ public:
 
 	void setDamping(float value) override {
 		lp_val_ = value;
-		lp_ = (value == 0.f) ? 1.f : 1.f - std::clamp((std::log2(((1.f - lp_val_) * 50.f) + 1.f) / 5.7f), 0.f, 1.f);
+		lp_ = toTankRate((value == 0.f) ? 1.f
+		                                : 1.f - std::clamp((std::log2(((1.f - lp_val_) * 50.f) + 1.f) / 5.7f), 0.f, 1.f));
 	}
 	[[nodiscard]] float getDamping() const override { return lp_val_; }
 
@@ -138,16 +57,122 @@ public:
 
 	void setHPF(float f) {
 		hp_cutoff_val_ = f;
-		hp_cutoff_ = calcFilterCutoff(f);
+		hp_cutoff_ = toTankRate(calcFilterCutoff(f));
 	}
 
 	[[nodiscard]] float getHPF() const { return hp_cutoff_val_; }
 
+protected:
+	/// The tank runs once every decimation samples - see MutableHalfRate. Its delays are shortened to match, so it
+	/// sounds the same, bar the missing top end
+	explicit Mutable(int32_t decimation)
+	    : decimation_(decimation), engine_{buffer_, {0.5f * decimation / sample_rate, 0.3f * decimation / sample_rate}},
+	      ap1_(tankLength(150)), ap2_(tankLength(214)), ap3_(tankLength(319)), ap4_(tankLength(527)),
+	      dap1a_(tankLength(2182)), dap1b_(tankLength(2690)), del1_(tankLength(4501)), dap2a_(tankLength(2525)),
+	      dap2b_(tankLength(2197)), del2_(tankLength(6312)) {
+		FxEngine::ConstructTopology(engine_, //<
+		                            {
+		                                &ap1_, &ap2_, &ap3_, &ap4_, //<
+		                                &dap1a_, &dap1b_, &del1_,   //<
+		                                &dap2a_, &dap2b_, &del2_,   //<
+		                            });
+		lp_ = toTankRate(lp_);
+		hp_cutoff_ = toTankRate(hp_cutoff_);
+	}
+
+	/// Run the tank for one of its samples, returning the left and right wet signals
+	[[gnu::always_inline]] std::pair<float, float> processTank(float input_sample) {
+		// This is the Griesinger topology described in the Dattorro paper
+		// (4 AP diffusers on the input, then a loop of 2x 2AP+1Delay).
+		// Modulation is applied in the loop of the first diffuser AP for additional
+		// smearing; and to the two long delays for a slow shimmer/chorus effect.
+		typename FxEngine::Context c;
+
+		const float kap = diffusion_;
+		const float klp = lp_;
+		const float krt = reverb_time_;
+
+		float wet = 0;
+		float apout = 0.0f;
+		engine_.Advance();
+
+		// Smear AP1 inside the loop.
+		// c.Interpolate(ap1, 10.0f, LFO_1, 80.0f, 1.0f);
+		// c.Write(ap1, 100, 0.0f);
+
+		c.Set(input_sample // * gain
+		);
+
+		// Diffuse through 4 allpasses.
+		ap1_.Process(c, kap);
+		ap2_.Process(c, kap);
+		ap3_.Process(c, kap);
+		ap4_.Process(c, kap);
+		apout = c.Get();
+
+		// Main reverb loop.
+		c.Set(apout);
+		del2_.Interpolate(c, 6261.0f / decimation_, LFO_2, 50.0f / decimation_, krt);
+		c.Lp(lp_decay_1_, klp);
+		dap1a_.Process(c, -kap);
+		dap1b_.Process(c, kap);
+		del1_.Write(c, 2.0f);
+		wet = c.Get();
+		dsp::OnePole(hp_r_, wet, hp_cutoff_);
+		const float wet_r = wet - hp_r_;
+
+		c.Set(apout);
+		del1_.Interpolate(c, 4460.0f / decimation_, LFO_1, 40.0f / decimation_, krt);
+		c.Lp(lp_decay_2_, klp);
+		dap2a_.Process(c, -kap);
+		dap2b_.Process(c, kap);
+		del2_.Write(c, 2.0f);
+		wet = c.Get();
+		dsp::OnePole(hp_l_, wet, hp_cutoff_);
+		const float wet_l = wet - hp_l_;
+
+		return {wet_l, wet_r};
+	}
+
+	[[gnu::always_inline]] void mix(StereoSample& s, float wet_l, float wet_r) {
+		auto output_left = static_cast<int32_t>(wet_l * static_cast<float>(std::numeric_limits<uint32_t>::max()) * 0xF);
+		auto output_right =
+		    static_cast<int32_t>(wet_r * static_cast<float>(std::numeric_limits<uint32_t>::max()) * 0xF);
+
+		s.l += multiply_32x32_rshift32_rounded(output_left, getPanLeft());
+		s.r += multiply_32x32_rshift32_rounded(output_right, getPanRight());
+	}
+
 private:
 	static constexpr float sample_rate = kSampleRate;
 
+	[[nodiscard]] size_t tankLength(size_t length) const { return (length + decimation_ / 2) / decimation_; }
+
+	/// A one-pole filter coefficient for the full sample rate, converted to give the same response in the tank
+	[[nodiscard]] float toTankRate(float coefficient) const {
+		if (decimation_ == 1) {
+			return coefficient;
+		}
+		return 1.f - std::pow(1.f - coefficient, static_cast<float>(decimation_));
+	}
+
+	int32_t decimation_;
+
 	std::array<float, kBufferSize> buffer_{};
-	FxEngine engine_{buffer_, {0.5f / sample_rate, 0.3f / sample_rate}};
+	FxEngine engine_;
+
+	typename FxEngine::AllPass ap1_;
+	typename FxEngine::AllPass ap2_;
+	typename FxEngine::AllPass ap3_;
+	typename FxEngine::AllPass ap4_;
+
+	typename FxEngine::AllPass dap1a_;
+	typename FxEngine::AllPass dap1b_;
+	typename FxEngine::AllPass del1_;
+
+	typename FxEngine::AllPass dap2a_;
+	typename FxEngine::AllPass dap2b_;
+	typename FxEngine::AllPass del2_;
 
 	float input_gain_ = 0.2;
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "base.hpp"
 #include "freeverb/freeverb.hpp"
+#include "mutable/half_rate_reverb.hpp"
 #include "mutable/reverb.hpp"
 #include <algorithm>
 #include <cstdint>
@@ -13,6 +14,7 @@ public:
 	enum class Model {
 		FREEVERB = 0, // Freeverb is the original
 		MUTABLE,
+		MUTABLE_HALF_RATE, // Mutable for about half the CPU, for busy songs
 	};
 
 	Reverb()
@@ -30,7 +32,11 @@ public:
 		case Model::MUTABLE:
 			reverb_.emplace<reverb::Mutable>();
 			break;
+		case Model::MUTABLE_HALF_RATE:
+			reverb_.emplace<reverb::MutableHalfRate>();
+			break;
 		}
+		base_ = std::visit([](reverb::Base& r) { return &r; }, reverb_);
 		base_->setRoomSize(room_size_);
 		base_->setDamping(damping_);
 		base_->setWidth(width_);
@@ -40,6 +46,9 @@ public:
 
 	Model getModel() { return model_; }
 
+	/// Whether the current model is one of the Mutable ones, which share their parameters
+	bool isMutable() { return model_ == Model::MUTABLE || model_ == Model::MUTABLE_HALF_RATE; }
+
 	void process(std::span<int32_t> input, std::span<StereoSample> output) override {
 		using namespace reverb;
 		switch (model_) {
@@ -49,6 +58,9 @@ public:
 		case Model::MUTABLE:
 			reverb_as<Mutable>().process(input, output);
 			break;
+		case Model::MUTABLE_HALF_RATE:
+			reverb_as<MutableHalfRate>().process(input, output);
+			break;
 		}
 	}
 
@@ -90,8 +102,9 @@ public:
 
 private:
 	std::variant<         //<
-	    reverb::Freeverb, //<
-	    reverb::Mutable   //<
+	    reverb::Freeverb,       //<
+	    reverb::Mutable,        //<
+	    reverb::MutableHalfRate //<
 	    >
 	    reverb_{};
 
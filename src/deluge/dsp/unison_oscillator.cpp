@@ -0,0 +1,226 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "dsp/unison_oscillator.h"
+#include "util/fixedpoint.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(__ARM_NEON)
+#include "arm_neon_shim.h"
+#endif
+
+namespace deluge::dsp {
+
+using Wave = UnisonOscillator::Wave;
+
+static constexpr int32_t kMaxNumVectors = UnisonOscillator::kMaxNumParts / UnisonOscillator::kNumLanes;
+
+static_assert(UnisonOscillator::kMaxNumParts % UnisonOscillator::kNumLanes == 0, "Parts fill whole vectors");
+
+int32_t UnisonOscillator::addPart(uint32_t phase, uint32_t phaseIncrement, int16_t const* table,
+                                  int32_t tableSizeMagnitude, int32_t amplitudeL, int32_t amplitudeR) {
+	int32_t part = numParts_++;
+	phases_[part] = phase;
+	phaseIncrements_[part] = phaseIncrement;
+	tables_[part] = table;
+	tableSizeMagnitudes_[part] = tableSizeMagnitude;
+	// shouldDoPanning() never gives more than 1 << 30, so these can go up to "1" for the doubling multiply
+	gainsL_[part] = amplitudeL << 1;
+	gainsR_[part] = amplitudeR << 1;
+	masks_[part] = -1;
+	return part;
+}
+
+void UnisonOscillator::render(Wave wave, int32_t* buffer, int32_t numSamples, bool stereo, int32_t amplitude,
+                              int32_t amplitudeIncrement) {
+	if (!numParts_) {
+		return;
+	}
+
+	// Any unused parts in the last vector just read the first part's table at phase 0, and then get masked out
+	for (int32_t part = numParts_; part < kMaxNumParts; part++) {
+		tables_[part] = tables_[0];
+		tableSizeMagnitudes_[part] = tableSizeMagnitudes_[0];
+	}
+
+	switch (wave) {
+	case Wave::CRUDE_SAW:
+		stereo ? renderWave<Wave::CRUDE_SAW, true>(buffer, numSamples, amplitude, amplitudeIncrement)
+		       : renderWave<Wave::CRUDE_SAW, false>(buffer, numSamples, amplitude, amplitudeIncrement);
+		break;
+	case Wave::CRUDE_SQUARE:
+		stereo ? renderWave<Wave::CRUDE_SQUARE, true>(buffer, numSamples, amplitude, amplitudeIncrement)
+		       : renderWave<Wave::CRUDE_SQUARE, false>(buffer, numSamples, amplitude, amplitudeIncrement);
+		break;
+	case Wave::TABLE:
+		stereo ? renderWave<Wave::TABLE, true>(buffer, numSamples, amplitude, amplitudeIncrement)
+		       : renderWave<Wave::TABLE, false>(buffer, numSamples, amplitude, amplitudeIncrement);
+		break;
+	}
+}
+
+#if defined(__ARM_NEON)
+
+template <int32_t kLane>
+[[gnu::always_inline]] static inline uint32x4_t loadTablePair(uint32x4_t values, int16_t const* table,
+                                                              uint32x4_t indexes) {
+	return vld1q_lane_u32((uint32_t const*)&table[vgetq_lane_u32(indexes, kLane)], values, kLane);
+}
+
+/// The same interpolation as waveRenderingFunctionGeneral(), but for four parts, each reading its own table
+[[gnu::always_inline]] static inline int32x4_t getTableValues(uint32x4_t phases, int32x4_t tableSizeMagnitudes,
+                                                              int16_t const* const* tables) {
+	uint32x4_t indexes = vshlq_u32(phases, vsubq_s32(tableSizeMagnitudes, vdupq_n_s32(32)));
+	uint16x4_t strength2 = vshr_n_u16(vshrn_n_u32(vshlq_u32(phases, tableSizeMagnitudes), 16), 1);
+
+	uint32x4_t values = vdupq_n_u32(0);
+	values = loadTablePair<0>(values, tables[0], indexes);
+	values = loadTablePair<1>(values, tables[1], indexes);
+	values = loadTablePair<2>(values, tables[2], indexes);
+	values = loadTablePair<3>(values, tables[3], indexes);
+
+	int16x4_t value1 = vreinterpret_s16_u16(vmovn_u32(values));
+	int16x4_t value2 = vreinterpret_s16_u16(vshrn_n_u32(values, 16));
+	int16x4_t difference = vsub_s16(value2, value1);
+	return vqdmlal_s16(vshll_n_s16(value1, 16), difference, vreinterpret_s16_u16(strength2));
+}
+
+template <Wave kWave, bool kStereo>
+void UnisonOscillator::renderWave(int32_t* buffer, int32_t numSamples, int32_t amplitude,
+                                  int32_t amplitudeIncrement) {
+	int32_t numVectors = (numParts_ + kNumLanes - 1) / kNumLanes;
+
+	uint32x4_t phases[kMaxNumVectors];
+	uint32x4_t phaseIncrements[kMaxNumVectors];
+	int32x4_t tableSizeMagnitudes[kMaxNumVectors];
+	int32x4_t gainsL[kMaxNumVectors];
+	int32x4_t gainsR[kMaxNumVectors];
+	for (int32_t v = 0; v < numVectors; v++) {
+		int32_t part = v * kNumLanes;
+		phases[v] = vld1q_u32(&phases_[part]);
+		phaseIncrements[v] = vld1q_u32(&phaseIncrements_[part]);
+		tableSizeMagnitudes[v] = vld1q_s32(&tableSizeMagnitudes_[part]);
+		gainsL[v] = vld1q_s32(kStereo ? &gainsL_[part] : &masks_[part]);
+		gainsR[v] = vld1q_s32(&gainsR_[part]);
+	}
+
+	for (int32_t i = 0; i < numSamples; i++) {
+		amplitude += amplitudeIncrement;
+		int32x4_t amplitudeVector = vdupq_n_s32(amplitude);
+		int32x4_t sumL = vdupq_n_s32(0);
+		int32x4_t sumR = vdupq_n_s32(0);
+
+		for (int32_t v = 0; v < numVectors; v++) {
+			phases[v] = vaddq_u32(phases[v], phaseIncrements[v]);
+
+			int32x4_t values;
+			if constexpr (kWave == Wave::TABLE) {
+				values = getTableValues(phases[v], tableSizeMagnitudes[v], &tables_[v * kNumLanes]);
+			}
+			else if constexpr (kWave == Wave::CRUDE_SAW) {
+				values = vshrq_n_s32(vreinterpretq_s32_u32(phases[v]), 1);
+			}
+			else {
+				// Half-scale, and negative for the second half of the cycle, like getSquareSmall()
+				values = veorq_s32(vshrq_n_s32(vreinterpretq_s32_u32(phases[v]), 31), vdupq_n_s32(1073741823));
+			}
+			values = vqdmulhq_s32(values, amplitudeVector);
+
+			if constexpr (kStereo) {
+				sumL = vaddq_s32(sumL, vqdmulhq_s32(values, gainsL[v]));
+				sumR = vaddq_s32(sumR, vqdmulhq_s32(values, gainsR[v]));
+			}
+			else {
+				sumL = vaddq_s32(sumL, vandq_s32(values, gainsL[v]));
+			}
+		}
+
+		int32x2_t pairL = vadd_s32(vget_low_s32(sumL), vget_high_s32(sumL));
+		if constexpr (kStereo) {
+			int32x2_t pairR = vadd_s32(vget_low_s32(sumR), vget_high_s32(sumR));
+			vst1_s32(buffer, vadd_s32(vld1_s32(buffer), vpadd_s32(pairL, pairR)));
+			buffer += 2;
+		}
+		else {
+			*(buffer++) += vget_lane_s32(vpadd_s32(pairL, pairL), 0);
+		}
+	}
+
+	for (int32_t v = 0; v < numVectors; v++) {
+		vst1q_u32(&phases_[v * kNumLanes], phases[v]);
+	}
+}
+
+#else
+
+/// vqdmulhq_s32() for one lane - which only saturates for -1 * -1
+[[gnu::always_inline]] static inline int32_t doublingMultiplyHigh(int32_t a, int32_t b) {
+	return std::min<int64_t>(((int64_t)a * b) >> 31, std::numeric_limits<int32_t>::max());
+}
+
+template <Wave kWave, bool kStereo>
+void UnisonOscillator::renderWave(int32_t* buffer, int32_t numSamples, int32_t amplitude,
+                                  int32_t amplitudeIncrement) {
+	// Without vectors, it's quicker to go a part at a time - and since the sums wrap, the result's the same
+	for (int32_t part = 0; part < numParts_; part++) {
+		uint32_t phase = phases_[part];
+		uint32_t phaseIncrement = phaseIncrements_[part];
+		int16_t const* table = tables_[part];
+		int32_t tableSizeMagnitude = tableSizeMagnitudes_[part];
+		int32_t gainL = gainsL_[part];
+		int32_t gainR = gainsR_[part];
+		int32_t amplitudeNow = amplitude;
+		int32_t* __restrict__ output = buffer;
+
+		for (int32_t i = 0; i < numSamples; i++) {
+			phase += phaseIncrement;
+			amplitudeNow += amplitudeIncrement;
+
+			int32_t value;
+			if constexpr (kWave == Wave::TABLE) {
+				// Wrapping and saturating as the NEON does
+				int16_t const* values = &table[phase >> (32 - tableSizeMagnitude)];
+				int32_t strength2 = (uint16_t)((phase << tableSizeMagnitude) >> 16) >> 1;
+				int16_t difference = values[1] - values[0];
+				value = add_saturation((int32_t)values[0] << 16, 2 * difference * strength2);
+			}
+			else if constexpr (kWave == Wave::CRUDE_SAW) {
+				value = (int32_t)phase >> 1;
+			}
+			else {
+				value = ((int32_t)phase >> 31) ^ 1073741823;
+			}
+			value = doublingMultiplyHigh(value, amplitudeNow);
+
+			if constexpr (kStereo) {
+				output[0] = (int32_t)((uint32_t)output[0] + doublingMultiplyHigh(value, gainL));
+				output[1] = (int32_t)((uint32_t)output[1] + doublingMultiplyHigh(value, gainR));
+				output += 2;
+			}
+			else {
+				*output = (int32_t)((uint32_t)*output + value);
+				output++;
+			}
+		}
+
+		phases_[part] = phase;
+	}
+}
+
+#endif
+
+} // namespace deluge::dsp
@@ -0,0 +1,75 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "definitions_cxx.hpp"
+#include <array>
+#include <cstdint>
+
+namespace deluge::dsp {
+
+/// Renders every part of a unison stack of one basic wave in a single pass, adding them straight into the osc buffer.
+///
+/// The parts' phases are kept four to a vector, so each sample advances, looks up, and applies the amplitude to four
+/// parts at once, and the unison stereo spread is applied per part on the way into the (stereo) buffer, rather than
+/// each part being rendered into a spare buffer and mixed in afterwards.
+class UnisonOscillator {
+public:
+	static constexpr int32_t kNumLanes = 4;
+	static constexpr int32_t kMaxNumParts = kMaxNumVoicesUnison;
+
+	enum class Wave {
+		/// The aliasing saw, straight from the phase - Voice::renderOsc() uses it when the pitch is low enough
+		CRUDE_SAW,
+		/// Likewise for the square, with no pulse width
+		CRUDE_SQUARE,
+		/// Interpolated from a band-limited table, which can be a different one for each part
+		TABLE,
+	};
+
+	/// Returns the part's index, for getPhase() afterwards. amplitudeL and amplitudeR are the unison pan, as from
+	/// shouldDoPanning(), and are ignored for a mono buffer
+	int32_t addPart(uint32_t phase, uint32_t phaseIncrement, int16_t const* table, int32_t tableSizeMagnitude,
+	                int32_t amplitudeL, int32_t amplitudeR);
+
+	/// Where the part's phase got to by the end of render()
+	[[nodiscard]] uint32_t getPhase(int32_t part) const { return phases_[part]; }
+
+	/// Adds numSamples into buffer - interleaved stereo if stereo. The amplitude ramps just as Voice::renderOsc()'s
+	/// does, by amplitudeIncrement before every sample
+	void render(Wave wave, int32_t* buffer, int32_t numSamples, bool stereo, int32_t amplitude,
+	            int32_t amplitudeIncrement);
+
+private:
+	template <Wave kWave, bool kStereo>
+	void renderWave(int32_t* buffer, int32_t numSamples, int32_t amplitude, int32_t amplitudeIncrement);
+
+	alignas(16) std::array<uint32_t, kMaxNumParts> phases_{};
+	alignas(16) std::array<uint32_t, kMaxNumParts> phaseIncrements_{};
+	/// For TABLE: each part's tableSizeMagnitude, which says where in its phase the table index and interpolation
+	/// strength come from
+	alignas(16) std::array<int32_t, kMaxNumParts> tableSizeMagnitudes_{};
+	/// The unison pan, and 0 for any unused parts in the last vector
+	alignas(16) std::array<int32_t, kMaxNumParts> gainsL_{};
+	alignas(16) std::array<int32_t, kMaxNumParts> gainsR_{};
+	/// All ones for the parts in use, for a mono buffer to mask the rest out with
+	alignas(16) std::array<int32_t, kMaxNumParts> masks_{};
+	std::array<int16_t const*, kMaxNumParts> tables_{};
+	int32_t numParts_ = 0;
+};
+
+} // namespace deluge::dsp
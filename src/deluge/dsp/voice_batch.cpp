@@ -0,0 +1,125 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "dsp/voice_batch.h"
+
+#if defined(__ARM_NEON)
+#include "arm_neon_shim.h"
+#endif
+
+namespace deluge::dsp {
+
+#if defined(__ARM_NEON)
+// multiply_32x32_rshift32_rounded() << 1, for 4 lanes at once
+[[gnu::always_inline]] static inline int32x4_t multiplyAmplitude(int32x4_t input, int32x4_t amplitude) {
+	int64x2_t low = vmull_s32(vget_low_s32(input), vget_low_s32(amplitude));
+	int64x2_t high = vmull_s32(vget_high_s32(input), vget_high_s32(amplitude));
+	int32x4_t product = vcombine_s32(vrshrn_n_s64(low, 32), vrshrn_n_s64(high, 32));
+	return vshlq_n_s32(product, 1);
+}
+#endif
+
+void VoiceBatch::renderFilters(int32_t numSamples) {
+	// Pair up whichever lanes have a filter to run. An odd one out runs on its own
+	int32_t waitingLane = -1;
+	for (int32_t lane = 0; lane < numLanes_; lane++) {
+		if (filters_[lane] == nullptr) {
+			continue;
+		}
+		if (waitingLane < 0) {
+			waitingLane = lane;
+			continue;
+		}
+		filter::SVFilter::doFilterPair(*filters_[waitingLane], buffers_[waitingLane], *filters_[lane], buffers_[lane],
+		                               numSamples);
+		waitingLane = -1;
+	}
+	if (waitingLane >= 0) {
+		filters_[waitingLane]->doFilter(buffers_[waitingLane], buffers_[waitingLane] + numSamples, 1);
+	}
+}
+
+[[gnu::hot]] void VoiceBatch::render(q31_t* output, int32_t numSamples, bool outputIsStereo) {
+	if (numLanes_ == 0) {
+		return;
+	}
+
+	renderFilters(numSamples);
+
+	std::array<int32_t, kNumLanes> amplitudeNow = amplitudes_;
+	int32_t i = 0;
+
+#if defined(__ARM_NEON)
+	// Amplitude of each voice for the next 4 samples, and how much that moves on by each time
+	int32x4_t amplitudeVectors[kNumLanes];
+	int32x4_t amplitudeSteps[kNumLanes];
+	for (int32_t lane = 0; lane < numLanes_; lane++) {
+		int32_t increment = amplitudeIncrements_[lane];
+		int32_t start = amplitudes_[lane];
+		int32_t ramp[4] = {start + increment, start + increment * 2, start + increment * 3, start + increment * 4};
+		amplitudeVectors[lane] = vld1q_s32(ramp);
+		amplitudeSteps[lane] = vdupq_n_s32(increment * 4);
+	}
+
+	for (; i + 4 <= numSamples; i += 4) {
+		int32x4_t sum = multiplyAmplitude(vld1q_s32(&buffers_[0][i]), amplitudeVectors[0]);
+		amplitudeVectors[0] = vaddq_s32(amplitudeVectors[0], amplitudeSteps[0]);
+		for (int32_t lane = 1; lane < numLanes_; lane++) {
+			sum = vaddq_s32(sum, multiplyAmplitude(vld1q_s32(&buffers_[lane][i]), amplitudeVectors[lane]));
+			amplitudeVectors[lane] = vaddq_s32(amplitudeVectors[lane], amplitudeSteps[lane]);
+		}
+
+		if (outputIsStereo) {
+			int32x4x2_t stereo = vld2q_s32(&output[i << 1]);
+			stereo.val[0] = vaddq_s32(stereo.val[0], sum);
+			stereo.val[1] = vaddq_s32(stereo.val[1], sum);
+			vst2q_s32(&output[i << 1], stereo);
+		}
+		else {
+			vst1q_s32(&output[i], vaddq_s32(vld1q_s32(&output[i]), sum));
+		}
+	}
+
+	for (int32_t lane = 0; lane < numLanes_; lane++) {
+		amplitudeNow[lane] += amplitudeIncrements_[lane] * i;
+	}
+#endif
+
+	// Scalar version, which also picks up any samples left over after the vectorised loop. Lane by lane, which is what
+	// the compiler does best with when it can't use NEON
+	int32_t firstScalarSample = i;
+	for (int32_t lane = 0; lane < numLanes_; lane++) {
+		const q31_t* __restrict__ input = buffers_[lane];
+		int32_t amplitude = amplitudeNow[lane];
+		int32_t amplitudeIncrement = amplitudeIncrements_[lane];
+		for (i = firstScalarSample; i < numSamples; i++) {
+			amplitude += amplitudeIncrement;
+			int32_t sample = multiply_32x32_rshift32_rounded(input[i], amplitude) << 1;
+			if (outputIsStereo) {
+				output[(i << 1)] += sample;
+				output[(i << 1) + 1] += sample;
+			}
+			else {
+				output[i] += sample;
+			}
+		}
+	}
+
+	numLanes_ = 0;
+}
+
+} // namespace deluge::dsp
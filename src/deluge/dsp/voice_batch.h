@@ -0,0 +1,79 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "dsp/filter/svf.h"
+#include "util/fixedpoint.h"
+#include <array>
+#include <cstdint>
+
+namespace deluge::dsp {
+
+/// Collects the oscillator output of up to kNumLanes voices of the same Sound, then filters them, applies each voice's
+/// amplitude ramp and mixes them all into the Sound's buffer, several voices at a time - rather than each voice doing
+/// its own pass over its buffer and then a read-modify-write pass over the Sound's.
+///
+/// Each voice renders its oscillators into buffer(), then calls commit() with the overall amplitude it was at at the
+/// end of the last window, how much that changes per sample, and its filter if that's a lone SVF (see
+/// FilterSet::getLoneSVF()) - otherwise it has already filtered the buffer itself. Once full() (or the last voice of
+/// the Sound has been rendered), render() filters, mixes and empties the batch. The filters run two voices at a time,
+/// one per lane of a Q31x2, and the mix four at a time, one per NEON lane.
+///
+/// The result is bit-identical to each voice doing it all itself: the filter as SVFilter::doFilter(), then sample i of
+/// a voice is scaled by multiply_32x32_rshift32_rounded(sample, amplitude + (i + 1) * amplitudeIncrement) << 1. Where
+/// NEON isn't available (i.e. the unit tests) a scalar version of the same thing is used.
+class VoiceBatch {
+public:
+	static constexpr int32_t kNumLanes = 4;
+
+	/// @param laneBuffers one buffer per lane, each long enough for a window of (possibly stereo) oscillator output
+	VoiceBatch(std::array<q31_t*, kNumLanes> laneBuffers) : buffers_(laneBuffers) {}
+
+	/// Where the next voice should render its oscillators to. Until commit() is called the buffer can be used like any
+	/// other scratch buffer - a voice which ends up mixing itself needn't give it back
+	[[nodiscard]] q31_t* buffer() const { return buffers_[numLanes_]; }
+
+	/// Hand the mono contents of buffer() over to the batch to be amplified and mixed, and first filtered if filter
+	/// isn't nullptr. The filter's state is only updated by render()
+	void commit(int32_t amplitude, int32_t amplitudeIncrement, filter::SVFilter* filter = nullptr) {
+		amplitudes_[numLanes_] = amplitude;
+		amplitudeIncrements_[numLanes_] = amplitudeIncrement;
+		filters_[numLanes_] = filter;
+		numLanes_++;
+	}
+
+	[[nodiscard]] bool full() const { return numLanes_ == kNumLanes; }
+	[[nodiscard]] bool empty() const { return numLanes_ == 0; }
+	[[nodiscard]] int32_t size() const { return numLanes_; }
+
+	/// Filter and mix all committed voices into output, then empty the batch
+	/// @param outputIsStereo whether output is interleaved stereo, in which case each voice is added to both channels
+	/// like StereoSample::addMono()
+	void render(q31_t* output, int32_t numSamples, bool outputIsStereo);
+
+private:
+	void renderFilters(int32_t numSamples);
+
+	std::array<q31_t*, kNumLanes> buffers_;
+	std::array<int32_t, kNumLanes> amplitudes_{};
+	std::array<int32_t, kNumLanes> amplitudeIncrements_{};
+	std::array<filter::SVFilter*, kNumLanes> filters_{};
+	int32_t numLanes_ = 0;
+};
+
+} // namespace deluge::dsp
@@ -0,0 +1,52 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "dsp/voice_output.h"
+#include <array>
+#include <utility>
+
+namespace deluge::dsp {
+
+namespace {
+
+// Every valid combination, indexed by its flags: stereo voice, stereo output, amplitude, saturation, panning
+constexpr int32_t kNumFlags = 5;
+
+template <int32_t kFlags>
+constexpr VoiceOutputFunction getInstance() {
+	constexpr bool kStereoVoice = kFlags & 16;
+	constexpr bool kStereoOutput = (kFlags & 8) || kStereoVoice;
+	constexpr bool kPan = (kFlags & 1) && kStereoOutput;
+	return &renderVoiceOutput<kStereoVoice, kStereoOutput, (bool)(kFlags & 4), (bool)(kFlags & 2), kPan>;
+}
+
+template <size_t... kFlags>
+constexpr std::array<VoiceOutputFunction, sizeof...(kFlags)> makeTable(std::index_sequence<kFlags...>) {
+	return {getInstance<kFlags>()...};
+}
+
+constexpr auto kVoiceOutputFunctions = makeTable(std::make_index_sequence<1 << kNumFlags>{});
+
+} // namespace
+
+VoiceOutputFunction getVoiceOutputFunction(bool stereoVoice, bool stereoOutput, bool applyAmplitude, bool saturate,
+                                           bool pan) {
+	int32_t flags = (stereoVoice << 4) | (stereoOutput << 3) | (applyAmplitude << 2) | (saturate << 1) | pan;
+	return kVoiceOutputFunctions[flags];
+}
+
+} // namespace deluge::dsp
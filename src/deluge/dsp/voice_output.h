@@ -0,0 +1,111 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "dsp/stereo_sample.h"
+#include "util/fixedpoint.h"
+#include "util/functions.h"
+#include <cstdint>
+
+namespace deluge::dsp {
+
+/// Sound::saturate(), for anything that only has the clipping amount
+[[gnu::always_inline]] inline void saturate(int32_t* data, uint32_t* workingValue, uint8_t clippingAmount) {
+	int32_t shiftAmount = (clippingAmount >= 2) ? (clippingAmount - 2) : 0;
+	*data = getTanHAntialiased(*data, workingValue, 5 + clippingAmount) << shiftAmount;
+}
+
+/// Everything the last stage of Voice::render() needs, besides the buffers
+struct VoiceOutputParams {
+	/// The overall amplitude at the end of the last window, and how much it changes per sample
+	int32_t amplitude;
+	int32_t amplitudeIncrement;
+	/// Only used when panning
+	int32_t panAmplitudeL;
+	int32_t panAmplitudeR;
+	/// Only used when saturating. One working value per channel of the voice
+	uint8_t clippingAmount;
+	uint32_t* saturationWorkingValues;
+};
+
+/// The last stage of Voice::render(): apply the voice's amplitude ramp, saturate, pan, and add it into the Sound's
+/// buffer. Which of those happen is fixed for a whole window, so each combination gets its own loop with nothing to
+/// decide per sample, and getVoiceOutputFunction() picks the right one once.
+///
+/// @param voiceBuffer the voice's filtered oscillators, interleaved stereo if kStereoVoice
+/// @param soundBuffer interleaved stereo if kStereoOutput, which it always is for a stereo voice
+template <bool kStereoVoice, bool kStereoOutput, bool kApplyAmplitude, bool kSaturate, bool kPan>
+[[gnu::hot]] void renderVoiceOutput(q31_t const* __restrict__ voiceBuffer, q31_t* __restrict__ soundBuffer,
+                                    int32_t numSamples, VoiceOutputParams const& params) {
+	static_assert(kStereoOutput || !kStereoVoice, "A stereo voice always goes into a stereo Sound");
+	static_assert(kStereoOutput || !kPan, "Panning needs a stereo Sound");
+
+	int32_t amplitude = params.amplitude;
+	StereoSample* __restrict__ output = (StereoSample*)soundBuffer;
+
+	for (int32_t i = 0; i < numSamples; i++) {
+		amplitude += params.amplitudeIncrement;
+
+		if constexpr (kStereoVoice) {
+			q31_t sampleL = voiceBuffer[i << 1];
+			q31_t sampleR = voiceBuffer[(i << 1) + 1];
+			if constexpr (kApplyAmplitude) {
+				sampleL = multiply_32x32_rshift32_rounded(sampleL, amplitude) << 1;
+				sampleR = multiply_32x32_rshift32_rounded(sampleR, amplitude) << 1;
+			}
+			if constexpr (kSaturate) {
+				saturate(&sampleL, &params.saturationWorkingValues[0], params.clippingAmount);
+				saturate(&sampleR, &params.saturationWorkingValues[1], params.clippingAmount);
+			}
+			if constexpr (kPan) {
+				output[i].addPannedStereo(sampleL, sampleR, params.panAmplitudeL, params.panAmplitudeR);
+			}
+			else {
+				output[i].addStereo(sampleL, sampleR);
+			}
+		}
+		else {
+			q31_t sample = voiceBuffer[i];
+			if constexpr (kApplyAmplitude) {
+				sample = multiply_32x32_rshift32_rounded(sample, amplitude) << 1;
+			}
+			if constexpr (kSaturate) {
+				saturate(&sample, &params.saturationWorkingValues[0], params.clippingAmount);
+			}
+			if constexpr (kPan) {
+				output[i].addPannedMono(sample, params.panAmplitudeL, params.panAmplitudeR);
+			}
+			else if constexpr (kStereoOutput) {
+				output[i].addMono(sample);
+			}
+			else {
+				soundBuffer[i] += sample;
+			}
+		}
+	}
+}
+
+using VoiceOutputFunction = void (*)(q31_t const* voiceBuffer, q31_t* soundBuffer, int32_t numSamples,
+                                     VoiceOutputParams const& params);
+
+/// Picks the renderVoiceOutput() for this combination. Panning is ignored for a mono Sound, since there's nowhere to
+/// pan to, and a stereo voice is always going into a stereo Sound
+VoiceOutputFunction getVoiceOutputFunction(bool stereoVoice, bool stereoOutput, bool applyAmplitude, bool saturate,
+                                           bool pan);
+
+} // namespace deluge::dsp
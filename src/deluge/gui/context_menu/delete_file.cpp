@@ -21,6 +21,7 @@
 #include "gui/l10n/l10n.h"
 #include "gui/ui/browser/browser.h"
 #include "hid/display/display.h"
+#include "storage/audio/audio_file_manager.h"
 
 extern "C" {
 #include "fatfs/ff.h"
@@ -83,6 +84,7 @@ bool DeleteFile::acceptCurrentOption() {
 			// But we'll still go back to the Browser
 		}
 		else {
+			audioFileManager.deleteClusterMapSidecar(filePath.get());
 			display->displayPopup(l10n::get(STRING_FOR_FILE_DELETED));
 			browser->currentFileDeleted();
 		}
@@ -367,6 +367,7 @@ PLACE_SDRAM_DATA Language english{
         {STRING_FOR_SAMPLE_PREVIEW, "Sample preview"},
         {STRING_FOR_PLAY_CURSOR, "Play-cursor"},
         {STRING_FOR_FIRMWARE_VERSION, "Firmware version"},
+        {STRING_FOR_PRELOADED_SAMPLES, "Preloaded samples"},
         {STRING_FOR_COMMUNITY_FTS, "Community features"},
         {STRING_FOR_MIDI_THRU, "MIDI-thru"},
         {STRING_FOR_TAKEOVER, "TAKEOVER"},
@@ -446,6 +447,8 @@ PLACE_SDRAM_DATA Language english{
         {STRING_FOR_COMMUNITY_FEATURE_CHORD_KEYBOARD, "Chord Keyboards"},
         {STRING_FOR_COMMUNITY_FEATURE_ALTERNATIVE_PLAYBACK_START_BEHAVIOUR, "Alternative Playback Start Behaviour"},
         {STRING_FOR_COMMUNITY_FEATURE_GRID_VIEW_LOOP_PADS, "Grid View Loop Layer Pads"},
+        {STRING_FOR_COMMUNITY_FEATURE_CACHE_SAMPLE_CLUSTER_MAPS, "Cache Sample Cluster Maps"},
+        {STRING_FOR_COMMUNITY_FEATURE_SAMPLE_PRELOAD_BUDGET, "Sample Preload Budget"},
         {STRING_FOR_TRACK_STILL_HAS_CLIPS_IN_SESSION, "Track still has clips in session"},
         {STRING_FOR_DELETE_ALL_TRACKS_CLIPS_FIRST, "Delete all track's clips first"},
         {STRING_FOR_CANT_DELETE_FINAL_CLIP, "Can't delete final Clip"},
@@ -480,6 +483,7 @@ PLACE_SDRAM_DATA Language english{
         {STRING_FOR_ARPEGGIATOR, "ARPEGGIATOR"},
         {STRING_FOR_POLYPHONY, "POLYPHONY"},
         {STRING_FOR_MAX_VOICES, "MAX VOICES"},
+        {STRING_FOR_PRELOAD_SAMPLES, "PRELOAD SAMPLES"},
         {STRING_FOR_PRIORITY, "PRIORITY"},
         {STRING_FOR_VOICE, "VOICE"},
         {STRING_FOR_DESTINATION, "Destination"},
@@ -510,6 +514,9 @@ PLACE_SDRAM_DATA Language english{
         {STRING_FOR_REVERB_WIDTH, "Reverb width"},
         {STRING_FOR_REVERB_PAN, "Reverb pan"},
         {STRING_FOR_SATURATION, "SATURATION"},
+        {STRING_FOR_OVERSAMPLING, "Oversampling"},
+        {STRING_FOR_2X, "2x"},
+        {STRING_FOR_4X, "4x"},
         {STRING_FOR_BANK, "BANK"},
         {STRING_FOR_MIDI_BANK, "MIDI bank"},
         {STRING_FOR_MIDI_SUB_BANK, "MIDI sub-bank"},
@@ -532,6 +539,9 @@ PLACE_SDRAM_DATA Language english{
         {STRING_FOR_DELAY, "DELAY"},
         {STRING_FOR_AMOUNT, "AMOUNT"},
         {STRING_FOR_REVERB, "REVERB"},
+        {STRING_FOR_CONVOLUTION, "Convolution"},
+        {STRING_FOR_CONVOLUTION_BLEND, "Convolution blend"},
+        {STRING_FOR_IMPULSE_RESPONSE, "Impulse response"},
         {STRING_FOR_VOLUME_DUCKING, "Volume ducking"},
         {STRING_FOR_SIDECHAIN, "Sidechain"},
         {STRING_FOR_THRESHOLD, "Threshold"},
@@ -763,6 +773,7 @@ PLACE_SDRAM_DATA Language english{
         {STRING_FOR_MODEL, "Model"},
         {STRING_FOR_FREEVERB, "Freeverb"},
         {STRING_FOR_MUTABLE, "Mutable"},
+        {STRING_FOR_MUTABLE_HALF_RATE, "Mutable Half-Rate"},
         {STRING_FOR_DIFFUSION, "Diffusion"},
         {STRING_FOR_TIME, "Time"},
         {STRING_FOR_MASTER, "Master"},
@@ -781,6 +792,7 @@ PLACE_SDRAM_DATA Language english{
         {STRING_FOR_CONFIGURE_EXPORT_STEMS_SILENCE, "Export to Silence"},
         {STRING_FOR_CONFIGURE_EXPORT_STEMS_SONGFX, "Song FX"},
         {STRING_FOR_CONFIGURE_EXPORT_STEMS_OFFLINE_RENDERING, "Offline Rendering"},
+        {STRING_FOR_CONFIGURE_EXPORT_STEMS_SINGLE_PASS, "Single Pass"},
         {STRING_FOR_CANT_EXPORT_STEMS, "Turn off playback and/or recording"},
         {STRING_FOR_STOP_EXPORT_STEMS_QMARK, "Cancel Export?"},
         {STRING_FOR_STOP_EXPORT_STEMS, "Export Cancelled"},
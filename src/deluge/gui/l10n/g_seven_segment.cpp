@@ -254,6 +254,7 @@ PLACE_SDRAM_DATA Language seven_segment{
         {STRING_FOR_ENVELOPE_2, "ENV2"},
         {STRING_FOR_VOLUME_LEVEL, "VOLUME"},
         {STRING_FOR_MAX_VOICES, "VCNT"},
+        {STRING_FOR_PRELOAD_SAMPLES, "PREL"},
         {STRING_FOR_REPEAT_MODE, "MODE"},
         {STRING_FOR_PITCH_SPEED, "PISP"},
         {STRING_FOR_OSCILLATOR_SYNC, "SYNC"},
@@ -290,6 +291,7 @@ PLACE_SDRAM_DATA Language seven_segment{
         {STRING_FOR_SAMPLE_PREVIEW, "PREV"},
         {STRING_FOR_PLAY_CURSOR, "CURS"},
         {STRING_FOR_FIRMWARE_VERSION, "FIRM"},
+        {STRING_FOR_PRELOADED_SAMPLES, "PINS"},
         {STRING_FOR_COMMUNITY_FTS, "FEAT"},
         {STRING_FOR_MIDI_THRU, "THRU"},
         {STRING_FOR_TAKEOVER, "TOVR"},
@@ -374,6 +376,8 @@ PLACE_SDRAM_DATA Language seven_segment{
         {STRING_FOR_COMMUNITY_FEATURE_CHORD_KEYBOARD, "CHRD"},
         {STRING_FOR_COMMUNITY_FEATURE_ALTERNATIVE_PLAYBACK_START_BEHAVIOUR, "STAR"},
         {STRING_FOR_COMMUNITY_FEATURE_GRID_VIEW_LOOP_PADS, "LOOP"},
+        {STRING_FOR_COMMUNITY_FEATURE_CACHE_SAMPLE_CLUSTER_MAPS, "CMAP"},
+        {STRING_FOR_COMMUNITY_FEATURE_SAMPLE_PRELOAD_BUDGET, "PBUD"},
         {STRING_FOR_TRACK_STILL_HAS_CLIPS_IN_SESSION, "CANT"},
         {STRING_FOR_DELETE_ALL_TRACKS_CLIPS_FIRST, "CANT"},
         {STRING_FOR_CANT_DELETE_FINAL_CLIP, "CANT"},
@@ -425,6 +429,10 @@ PLACE_SDRAM_DATA Language seven_segment{
         {STRING_FOR_MODEL, "MODE"},
         {STRING_FOR_FREEVERB, "FVRB"},
         {STRING_FOR_MUTABLE, "MTBL"},
+        {STRING_FOR_MUTABLE_HALF_RATE, "MTB2"},
+        {STRING_FOR_CONVOLUTION, "CONV"},
+        {STRING_FOR_IMPULSE_RESPONSE, "IR"},
+        {STRING_FOR_OVERSAMPLING, "OVSA"},
         {STRING_FOR_DIFFUSION, "DIFF"},
         {STRING_FOR_TIME, "TIME"},
         {STRING_FOR_MASTER, "MSTR"},
@@ -443,6 +451,7 @@ PLACE_SDRAM_DATA Language seven_segment{
         {STRING_FOR_CONFIGURE_EXPORT_STEMS_SILENCE, "SILE"},
         {STRING_FOR_CONFIGURE_EXPORT_STEMS_SONGFX, "SONG"},
         {STRING_FOR_CONFIGURE_EXPORT_STEMS_OFFLINE_RENDERING, "OFFR"},
+        {STRING_FOR_CONFIGURE_EXPORT_STEMS_SINGLE_PASS, "1PAS"},
         {STRING_FOR_CANT_EXPORT_STEMS, "CANT"},
         {STRING_FOR_STOP_EXPORT_STEMS, "STOP"},
         {STRING_FOR_DONE_EXPORT_STEMS, "DONE"},
@@ -389,6 +389,7 @@ enum class String : size_t {
 	STRING_FOR_SAMPLE_PREVIEW,
 	STRING_FOR_PLAY_CURSOR,
 	STRING_FOR_FIRMWARE_VERSION,
+	STRING_FOR_PRELOADED_SAMPLES,
 	STRING_FOR_COMMUNITY_FTS,
 	STRING_FOR_MIDI_THRU,
 	STRING_FOR_TAKEOVER,
@@ -470,6 +471,8 @@ enum class String : size_t {
 	STRING_FOR_COMMUNITY_FEATURE_CHORD_KEYBOARD,
 	STRING_FOR_COMMUNITY_FEATURE_ALTERNATIVE_PLAYBACK_START_BEHAVIOUR,
 	STRING_FOR_COMMUNITY_FEATURE_GRID_VIEW_LOOP_PADS,
+	STRING_FOR_COMMUNITY_FEATURE_CACHE_SAMPLE_CLUSTER_MAPS,
+	STRING_FOR_COMMUNITY_FEATURE_SAMPLE_PRELOAD_BUDGET,
 
 	STRING_FOR_TRACK_STILL_HAS_CLIPS_IN_SESSION,
 	STRING_FOR_DELETE_ALL_TRACKS_CLIPS_FIRST,
@@ -512,6 +515,7 @@ enum class String : size_t {
 	STRING_FOR_PRIORITY,
 	STRING_FOR_VOICE,
 	STRING_FOR_MAX_VOICES,
+	STRING_FOR_PRELOAD_SAMPLES,
 	STRING_FOR_DESTINATION,
 	STRING_FOR_RETRIGGER_PHASE,
 	STRING_FOR_LFO1_TYPE,
@@ -548,6 +552,9 @@ enum class String : size_t {
 	STRING_FOR_REVERB_WIDTH,
 	STRING_FOR_REVERB_PAN,
 	STRING_FOR_SATURATION,
+	STRING_FOR_OVERSAMPLING,
+	STRING_FOR_2X,
+	STRING_FOR_4X,
 	STRING_FOR_DECIMATION,
 	STRING_FOR_BANK,
 	STRING_FOR_MIDI_BANK,
@@ -579,6 +586,9 @@ enum class String : size_t {
 	STRING_FOR_AMOUNT,
 	STRING_FOR_REVERB_AMOUNT,
 	STRING_FOR_REVERB,
+	STRING_FOR_CONVOLUTION,
+	STRING_FOR_CONVOLUTION_BLEND,
+	STRING_FOR_IMPULSE_RESPONSE,
 	STRING_FOR_VOLUME_DUCKING,
 	STRING_FOR_SIDECHAIN,
 	STRING_FOR_THRESHOLD,
@@ -850,6 +860,7 @@ enum class String : size_t {
 	STRING_FOR_MODEL,
 	STRING_FOR_FREEVERB,
 	STRING_FOR_MUTABLE,
+	STRING_FOR_MUTABLE_HALF_RATE,
 	STRING_FOR_DIFFUSION,
 	STRING_FOR_TIME,
 
@@ -879,6 +890,7 @@ enum class String : size_t {
 	STRING_FOR_CONFIGURE_EXPORT_STEMS_SILENCE,
 	STRING_FOR_CONFIGURE_EXPORT_STEMS_SONGFX,
 	STRING_FOR_CONFIGURE_EXPORT_STEMS_OFFLINE_RENDERING,
+	STRING_FOR_CONFIGURE_EXPORT_STEMS_SINGLE_PASS,
 	STRING_FOR_CANT_EXPORT_STEMS,
 	STRING_FOR_STOP_EXPORT_STEMS_QMARK,
 	STRING_FOR_STOP_EXPORT_STEMS,
@@ -0,0 +1,36 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "gui/l10n/l10n.h"
+#include "gui/menu_item/selection.h"
+#include "gui/ui/sound_editor.h"
+#include "model/mod_controllable/mod_controllable_audio.h"
+
+namespace deluge::gui::menu_item::fx {
+
+class Oversampling final : public Selection {
+public:
+	using Selection::Selection;
+	void readCurrentValue() override { this->setValue(soundEditor.currentModControllable->oversamplingMagnitude); }
+	void writeCurrentValue() override { soundEditor.currentModControllable->oversamplingMagnitude = this->getValue(); }
+	deluge::vector<std::string_view> getOptions() override {
+		using enum l10n::String;
+		return {l10n::getView(STRING_FOR_DISABLED), l10n::getView(STRING_FOR_2X), l10n::getView(STRING_FOR_4X)};
+	}
+};
+
+} // namespace deluge::gui::menu_item::fx
@@ -33,6 +33,7 @@ public:
 		using enum l10n::String;
 		switch (AudioEngine::reverb.getModel()) {
 		case dsp::Reverb::Model::MUTABLE:
+		case dsp::Reverb::Model::MUTABLE_HALF_RATE:
 			return l10n::getView(STRING_FOR_DIFFUSION);
 		default:
 			return l10n::getView(this->name);
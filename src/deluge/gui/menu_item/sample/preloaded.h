@@ -0,0 +1,96 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "definitions_cxx.hpp"
+#include "gui/menu_item/menu_item.h"
+#include "gui/ui/ui.h"
+#include "hid/display/display.h"
+#include "hid/display/oled.h"
+#include "model/sample/sample.h"
+#include "storage/audio/audio_file_manager.h"
+#include "util/d_string.h"
+#include "util/functions.h"
+#include <algorithm>
+
+namespace deluge::gui::menu_item::sample {
+/// Shows how many Samples are preloaded into RAM and how much of the preload budget they take up. Turning the select
+/// encoder steps through the preloaded Samples themselves
+class Preloaded final : public MenuItem {
+public:
+	using MenuItem::MenuItem;
+
+	void beginSession(MenuItem* navigatedBackwardFrom) override {
+		currentIndex = 0;
+		drawValue();
+	}
+
+	void selectEncoderAction(int32_t offset) override {
+		currentIndex = std::clamp<int32_t>(currentIndex + offset, 0, audioFileManager.getNumPreloadedSamples());
+		drawValue();
+	}
+
+	void drawPixelsForOled() {
+		deluge::hid::display::oled_canvas::Canvas& canvas = hid::display::OLED::main;
+		DEF_STACK_STRING_BUF(summary, 32);
+		getSummary(summary);
+
+		Sample* sample = getCurrentSample();
+		if (!sample) {
+			canvas.drawStringCentredShrinkIfNecessary(summary.c_str(), 22, 18, 20);
+			return;
+		}
+
+		canvas.drawStringCentred(summary.c_str(), OLED_MAIN_TOPMOST_PIXEL + 14, kTextSpacingX, kTextSpacingY);
+		canvas.drawStringCentredShrinkIfNecessary(getFileNameFromEndOfPath(sample->filePath.get()),
+		                                          OLED_MAIN_TOPMOST_PIXEL + 28, kTextSpacingX, kTextSpacingY);
+	}
+
+	void drawValue() {
+		if (display->haveOLED()) {
+			renderUIsForOled();
+			return;
+		}
+
+		Sample* sample = getCurrentSample();
+		if (sample) {
+			display->setScrollingText(getFileNameFromEndOfPath(sample->filePath.get()));
+		}
+		else {
+			DEF_STACK_STRING_BUF(summary, 32);
+			getSummary(summary);
+			display->setScrollingText(summary.c_str());
+		}
+	}
+
+private:
+	/// 0 shows the totals. After that, each one is a preloaded Sample
+	int32_t currentIndex = 0;
+
+	Sample* getCurrentSample() {
+		// Preloads may have been released since we were scrolled here
+		currentIndex = std::min(currentIndex, audioFileManager.getNumPreloadedSamples());
+		return currentIndex ? audioFileManager.getPreloadedSample(currentIndex - 1) : nullptr;
+	}
+
+	static void getSummary(StringBuf& text) {
+		text.appendInt(audioFileManager.getNumPreloadedSamples());
+		text.append(display->haveOLED() ? " samples, " : " SAMPLES ");
+		text.appendFloat(audioFileManager.getPreloadedSampleBytes() / 1048576.f, 1, 1);
+		text.append("MB");
+	}
+};
+} // namespace deluge::gui::menu_item::sample
@@ -0,0 +1,93 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+#include "definitions_cxx.hpp"
+#include "gui/menu_item/selection.h"
+#include "gui/ui/sound_editor.h"
+#include "hid/display/display.h"
+#include "model/drum/drum.h"
+#include "model/instrument/kit.h"
+#include "model/song/song.h"
+#include "processing/sound/sound.h"
+#include "processing/sound/sound_drum.h"
+
+namespace deluge::gui::menu_item::voice {
+/// Sets Sound::preloadSamplesUpToKB. Raising it preloads any Samples which now qualify straight away. Samples which no
+/// longer do stay preloaded until the Song is next loaded
+class PreloadSamples final : public Selection {
+public:
+	using Selection::Selection;
+
+	void readCurrentValue() override {
+		uint32_t upToKB = soundEditor.currentSound->preloadSamplesUpToKB;
+		int32_t option = 0;
+		while (option < kNumOptions - 1 && upToKB >= optionToKB(option + 1)) {
+			option++;
+		}
+		this->setValue(option);
+	}
+
+	void writeCurrentValue() override {
+		uint32_t upToKB = optionToKB(this->getValue());
+
+		// If affect-entire button held, do whole kit
+		if (currentUIMode == UI_MODE_HOLDING_AFFECT_ENTIRE_IN_SOUND_EDITOR && soundEditor.editingKit()) {
+
+			Kit* kit = getCurrentKit();
+
+			for (Drum* thisDrum = kit->firstDrum; thisDrum != nullptr; thisDrum = thisDrum->next) {
+				if (thisDrum->type == DrumType::SOUND) {
+					auto* soundDrum = static_cast<SoundDrum*>(thisDrum);
+					soundDrum->preloadSamplesUpToKB = upToKB;
+					soundDrum->preloadSamples();
+				}
+			}
+		}
+
+		// Or, the normal case of just one sound
+		else {
+			soundEditor.currentSound->preloadSamplesUpToKB = upToKB;
+			soundEditor.currentSound->preloadSamples();
+		}
+	}
+
+	deluge::vector<std::string_view> getOptions() override {
+		return {
+		    l10n::getView(l10n::String::STRING_FOR_OFF),
+		    display->haveOLED() ? "256KB" : "256K",
+		    display->haveOLED() ? "512KB" : "512K",
+		    "1MB",
+		    "2MB",
+		    "4MB",
+		};
+	}
+
+	bool isRelevant(ModControllableAudio* modControllable, int32_t whichThing) override {
+		Sound* sound = static_cast<Sound*>(modControllable);
+		return (sound->getSynthMode() == ::SynthMode::SUBTRACTIVE
+		        && (sound->sources[0].oscType == OscType::SAMPLE || sound->sources[1].oscType == OscType::SAMPLE));
+	}
+
+	bool usesAffectEntire() override { return true; }
+
+private:
+	static constexpr int32_t kNumOptions = 6;
+
+	/// Option 0 is off, and each one after doubles the size, from 256KB
+	static uint32_t optionToKB(int32_t option) { return option == 0 ? 0 : 128 << option; }
+};
+} // namespace deluge::gui::menu_item::voice
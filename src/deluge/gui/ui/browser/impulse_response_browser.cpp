@@ -0,0 +1,133 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gui/ui/browser/impulse_response_browser.h"
+#include "definitions_cxx.hpp"
+#include "gui/ui/sound_editor.h"
+#include "hid/display/oled.h"
+#include "model/mod_controllable/mod_controllable_audio.h"
+#include "util/functions.h"
+#include <cstring>
+
+ImpulseResponseBrowser::ImpulseResponseBrowser() {
+	fileIcon = deluge::hid::display::OLED::waveIcon;
+	title = "Impulse responses";
+	shouldWrapFolderContents = false;
+}
+
+static char const* allowedFileExtensionsImpulseResponse[] = {"WAV", "AIF", "AIFF", NULL};
+
+bool ImpulseResponseBrowser::opened() {
+
+	bool success = Browser::opened();
+	if (!success) {
+		return false;
+	}
+
+	allowedFileExtensions = allowedFileExtensionsImpulseResponse;
+
+	allowFoldersSharingNameWithFile = true;
+	outputTypeToLoad = OutputType::NONE;
+	qwertyVisible = false;
+
+	fileIndexSelected = 0;
+
+	Error error = StorageManager::initSD();
+	if (error != Error::NONE) {
+		goto sdError;
+	}
+
+	{
+		// Start where the current impulse response is, if there is one
+		String currentPath;
+		currentPath.set(&soundEditor.currentModControllable->convolution.filePath);
+		char const* searchFilename = nullptr;
+		char const* slashAddress = strrchr(currentPath.get(), '/');
+		if (currentPath.getLength() < 8 || memcasecmp(currentPath.get(), "SAMPLES/", 8) || !slashAddress) {
+			currentDir.set("SAMPLES");
+		}
+		else {
+			searchFilename = slashAddress + 1;
+			currentDir.set(currentPath.get(), slashAddress - currentPath.get());
+		}
+
+		error = arrivedInNewFolder(1, searchFilename, "SAMPLES");
+		if (error != Error::NONE) {
+			goto sdError;
+		}
+	}
+
+	return true;
+sdError:
+	display->displayError(error);
+	return false;
+}
+
+Error ImpulseResponseBrowser::getCurrentFilePath(String* path) {
+	Error error;
+
+	path->set(&currentDir);
+	int oldLength = path->getLength();
+	if (oldLength) {
+		error = path->concatenateAtPos("/", oldLength);
+		if (error != Error::NONE) {
+gotError:
+			path->clear();
+			return error;
+		}
+	}
+
+	FileItem* currentFileItem = getCurrentFileItem();
+
+	error = path->concatenate(&currentFileItem->filename);
+	if (error != Error::NONE) {
+		goto gotError;
+	}
+
+	return Error::NONE;
+}
+
+void ImpulseResponseBrowser::enterKeyPress() {
+	FileItem* currentFileItem = getCurrentFileItem();
+	if (!currentFileItem) {
+		return;
+	}
+
+	if (currentFileItem->isFolder) {
+		char const* filenameChars = currentFileItem->filename.get();
+		Error error = goIntoFolder(filenameChars);
+		if (error != Error::NONE) {
+			display->displayError(error);
+			close(); // Don't use goBackToSoundEditor() because that would do a left-scroll
+			return;
+		}
+	}
+	else {
+		String path;
+		getCurrentFilePath(&path);
+		close();
+
+		if (!path.isEmpty()) {
+			Error error = soundEditor.currentModControllable->convolution.setImpulseResponseFile(&path);
+			if (error != Error::NONE) {
+				display->displayError(error);
+			}
+		}
+	}
+}
+
+ImpulseResponseBrowser impulseResponseBrowser{};
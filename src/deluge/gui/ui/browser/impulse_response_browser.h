@@ -0,0 +1,33 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "definitions_cxx.hpp"
+#include "gui/ui/browser/browser.h"
+
+/// For picking the impulse response file for the Convolution of whatever the sound editor is editing
+class ImpulseResponseBrowser final : public Browser {
+public:
+	ImpulseResponseBrowser();
+	bool opened();
+	void enterKeyPress();
+	Error getCurrentFilePath(String* path) override;
+	const char* getName() { return "impulse_response_browser"; }
+};
+
+extern ImpulseResponseBrowser impulseResponseBrowser;
@@ -77,7 +77,7 @@ using namespace gui;
 
 SampleBrowser sampleBrowser{};
 
-char const* allowedFileExtensionsAudio[] = {"WAV", "AIFF", "AIF", NULL};
+char const* allowedFileExtensionsAudio[] = {"WAV", "AIFF", "AIF", "FLAC", NULL};
 
 SampleBrowser::SampleBrowser() {
 	fileIcon = deluge::hid::display::OLED::waveIcon;
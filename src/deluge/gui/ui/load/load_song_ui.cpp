@@ -343,6 +343,9 @@ fail:
 		// we might actually want
 		preLoadedSong->loadAllSamples(false);
 
+		// The new Song gets the whole preload budget. The old one's Samples just go back to being streamed
+		audioFileManager.releaseAllSamplePreloads();
+
 		// Load samples from files, just for currently playing Sounds (or if not playing, then all Sounds)
 		if (playbackHandler.isEitherClockActive()) {
 			preLoadedSong->loadCrucialSamplesOnly();
@@ -405,6 +408,9 @@ gotErrorAfterCreatingSong:
 	// might actually want
 	preLoadedSong->loadAllSamples(false);
 
+	// The new Song gets the whole preload budget. The old one's Samples just go back to being streamed
+	audioFileManager.releaseAllSamplePreloads();
+
 	// Load samples from files, just for currently playing Sounds (or if not playing, then all Sounds)
 	if (playbackHandler.isEitherClockActive()) {
 		preLoadedSong->loadCrucialSamplesOnly();
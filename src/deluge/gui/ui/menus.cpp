@@ -27,6 +27,8 @@
 #include "gui/menu_item/bend_range/main.h"
 #include "gui/menu_item/bend_range/per_finger.h"
 #include "gui/menu_item/colour.h"
+#include "gui/menu_item/convolution/blend.h"
+#include "gui/menu_item/convolution/browse.h"
 #include "gui/menu_item/cv/selection.h"
 #include "gui/menu_item/cv/submenu.h"
 #include "gui/menu_item/cv/transpose.h"
@@ -64,6 +66,7 @@
 #include "gui/menu_item/firmware/version.h"
 #include "gui/menu_item/flash/status.h"
 #include "gui/menu_item/fx/clipping.h"
+#include "gui/menu_item/fx/oversampling.h"
 #include "gui/menu_item/gate/mode.h"
 #include "gui/menu_item/gate/off_time.h"
 #include "gui/menu_item/gate/selection.h"
@@ -137,6 +140,7 @@
 #include "gui/menu_item/sample/end.h"
 #include "gui/menu_item/sample/interpolation.h"
 #include "gui/menu_item/sample/pitch_speed.h"
+#include "gui/menu_item/sample/preloaded.h"
 #include "gui/menu_item/sample/repeat.h"
 #include "gui/menu_item/sample/reverse.h"
 #include "gui/menu_item/sample/start.h"
@@ -174,6 +178,7 @@
 #include "gui/menu_item/unpatched_param/sound_unpatched_param.h"
 #include "gui/menu_item/unpatched_param/updating_reverb_params.h"
 #include "gui/menu_item/voice/polyphony.h"
+#include "gui/menu_item/voice/preload_samples.h"
 #include "gui/menu_item/voice/priority.h"
 #include "io/midi/midi_device_manager.h"
 #include "io/midi/midi_engine.h"
@@ -265,9 +270,11 @@ voice::PolyphonyType polyphonyMenu{STRING_FOR_POLYPHONY};
 voice::VoiceCount voice::polyphonicVoiceCountMenu{STRING_FOR_MAX_VOICES};
 UnpatchedParam portaMenu{STRING_FOR_PORTAMENTO, params::UNPATCHED_PORTAMENTO};
 voice::Priority priorityMenu{STRING_FOR_PRIORITY};
+voice::PreloadSamples preloadSamplesMenu{STRING_FOR_PRELOAD_SAMPLES};
 
-Submenu voiceMenu{STRING_FOR_VOICE,
-                  {&polyphonyMenu, &unisonMenu, &voice::polyphonicVoiceCountMenu, &portaMenu, &priorityMenu}};
+Submenu voiceMenu{
+    STRING_FOR_VOICE,
+    {&polyphonyMenu, &unisonMenu, &voice::polyphonicVoiceCountMenu, &portaMenu, &priorityMenu, &preloadSamplesMenu}};
 
 // Modulator menu -----------------------------------------------------------------------
 
@@ -347,6 +354,18 @@ Submenu delayMenu{
     },
 };
 
+// Convolution -------------------------------------------------------------------------------
+convolution::Browse convolutionBrowseMenu{STRING_FOR_IMPULSE_RESPONSE};
+convolution::Blend convolutionBlendMenu{STRING_FOR_BLEND, STRING_FOR_CONVOLUTION_BLEND};
+
+Submenu convolutionMenu{
+    STRING_FOR_CONVOLUTION,
+    {
+        &convolutionBrowseMenu,
+        &convolutionBlendMenu,
+    },
+};
+
 // Bend Ranges -------------------------------------------------------------------------------
 
 bend_range::Main mainBendRangeMenu{STRING_FOR_NORMAL};
@@ -429,6 +448,7 @@ fx::Clipping clippingMenu{STRING_FOR_SATURATION};
 UnpatchedParam srrMenu{STRING_FOR_DECIMATION, params::UNPATCHED_SAMPLE_RATE_REDUCTION};
 UnpatchedParam bitcrushMenu{STRING_FOR_BITCRUSH, params::UNPATCHED_BITCRUSHING};
 patched_param::Integer foldMenu{STRING_FOR_WAVEFOLD, STRING_FOR_WAVEFOLD, params::LOCAL_FOLD};
+fx::Oversampling oversamplingMenu{STRING_FOR_OVERSAMPLING};
 
 Submenu soundDistortionMenu{
     STRING_FOR_DISTORTION,
@@ -437,6 +457,7 @@ Submenu soundDistortionMenu{
         &srrMenu,
         &bitcrushMenu,
         &foldMenu,
+        &oversamplingMenu,
     },
 };
 
@@ -599,6 +620,7 @@ Submenu globalFXMenu{
         &globalEQMenu,
         &globalDelayMenu,
         &globalReverbMenu,
+        &convolutionMenu,
         &globalModFXMenu,
         &globalDistortionMenu,
     },
@@ -656,6 +678,7 @@ Submenu audioClipDistortionMenu{
         &clippingMenu,
         &srrMenu,
         &bitcrushMenu,
+        &oversamplingMenu,
     },
 };
 
@@ -665,6 +688,7 @@ Submenu audioClipFXMenu{
         &eqMenu,
         &globalDelayMenu,
         &globalReverbMenu,
+        &convolutionMenu,
         &globalModFXMenu,
         &audioClipDistortionMenu,
     },
@@ -763,6 +787,8 @@ sample::browser_preview::Mode sampleBrowserPreviewModeMenu{STRING_FOR_SAMPLE_PRE
 
 flash::Status flashStatusMenu{STRING_FOR_PLAY_CURSOR};
 
+sample::Preloaded preloadedSamplesMenu{STRING_FOR_PRELOADED_SAMPLES};
+
 firmware::Version firmwareVersionMenu{STRING_FOR_FIRMWARE_VERSION, STRING_FOR_FIRMWARE_VER_MENU_TITLE};
 
 runtime_feature::Settings runtimeFeatureSettingsMenu{STRING_FOR_COMMUNITY_FTS, STRING_FOR_COMMUNITY_FTS_MENU_TITLE};
@@ -1151,6 +1177,7 @@ Submenu soundFXMenu{
         &eqMenu,
         &delayMenu,
         &reverbMenu,
+        &convolutionMenu,
         &modFXMenu,
         &soundDistortionMenu,
         &noiseMenu,
@@ -1270,12 +1297,15 @@ ToggleBool configureSongFXMenu{STRING_FOR_CONFIGURE_EXPORT_STEMS_SONGFX, STRING_
                                stemExport.includeSongFX};
 ToggleBool configureOfflineRenderingMenu{STRING_FOR_CONFIGURE_EXPORT_STEMS_OFFLINE_RENDERING,
                                          STRING_FOR_CONFIGURE_EXPORT_STEMS_OFFLINE_RENDERING, stemExport.renderOffline};
+ToggleBool configureSinglePassMenu{STRING_FOR_CONFIGURE_EXPORT_STEMS_SINGLE_PASS,
+                                    STRING_FOR_CONFIGURE_EXPORT_STEMS_SINGLE_PASS, stemExport.exportInSinglePass};
 menu_item::Submenu configureStemExportMenu{STRING_FOR_CONFIGURE_EXPORT_STEMS,
                                            {
                                                &configureNormalizationMenu,
                                                &configureSilenceMenu,
                                                &configureSongFXMenu,
                                                &configureOfflineRenderingMenu,
+                                               &configureSinglePassMenu,
                                            }};
 
 menu_item::Submenu stemExportMenu{
@@ -1332,6 +1362,7 @@ Submenu settingsRootMenu{
         &flashStatusMenu,
         &recordSubmenu,
         &runtimeFeatureSettingsMenu,
+        &preloadedSamplesMenu,
         &firmwareVersionMenu,
     },
 };
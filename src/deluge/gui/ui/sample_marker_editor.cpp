@@ -1018,10 +1018,7 @@ void SampleMarkerEditor::graphicsRoutine() {
 
 			Voice* assignedVoice = NULL;
 
-			int32_t ends[2];
-			AudioEngine::activeVoices.getRangeForSound(soundEditor.currentSound, ends);
-			for (int32_t v = ends[0]; v < ends[1]; v++) {
-				Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+			for (Voice* thisVoice : AudioEngine::activeVoices.forSound(soundEditor.currentSound)) {
 
 				// Ensure correct MultisampleRange.
 				if (thisVoice->guides[soundEditor.currentSourceIndex].audioFileHolder
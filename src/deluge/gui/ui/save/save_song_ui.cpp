@@ -192,6 +192,7 @@ gotError:
 					FRESULT result =
 					    f_rename(((Sample*)audioFile)->tempFilePathForRecording.get(), audioFile->filePath.get());
 					if (result == FR_OK) {
+						audioFileManager.deleteClusterMapSidecar(((Sample*)audioFile)->tempFilePathForRecording.get());
 						((Sample*)audioFile)->tempFilePathForRecording.clear();
 					}
 					else {
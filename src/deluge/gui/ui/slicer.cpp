@@ -174,10 +174,7 @@ void Slicer::graphicsRoutine() {
 
 			range = (MultisampleRange*)drum->sources[0].getOrCreateFirstRange();
 
-			int32_t ends[2];
-			AudioEngine::activeVoices.getRangeForSound(drum, ends);
-			for (int32_t v = ends[0]; v < ends[1]; v++) {
-				Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+			for (Voice* thisVoice : AudioEngine::activeVoices.forSound(drum)) {
 
 				// Ensure correct MultisampleRange.
 				if (thisVoice->guides[0].audioFileHolder != range->getAudioFileHolder()) {
@@ -526,10 +523,7 @@ ActionResult Slicer::padAction(int32_t x, int32_t y, int32_t on) {
 
 					range = (MultisampleRange*)drum->sources[0].getOrCreateFirstRange();
 
-					int32_t ends[2];
-					AudioEngine::activeVoices.getRangeForSound(drum, ends);
-					for (int32_t v = ends[0]; v < ends[1]; v++) {
-						Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+					for (Voice* thisVoice : AudioEngine::activeVoices.forSound(drum)) {
 						// Ensure correct MultisampleRange.
 						if (thisVoice->guides[0].audioFileHolder != range->getAudioFileHolder()) {
 							continue;
@@ -1185,6 +1185,17 @@ ActionResult SoundEditor::padAction(int32_t x, int32_t y, int32_t on) {
 				return ActionResult::DEALT_WITH;
 			}
 
+			// Read largest free run in internal (x == 12) or stealable (x == 11) memory, and dump all the allocator
+			// stats to the debug log
+			else if (x == 12 || x == 11) {
+				GeneralMemoryAllocator& allocator = GeneralMemoryAllocator::get();
+				auto& region = allocator.regions[(x == 12) ? MEMORY_REGION_INTERNAL : MEMORY_REGION_STEALABLE];
+				intToString(region.getStats().largestFreeRun, buffer);
+				display->displayPopup(buffer);
+				allocator.printStats([](char const* line) { D_PRINTLN("%s", line); });
+				return ActionResult::DEALT_WITH;
+			}
+
 			// Read active voices
 			else if (x == 14) {
 				intToString(AudioEngine::activeVoices.getNumElements(), buffer);
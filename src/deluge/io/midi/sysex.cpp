@@ -21,6 +21,7 @@
 #include "io/debug/print.h"
 #include "io/midi/midi_device.h"
 #include "io/midi/midi_engine.h"
+#include "memory/general_memory_allocator.h"
 #include "util/chainload.h"
 
 #include "util/pack.h"
@@ -53,6 +54,10 @@ void Debug::sysexReceived(MIDIDevice* device, uint8_t* data, int32_t len) {
 #endif
 		break;
 
+	case 3: // Dump memory allocator stats
+		GeneralMemoryAllocator::get().printStats([device](char const* line) { sysexDebugPrint(device, line, true); });
+		break;
+
 	default:
 		break;
 	}
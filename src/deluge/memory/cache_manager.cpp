@@ -4,11 +4,103 @@
 #include "memory/memory_region.h"
 #include "memory/stealable.h"
 #include "processing/engines/audio_engine.h"
+#include <algorithm>
 #include <cstdint>
 
 extern bool skipConsistencyCheck;
 uint32_t currentTraversalNo = 0;
 
+namespace {
+uint32_t getSpaceSize(Stealable* stealable) {
+	auto* __restrict__ header = std::bit_cast<uintptr_t*>((uint32_t)stealable - 4);
+	return (*header & SPACE_SIZE_MASK);
+}
+} // namespace
+
+void CacheManager::QueueForReclamation(StealableQueue queue, Stealable* stealable) {
+	size_t q = util::to_underlying(queue);
+
+	/// Alternatively we could add to start of queue - logic is that a recently freed sample is unlikely
+	/// to be immediately needed again. This increases average and max voice counts, but has a problem with medium
+	/// memory pressure songs where it tends to prioritize earlier sounds in the song and makes it possible for
+	/// later songs to break in. This occurs since there's no mechanism to determine if a sample is going to be used
+	/// in the remainder of the song, so if there's not enough memory pressure for all stealable clusters to get
+	/// reclaimed the same few just get put on and off the list repeatedly
+	reclamation_queue_[q].addToEnd(stealable);
+	longest_runs_[q] = 0xFFFFFFFF;
+
+	// We don't yet know what's around it, but it's at least a run of its own size. This also replaces anything we knew
+	// about it from whichever queue it was in before
+	IndexRun(q, stealable, getSpaceSize(stealable));
+}
+
+void CacheManager::IndexRun(size_t q, Stealable* stealable, uint32_t length) {
+	if (stealable->runIndexedBy != nullptr) {
+		ForgetRun(stealable);
+	}
+
+	auto& runs = run_index_[q];
+
+	// Keep them longest first. Among equal lengths, whatever was there first stays ahead
+	size_t pos = 0;
+	while (pos < kNumIndexedRunsPerQueue && runs[pos].stealable != nullptr && runs[pos].length >= length) {
+		pos++;
+	}
+	if (pos == kNumIndexedRunsPerQueue) {
+		return; // Shorter than everything we already know about
+	}
+
+	if (runs.back().stealable != nullptr) {
+		runs.back().stealable->runIndexedBy = nullptr;
+	}
+	std::move_backward(runs.begin() + pos, runs.end() - 1, runs.end());
+	runs[pos] = {stealable, length};
+	stealable->runIndexedBy = this;
+}
+
+void CacheManager::ForgetRun(Stealable* stealable) {
+	for (auto& runs : run_index_) {
+		auto it = std::ranges::find(runs, stealable, &StealableRun::stealable);
+		if (it != runs.end()) {
+			std::move(it + 1, runs.end(), it);
+			runs.back() = {nullptr, 0};
+			break;
+		}
+	}
+	stealable->runIndexedBy = nullptr;
+}
+
+void CacheManager::RecordSteal(Stealable* stealable) {
+	for (size_t q = 0; q < kNumStealableQueue; q++) {
+		if (stealable->list == &reclamation_queue_[q]) {
+			steals_[q]++;
+			return;
+		}
+	}
+}
+
+// Returns the Stealable with the shortest known run that'd still be long enough, or nullptr if there isn't one.
+// Entries for things which have left the queue since are dropped as we go
+Stealable* CacheManager::FindIndexedRun(size_t q, uint32_t totalSizeNeeded, void* thingNotToStealFrom) {
+	auto& runs = run_index_[q];
+	Stealable* bestFit = nullptr;
+
+	size_t i = 0;
+	while (i < kNumIndexedRunsPerQueue && runs[i].stealable != nullptr && runs[i].length >= totalSizeNeeded) {
+		Stealable* stealable = runs[i].stealable;
+		if (stealable->list != &reclamation_queue_[q]) {
+			ForgetRun(stealable); // Shuffles the rest up, so look at this position again
+			continue;
+		}
+		// If we've already looked at it (or it was part of a run we looked at) during this queue, we know it's no good
+		if (stealable->lastTraversalNo != currentTraversalNo && stealable->mayBeStolen(thingNotToStealFrom)) {
+			bestFit = stealable;
+		}
+		i++;
+	}
+	return bestFit;
+}
+
 // Size 0 means don't care, just get any memory.
 uint32_t CacheManager::ReclaimMemory(MemoryRegion& region, int32_t totalSizeNeeded, void* thingNotToStealFrom,
                                      int32_t* __restrict__ foundSpaceSize) {
@@ -49,6 +141,9 @@ uint32_t CacheManager::ReclaimMemory(MemoryRegion& region, int32_t totalSizeNeed
 
 		uint32_t longestRunSeenInThisQueue = 0;
 
+		// Size 0 will take any Stealable, so the least recently used one is as good as any
+		bool triedIndexedRun = (totalSizeNeeded <= 0);
+
 		stealable = static_cast<Stealable*>(reclamation_queue_[q].getFirst());
 		while (stealable != nullptr) {
 			// If we've already looked at this one as part of a bigger run, move on
@@ -108,8 +203,7 @@ uint32_t CacheManager::ReclaimMemory(MemoryRegion& region, int32_t totalSizeNeed
 			}
 
 			// Ok, we've got one Stealable
-			auto* __restrict__ header = std::bit_cast<uintptr_t*>((uint32_t)stealable - 4);
-			spaceSize = (*header & SPACE_SIZE_MASK);
+			spaceSize = getSpaceSize(stealable);
 
 			stealable->lastTraversalNo = currentTraversalNo;
 
@@ -144,8 +238,41 @@ uint32_t CacheManager::ReclaimMemory(MemoryRegion& region, int32_t totalSizeNeed
 				if (result.longestRunFound > longestRunSeenInThisQueue) {
 					longestRunSeenInThisQueue = result.longestRunFound;
 				}
-				stealable = static_cast<Stealable*>(reclamation_queue_[q].getNext(stealable));
-				continue;
+				IndexRun(q, stealable, result.longestRunFound);
+				auto* next = static_cast<Stealable*>(reclamation_queue_[q].getNext(stealable));
+
+				// Rather than going on to try the neighbouring memory around every Stealable in turn, have a go at the
+				// best-fitting run we know of in this queue. Just once per queue - the index is only a hint, and if
+				// it's out of date we've not lost much before carrying on with the walk
+				Stealable* candidate = triedIndexedRun ? nullptr : FindIndexedRun(q, totalSizeNeeded, thingNotToStealFrom);
+				triedIndexedRun = true;
+				if (candidate == nullptr) {
+					stealable = next;
+					continue;
+				}
+
+				candidate->lastTraversalNo = currentTraversalNo;
+				spaceSize = getSpaceSize(candidate);
+				amountToExtend = totalSizeNeeded - spaceSize;
+
+				if (amountToExtend <= 0) {
+					stealable = candidate;
+					newSpaceAddress = (uint32_t)candidate;
+					longestRunSeenInThisQueue = 0xFFFFFFFF;
+					found = true;
+					break;
+				}
+
+				result = region.attemptToGrabNeighbouringMemory(candidate, spaceSize, amountToExtend, amountToExtend,
+				                                                thingNotToStealFrom, currentTraversalNo, true);
+				if (!result.address) {
+					if (result.longestRunFound > longestRunSeenInThisQueue) {
+						longestRunSeenInThisQueue = result.longestRunFound;
+					}
+					IndexRun(q, candidate, result.longestRunFound);
+					stealable = next;
+					continue;
+				}
 			}
 			// reset this since it's getting stolen
 			longestRunSeenInThisQueue = 0xFFFFFFFF;
@@ -178,6 +305,7 @@ uint32_t CacheManager::ReclaimMemory(MemoryRegion& region, int32_t totalSizeNeed
 	if (found && !stolen) {
 		// Warning - for perc cache Cluster, stealing one can cause it to want to allocate more memory for its list of
 		// zones
+		RecordSteal(stealable);
 		stealable->steal("i007");
 		stealable->~Stealable();
 	}
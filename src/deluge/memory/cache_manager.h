@@ -20,27 +20,49 @@ public:
 	uint32_t& longest_runs(size_t idx) { return longest_runs_.at(idx); }
 
 	/// add a stealable to end of given queue
-	void QueueForReclamation(StealableQueue queue, Stealable* stealable) {
-		size_t q = util::to_underlying(queue);
-
-		/// Alternatively we could add to start of queue - logic is that a recently freed sample is unlikely
-		/// to be immediately needed again. This increases average and max voice counts, but has a problem with medium
-		/// memory pressure songs where it tends to prioritize earlier sounds in the song and makes it possible for
-		/// later songs to break in. This occurs since there's no mechanism to determine if a sample is going to be used
-		/// in the remainder of the song, so if there's not enough memory pressure for all stealable clusters to get
-		/// reclaimed the same few just get put on and off the list repeatedly
-		reclamation_queue_[q].addToEnd(stealable);
-		longest_runs_[q] = 0xFFFFFFFF; // TODO: actually investigate neighbouring memory "run".
-	}
+	void QueueForReclamation(StealableQueue queue, Stealable* stealable);
 
 	uint32_t ReclaimMemory(MemoryRegion& region, int32_t totalSizeNeeded, void* thingNotToStealFrom,
 	                       int32_t* __restrict__ foundSpaceSize);
 
+	/// Drop any record of the given Stealable's run. Called as Stealables are destroyed
+	void ForgetRun(Stealable* stealable);
+
+	/// Count a Stealable as stolen, against the queue it's in. Call before stealing it
+	void RecordSteal(Stealable* stealable);
+
+	/// How many things have been stolen from the given queue since boot
+	uint32_t steals(StealableQueue queue) const { return steals_.at(util::to_underlying(queue)); }
+
+	/// A Stealable, and how much contiguous memory we'd get by stealing it along with its stealable and empty
+	/// neighbours, as of when we last looked.
+	struct StealableRun {
+		Stealable* stealable;
+		uint32_t length;
+	};
+	static constexpr size_t kNumIndexedRunsPerQueue = 8;
+
+	/// The longest runs we know of in a queue, longest first. Unused entries have a null stealable.
+	const std::array<StealableRun, kNumIndexedRunsPerQueue>& indexed_runs(StealableQueue queue) const {
+		return run_index_.at(util::to_underlying(queue));
+	}
+
 private:
+	void IndexRun(size_t q, Stealable* stealable, uint32_t length);
+	Stealable* FindIndexedRun(size_t q, uint32_t totalSizeNeeded, void* thingNotToStealFrom);
+
 	std::array<BidirectionalLinkedList, kNumStealableQueue> reclamation_queue_;
 
-	// Keeps track, semi-accurately, of biggest runs of memory that could be stolen. In a perfect world, we'd have a
-	// second index on stealableClusterQueues[q], for run length. Although even that wouldn't automatically reflect
-	// changes to run lengths as neighbouring memory is allocated.
+	// Upper bound on the biggest run of memory that could be stolen from each queue, so ReclaimMemory() can skip a
+	// queue outright. Set to "unknown" whenever something's added to the queue, and lowered once we've walked it.
 	std::array<uint32_t, kNumStealableQueue> longest_runs_;
+
+	// Second index on each queue, by run length: the longest runs seen when queueing things or walking the queue in
+	// ReclaimMemory(). This lets a big allocation go straight to a Stealable with enough memory around it rather than
+	// trying to grab neighbouring memory around each Stealable in LRU order. Run lengths go stale as neighbouring
+	// memory gets allocated and freed, so an entry is only ever a hint - it's checked by actually trying to grab the
+	// memory, and updated with what was found. Each Stealable is in here at most once.
+	std::array<std::array<StealableRun, kNumIndexedRunsPerQueue>, kNumStealableQueue> run_index_{};
+
+	std::array<uint32_t, kNumStealableQueue> steals_{};
 };
@@ -120,6 +120,16 @@ void* GeneralMemoryAllocator::alloc(uint32_t requiredSize, bool mayUseOnChipRam,
 	if (!makeStealable) {
 		// If internal is allowed, try that first
 		if (mayUseOnChipRam) {
+			if (SlabAllocator::handles(requiredSize)) {
+				lock = true;
+				address = smallObjects.alloc(requiredSize);
+				lock = false;
+
+				if (address) {
+					return address;
+				}
+			}
+
 			lock = true;
 			address = regions[MEMORY_REGION_INTERNAL].alloc(requiredSize, makeStealable, thingNotToStealFrom);
 			lock = false;
@@ -181,12 +191,18 @@ int32_t GeneralMemoryAllocator::getRegion(void* address) {
 
 // Returns new size
 uint32_t GeneralMemoryAllocator::shortenRight(void* address, uint32_t newSize) {
+	if (SlabAllocator::isSlabAllocation(address)) {
+		return getAllocatedSize(address);
+	}
 	return regions[getRegion(address)].shortenRight(address, newSize);
 }
 
 // Returns how much it was shortened by
 uint32_t GeneralMemoryAllocator::shortenLeft(void* address, uint32_t amountToShorten,
                                              uint32_t numBytesToMoveRightIfSuccessful) {
+	if (SlabAllocator::isSlabAllocation(address)) {
+		return 0;
+	}
 	return regions[getRegion(address)].shortenLeft(address, amountToShorten, numBytesToMoveRightIfSuccessful);
 }
 
@@ -197,7 +213,7 @@ void GeneralMemoryAllocator::extend(void* address, uint32_t minAmountToExtend, u
 	*getAmountExtendedLeft = 0;
 	*getAmountExtendedRight = 0;
 
-	if (lock) {
+	if (lock || SlabAllocator::isSlabAllocation(address)) {
 		return;
 	}
 
@@ -208,13 +224,27 @@ void GeneralMemoryAllocator::extend(void* address, uint32_t minAmountToExtend, u
 }
 
 uint32_t GeneralMemoryAllocator::extendRightAsMuchAsEasilyPossible(void* address) {
+	if (SlabAllocator::isSlabAllocation(address)) {
+		return getAllocatedSize(address);
+	}
 	return regions[getRegion(address)].extendRightAsMuchAsEasilyPossible(address);
 }
 
 void GeneralMemoryAllocator::dealloc(void* address) {
+	if (SlabAllocator::isSlabAllocation(address)) {
+		return smallObjects.dealloc(address);
+	}
 	return regions[getRegion(address)].dealloc(address);
 }
 
+void GeneralMemoryAllocator::printStats(const MemoryStatsPrinter& printLine) {
+	static char const* const regionNames[NUM_MEMORY_REGIONS] = {"stealable", "internal", "external"};
+	for (int32_t r = 0; r < NUM_MEMORY_REGIONS; r++) {
+		regions[r].printStats(regionNames[r], printLine);
+	}
+	smallObjects.printStats(printLine);
+}
+
 void GeneralMemoryAllocator::putStealableInQueue(Stealable* stealable, StealableQueue q) {
 	MemoryRegion& region = regions[getRegion(stealable)];
 	region.cache_manager().QueueForReclamation(q, stealable);
@@ -19,6 +19,7 @@
 
 #include "definitions_cxx.hpp"
 #include "memory/memory_region.h"
+#include "memory/slab_allocator.h"
 
 #define MEMORY_REGION_STEALABLE 0
 #define MEMORY_REGION_INTERNAL 1
@@ -55,6 +56,9 @@ class Stealable;
  * case where a neighbouring region of memory is chosen for allocation (or itself being stolen) when
  * the allocation requires that the object in question have its memory stolen too in order to make
  * up a large enough allocation.
+ *
+ * Small, non-stealable allocations which may use on-chip RAM are served from slabs of fixed-size slots, themselves
+ * allocated from the internal region - see SlabAllocator. These can't be shortened or extended.
  */
 
 class GeneralMemoryAllocator {
@@ -88,10 +92,14 @@ public:
 	int32_t getRegion(void* address);
 	void testMemoryDeallocated(void* address);
 
+	/// Dump each region's usage, fragmentation, steals and alloc / dealloc latency, and the slab allocator's usage
+	void printStats(const MemoryStatsPrinter& printLine);
+
 	void putStealableInQueue(Stealable* stealable, StealableQueue q);
 	void putStealableInAppropriateQueue(Stealable* stealable);
 
 	MemoryRegion regions[NUM_MEMORY_REGIONS];
+	SlabAllocator smallObjects{regions[MEMORY_REGION_INTERNAL]};
 
 	bool lock;
 
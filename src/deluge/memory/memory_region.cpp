@@ -50,6 +50,9 @@ void MemoryRegion::setup(void* emptySpacesMemory, int32_t emptySpacesMemorySize,
 	firstRecord->length = memorySizeWithoutHeaders;
 	firstRecord->address = regionBegin + 8;
 	pivot = 512;
+
+	allocLatency.reset();
+	deallocLatency.reset();
 }
 
 uint32_t MemoryRegion::padSize(uint32_t requiredSize) {
@@ -72,6 +75,42 @@ uint32_t MemoryRegion::padSize(uint32_t requiredSize) {
 	return requiredSize;
 }
 
+MemoryRegionStats MemoryRegion::getStats() {
+	MemoryRegionStats stats{};
+	stats.size = end - start;
+	stats.numEmptySpaces = emptySpaces.getNumElements();
+
+	uint32_t bytesFree = 0;
+	for (int32_t i = 0; i < emptySpaces.getNumElements(); i++) {
+		auto* emptySpaceRecord = (EmptySpaceRecord*)emptySpaces.getElementAddress(i);
+		bytesFree += emptySpaceRecord->length + 8;
+	}
+	stats.bytesAllocated = stats.size - bytesFree;
+
+	// They're ordered by length, so the last one's the biggest
+	if (stats.numEmptySpaces) {
+		stats.largestFreeRun =
+		    ((EmptySpaceRecord*)emptySpaces.getElementAddress(stats.numEmptySpaces - 1))->length;
+	}
+
+	for (size_t q = 0; q < kNumStealableQueue; q++) {
+		stats.steals[q] = cache_manager_.steals(static_cast<StealableQueue>(q));
+	}
+	return stats;
+}
+
+void MemoryRegion::printStats(char const* label, const MemoryStatsPrinter& printLine) {
+	getStats().print(label, printLine);
+
+	char latencyLabel[32];
+	strcpy(latencyLabel, label);
+	strcat(latencyLabel, " alloc");
+	allocLatency.print(latencyLabel, printLine);
+	strcpy(latencyLabel, label);
+	strcat(latencyLabel, " dealloc");
+	deallocLatency.print(latencyLabel, printLine);
+}
+
 bool seenYet = false;
 
 void MemoryRegion::sanityCheck() {
@@ -273,6 +312,8 @@ goingToReplaceOldRecord:
 }
 
 void* MemoryRegion::alloc(uint32_t requiredSize, bool makeStealable, void* thingNotToStealFrom) {
+	LatencyHistogram::Timer timer{allocLatency};
+
 	requiredSize = padSize(requiredSize);
 	bool large = requiredSize > pivot;
 	// set a minimum size	requiredSize = padSize(requiredSize);
@@ -531,6 +572,7 @@ uint32_t MemoryRegion::extendRightAsMuchAsEasilyPossible(void* address) {
 		if (!stealable->mayBeStolen(NULL)) {
 			goto finished;
 		}
+		cache_manager_.RecordSteal(stealable);
 		stealable->steal("E446");
 		stealable->~Stealable();
 	}
@@ -579,6 +621,7 @@ NeighbouringMemoryGrabAttemptResult MemoryRegion::attemptToGrabNeighbouringMemor
 	for (int32_t actuallyGrabbing = 0; actuallyGrabbing < 2; actuallyGrabbing++) {
 
 		if (actuallyGrabbing && originalSpaceNeedsStealing) {
+			cache_manager_.RecordSteal((Stealable*)originalSpaceAddress);
 			((Stealable*)originalSpaceAddress)->steal("E417"); // Jensg still getting.
 			((Stealable*)originalSpaceAddress)->~Stealable();
 		}
@@ -670,6 +713,7 @@ tryNotStealingFirst:
 							                                                   + toReturn.amountsExtended[0]
 							                                                   + toReturn.amountsExtended[1]);
 
+							cache_manager_.RecordSteal(stealable);
 							stealable->steal("E418"); // Jensg still getting.
 							stealable->~Stealable();
 						}
@@ -819,8 +863,7 @@ int32_t numDeallocTimes = 0;
 #endif
 
 void MemoryRegion::dealloc(void* address) {
-
-	// uint16_t startTime = *TCNT[TIMER_SYSTEM_FAST];
+	LatencyHistogram::Timer timer{deallocLatency};
 
 	uint32_t* __restrict__ header = (uint32_t*)((uint32_t)address - 4);
 	uint32_t spaceSize = (*header & SPACE_SIZE_MASK);
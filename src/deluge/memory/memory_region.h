@@ -18,6 +18,7 @@
 #pragma once
 
 #include "memory/cache_manager.h"
+#include "memory/memory_stats.h"
 #include "util/container/array/ordered_resizeable_array_with_multi_word_key.h"
 
 struct EmptySpaceRecord {
@@ -34,6 +35,8 @@ struct NeighbouringMemoryGrabAttemptResult {
 #define SPACE_HEADER_EMPTY 0
 #define SPACE_HEADER_STEALABLE 0x40000000
 #define SPACE_HEADER_ALLOCATED 0x80000000
+// Never seen by a MemoryRegion - marks a small allocation handed out from inside one of SlabAllocator's slabs
+#define SPACE_HEADER_SLAB 0xC0000000
 
 #define SPACE_TYPE_MASK 0xC0000000u
 #define SPACE_SIZE_MASK 0x3FFFFFFFu
@@ -54,6 +57,9 @@ public:
 	void dealloc(void* address);
 	void verifyMemoryNotFree(void* address, uint32_t spaceSize);
 
+	MemoryRegionStats getStats();
+	void printStats(char const* label, const MemoryStatsPrinter& printLine);
+
 	uint32_t start;
 	uint32_t end;
 	uint32_t numAllocations;
@@ -65,6 +71,9 @@ public:
 #endif
 	OrderedResizeableArrayWithMultiWordKey emptySpaces;
 
+	LatencyHistogram allocLatency;
+	LatencyHistogram deallocLatency;
+
 private:
 	friend class CacheManager;
 	CacheManager cache_manager_;
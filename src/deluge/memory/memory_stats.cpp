@@ -0,0 +1,65 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "memory/memory_stats.h"
+#include <cstdio>
+
+// Formatting lives here rather than with the allocator itself so it doesn't need to pull in the debug log
+
+void MemoryRegionStats::print(char const* label, const MemoryStatsPrinter& printLine) const {
+	char buffer[128];
+	snprintf(buffer, sizeof(buffer), "%s: %lu of %lu bytes allocated, largest free %lu, %lu empty spaces", label,
+	         (unsigned long)bytesAllocated, (unsigned long)size, (unsigned long)largestFreeRun,
+	         (unsigned long)numEmptySpaces);
+	printLine(buffer);
+
+	size_t length = snprintf(buffer, sizeof(buffer), "%s steals by queue:", label);
+	uint32_t totalSteals = 0;
+	for (size_t q = 0; q < kNumStealableQueue && length < sizeof(buffer); q++) {
+		totalSteals += steals[q];
+		if (steals[q]) {
+			length += snprintf(&buffer[length], sizeof(buffer) - length, " %lu:%lu", (unsigned long)q,
+			                   (unsigned long)steals[q]);
+		}
+	}
+	if (totalSteals) {
+		printLine(buffer);
+	}
+}
+
+void LatencyHistogram::print(char const* label, const MemoryStatsPrinter& printLine) const {
+	char buffer[256];
+	size_t length = snprintf(buffer, sizeof(buffer), "%s latency:", label);
+
+	// Leave out empty buckets, which is most of them
+	for (size_t bucket = 0; bucket < kNumBuckets && length < sizeof(buffer); bucket++) {
+		if (!counts_[bucket]) {
+			continue;
+		}
+		if (bucket == kNumBuckets - 1) {
+			length += snprintf(&buffer[length], sizeof(buffer) - length, " more:%lu", (unsigned long)counts_[bucket]);
+		}
+		else {
+			length += snprintf(&buffer[length], sizeof(buffer) - length, " <%lu:%lu",
+			                   (unsigned long)(kFirstBucketLimit << bucket), (unsigned long)counts_[bucket]);
+		}
+	}
+	if (length < sizeof(buffer)) {
+		snprintf(&buffer[length], sizeof(buffer) - length, " max %lu", (unsigned long)max_);
+	}
+	printLine(buffer);
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "definitions_cxx.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#if IN_UNIT_TESTS
+#include <chrono>
+#else
+#include "io/debug/print.h"
+#endif
+
+/// Receives a dump of allocator stats one line at a time, e.g. to print them or send them out as sysex
+using MemoryStatsPrinter = std::function<void(char const* line)>;
+
+/// Where a MemoryRegion's at, as of the moment it was asked
+struct MemoryRegionStats {
+	uint32_t size;           // Including headers and footers
+	uint32_t bytesAllocated; // Allocated or stealable, including headers and footers
+	uint32_t largestFreeRun; // Biggest allocation that could be made without stealing anything
+	uint32_t numEmptySpaces;
+	std::array<uint32_t, kNumStealableQueue> steals; // Since boot, by the queue they were stolen from
+
+	void print(char const* label, const MemoryStatsPrinter& printLine) const;
+};
+
+/// Counts how long something took, in power-of-two buckets: bucket i counts times under (kFirstBucketLimit << i),
+/// and the last bucket anything slower than that. Times are in CPU cycles on the Deluge, or nanoseconds in host builds
+class LatencyHistogram {
+public:
+	static constexpr size_t kNumBuckets = 12;
+	static constexpr uint32_t kFirstBucketLimit = 256;
+
+	/// Times from construction to destruction
+	class Timer {
+	public:
+		Timer(LatencyHistogram& histogram) : histogram_(histogram), startTime_(now()) {}
+		~Timer() { histogram_.note(now() - startTime_); }
+
+	private:
+		LatencyHistogram& histogram_;
+		uint32_t startTime_;
+	};
+
+	void note(uint32_t time) {
+		size_t bucket = 0;
+		uint32_t limit = kFirstBucketLimit;
+		while (time >= limit && bucket < kNumBuckets - 1) {
+			bucket++;
+			limit <<= 1;
+		}
+		counts_[bucket]++;
+		if (time > max_) {
+			max_ = time;
+		}
+	}
+
+	void reset() {
+		counts_ = {};
+		max_ = 0;
+	}
+
+	[[nodiscard]] uint32_t count(size_t bucket) const { return counts_[bucket]; }
+	[[nodiscard]] uint32_t max() const { return max_; }
+	[[nodiscard]] uint32_t total() const {
+		uint32_t total = 0;
+		for (uint32_t count : counts_) {
+			total += count;
+		}
+		return total;
+	}
+
+	/// Prints something like "alloc latency: <256:1234 <512:56 <1024:7 max 700"
+	void print(char const* label, const MemoryStatsPrinter& printLine) const;
+
+	static uint32_t now() {
+#if IN_UNIT_TESTS
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		           std::chrono::steady_clock::now().time_since_epoch())
+		    .count();
+#else
+		return Debug::readCycleCounter();
+#endif
+	}
+
+private:
+	std::array<uint32_t, kNumBuckets> counts_{};
+	uint32_t max_ = 0;
+};
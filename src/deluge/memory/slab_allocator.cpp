@@ -0,0 +1,182 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "memory/slab_allocator.h"
+#include "definitions_cxx.hpp"
+#include <cstdio>
+#include <new>
+
+// Lives at the start of each slab's memory. The slots follow it
+struct SlabAllocator::Slab {
+	Slab* next; // In the list of slabs of this size class which have a free slot
+	Slab* prev;
+	void* firstFreeSlot; // Free slots are linked through their first word
+	uint16_t numInUse;
+	uint16_t numSlots;
+	uint32_t sizeClass;
+};
+
+namespace {
+// Each slot is preceded by the distance back to the start of its slab, then the header word, which is where everything
+// else expects to find it
+constexpr uint32_t kSlotOverhead = 8;
+
+size_t sizeClassFor(uint32_t requiredSize) {
+	size_t c = 0;
+	while (SlabAllocator::kSizeClasses[c] < requiredSize) {
+		c++;
+	}
+	return c;
+}
+} // namespace
+
+void* SlabAllocator::alloc(uint32_t requiredSize) {
+	if (!handles(requiredSize)) {
+		return nullptr;
+	}
+
+	size_t c = sizeClassFor(requiredSize);
+	SizeClass& sizeClass = classes_[c];
+
+	Slab* slab = sizeClass.slabsWithFreeSlots;
+	if (slab == nullptr) {
+		slab = newSlab(c);
+		if (slab == nullptr) {
+			sizeClass.stats.numSlabFailures++;
+			return nullptr;
+		}
+	}
+
+	void* address = slab->firstFreeSlot;
+	slab->firstFreeSlot = *static_cast<void**>(address);
+	slab->numInUse++;
+	if (slab->firstFreeSlot == nullptr) {
+		unlinkSlab(sizeClass, slab);
+	}
+
+	Stats& stats = sizeClass.stats;
+	stats.numAllocs++;
+	stats.numInUse++;
+	if (stats.numInUse > stats.peakInUse) {
+		stats.peakInUse = stats.numInUse;
+	}
+	return address;
+}
+
+void SlabAllocator::dealloc(void* address) {
+	uint32_t* slotWords = static_cast<uint32_t*>(address) - 2;
+	Slab* slab = reinterpret_cast<Slab*>(static_cast<char*>(address) - slotWords[0]);
+	SizeClass& sizeClass = classes_[slab->sizeClass];
+
+#if ALPHA_OR_BETA_VERSION
+	if ((slotWords[1] & SPACE_TYPE_MASK) != SPACE_HEADER_SLAB || !slab->numInUse) {
+		FREEZE_WITH_ERROR("M005");
+	}
+#endif
+
+	bool wasFull = (slab->firstFreeSlot == nullptr);
+	*static_cast<void**>(address) = slab->firstFreeSlot;
+	slab->firstFreeSlot = address;
+	slab->numInUse--;
+	sizeClass.stats.numInUse--;
+
+	if (wasFull) {
+		linkSlab(sizeClass, slab);
+	}
+
+	// Give an empty slab back, unless it's the only one with free slots - no point handing it back just to have to ask
+	// for it again when the next one of these gets allocated
+	else if (!slab->numInUse && (sizeClass.slabsWithFreeSlots != slab || slab->next != nullptr)) {
+		unlinkSlab(sizeClass, slab);
+		sizeClass.stats.numSlabs--;
+		sizeClass.stats.numSlots -= slab->numSlots;
+		region_.dealloc(slab);
+	}
+}
+
+SlabAllocator::Slab* SlabAllocator::newSlab(size_t c) {
+	void* memory = region_.alloc(kSlabSize, false, nullptr);
+	if (memory == nullptr) {
+		return nullptr;
+	}
+
+	constexpr uint32_t kFirstSlotOffset = (sizeof(Slab) + 7) & ~7u;
+	uint32_t slotSize = kSizeClasses[c];
+	uint32_t stride = slotSize + kSlotOverhead;
+	uint16_t numSlots = (kSlabSize - kFirstSlotOffset) / stride;
+
+	Slab* slab = new (memory) Slab{
+	    .next = nullptr,
+	    .prev = nullptr,
+	    .firstFreeSlot = nullptr,
+	    .numInUse = 0,
+	    .numSlots = numSlots,
+	    .sizeClass = (uint32_t)c,
+	};
+
+	// Link them up last to first, so they get handed out in address order
+	char* firstSlot = static_cast<char*>(memory) + kFirstSlotOffset + kSlotOverhead;
+	for (int32_t i = numSlots - 1; i >= 0; i--) {
+		char* address = firstSlot + i * stride;
+		uint32_t* slotWords = reinterpret_cast<uint32_t*>(address) - 2;
+		slotWords[0] = address - static_cast<char*>(memory);
+		slotWords[1] = SPACE_HEADER_SLAB | slotSize;
+		*reinterpret_cast<void**>(address) = slab->firstFreeSlot;
+		slab->firstFreeSlot = address;
+	}
+
+	SizeClass& sizeClass = classes_[c];
+	linkSlab(sizeClass, slab);
+	sizeClass.stats.numSlabs++;
+	sizeClass.stats.numSlots += numSlots;
+	return slab;
+}
+
+void SlabAllocator::linkSlab(SizeClass& sizeClass, Slab* slab) {
+	slab->prev = nullptr;
+	slab->next = sizeClass.slabsWithFreeSlots;
+	if (slab->next != nullptr) {
+		slab->next->prev = slab;
+	}
+	sizeClass.slabsWithFreeSlots = slab;
+}
+
+void SlabAllocator::unlinkSlab(SizeClass& sizeClass, Slab* slab) {
+	if (slab->prev != nullptr) {
+		slab->prev->next = slab->next;
+	}
+	else {
+		sizeClass.slabsWithFreeSlots = slab->next;
+	}
+	if (slab->next != nullptr) {
+		slab->next->prev = slab->prev;
+	}
+	slab->next = nullptr;
+	slab->prev = nullptr;
+}
+
+void SlabAllocator::printStats(const MemoryStatsPrinter& printLine) const {
+	char buffer[128];
+	for (size_t c = 0; c < kNumSizeClasses; c++) {
+		const Stats& stats = classes_[c].stats;
+		snprintf(buffer, sizeof(buffer), "slab %lu: %lu slabs, %lu of %lu slots in use, peak %lu, %lu allocs, %lu failed",
+		         (unsigned long)kSizeClasses[c], (unsigned long)stats.numSlabs, (unsigned long)stats.numInUse,
+		         (unsigned long)stats.numSlots, (unsigned long)stats.peakInUse, (unsigned long)stats.numAllocs,
+		         (unsigned long)stats.numSlabFailures);
+		printLine(buffer);
+	}
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "memory/memory_region.h"
+#include "memory/memory_stats.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Small allocations - Voices' bits and pieces, ParamNodes, little arrays and the like - are made and freed all the
+ * time, including from the audio routine as notes come in. Going to the MemoryRegion for each one means a search of
+ * its empty spaces and maybe some merging of neighbours, and the time that takes varies with how fragmented things
+ * are.
+ *
+ * Instead, these get handed out from slabs: kSlabSize blocks, taken from the MemoryRegion, each cut up into slots of
+ * one size class. Each size class keeps a list of its slabs which have a free slot, and each slab a list of its free
+ * slots, so alloc() and dealloc() are both O(1) unless a new slab is needed or an empty one gets given back.
+ *
+ * Each slot has the same header word in front of it as a MemoryRegion allocation, marked SPACE_HEADER_SLAB, so
+ * GeneralMemoryAllocator::getAllocatedSize() works the same for both. Slab allocations can't be shortened or extended.
+ */
+class SlabAllocator {
+public:
+	/// Sizes are the same as MemoryRegion::padSize() would round the request up to, so nothing takes more space (or
+	/// sees a different getAllocatedSize()) for coming from a slab
+	static constexpr std::array<uint32_t, 5> kSizeClasses = {64, 128, 256, 512, 1024};
+	static constexpr size_t kNumSizeClasses = kSizeClasses.size();
+	static constexpr uint32_t kMaxSize = kSizeClasses.back();
+	static constexpr uint32_t kSlabSize = 8192;
+
+	struct Stats {
+		uint32_t numSlabs;
+		uint32_t numSlots;        // Across all slabs
+		uint32_t numInUse;        // Slots currently allocated
+		uint32_t peakInUse;       // Most slots ever allocated at once
+		uint32_t numAllocs;       // Total since boot
+		uint32_t numSlabFailures; // Times we needed a new slab and the MemoryRegion couldn't give us one
+	};
+
+	SlabAllocator(MemoryRegion& region) : region_(region) {}
+
+	/// Returns nullptr if requiredSize is too big for us, or if we needed another slab and couldn't get one
+	void* alloc(uint32_t requiredSize);
+	void dealloc(void* address);
+
+	static bool handles(uint32_t requiredSize) { return requiredSize && requiredSize <= kMaxSize; }
+
+	/// Whether address came from some SlabAllocator rather than straight from a MemoryRegion
+	static bool isSlabAllocation(void* address) {
+		uint32_t* header = static_cast<uint32_t*>(address) - 1;
+		return (*header & SPACE_TYPE_MASK) == SPACE_HEADER_SLAB;
+	}
+
+	const Stats& stats(size_t sizeClass) const { return classes_[sizeClass].stats; }
+	void printStats(const MemoryStatsPrinter& printLine) const;
+
+private:
+	struct Slab;
+	struct SizeClass {
+		Slab* slabsWithFreeSlots = nullptr;
+		Stats stats{};
+	};
+
+	Slab* newSlab(size_t sizeClass);
+	void linkSlab(SizeClass& sizeClass, Slab* slab);
+	void unlinkSlab(SizeClass& sizeClass, Slab* slab);
+
+	MemoryRegion& region_;
+	std::array<SizeClass, kNumSizeClasses> classes_{};
+};
@@ -22,13 +22,17 @@
 
 // Please see explanation of memory allocation and "stealing" at the top of GeneralMemoryAllocator.h
 
+class CacheManager;
+
 class Stealable : public BidirectionalLinkedListNode {
 public:
 	Stealable() = default;
+	~Stealable() override;
 
 	virtual bool mayBeStolen(void* thingNotToStealFrom) = 0;
 	virtual void steal(char const* errorCode) = 0; // You gotta also call the destructor after this.
 	virtual StealableQueue getAppropriateQueue() = 0;
 
 	uint32_t lastTraversalNo = 0xFFFFFFFF;
+	CacheManager* runIndexedBy = nullptr; // If we're in a CacheManager's index of stealable runs, which one
 };
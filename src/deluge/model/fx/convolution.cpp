@@ -0,0 +1,152 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "model/fx/convolution.h"
+#include "memory/memory_allocator_interface.h"
+#include "model/sample/sample.h"
+#include "model/sample/sample_reader.h"
+#include "storage/audio/audio_file_manager.h"
+#include "storage/cluster/cluster.h"
+#include <algorithm>
+
+Error Convolution::setImpulseResponseFile(String* newFilePath) {
+	filePath.set(newFilePath);
+	convolver.clear();
+	return loadImpulseResponse();
+}
+
+Error Convolution::loadImpulseResponse(bool mayReadCard) {
+	if (filePath.isEmpty() || convolver.hasImpulseResponse()) {
+		return Error::NONE;
+	}
+
+	Error error;
+	AudioFile* audioFile =
+	    audioFileManager.getAudioFileFromFilename(&filePath, mayReadCard, &error, nullptr, AudioFileType::SAMPLE);
+	if (!audioFile) {
+		return error;
+	}
+
+	// Once it's been read, the convolver has its own copy, so nothing needs to keep the Sample
+	audioFile->addReason();
+	error = readImpulseResponse((Sample*)audioFile);
+	audioFile->removeReason("E458");
+	return error;
+}
+
+Error Convolution::readImpulseResponse(Sample* sample) {
+	if (sample->numChannels < 1 || sample->numChannels > 2 || !sample->sampleRate) {
+		return Error::FILE_UNSUPPORTED;
+	}
+
+	uint64_t lengthAtOurRate = sample->lengthInSamples * kSampleRate / sample->sampleRate;
+	int32_t length = std::min<uint64_t>(lengthAtOurRate, PartitionedConvolver::kMaxLength);
+	if (!length) {
+		return Error::FILE_CORRUPTED;
+	}
+
+	int32_t* memory = (int32_t*)allocLowSpeed(length * sample->numChannels * sizeof(int32_t));
+	if (!memory) {
+		return Error::INSUFFICIENT_RAM;
+	}
+	int32_t* channels[2] = {memory, &memory[length]};
+
+	SampleReader reader;
+	reader.currentClusterIndex = -1;
+	reader.byteIndexWithinCluster = audioFileManager.clusterSize;
+	reader.currentCluster = nullptr;
+	reader.audioFile = sample;
+	reader.fileSize = sample->audioDataStartPosBytes + sample->audioDataLengthBytes;
+	reader.jumpForwardToBytePos(sample->audioDataStartPosBytes);
+
+	// The clusters' data has already been converted to native signed integers, so each sample just needs putting at
+	// the top of an int32
+	uint64_t framesLeftInFile = sample->lengthInSamples;
+	auto readFrame = [&](int32_t* frame) {
+		if (!framesLeftInFile) {
+			std::fill(frame, frame + sample->numChannels, 0);
+			return Error::NONE;
+		}
+		framesLeftInFile--;
+		for (int32_t c = 0; c < sample->numChannels; c++) {
+			int32_t value = 0;
+			Error error = reader.readBytes((char*)&value + 4 - sample->byteDepth, sample->byteDepth);
+			if (error != Error::NONE) {
+				return error;
+			}
+			frame[c] = value;
+		}
+		return Error::NONE;
+	};
+
+	// Linear interpolation. Crude next to what the sample playback does, but what's lost is mostly at the very top,
+	// and only for files that weren't recorded at our rate to begin with
+	int32_t previousFrame[2];
+	int32_t nextFrame[2];
+	Error error = readFrame(previousFrame);
+	if (error == Error::NONE) {
+		error = readFrame(nextFrame);
+	}
+	uint64_t posInFile = 0; // 32.32 fixed point
+	uint64_t stepInFile = ((uint64_t)sample->sampleRate << 32) / kSampleRate;
+	uint64_t previousFrameIndex = 0;
+
+	for (int32_t n = 0; n < length && error == Error::NONE; n++) {
+		while ((posInFile >> 32) > previousFrameIndex && error == Error::NONE) {
+			std::copy(nextFrame, nextFrame + 2, previousFrame);
+			error = readFrame(nextFrame);
+			previousFrameIndex++;
+		}
+		int64_t fraction = (posInFile & 0xFFFFFFFF) >> 1;
+		for (int32_t c = 0; c < sample->numChannels; c++) {
+			channels[c][n] = previousFrame[c] + (((int64_t)nextFrame[c] - previousFrame[c]) * fraction >> 31);
+		}
+		posInFile += stepInFile;
+	}
+
+	if (reader.currentCluster) {
+		audioFileManager.removeReasonFromCluster(reader.currentCluster, "E459");
+	}
+
+	if (error == Error::NONE) {
+		std::span<int32_t const> right;
+		if (sample->numChannels == 2) {
+			right = {channels[1], (size_t)length};
+		}
+		error = convolver.setImpulseResponse({channels[0], (size_t)length}, right);
+	}
+
+	delugeDealloc(memory);
+	return error;
+}
+
+void Convolution::cloneFrom(Convolution const& other) {
+	filePath.set(&other.filePath);
+	mix = other.mix;
+	convolver.copyImpulseResponseFrom(other.convolver); // Could fail if no RAM... not too big a concern
+}
+
+void Convolution::process(std::span<StereoSample> buffer) {
+	if (!isActive()) {
+		return;
+	}
+
+	// A linear crossfade - the wet signal is normalised, and a cabinet or room doesn't sit far from the dry's level
+	q31_t wetLevel = (ONE_Q31 / kMaxMix) * mix;
+	q31_t dryLevel = (ONE_Q31 / kMaxMix) * (kMaxMix - mix);
+	convolver.process(buffer, dryLevel, wetLevel);
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "definitions_cxx.hpp"
+#include "dsp/convolution/partitioned_convolver.h"
+#include "util/d_string.h"
+#include <cstdint>
+#include <span>
+
+class Sample;
+
+/// Convolution with an impulse response from the card - a speaker cabinet, or a room. Each ModControllableAudio has
+/// one, so it works both as a song FX and on individual clips.
+class Convolution {
+public:
+	static constexpr int32_t kMaxMix = 50;
+
+	Convolution() = default;
+
+	/// Remember the file, and load it. If it can't be loaded the file is still remembered, so that saving the song
+	/// doesn't lose it
+	Error setImpulseResponseFile(String* newFilePath);
+	/// Load whatever file was read from the song or preset, unless that's already been done
+	Error loadImpulseResponse(bool mayReadCard = true);
+	void cloneFrom(Convolution const& other);
+
+	void process(std::span<StereoSample> buffer);
+	void reset() { convolver.reset(); }
+	[[nodiscard]] bool isActive() const { return mix != 0 && convolver.hasImpulseResponse(); }
+
+	String filePath;
+	/// 0 is off, kMaxMix is only the wet signal
+	int32_t mix = kMaxMix / 2;
+
+private:
+	/// Read the Sample's audio, resampled to kSampleRate if it was recorded at some other rate
+	Error readImpulseResponse(Sample* sample);
+
+	PartitionedConvolver convolver;
+};
@@ -31,6 +31,7 @@
 #include "model/song/song.h"
 #include "modulation/params/param_set.h"
 #include "playback/playback_handler.h"
+#include "processing/stem_export/stem_export.h"
 
 extern "C" {
 #include "drivers/ssi/ssi.h"
@@ -151,7 +152,7 @@ GlobalEffectableForClip::GlobalEffectableForClip() {
 	}
 	if (recorder && recorder->status < RecorderStatus::FINISHED_CAPTURING_BUT_STILL_WRITING) {
 		// we need to double it because for reasons I don't understand audio clips max volume is half the sample volume
-		recorder->feedAudio((int32_t*)globalEffectableBuffer, numSamples, true, 2);
+		recorder->feedAudio((int32_t*)globalEffectableBuffer, numSamples, true, stemExport.getOutputRecorderGain(2));
 	}
 	addAudio(globalEffectableBuffer, outputBuffer, numSamples);
 
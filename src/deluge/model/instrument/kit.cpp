@@ -379,6 +379,8 @@ Error Kit::loadAllAudioFiles(bool mayActuallyReadFiles) {
 		}
 	}
 
+	convolution.loadImpulseResponse(mayActuallyReadFiles); // A missing impulse response just means no convolution
+
 getOut:
 	if (doingAlternatePath) {
 		audioFileManager.thingFinishedLoading();
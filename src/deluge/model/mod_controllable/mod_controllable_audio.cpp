@@ -82,6 +82,7 @@ ModControllableAudio::ModControllableAudio() {
 
 	// Saturation
 	clippingAmount = 0;
+	oversamplingMagnitude = 0;
 
 	SyncLevel syncLevel;
 	Song* song = preLoadedSong;
@@ -113,6 +114,7 @@ void ModControllableAudio::cloneFrom(ModControllableAudio* other) {
 	lpfMode = other->lpfMode;
 	hpfMode = other->hpfMode;
 	clippingAmount = other->clippingAmount;
+	oversamplingMagnitude = other->oversamplingMagnitude;
 	modFXType = other->modFXType;
 	bassFreq = other->bassFreq; // Eventually, these shouldn't be variables like this
 	trebleFreq = other->trebleFreq;
@@ -120,6 +122,7 @@ void ModControllableAudio::cloneFrom(ModControllableAudio* other) {
 	sidechain.cloneFrom(&other->sidechain);
 	midiKnobArray.cloneFrom(&other->midiKnobArray); // Could fail if no RAM... not too big a concern
 	delay = other->delay;
+	convolution.cloneFrom(other->convolution);
 }
 
 void ModControllableAudio::initParams(ParamManager* paramManager) {
@@ -209,6 +212,9 @@ void ModControllableAudio::processFX(StereoSample* buffer, int32_t numSamples, M
 		} while (++currentSample != bufferEnd);
 	}
 
+	// Convolution ----------------------------------------------------------------------------
+	convolution.process({buffer, static_cast<size_t>(numSamples)});
+
 	// Delay ----------------------------------------------------------------------------------
 	delay.process({buffer, static_cast<size_t>(numSamples)}, delayWorkingState);
 }
@@ -714,11 +720,16 @@ void ModControllableAudio::processSRRAndBitcrushing(StereoSample* buffer, int32_
 		// If not also doing SRR
 		if (!srrEnabled) {
 			uint32_t mask = 0xFFFFFFFF << (19 + (positivePreset));
-			StereoSample* __restrict__ currentSample = buffer;
-			do {
-				currentSample->l &= mask;
-				currentSample->r &= mask;
-			} while (++currentSample != bufferEnd);
+			if (oversamplingMagnitude) {
+				bitcrushOversampled(buffer, numSamples, mask);
+			}
+			else {
+				StereoSample* __restrict__ currentSample = buffer;
+				do {
+					currentSample->l &= mask;
+					currentSample->r &= mask;
+				} while (++currentSample != bufferEnd);
+			}
 		}
 
 		else {
@@ -795,6 +806,24 @@ void ModControllableAudio::processSRRAndBitcrushing(StereoSample* buffer, int32_
 	}
 }
 
+// The quantisation's harmonics land mostly above the oversampled Nyquist frequency and get filtered off, rather than
+// aliasing back down. Sample rate reduction is left as it is, since its aliasing is what it's there for
+void ModControllableAudio::bitcrushOversampled(StereoSample* buffer, int32_t numSamples, uint32_t mask) {
+	static q31_t oversampled[SSI_TX_BUFFER_NUM_SAMPLES * dsp::Oversampler::kMaxNumChannels];
+	int32_t magnitude = oversamplingMagnitude;
+
+	while (numSamples > 0) {
+		int32_t chunkSize = std::min(numSamples, dsp::Oversampler::getMaxNumSamples(magnitude));
+		bitcrushOversampler.upsample((q31_t*)buffer, chunkSize, 2, magnitude, oversampled);
+		for (int32_t i = 0; i < (chunkSize << (magnitude + 1)); i++) {
+			oversampled[i] &= mask;
+		}
+		bitcrushOversampler.downsample(oversampled, chunkSize, 2, magnitude, (q31_t*)buffer);
+		buffer += chunkSize;
+		numSamples -= chunkSize;
+	}
+}
+
 inline void ModControllableAudio::doEQ(bool doBass, bool doTreble, int32_t* inputL, int32_t* inputR, int32_t bassAmount,
                                        int32_t trebleAmount) {
 	int32_t trebleOnlyL;
@@ -837,6 +866,9 @@ void ModControllableAudio::writeAttributesToFile(Serializer& writer) {
 	if (clippingAmount) {
 		writer.writeAttribute("clippingAmount", clippingAmount);
 	}
+	if (oversamplingMagnitude) {
+		writer.writeAttribute("oversampling", oversamplingMagnitude);
+	}
 }
 
 void ModControllableAudio::writeTagsToFile(Serializer& writer) {
@@ -903,6 +935,13 @@ void ModControllableAudio::writeTagsToFile(Serializer& writer) {
 	writer.writeAttribute("compHPF", compressor.getSidechain());
 	writer.writeAttribute("compBlend", compressor.getBlend());
 	writer.closeTag();
+
+	if (!convolution.filePath.isEmpty()) {
+		writer.writeOpeningTagBeginning("convolution");
+		writer.writeAttribute("fileName", convolution.filePath.get());
+		writer.writeAttribute("mix", convolution.mix);
+		writer.closeTag();
+	}
 }
 
 void ModControllableAudio::writeParamAttributesToFile(Serializer& writer, ParamManager* paramManager,
@@ -1039,6 +1078,12 @@ Error ModControllableAudio::readTagFromFile(Deserializer& reader, char const* ta
 		reader.exitTag("clippingAmount");
 	}
 
+	else if (!strcmp(tagName, "oversampling")) {
+		oversamplingMagnitude =
+		    std::clamp<int32_t>(reader.readTagOrAttributeValueInt(), 0, dsp::Oversampler::kMaxMagnitude);
+		reader.exitTag("oversampling");
+	}
+
 	else if (!strcmp(tagName, "delay")) {
 		// Set default values in case they are not configured
 		delay.syncType = SYNC_TYPE_EVEN;
@@ -1134,6 +1179,24 @@ doReadPatchedParam:
 		}
 		reader.exitTag("AudioCompressor", true);
 	}
+	else if (!strcmp(tagName, "convolution")) {
+		reader.match('{');
+		while (*(tagName = reader.readNextTagOrAttributeName())) {
+			if (!strcmp(tagName, "fileName")) {
+				reader.readTagOrAttributeValueString(&convolution.filePath);
+				reader.exitTag("fileName");
+			}
+			else if (!strcmp(tagName, "mix")) {
+				int32_t contents = reader.readTagOrAttributeValueInt();
+				convolution.mix = std::clamp<int32_t>(contents, 0, Convolution::kMaxMix);
+				reader.exitTag("mix");
+			}
+			else {
+				reader.exitTag(tagName);
+			}
+		}
+		reader.exitTag("convolution", true);
+	}
 	// this is actually the sidechain but pre c1.1 songs save it as compressor
 	else if (!strcmp(tagName, "compressor") || !strcmp(tagName, "sidechain")) { // Remember, Song doesn't use this
 		// Set default values in case they are not configured
@@ -1692,6 +1755,8 @@ char const* ModControllableAudio::getHPFModeDisplayName() {
 // This can get called either for hibernation, or because drum now has no active noteRow
 void ModControllableAudio::wontBeRenderedForAWhile() {
 	delay.discardBuffers();
+	convolution.reset();
+	bitcrushOversampler.reset();
 	endStutter(nullptr);
 }
 
@@ -20,7 +20,9 @@
 #include "definitions_cxx.hpp"
 #include "dsp/compressor/rms_feedback.h"
 #include "dsp/delay/delay.h"
+#include "dsp/oversampling/oversampler.h"
 #include "hid/button.h"
+#include "model/fx/convolution.h"
 #include "model/fx/stutterer.h"
 #include "model/mod_controllable/filters/filter_config.h"
 #include "model/mod_controllable/mod_controllable.h"
@@ -113,8 +115,13 @@ public:
 	// Delay
 	Delay delay;
 
+	Convolution convolution;
+
 	bool sampleRateReductionOnLastTime;
 	uint8_t clippingAmount; // Song probably doesn't currently use this?
+	/// 0 for none, 1 for 2x, 2 for 4x. Applies to the drive, folding and saturation in Voices, and to bitcrushing
+	uint8_t oversamplingMagnitude;
+	deluge::dsp::Oversampler bitcrushOversampler;
 	FilterMode lpfMode;
 	FilterMode hpfMode;
 	FilterRoute filterRoute;
@@ -189,6 +196,7 @@ protected:
 private:
 	void initializeSecondaryDelayBuffer(int32_t newNativeRate, bool makeNativeRatePreciseRelativeToOtherBuffer);
 	void doEQ(bool doBass, bool doTreble, int32_t* inputL, int32_t* inputR, int32_t bassAmount, int32_t trebleAmount);
+	void bitcrushOversampled(StereoSample* buffer, int32_t numSamples, uint32_t mask);
 	ModelStackWithThreeMainThings* addNoteRowIndexAndStuff(ModelStackWithTimelineCounter* modelStack,
 	                                                       int32_t noteRowIndex);
 	void switchHPFModeWithOff();
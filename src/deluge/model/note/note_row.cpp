@@ -2369,6 +2369,11 @@ gotValidNoteIndex:
 					    nextNote->length; // Want this even if we're "skipping" playing the note (why exactly?)
 				}
 
+				// Or if it's still to come, make sure the card's had a chance to get what it'll play in time
+				else if (!muted) {
+					prefetchSamplesForNote(modelStack, newTicksTil);
+				}
+
 				ticksTilNextNoteEvent = newTicksTil;
 			}
 		}
@@ -2489,6 +2494,32 @@ void NoteRow::attemptLateStartOfNextNoteToPlay(ModelStackWithNoteRow* modelStack
 	}
 }
 
+// The Voice will only ask for each Cluster past the first kNumClustersLoadedAhead once it's playing, which for a long
+// sample that's been stolen from memory is often too late.
+void NoteRow::prefetchSamplesForNote(ModelStackWithNoteRow* modelStack, int32_t ticksTilNote) {
+	Output* output = ((InstrumentClip*)modelStack->getTimelineCounter())->output;
+
+	Sound* sound;
+	int32_t noteCode;
+	if (drum) {
+		if (drum->type != DrumType::SOUND) {
+			return;
+		}
+		sound = (SoundDrum*)drum;
+		noteCode = kNoteForDrum;
+	}
+	else if (output->type == OutputType::SYNTH) {
+		sound = (SoundInstrument*)output;
+		noteCode = getNoteCode();
+	}
+	else {
+		return;
+	}
+
+	uint64_t timeTilNote = (uint64_t)ticksTilNote * playbackHandler.getTimePerInternalTick();
+	sound->prefetchForUpcomingNote(noteCode, std::min<uint64_t>(timeTilNote, UINT32_MAX));
+}
+
 // Note may be NULL if it's a note-off, in which case you don't get lift-velocity
 void NoteRow::playNote(bool on, ModelStackWithNoteRow* modelStack, Note* thisNote, int32_t ticksLate,
                        uint32_t samplesLate, bool noteMightBeConstant, PendingNoteOnList* pendingNoteOnList) {
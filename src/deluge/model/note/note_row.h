@@ -246,6 +246,7 @@ private:
 	                  PendingNoteOnList* pendingNoteOnList = NULL);
 	void findNextNoteToPlay(uint32_t);
 	void attemptLateStartOfNextNoteToPlay(ModelStackWithNoteRow* modelStack, Note* note);
+	void prefetchSamplesForNote(ModelStackWithNoteRow* modelStack, int32_t ticksTilNote);
 	bool noteRowMayMakeSound(bool);
 	void drawTail(int32_t startTail, int32_t endTail, uint8_t squareColour[], bool overwriteExisting,
 	              uint8_t image[][3], uint8_t occupancyMask[]);
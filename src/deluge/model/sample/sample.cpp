@@ -99,6 +99,16 @@ Error Sample::initialize(int32_t newNumClusters) {
 	return clusters.insertSampleClustersAtEnd(newNumClusters);
 }
 
+// Throws away any Clusters loaded so far, for when the file turns out not to be what the Clusters will hold. There
+// mustn't be any reasons left on them.
+Error Sample::reinitializeClusters(int32_t newNumClusters) {
+	for (int32_t c = 0; c < clusters.getNumElements(); c++) {
+		clusters.getElement(c)->~SampleCluster();
+	}
+	clusters.empty();
+	return clusters.insertSampleClustersAtEnd(newNumClusters);
+}
+
 Sample::~Sample() {
 	for (int32_t c = 0; c < clusters.getNumElements(); c++) {
 		clusters.getElement(c)->~SampleCluster();
@@ -1762,7 +1772,7 @@ void Sample::numReasonsDecreasedToZero(char const* errorCode) {
 
 			numClusterReasons += cluster->numReasonsToBeLoaded;
 
-			if (cluster == audioFileManager.clusterBeingLoaded) {
+			if (audioFileManager.isClusterBeingLoaded(cluster)) {
 				numClusterReasons--;
 			}
 		}
@@ -1777,7 +1787,7 @@ void Sample::numReasonsDecreasedToZero(char const* errorCode) {
 			if (cluster) {
 				D_PRINT("cluster->numReasonsToBeLoaded[%d]", cluster->numReasonsToBeLoaded);
 
-				if (cluster == audioFileManager.clusterBeingLoaded) {
+				if (audioFileManager.isClusterBeingLoaded(cluster)) {
 					D_PRINTLN(" (loading)");
 				}
 				else if (!cluster->loaded) {
@@ -21,6 +21,9 @@
 #include "model/sample/sample_cluster.h"
 #include "model/sample/sample_cluster_array.h"
 #include "storage/audio/audio_file.h"
+#include "storage/audio/flac_decoder.h"
+#include "storage/audio/flac_seek_table.h"
+#include "storage/cluster/cluster_extent_map.h"
 #include "util/container/array/ordered_resizeable_array.h"
 #include "util/container/array/ordered_resizeable_array_with_multi_word_key.h"
 #include "util/functions.h"
@@ -50,6 +53,7 @@ public:
 
 	void workOutBitMask();
 	Error initialize(int32_t numClusters);
+	Error reinitializeClusters(int32_t newNumClusters);
 	void markAsUnloadable();
 	float determinePitch(bool doingSingleCycle, float minFreqHz, float maxFreqHz, bool doPrimeTest);
 	void workOutMIDINote(bool doingSingleCycle, float minFreqHz = 20, float maxFreqHz = 10000, bool doPrimeTest = true);
@@ -139,6 +143,16 @@ public:
 	uint32_t waveTableCycleSize; // In case this later gets used for a WaveTable
 
 	SampleClusterArray clusters;
+	/// Where the file is on the card, run by run. Each SampleCluster's sdAddress is filled in from this when loading.
+	/// Left empty for Samples being recorded, which get their addresses as they're written
+	ClusterExtentMap<> clusterExtents;
+
+	/// For a FLAC file, whose Clusters hold its decoded audio rather than what's in the file. Each one gets decoded as
+	/// it's loaded, starting from the frame the seek table gives it
+	FlacDecoder flacDecoder;
+	FlacSeekTable<> flacSeekTable;
+	uint32_t flacFileSize{0}; // Of the compressed file, for scanning it for frames the seek table doesn't have yet
+	[[nodiscard]] bool isFlac() const { return flacSeekTable.numClusters() != 0; }
 
 protected:
 #if ALPHA_OR_BETA_VERSION
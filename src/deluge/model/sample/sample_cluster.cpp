@@ -29,7 +29,7 @@ SampleCluster::~SampleCluster() {
 
 #if ALPHA_OR_BETA_VERSION
 		int32_t numReasonsToBeLoaded = cluster->numReasonsToBeLoaded;
-		if (cluster == audioFileManager.clusterBeingLoaded) {
+		if (audioFileManager.isClusterBeingLoaded(cluster)) {
 			numReasonsToBeLoaded--;
 		}
 
@@ -164,6 +164,12 @@ void SampleHolder::claimClusterReasons(bool reversed, int32_t clusterLoadInstruc
 	// unassignAllReasons(); // This now happens as part of reassessPosForMarker(), called below
 
 	int32_t playDirection = reversed ? -1 : 1;
+	uint32_t startPlaybackAtByte = getStartPlaybackAtByte(reversed);
+
+	claimClusterReasonsForMarker(clustersForStart, startPlaybackAtByte, playDirection, clusterLoadInstruction);
+}
+
+uint32_t SampleHolder::getStartPlaybackAtByte(bool reversed) {
 	int32_t bytesPerSample = audioFile->numChannels * ((Sample*)audioFile)->byteDepth;
 
 	// This code basically copied from VoiceSource::setupPlaybackBounds()
@@ -182,9 +188,7 @@ void SampleHolder::claimClusterReasons(bool reversed, int32_t clusterLoadInstruc
 		}
 	}
 
-	int32_t startPlaybackAtByte = ((Sample*)audioFile)->audioDataStartPosBytes + startPlaybackAtSample * bytesPerSample;
-
-	claimClusterReasonsForMarker(clustersForStart, startPlaybackAtByte, playDirection, clusterLoadInstruction);
+	return ((Sample*)audioFile)->audioDataStartPosBytes + startPlaybackAtSample * bytesPerSample;
 }
 
 void SampleHolder::claimClusterReasonsForMarker(Cluster** clusters, uint32_t startPlaybackAtByte, int32_t playDirection,
@@ -38,6 +38,9 @@ public:
 	int64_t getDurationInSamples(bool forTimeStretching = false);
 	void beenClonedFrom(SampleHolder const* other, bool reversed);
 	virtual void claimClusterReasons(bool reversed, int32_t clusterLoadInstruction = CLUSTER_ENQUEUE);
+	/// Byte within the file from which clustersForStart are held - a little before the start marker, to allow for a
+	/// late start
+	uint32_t getStartPlaybackAtByte(bool reversed);
 	int32_t getLengthInSamplesAtSystemSampleRate(bool forTimeStretching = false);
 	int32_t getLoopLengthAtSystemSampleRate(bool forTimeStretching = false);
 	void setAudioFile(AudioFile* newAudioFile, bool reversed = false, bool manuallySelected = false,
@@ -19,6 +19,7 @@
 #pragma GCC target("fpu=neon")
 
 #include "model/sample/sample_low_level_reader.h"
+#include "dsp/interpolation/sinc_resampler.h"
 #include "dsp/timestretch/time_stretcher.h"
 #include "hid/display/display.h"
 #include "io/debug/log.h"
@@ -27,6 +28,7 @@
 #include "model/voice/voice_sample_playback_guide.h"
 #include "storage/audio/audio_file_manager.h"
 #include "storage/cluster/cluster.h"
+#include <algorithm>
 
 #include "arm_neon.h"
 
@@ -1017,119 +1019,113 @@ void SampleLowLevelReader::readSamplesResampled(int32_t** __restrict__ oscBuffer
 
 	// Windowed sinc interpolation
 	if (interpolationBufferSize > 2) {
+		using deluge::dsp::SincResampler;
 
 		char* __restrict__ currentPlayPosNow = currentPlayPos + 2;
 
-		if (!*doneAnySamplesYet) {
-			*doneAnySamplesYet = true;
-			goto skipFirstSmooth;
+		SincResampler resampler;
+		for (int32_t c = 0; c < numChannels; c++) {
+			resampler.loadHistory((int16_t*)interpolationBuffer[c], c);
 		}
 
-		do {
-
-			if (__builtin_expect(stillGotActualData, 1)) {
+		bool skipFirstAdvance = !*doneAnySamplesYet;
+		*doneAnySamplesYet = true;
 
-				oscPos += phaseIncrement;
-				int32_t numSamplesToJumpForward = oscPos >> 24;
-				if (numSamplesToJumpForward) {
+		do {
+			int32_t numOutputs = std::min<int32_t>((oscBufferEnd - oscBufferPosNow) / numChannelsAfterCondensing,
+			                                       SincResampler::kBlockSize);
+
+			// Move along the source for each output in the block, and note where its window ends up
+			resampler.beginBlock();
+			for (int32_t k = 0; k < numOutputs; k++) {
+				if (skipFirstAdvance) {
+					skipFirstAdvance = false;
+				}
+				else {
+					oscPos += phaseIncrement;
+					int32_t numSamplesToJumpForward = oscPos >> 24;
 					oscPos &= 16777215;
 
 					// If jumping forward by more than kInterpolationMaxNumSamples, we first need to jump to the one
 					// before we're jumping forward to, to grab its value
 					if (numSamplesToJumpForward > kInterpolationMaxNumSamples) {
-						currentPlayPosNow += (numSamplesToJumpForward - kInterpolationMaxNumSamples) * jumpAmount;
+						if (stillGotActualData) {
+							currentPlayPosNow += (numSamplesToJumpForward - kInterpolationMaxNumSamples) * jumpAmount;
+						}
 						numSamplesToJumpForward = kInterpolationMaxNumSamples;
 					}
 
-					int16_t sourceL = *(int16_t*)currentPlayPosNow;
-
-					for (int32_t i = kInterpolationMaxNumSamples - 1; i >= numSamplesToJumpForward; i--) {
-						interpolationBuffer[0][0][i] = interpolationBuffer[0][0][i - numSamplesToJumpForward];
-					}
-
-					if (numChannels == 2) {
-						for (int32_t i = kInterpolationMaxNumSamples - 1; i >= numSamplesToJumpForward; i--) {
-							interpolationBuffer[1][0][i] = interpolationBuffer[1][0][i - numSamplesToJumpForward];
+					if (!stillGotActualData) [[unlikely]] {
+						for (; numSamplesToJumpForward; numSamplesToJumpForward--) {
+							resampler.pushSample(0, 0);
 						}
-
-						numSamplesToJumpForward--;
-
-						while (true) {
-							interpolationBuffer[0][0][numSamplesToJumpForward] = sourceL;
-							interpolationBuffer[1][0][numSamplesToJumpForward] =
-							    *(int16_t*)(currentPlayPosNow + byteDepth);
+					}
+					else if (numChannels == 2) {
+						for (; numSamplesToJumpForward; numSamplesToJumpForward--) {
+							resampler.pushSample(*(int16_t*)currentPlayPosNow,
+							                     *(int16_t*)(currentPlayPosNow + byteDepth));
 							currentPlayPosNow += jumpAmount;
-							if (!numSamplesToJumpForward) {
-								goto skipFirstSmooth;
-							}
-							numSamplesToJumpForward--;
-							sourceL = *(int16_t*)currentPlayPosNow;
 						}
 					}
-
 					else {
-
-						numSamplesToJumpForward--;
-
-						while (true) {
+						for (; numSamplesToJumpForward; numSamplesToJumpForward--) {
+							resampler.pushSample(*(int16_t*)currentPlayPosNow);
 							currentPlayPosNow += jumpAmount;
-							interpolationBuffer[0][0][numSamplesToJumpForward] = sourceL;
-							if (!numSamplesToJumpForward) {
-								goto skipFirstSmooth;
-							}
-							sourceL = *(int16_t*)currentPlayPosNow;
-							numSamplesToJumpForward--;
 						}
 					}
 				}
-			}
-			else {
-				jumpForwardZeroes(interpolationBufferSize, numChannels, phaseIncrement);
+				resampler.markOutput(oscPos);
 			}
 
-skipFirstSmooth:
-			int32_t sampleRead[2];
-			interpolate(sampleRead, numChannels, whichKernel);
+			int32_t samplesRead[2][SincResampler::kBlockSize];
+			resampler.renderBlock(samplesRead, numChannels, whichKernel);
 
-			int32_t existingValueL = *oscBufferPosNow;
+			for (int32_t k = 0; k < numOutputs; k++) {
+				int32_t sampleRead[2] = {samplesRead[0][k], samplesRead[1][k]};
 
-			// If caching, do that now
-			if (writingCache) {
-				for (int32_t i = 4 - kCacheByteDepth; i < 4; i++) {
-					*cacheWritePosNow = ((char*)&sampleRead[0])[i];
-					cacheWritePosNow++;
-				}
+				int32_t existingValueL = *oscBufferPosNow;
 
-				if (numChannels == 2) {
+				// If caching, do that now
+				if (writingCache) {
 					for (int32_t i = 4 - kCacheByteDepth; i < 4; i++) {
-						*cacheWritePosNow = ((char*)&sampleRead[1])[i];
+						*cacheWritePosNow = ((char*)&sampleRead[0])[i];
 						cacheWritePosNow++;
 					}
-				}
-			}
 
-			// If condensing to mono, do that now
-			if (numChannels == 2 && numChannelsAfterCondensing == 1) {
-				sampleRead[0] = ((sampleRead[0] >> 1) + (sampleRead[1] >> 1));
-			}
+					if (numChannels == 2) {
+						for (int32_t i = 4 - kCacheByteDepth; i < 4; i++) {
+							*cacheWritePosNow = ((char*)&sampleRead[1])[i];
+							cacheWritePosNow++;
+						}
+					}
+				}
 
-			*amplitude += amplitudeIncrement;
+				// If condensing to mono, do that now
+				if (numChannels == 2 && numChannelsAfterCondensing == 1) {
+					sampleRead[0] = ((sampleRead[0] >> 1) + (sampleRead[1] >> 1));
+				}
 
-			// Mono / left channel (or stereo condensed to mono)
-			*oscBufferPosNow = multiply_accumulate_32x32_rshift32_rounded(
-			    existingValueL, sampleRead[0],
-			    *amplitude); // sourceAmplitude is modified above; using accumulate made no difference
-			oscBufferPosNow++;
+				*amplitude += amplitudeIncrement;
 
-			// Right channel
-			if (numChannelsAfterCondensing == 2) {
-				int32_t existingValueR = *oscBufferPosNow;
-				*oscBufferPosNow =
-				    multiply_accumulate_32x32_rshift32_rounded(existingValueR, sampleRead[1], *amplitude);
+				// Mono / left channel (or stereo condensed to mono)
+				*oscBufferPosNow = multiply_accumulate_32x32_rshift32_rounded(
+				    existingValueL, sampleRead[0],
+				    *amplitude); // sourceAmplitude is modified above; using accumulate made no difference
 				oscBufferPosNow++;
+
+				// Right channel
+				if (numChannelsAfterCondensing == 2) {
+					int32_t existingValueR = *oscBufferPosNow;
+					*oscBufferPosNow =
+					    multiply_accumulate_32x32_rshift32_rounded(existingValueR, sampleRead[1], *amplitude);
+					oscBufferPosNow++;
+				}
 			}
 		} while (oscBufferPosNow != oscBufferEnd);
 
+		for (int32_t c = 0; c < numChannels; c++) {
+			resampler.storeHistory((int16_t*)interpolationBuffer[c], c);
+		}
 		currentPlayPos = currentPlayPosNow - 2;
 	}
 
@@ -49,6 +49,7 @@ extern uint8_t currentlyAccessingCard;
 
 SampleRecorder::~SampleRecorder() {
 	D_PRINTLN("~SampleRecorder()");
+	releaseSpareClusters();
 	if (sample != nullptr) {
 		detachSample();
 	}
@@ -111,6 +112,7 @@ Error SampleRecorder::setup(int32_t newNumChannels, AudioInputChannel newMode, b
 		return Error::INSUFFICIENT_RAM;
 	}
 	outputRecordingFrom = outputRecordingFrom_;
+	timeLastFed = AudioEngine::audioSampleTimer - 1;
 	keepingReasonsForFirstClusters = newKeepingReasons;
 	recordingExtraMargins = shouldRecordExtraMargins;
 	folderID = newFolderID;
@@ -361,6 +363,11 @@ aborted:
 
 	Error error = Error::NONE;
 
+	// Get the next Clusters ready now, while we're outside of the audio routine
+	if (status < RecorderStatus::FINISHED_CAPTURING_BUT_STILL_WRITING) {
+		topUpSpareClusters();
+	}
+
 	if (!hadCardError) {
 
 		// If file not created yet, do that
@@ -384,7 +391,9 @@ aborted:
 			// during the card access! (Though probably not anymore right?)
 			// Recording could finish or abort during this!
 			if (stemExport.processStarted) {
-				error = stemExport.getUnusedStemRecordingFilePath(&filePath, folderID);
+				// When every stem is being recorded at once, each file is named after the Output it's recording
+				error = stemExport.getUnusedStemRecordingFilePath(
+				    &filePath, folderID, (mode == AudioInputChannel::SPECIFIC_OUTPUT) ? outputRecordingFrom : nullptr);
 			}
 			else {
 				const char* name;
@@ -491,6 +500,10 @@ gotError:
 		else {
 			status = autoDeleteWhenDone ? RecorderStatus::AWAITING_DELETION : RecorderStatus::COMPLETE;
 		}
+
+		releaseSpareClusters();
+		D_PRINTLN("recording done. most unwritten clusters: %d, clusters allocated while capturing: %d",
+		          mostUnwrittenClusters, numClustersAllocatedWhileCapturing);
 	}
 
 allDoneForNow:
@@ -811,14 +824,34 @@ Error SampleRecorder::createNextCluster() {
 		return Error::MAX_FILE_SIZE_REACHED;
 	}
 
+	mostUnwrittenClusters = std::max(mostUnwrittenClusters, getNumUnwrittenClusters());
+
+	// If the card's fallen this far behind, it's not going to catch up
+	if (getNumUnwrittenClusters() > (int32_t)(kMaxUnwrittenRecordBytes >> audioFileManager.clusterSizeMagnitude)) {
+		D_PRINTLN("SampleRecorder::createNextCluster() card too far behind");
+		return Error::INSUFFICIENT_RAM;
+	}
+
 	// We need to allocate our next Cluster
 	Error error = sample->clusters.insertSampleClustersAtEnd(1);
 	if (error != Error::NONE) {
 		return error;
 	}
 
-	currentRecordCluster = sample->clusters.getElement(currentRecordClusterIndex)
-	                           ->getCluster(sample, currentRecordClusterIndex, CLUSTER_DONT_LOAD);
+	SampleCluster* sampleCluster = sample->clusters.getElement(currentRecordClusterIndex);
+
+	// Ideally the card routine already allocated one for us. It comes with its "reason" already added, just like
+	// getCluster() would have given us
+	if (std::optional<Cluster*> spareCluster = spareClusters.pop()) {
+		currentRecordCluster = *spareCluster;
+		currentRecordCluster->sample = sample;
+		currentRecordCluster->clusterIndex = currentRecordClusterIndex;
+		sampleCluster->cluster = currentRecordCluster;
+	}
+	else {
+		numClustersAllocatedWhileCapturing++;
+		currentRecordCluster = sampleCluster->getCluster(sample, currentRecordClusterIndex, CLUSTER_DONT_LOAD);
+	}
 
 	// If couldn't allocate cluster (would normally only happen if no SD card present so recording only to RAM)
 	if (!currentRecordCluster) {
@@ -847,6 +880,24 @@ Error SampleRecorder::createNextCluster() {
 	return Error::NONE;
 }
 
+// Called from the card routine, so the audio routine rarely has to allocate a Cluster itself
+void SampleRecorder::topUpSpareClusters() {
+	while (!spareClusters.full()) {
+		Cluster* cluster = audioFileManager.allocateCluster(); // Adds 1 reason
+		if (!cluster) {
+			return; // No drama - the audio routine can still try for itself when the time comes
+		}
+		spareClusters.push(cluster);
+	}
+}
+
+// Only call from outside the audio routine, or once capturing's finished
+void SampleRecorder::releaseSpareClusters() {
+	while (std::optional<Cluster*> spareCluster = spareClusters.pop()) {
+		audioFileManager.deallocateCluster(*spareCluster);
+	}
+}
+
 // Gets called when we've captured all the samples of audio that we wanted - either as a direct result of user
 // action, or after being fed a few more samples to make up for latency.
 void SampleRecorder::finishCapturing() {
@@ -864,6 +915,8 @@ void SampleRecorder::finishCapturing() {
 void SampleRecorder::feedAudio(int32_t* __restrict__ inputAddress, int32_t numSamples, bool applyGain,
                                uint8_t gainToApply) {
 
+	timeLastFed = AudioEngine::audioSampleTimer;
+
 	do {
 		int32_t numSamplesThisCycle = numSamples;
 		if (ALPHA_OR_BETA_VERSION && numSamplesThisCycle <= 0) {
@@ -1060,6 +1113,18 @@ doFinishCapturing:
 	} while (numSamples);
 }
 
+// For when the Output being recorded skipped rendering, so the recording still keeps time with everything else.
+// Same rules as feedAudio() about when this may be called
+void SampleRecorder::feedSilence(int32_t numSamples) {
+	static int32_t silence[SSI_TX_BUFFER_NUM_SAMPLES << NUM_MONO_INPUT_CHANNELS_MAGNITUDE]{};
+
+	while (numSamples && status < RecorderStatus::FINISHED_CAPTURING_BUT_STILL_WRITING) {
+		int32_t numSamplesThisCycle = std::min<int32_t>(numSamples, SSI_TX_BUFFER_NUM_SAMPLES);
+		feedAudio(silence, numSamplesThisCycle);
+		numSamples -= numSamplesThisCycle;
+	}
+}
+
 void SampleRecorder::endSyncedRecording(int32_t buttonLatencyForTempolessRecording) {
 #if ALPHA_OR_BETA_VERSION
 	if (status == RecorderStatus::CAPTURING_DATA_WAITING_TO_STOP) {
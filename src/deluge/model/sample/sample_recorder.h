@@ -20,9 +20,20 @@
 #include "definitions_cxx.hpp"
 #include "dsp/stereo_sample.h"
 #include "fatfs/fatfs.hpp"
+#include "util/container/spsc_ring.hpp"
 #include <cstddef>
 #include <optional>
 
+// How many empty Clusters the card routine keeps allocated ahead of each recording, so the audio routine doesn't
+// have to allocate one itself each time it fills one
+constexpr size_t kNumSpareRecordClusters = 4;
+// How far the card may fall behind a recording before offline rendering waits for it to catch up
+constexpr int32_t kRecordClustersBackPressureLevel = 8;
+// And if it falls this many bytes behind, the recording is abandoned, same as if we'd run out of RAM - rather than
+// letting one recording take all the RAM the rest of the song needs. In bytes rather than Clusters so that a card
+// with small Clusters can ride out a stall just as long - this is about 15 seconds of 24-bit stereo
+constexpr uint32_t kMaxUnwrittenRecordBytes = 4 * 1024 * 1024;
+
 enum class MonitoringAction {
 	NONE = 0,
 	REMOVE_RIGHT_CHANNEL = 1,
@@ -52,6 +63,7 @@ public:
 	            bool shouldRecordExtraMargins, AudioRecordingFolder newFolderID, int32_t buttonPressLatency,
 	            Output* outputRecordingFrom);
 	void feedAudio(int32_t* inputAddress, int32_t numSamples, bool applyGain = false, uint8_t gainToApply = 5);
+	void feedSilence(int32_t numSamples);
 	Error cardRoutine();
 	void endSyncedRecording(int32_t buttonLatencyForTempolessRecording);
 	bool inputLooksDifferential();
@@ -74,6 +86,9 @@ public:
 
 	uint32_t numSamplesExtraToCaptureAtEndSyncingWise;
 
+	// So we can tell whether the Output being recorded skipped rendering this time
+	uint32_t timeLastFed;
+
 	int32_t firstUnwrittenClusterIndex = 0;
 
 	// Put things in valid state so if we get destructed before any recording, it's all ok
@@ -133,6 +148,14 @@ public:
 
 	std::optional<FatFS::File> file;
 
+	// Watermark stats - the furthest the card's fallen behind this recording, and how many times the audio routine
+	// filled a Cluster with no spare one ready, so had to allocate the next itself
+	int32_t mostUnwrittenClusters = 0;
+	int32_t numClustersAllocatedWhileCapturing = 0;
+
+	int32_t getNumUnwrittenClusters() { return currentRecordClusterIndex - firstUnwrittenClusterIndex; }
+	bool isBackedUp() { return getNumUnwrittenClusters() >= kRecordClustersBackPressureLevel; }
+
 private:
 	void setExtraBytesOnPreviousCluster(Cluster* currentCluster, int32_t currentClusterIndex);
 	Error writeCluster(int32_t clusterIndex, size_t numBytes);
@@ -148,4 +171,9 @@ private:
 	void detachSample();
 	Error truncateFileDownToSize(uint32_t newFileSize);
 	Error writeOneCompletedCluster();
+	void topUpSpareClusters();
+	void releaseSpareClusters();
+
+	// Filled by the card routine, emptied by the audio routine
+	deluge::SPSCRing<Cluster*, kNumSpareRecordClusters> spareClusters;
 };
@@ -101,6 +101,36 @@ static void SetupEmulatedDisplaySetting(RuntimeFeatureSetting& setting, deluge::
 	};
 }
 
+static void SetupSamplePreloadBudgetSetting(RuntimeFeatureSetting& setting, deluge::l10n::String displayName,
+                                            std::string_view xmlName, RuntimeFeatureStateSamplePreloadBudget def) {
+	setting.displayName = displayName;
+	setting.xmlName = xmlName;
+	setting.value = static_cast<uint32_t>(def);
+
+	setting.options = {
+	    {
+	        .displayName = "Off",
+	        .value = RuntimeFeatureStateSamplePreloadBudget::NoPreload,
+	    },
+	    {
+	        .displayName = "4MB",
+	        .value = RuntimeFeatureStateSamplePreloadBudget::Preload4MB,
+	    },
+	    {
+	        .displayName = "8MB",
+	        .value = RuntimeFeatureStateSamplePreloadBudget::Preload8MB,
+	    },
+	    {
+	        .displayName = "16MB",
+	        .value = RuntimeFeatureStateSamplePreloadBudget::Preload16MB,
+	    },
+	    {
+	        .displayName = "24MB",
+	        .value = RuntimeFeatureStateSamplePreloadBudget::Preload24MB,
+	    },
+	};
+}
+
 void RuntimeFeatureSettings::init() {
 	using enum deluge::l10n::String;
 	// Drum randomizer
@@ -187,6 +217,16 @@ void RuntimeFeatureSettings::init() {
 	SetupOnOffSetting(settings[RuntimeFeatureSettingType::EnableGridViewLoopPads],
 	                  STRING_FOR_COMMUNITY_FEATURE_GRID_VIEW_LOOP_PADS, "enableGridViewLoopPads",
 	                  RuntimeFeatureStateToggle::Off);
+
+	// CacheSampleClusterMaps
+	SetupOnOffSetting(settings[RuntimeFeatureSettingType::CacheSampleClusterMaps],
+	                  STRING_FOR_COMMUNITY_FEATURE_CACHE_SAMPLE_CLUSTER_MAPS, "cacheSampleClusterMaps",
+	                  RuntimeFeatureStateToggle::Off);
+
+	// SamplePreloadBudget
+	SetupSamplePreloadBudgetSetting(settings[RuntimeFeatureSettingType::SamplePreloadBudget],
+	                                STRING_FOR_COMMUNITY_FEATURE_SAMPLE_PRELOAD_BUDGET, "samplePreloadBudget",
+	                                RuntimeFeatureStateSamplePreloadBudget::Preload16MB);
 }
 
 void RuntimeFeatureSettings::readSettingsFromFile() {
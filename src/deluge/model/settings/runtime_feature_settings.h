@@ -41,6 +41,15 @@ enum RuntimeFeatureStateSyncScalingAction : uint32_t { SyncScaling = 0, Fill = 1
 
 enum RuntimeFeatureStateEmulatedDisplay : uint32_t { Hardware = 0, Toggle = 1, OnBoot = 2 };
 
+/// In megabytes. The SDRAM is 64MB, and everything else needs its share, so the biggest option stays well short of that
+enum RuntimeFeatureStateSamplePreloadBudget : uint32_t {
+	NoPreload = 0,
+	Preload4MB = 4,
+	Preload8MB = 8,
+	Preload16MB = 16,
+	Preload24MB = 24
+};
+
 /// Every setting needs to be declared in here
 enum RuntimeFeatureSettingType : uint32_t {
 	DrumRandomizer,
@@ -64,6 +73,8 @@ enum RuntimeFeatureSettingType : uint32_t {
 	DisplayChordKeyboard,
 	AlternativePlaybackStartBehaviour,
 	EnableGridViewLoopPads,
+	CacheSampleClusterMaps,
+	SamplePreloadBudget,
 	MaxElement // Keep as boundary
 };
 
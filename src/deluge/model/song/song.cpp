@@ -2273,6 +2273,8 @@ readClip:
 // this is called, because this will open other (sample) files
 void Song::loadAllSamples(bool mayActuallyReadFiles) {
 
+	globalEffectable.convolution.loadImpulseResponse(mayActuallyReadFiles);
+
 	for (Output* thisOutput = firstOutput; thisOutput; thisOutput = thisOutput->next) {
 		thisOutput->loadAllAudioFiles(mayActuallyReadFiles);
 	}
@@ -2402,6 +2404,13 @@ void Song::renderAudio(StereoSample* outputBuffer, int32_t numSamples, int32_t*
 		if (recorder->mode == AudioInputChannel::MIX) {
 			recorder->feedAudio((int32_t*)outputBuffer, numSamples, true);
 		}
+
+		// An Output that skipped rendering didn't feed its recorder, but the recording still has to keep time - stems
+		// exported together have to line up
+		else if (recorder->mode == AudioInputChannel::SPECIFIC_OUTPUT
+		         && recorder->timeLastFed != AudioEngine::audioSampleTimer) {
+			recorder->feedSilence(numSamples);
+		}
 	}
 
 	Delay::State delayWorkingState = globalEffectable.createDelayWorkingState(paramManager);
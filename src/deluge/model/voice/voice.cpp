@@ -21,7 +21,9 @@
 #include "dsp/dx/engine.h"
 #include "dsp/filter/filter_set.h"
 #include "dsp/timestretch/time_stretcher.h"
+#include "dsp/unison_oscillator.h"
 #include "dsp/util.hpp"
+#include "dsp/voice_output.h"
 #include "gui/waveform/waveform_renderer.h"
 #include "io/debug/log.h"
 #include "memory/general_memory_allocator.h"
@@ -65,6 +67,11 @@ namespace params = deluge::modulation::params;
 PLACE_INTERNAL_FRUNK int32_t spareRenderingBuffer[4][SSI_TX_BUFFER_NUM_SAMPLES]
     __attribute__((aligned(CACHE_LINE_SIZE)));
 
+// One per lane of a dsp::VoiceBatch. Stereo-sized, since a voice's oscillators may render in stereo before it finds out
+// it can't be batched after all
+PLACE_INTERNAL_FRUNK int32_t voiceBatchRenderingBuffer[dsp::VoiceBatch::kNumLanes][SSI_TX_BUFFER_NUM_SAMPLES * 2]
+    __attribute__((aligned(CACHE_LINE_SIZE)));
+
 PLACE_INTERNAL_FRUNK int32_t oscSyncRenderingBuffer[SSI_TX_BUFFER_NUM_SAMPLES + 4]
     __attribute__((aligned(CACHE_LINE_SIZE))); // Hopefully I could make this use the spareRenderingBuffer instead...
 
@@ -111,6 +118,17 @@ void Voice::unassignStuff(bool deletingSong) {
 
 uint32_t lastSoundOrder = 0;
 
+// Whether any of the nonlinear stuff could do anything during the note. Fold counts if it's up now, or if it could come
+// up because something's patched to it or it's automated
+bool Voice::mayBeNonlinear(Sound* sound, ParamManagerForTimeline* paramManager) {
+	if (sound->clippingAmount || sound->lpfMode == FilterMode::TRANSISTOR_24DB_DRIVE) {
+		return true;
+	}
+	return paramFinalValues[params::LOCAL_FOLD] > 0
+	       || paramManager->getPatchedParamSet()->params[params::LOCAL_FOLD].isAutomated()
+	       || paramManager->getPatchCableSet()->doesParamHaveSomethingPatchedToIt(params::LOCAL_FOLD);
+}
+
 // Returns false if fail and we need to unassign again
 bool Voice::noteOn(ModelStackWithVoice* modelStack, int32_t newNoteCodeBeforeArpeggiation,
                    int32_t newNoteCodeAfterArpeggiation, uint8_t velocity, uint32_t newSampleSyncLength,
@@ -177,6 +195,7 @@ bool Voice::noteOn(ModelStackWithVoice* modelStack, int32_t newNoteCodeBeforeArp
 		doneFirstRender = false;
 
 		filterSet.reset();
+		oversampler.reset();
 
 		lastSaturationTanHWorkingValue[0] = 2147483648;
 		lastSaturationTanHWorkingValue[1] = 2147483648;
@@ -213,6 +232,13 @@ bool Voice::noteOn(ModelStackWithVoice* modelStack, int32_t newNoteCodeBeforeArp
 		for (int32_t s = 0; s < kNumSources; s++) {
 			sourceWaveIndexesLastTime[s] = paramFinalValues[params::LOCAL_OSC_A_WAVE_INDEX + s];
 		}
+
+		// Oversampling only does anything for the nonlinear stuff, so a voice which can't have any pays nothing for
+		// it. This is decided for the whole note, since switching it mid-note would click
+		oversamplingMagnitude = 0;
+		if (sound->oversamplingMagnitude && mayBeNonlinear(sound, paramManager)) {
+			oversamplingMagnitude = sound->oversamplingMagnitude;
+		}
 	}
 
 	// Make all VoiceUnisonPartSources "active" by default
@@ -705,7 +731,7 @@ uint32_t Voice::getLocalLFOPhaseIncrement() {
 // Returns false if became inactive and needs unassigning
 [[gnu::hot]] bool Voice::render(ModelStackWithVoice* modelStack, int32_t* soundBuffer, int32_t numSamples,
                                 bool soundRenderingInStereo, bool applyingPanAtVoiceLevel, uint32_t sourcesChanged,
-                                bool doLPF, bool doHPF, int32_t externalPitchAdjust) {
+                                bool doLPF, bool doHPF, int32_t externalPitchAdjust, dsp::VoiceBatch* batch) {
 
 	GeneralMemoryAllocator::get().checkStack("Voice::render");
 
@@ -973,9 +999,12 @@ skipAutoRelease: {}
 	// Checking if filters should run now happens within the filterset
 	FilterMode lpfMode = doLPF ? sound->lpfMode : FilterMode::OFF;
 	FilterMode hpfMode = doHPF ? sound->hpfMode : FilterMode::OFF;
+
+	// If oversampling, the filters run at the higher rate, so their frequencies need scaling down to match
 	filterGain = filterSet.setConfig(
-	    paramFinalValues[params::LOCAL_LPF_FREQ], paramFinalValues[params::LOCAL_LPF_RESONANCE], lpfMode,
-	    paramFinalValues[params::LOCAL_LPF_MORPH], paramFinalValues[params::LOCAL_HPF_FREQ],
+	    paramFinalValues[params::LOCAL_LPF_FREQ] >> oversamplingMagnitude,
+	    paramFinalValues[params::LOCAL_LPF_RESONANCE], lpfMode, paramFinalValues[params::LOCAL_LPF_MORPH],
+	    paramFinalValues[params::LOCAL_HPF_FREQ] >> oversamplingMagnitude,
 	    (paramFinalValues[params::LOCAL_HPF_RESONANCE]), // >> StorageManager::devVarA) << StorageManager::devVarA,
 	    hpfMode, paramFinalValues[params::LOCAL_HPF_MORPH], sound->volumeNeutralValueForUnison << 1, sound->filterRoute,
 	    false, nullptr); // Level adjustment for unison now happens *before* the filter!
@@ -1101,8 +1130,9 @@ skipAutoRelease: {}
 	int32_t amplitudeL, amplitudeR;
 	bool doPanning;
 
-	// two first indicies are reserved in case we need stereo for unison spread
-	oscBuffer = spareRenderingBuffer[0];
+	// two first indicies are reserved in case we need stereo for unison spread. If we're part of a batch, render
+	// straight into our lane so the batch can do the mixing if we turn out to be a plain mono voice
+	oscBuffer = batch ? batch->buffer() : spareRenderingBuffer[0];
 	int32_t channels = stereoUnison ? 2 : 1;
 
 	int32_t const* const oscBufferEnd = oscBuffer + numSamples * channels;
@@ -1472,74 +1502,25 @@ carriersDone: {}
 skipUnisonPart: {}
 	}
 
+	// If oversampling, the amplitude has to go on before the saturation, at the higher rate too
+	bool saturateOversampled = oversamplingMagnitude && sound->clippingAmount;
+	bool applyAmplitude = synthMode != SynthMode::FM && !saturateOversampled;
+	bool saturate = sound->clippingAmount && !saturateOversampled;
+
 	if (didStereoTempBuffer) {
 		int32_t* const oscBufferEnd = oscBuffer + (numSamples << 1);
-		// fold
-		if (paramFinalValues[params::LOCAL_FOLD] > 0) {
-			dsp::foldBufferPolyApproximation(oscBuffer, oscBufferEnd, paramFinalValues[params::LOCAL_FOLD]);
+		if (oversamplingMagnitude) {
+			renderOversampled(sound, oscBuffer, numSamples, 2, oversamplingMagnitude,
+			                  paramFinalValues[params::LOCAL_FOLD], synthMode != SynthMode::FM,
+			                  overallOscAmplitudeLastTime, overallOscillatorAmplitudeIncrement);
 		}
-		// Filters
-		filterSet.renderLongStereo(oscBuffer, oscBufferEnd);
-
-		// No clipping
-		if (!sound->clippingAmount) {
-
-			int32_t const* __restrict__ oscBufferPos = oscBuffer; // For traversal
-			StereoSample* __restrict__ outputSample = (StereoSample*)soundBuffer;
-			int32_t overallOscAmplitudeNow = overallOscAmplitudeLastTime;
-
-			do {
-				int32_t outputSampleL = *(oscBufferPos++);
-				int32_t outputSampleR = *(oscBufferPos++);
-
-				overallOscAmplitudeNow += overallOscillatorAmplitudeIncrement;
-				if (synthMode != SynthMode::FM) {
-					outputSampleL = multiply_32x32_rshift32_rounded(outputSampleL, overallOscAmplitudeNow) << 1;
-					outputSampleR = multiply_32x32_rshift32_rounded(outputSampleR, overallOscAmplitudeNow) << 1;
-				}
-
-				// Write to the output buffer, panning or not
-				if (doPanning) {
-					outputSample->addPannedStereo(outputSampleL, outputSampleR, amplitudeL, amplitudeR);
-				}
-				else {
-					outputSample->addStereo(outputSampleL, outputSampleR);
-				}
-
-				outputSample++;
-			} while (oscBufferPos != oscBufferEnd);
-		}
-
-		// Yes clipping
 		else {
-
-			int32_t const* __restrict__ oscBufferPos = oscBuffer; // For traversal
-			StereoSample* __restrict__ outputSample = (StereoSample*)soundBuffer;
-			int32_t overallOscAmplitudeNow = overallOscAmplitudeLastTime;
-
-			do {
-				int32_t outputSampleL = *(oscBufferPos++);
-				int32_t outputSampleR = *(oscBufferPos++);
-
-				overallOscAmplitudeNow += overallOscillatorAmplitudeIncrement;
-				if (synthMode != SynthMode::FM) {
-					outputSampleL = multiply_32x32_rshift32_rounded(outputSampleL, overallOscAmplitudeNow) << 1;
-					outputSampleR = multiply_32x32_rshift32_rounded(outputSampleR, overallOscAmplitudeNow) << 1;
-				}
-
-				sound->saturate(&outputSampleL, &lastSaturationTanHWorkingValue[0]);
-				sound->saturate(&outputSampleR, &lastSaturationTanHWorkingValue[1]);
-
-				// Write to the output buffer, panning or not
-				if (doPanning) {
-					outputSample->addPannedStereo(outputSampleL, outputSampleR, amplitudeL, amplitudeR);
-				}
-				else {
-					outputSample->addStereo(outputSampleL, outputSampleR);
-				}
-
-				outputSample++;
-			} while (oscBufferPos != oscBufferEnd);
+			// fold
+			if (paramFinalValues[params::LOCAL_FOLD] > 0) {
+				dsp::foldBufferPolyApproximation(oscBuffer, oscBufferEnd, paramFinalValues[params::LOCAL_FOLD]);
+			}
+			// Filters
+			filterSet.renderLongStereo(oscBuffer, oscBufferEnd);
 		}
 	}
 	else {
@@ -1555,78 +1536,52 @@ skipUnisonPart: {}
 		*/
 
 		int32_t* const oscBufferEnd = oscBuffer + numSamples;
-		// wavefolding pre filter
-		if (paramFinalValues[params::LOCAL_FOLD] > 0) {
-			q31_t foldAmount = paramFinalValues[params::LOCAL_FOLD];
+		// Plain mono voice - let the batch apply our amplitude and mix us in along with the Sound's other voices
+		bool batching =
+		    batch && !sound->clippingAmount && synthMode != SynthMode::FM && !(soundRenderingInStereo && doPanning);
+		dsp::filter::SVFilter* batchedFilter = nullptr;
 
-			dsp::foldBufferPolyApproximation(oscBuffer, oscBufferEnd, foldAmount);
+		if (oversamplingMagnitude) {
+			renderOversampled(sound, oscBuffer, numSamples, 1, oversamplingMagnitude,
+			                  paramFinalValues[params::LOCAL_FOLD], synthMode != SynthMode::FM,
+			                  overallOscAmplitudeLastTime, overallOscillatorAmplitudeIncrement);
 		}
-
-		filterSet.renderLong(oscBuffer, oscBufferEnd, numSamples);
-
-		// No clipping
-		if (!sound->clippingAmount) {
-			int32_t const* __restrict__ oscBufferPos = oscBuffer; // For traversal
-			int32_t* __restrict__ outputSample = soundBuffer;
-			int32_t overallOscAmplitudeNow = overallOscAmplitudeLastTime;
-
-			do {
-				int32_t output = *oscBufferPos;
-
-				if (synthMode != SynthMode::FM) {
-					overallOscAmplitudeNow += overallOscillatorAmplitudeIncrement;
-					output = multiply_32x32_rshift32_rounded(output, overallOscAmplitudeNow) << 1;
-				}
-
-				if (soundRenderingInStereo) {
-					if (doPanning) {
-						((StereoSample*)outputSample)->addPannedMono(output, amplitudeL, amplitudeR);
-					}
-					else {
-						((StereoSample*)outputSample)->addMono(output);
-					}
-					outputSample += 2;
-				}
-				else {
-					*outputSample += output;
-					outputSample++;
-				}
-			} while (++oscBufferPos != oscBufferEnd);
-		}
-
-		// Yes clipping
 		else {
-			int32_t const* __restrict__ oscBufferPos = oscBuffer; // For traversal
-			int32_t* __restrict__ outputSample = soundBuffer;
-			int32_t overallOscAmplitudeNow = overallOscAmplitudeLastTime;
-
-			do {
-				int32_t output = *oscBufferPos;
+			// wavefolding pre filter
+			if (paramFinalValues[params::LOCAL_FOLD] > 0) {
+				q31_t foldAmount = paramFinalValues[params::LOCAL_FOLD];
 
-				if (synthMode != SynthMode::FM) {
-					overallOscAmplitudeNow += overallOscillatorAmplitudeIncrement;
-					output = multiply_32x32_rshift32_rounded(output, overallOscAmplitudeNow) << 1;
-				}
+				dsp::foldBufferPolyApproximation(oscBuffer, oscBufferEnd, foldAmount);
+			}
 
-				sound->saturate(&output, &lastSaturationTanHWorkingValue[0]);
+			// A lone SVF can go in the batch too, to run alongside another voice's
+			if (batching) {
+				batchedFilter = filterSet.getLoneSVF();
+			}
+			if (!batchedFilter) {
+				filterSet.renderLong(oscBuffer, oscBufferEnd, numSamples);
+			}
+		}
 
-				if (soundRenderingInStereo) {
-					if (doPanning) {
-						((StereoSample*)outputSample)->addPannedMono(output, amplitudeL, amplitudeR);
-					}
-					else {
-						((StereoSample*)outputSample)->addMono(output);
-					}
-					outputSample += 2;
-				}
-				else {
-					*outputSample += output;
-					outputSample++;
-				}
-			} while (++oscBufferPos != oscBufferEnd);
+		if (batching) {
+			batch->commit(overallOscAmplitudeLastTime, overallOscillatorAmplitudeIncrement, batchedFilter);
+			goto renderingDone;
 		}
 	}
 
+	// Amplitude, saturation and panning, then into the Sound's buffer - with a loop made for whichever of those apply
+	{
+		dsp::VoiceOutputParams outputParams{overallOscAmplitudeLastTime,
+		                                    overallOscillatorAmplitudeIncrement,
+		                                    amplitudeL,
+		                                    amplitudeR,
+		                                    sound->clippingAmount,
+		                                    lastSaturationTanHWorkingValue};
+		dsp::VoiceOutputFunction renderOutput = dsp::getVoiceOutputFunction(
+		    didStereoTempBuffer, soundRenderingInStereo, applyAmplitude, saturate, doPanning);
+		renderOutput(oscBuffer, soundBuffer, numSamples, outputParams);
+	}
+
 renderingDone:
 
 	for (int32_t s = 0; s < kNumSources; s++) {
@@ -1641,6 +1596,49 @@ renderingDone:
 	return !unassignVoiceAfter;
 }
 
+// The folding, filters and saturation, at 2x or 4x the sample rate. Done a chunk at a time so the oversampled audio
+// never needs more room than a normal render window's worth of stereo, which is what the filters' buffers allow for
+void Voice::renderOversampled(Sound* sound, int32_t* oscBuffer, int32_t numSamples, int32_t numChannels,
+                              int32_t magnitude, q31_t foldAmount, bool applyAmplitude, int32_t amplitude,
+                              int32_t amplitudeIncrement) {
+	static q31_t oversampled[SSI_TX_BUFFER_NUM_SAMPLES * dsp::Oversampler::kMaxNumChannels];
+	int32_t maxChunkSize = dsp::Oversampler::getMaxNumSamples(magnitude);
+	amplitudeIncrement >>= magnitude;
+
+	for (int32_t pos = 0; pos < numSamples; pos += maxChunkSize) {
+		int32_t chunkSize = std::min(numSamples - pos, maxChunkSize);
+		int32_t numOversampled = chunkSize << magnitude;
+		int32_t* chunk = &oscBuffer[pos * numChannels];
+		q31_t* const oversampledEnd = oversampled + numOversampled * numChannels;
+
+		oversampler.upsample(chunk, chunkSize, numChannels, magnitude, oversampled);
+
+		if (foldAmount > 0) {
+			dsp::foldBufferPolyApproximation(oversampled, oversampledEnd, foldAmount);
+		}
+		if (numChannels == 2) {
+			filterSet.renderLongStereo(oversampled, oversampledEnd);
+		}
+		else {
+			filterSet.renderLong(oversampled, oversampledEnd, numOversampled);
+		}
+
+		if (sound->clippingAmount) {
+			for (q31_t* sample = oversampled; sample != oversampledEnd; sample += numChannels) {
+				amplitude += amplitudeIncrement;
+				for (int32_t c = 0; c < numChannels; c++) {
+					if (applyAmplitude) {
+						sample[c] = multiply_32x32_rshift32_rounded(sample[c], amplitude) << 1;
+					}
+					sound->saturate(&sample[c], &lastSaturationTanHWorkingValue[c]);
+				}
+			}
+		}
+
+		oversampler.downsample(oversampled, chunkSize, numChannels, magnitude, chunk);
+	}
+}
+
 bool Voice::areAllUnisonPartsInactive(ModelStackWithVoice* modelStack) {
 	// If no noise-source, then it might be time to unassign the voice...
 	if (!modelStack->paramManager->getPatchedParamSet()->params[params::LOCAL_NOISE_VOLUME].containsSomething(
@@ -1985,6 +1983,13 @@ void Voice::renderBasicSource(Sound* sound, ParamManagerForTimeline* paramManage
 
 	GeneralMemoryAllocator::get().checkStack("Voice::renderBasicSource");
 
+	// The most common unison stacks get rendered all together
+	if (!doOscSync && !getOutAfterPhaseIncrements
+	    && renderUnisonWave(sound, s, oscBuffer, numSamples, stereoBuffer, sourceAmplitude, amplitudeIncrement,
+	                        overallPitchAdjust, getPhaseIncrements)) {
+		return;
+	}
+
 	// For each unison part
 	for (int32_t u = 0; u < sound->numUnison; u++) {
 
@@ -2479,123 +2484,6 @@ dontUseCache: {}
 CREATE_WAVE_RENDER_FUNCTION_INSTANCE(renderWave, waveRenderingFunctionGeneral);
 CREATE_WAVE_RENDER_FUNCTION_INSTANCE(renderPulseWave, waveRenderingFunctionPulse);
 
-// Experiment. It goes basically exactly the same speed as the non-vector one.
-/*
-void renderCrudeSawWaveWithAmplitude(int32_t* __restrict__ thisSample, int32_t const* bufferEnd, uint32_t phaseNowNow,
-uint32_t phaseIncrementNow, int32_t amplitude, int32_t amplitudeIncrement, int32_t numSamples) {
-
-    int32x4_t existingDataInBuffer = vld1q_s32(thisSample);
-
-    uint32x4_t phaseVector;
-    for (int32_t i = 0; i < 4; i++) {
-        phaseNowNow += phaseIncrementNow;
-        phaseVector = vsetq_lane_u32(phaseNowNow, phaseVector, i);
-    }
-    uint32x4_t phaseIncrementVector = vdupq_n_u32(phaseIncrementNow << 2);
-
-    SETUP_FOR_APPLYING_AMPLITUDE_WITH_VECTORS();
-
-    bufferEnd -= 4;
-
-    while (true) {
-        int32x4_t valueVector = vqdmulhq_s32(amplitudeVector, vreinterpretq_s32_u32(phaseVector));
-        valueVector = vaddq_s32(valueVector, existingDataInBuffer);
-        vst1q_s32(thisSample, valueVector);
-        if (thisSample >= bufferEnd) break;
-        thisSample += 4;
-        existingDataInBuffer = vld1q_s32(thisSample);
-        phaseVector = vaddq_u32(phaseVector, phaseIncrementVector);
-        amplitudeVector = vaddq_s32(amplitudeVector, amplitudeIncrementVector);
-    }
-}
-*/
-
-uint32_t renderCrudeSawWaveWithAmplitude(int32_t* thisSample, int32_t* bufferEnd, uint32_t phaseNowNow,
-                                         uint32_t phaseIncrementNow, int32_t amplitudeNow, int32_t amplitudeIncrement,
-                                         int32_t numSamples) {
-
-	int32_t* remainderSamplesEnd = thisSample + (numSamples & 3);
-
-	while (thisSample != remainderSamplesEnd) {
-		phaseNowNow += phaseIncrementNow;
-		amplitudeNow += amplitudeIncrement;
-		*thisSample = multiply_accumulate_32x32_rshift32_rounded(*thisSample, (int32_t)phaseNowNow, amplitudeNow);
-		++thisSample;
-	}
-
-	while (thisSample != bufferEnd) {
-		phaseNowNow += phaseIncrementNow;
-		amplitudeNow += amplitudeIncrement;
-		*thisSample = multiply_accumulate_32x32_rshift32_rounded(*thisSample, (int32_t)phaseNowNow, amplitudeNow);
-		++thisSample;
-
-		phaseNowNow += phaseIncrementNow;
-		amplitudeNow += amplitudeIncrement;
-		*thisSample = multiply_accumulate_32x32_rshift32_rounded(*thisSample, (int32_t)phaseNowNow, amplitudeNow);
-		++thisSample;
-
-		phaseNowNow += phaseIncrementNow;
-		amplitudeNow += amplitudeIncrement;
-		*thisSample = multiply_accumulate_32x32_rshift32_rounded(*thisSample, (int32_t)phaseNowNow, amplitudeNow);
-		++thisSample;
-
-		phaseNowNow += phaseIncrementNow;
-		amplitudeNow += amplitudeIncrement;
-		*thisSample = multiply_accumulate_32x32_rshift32_rounded(*thisSample, (int32_t)phaseNowNow, amplitudeNow);
-		++thisSample;
-	}
-
-	return phaseNowNow;
-}
-
-uint32_t renderCrudeSawWaveWithoutAmplitude(int32_t* thisSample, int32_t* bufferEnd, uint32_t phaseNowNow,
-                                            uint32_t phaseIncrementNow, int32_t numSamples) {
-
-	int32_t* remainderSamplesEnd = thisSample + (numSamples & 7);
-
-	while (thisSample != remainderSamplesEnd) {
-		phaseNowNow += phaseIncrementNow;
-		*thisSample = (int32_t)phaseNowNow >> 1;
-		++thisSample;
-	}
-
-	while (thisSample != bufferEnd) {
-		phaseNowNow += phaseIncrementNow;
-		*thisSample = (int32_t)phaseNowNow >> 1;
-		++thisSample;
-
-		phaseNowNow += phaseIncrementNow;
-		*thisSample = (int32_t)phaseNowNow >> 1;
-		++thisSample;
-
-		phaseNowNow += phaseIncrementNow;
-		*thisSample = (int32_t)phaseNowNow >> 1;
-		++thisSample;
-
-		phaseNowNow += phaseIncrementNow;
-		*thisSample = (int32_t)phaseNowNow >> 1;
-		++thisSample;
-
-		phaseNowNow += phaseIncrementNow;
-		*thisSample = (int32_t)phaseNowNow >> 1;
-		++thisSample;
-
-		phaseNowNow += phaseIncrementNow;
-		*thisSample = (int32_t)phaseNowNow >> 1;
-		++thisSample;
-
-		phaseNowNow += phaseIncrementNow;
-		*thisSample = (int32_t)phaseNowNow >> 1;
-		++thisSample;
-
-		phaseNowNow += phaseIncrementNow;
-		*thisSample = (int32_t)phaseNowNow >> 1;
-		++thisSample;
-	}
-
-	return phaseNowNow;
-}
-
 // Not used, obviously. Just experimenting.
 void renderPDWave(const int16_t* table, const int16_t* secondTable, int32_t numBitsInTableSize,
                   int32_t numBitsInSecondTableSize, int32_t amplitude, int32_t* thisSample, int32_t* bufferEnd,
@@ -2760,6 +2648,112 @@ const int16_t* analogSawTables[] = {
     mysterySynthBSaw_53,   mysterySynthBSaw_39,   mysterySynthBSaw_27,  mysterySynthBSaw_19,  mysterySynthBSaw_13,
     mysterySynthBSaw_9,    mysterySynthBSaw_7,    mysterySynthBSaw_5,   mysterySynthBSaw_3,   mysterySynthBSaw_1};
 
+// For a unison stack of saws or squares with no pulse width, this renders all the parts in one go, with the unison
+// stereo spread, choosing each part's table just as renderOsc() would. Returns false, having changed nothing, if it
+// can't - for any other wave, or if the parts don't all want the same kind of rendering (one part pitched low enough
+// for the crude saw and another not, say), and renderBasicSource() then renders the parts one by one.
+bool Voice::renderUnisonWave(Sound* sound, int32_t s, int32_t* oscBuffer, int32_t numSamples, bool stereoBuffer,
+                             int32_t sourceAmplitude, int32_t amplitudeIncrement, int32_t overallPitchAdjust,
+                             uint32_t* getPhaseIncrements) {
+	using deluge::dsp::UnisonOscillator;
+
+	OscType type = sound->sources[s].oscType;
+	if (!sound->getOscKernels(s).unisonWave || paramFinalValues[params::LOCAL_OSC_A_PHASE_WIDTH + s]) {
+		return false;
+	}
+
+	uint32_t phaseIncrements[kMaxNumVoicesUnison];
+	int16_t const* tables[kMaxNumVoicesUnison];
+	int32_t tableSizeMagnitudes[kMaxNumVoicesUnison];
+	UnisonOscillator::Wave wave = UnisonOscillator::Wave::TABLE;
+	bool anyPartsYet = false;
+
+	for (int32_t u = 0; u < sound->numUnison; u++) {
+		if (!unisonParts[u].sources[s].active) {
+			return false;
+		}
+
+		uint32_t phaseIncrement = unisonParts[u].sources[s].phaseIncrementStoredValue;
+		if (!adjustPitch(&phaseIncrement, overallPitchAdjust)
+		    || !adjustPitch(&phaseIncrement, paramFinalValues[params::LOCAL_OSC_A_PITCH_ADJUST + s])) {
+			phaseIncrement = 0; // Pitch too high - this part is skipped
+		}
+		phaseIncrements[u] = phaseIncrement;
+		if (!phaseIncrement) {
+			continue;
+		}
+
+		int32_t tableNumber;
+		getTableNumber(phaseIncrement, &tableNumber, &tableSizeMagnitudes[u]);
+		bool crude = tableNumber < AudioEngine::cpuDireness + 6;
+
+		UnisonOscillator::Wave partWave = UnisonOscillator::Wave::TABLE;
+		tables[u] = nullptr;
+		if (type == OscType::SAW) {
+			if (crude) {
+				partWave = UnisonOscillator::Wave::CRUDE_SAW;
+			}
+			else {
+				tables[u] = sawTables[tableNumber];
+			}
+		}
+		else if (type == OscType::SQUARE) {
+			if (crude) {
+				partWave = UnisonOscillator::Wave::CRUDE_SQUARE;
+			}
+			else {
+				tables[u] = squareTables[tableNumber];
+			}
+		}
+		else if (type == OscType::ANALOG_SAW_2) {
+			// Swapped for the digital saw when the CPU load is dire, as in renderOsc()
+			if (crude && tableNumber >= 8) {
+				partWave = UnisonOscillator::Wave::CRUDE_SAW;
+			}
+			else {
+				tables[u] = analogSawTables[tableNumber];
+			}
+		}
+		else {
+			tables[u] = analogSquareTables[tableNumber];
+		}
+
+		if (anyPartsYet && partWave != wave) {
+			return false;
+		}
+		wave = partWave;
+		anyPartsYet = true;
+	}
+
+	if (getPhaseIncrements) {
+		memcpy(getPhaseIncrements, phaseIncrements, sound->numUnison * sizeof(uint32_t));
+	}
+	if (!anyPartsYet) {
+		return true;
+	}
+
+	bool stereoUnison = sound->unisonStereoSpread && stereoBuffer;
+	UnisonOscillator unison;
+	int32_t whichPart[kMaxNumVoicesUnison];
+	for (int32_t u = 0; u < sound->numUnison; u++) {
+		if (phaseIncrements[u]) {
+			int32_t amplitudeL, amplitudeR;
+			shouldDoPanning((stereoUnison ? sound->unisonPan[u] : 0), &amplitudeL, &amplitudeR);
+			whichPart[u] = unison.addPart(unisonParts[u].sources[s].oscPos, phaseIncrements[u], tables[u],
+			                              tableSizeMagnitudes[u], amplitudeL, amplitudeR);
+		}
+	}
+
+	unison.render(wave, oscBuffer, numSamples, stereoBuffer, sourceAmplitude, amplitudeIncrement);
+
+	for (int32_t u = 0; u < sound->numUnison; u++) {
+		if (phaseIncrements[u]) {
+			unisonParts[u].sources[s].oscPos = unison.getPhase(whichPart[u]);
+		}
+	}
+	return true;
+}
+
 __attribute__((optimize("unroll-loops"))) void
 Voice::renderOsc(int32_t s, OscType type, int32_t amplitude, int32_t* bufferStart, int32_t* bufferEnd,
                  int32_t numSamples, uint32_t phaseIncrement, uint32_t pulseWidth, uint32_t* startPhase,
@@ -2774,7 +2768,7 @@ Voice::renderOsc(int32_t s, OscType type, int32_t amplitude, int32_t* bufferStar
 
 	bool doPulseWave = false;
 
-	int32_t resetterDivideByPhaseIncrement;
+	int32_t resetterDivideByPhaseIncrement = 0; // Only worked out if syncing
 	const int16_t* table;
 
 	// For cases other than sines and triangles, we use these standard table lookup size thingies. We need to work this
@@ -2907,59 +2901,7 @@ doSine:
 	else if (type == OscType::TRIANGLE) {
 
 		if (phaseIncrement < 69273666 || AudioEngine::cpuDireness >= 7) {
-			if (doOscSync) {
-
-				int32_t amplitudeNow = amplitude << 1;
-				uint32_t phaseNow = phase;
-				int32_t* thisSample = bufferStart;
-				uint32_t resetterPhaseNow = resetterPhase;
-				amplitudeIncrement <<= 1;
-				do {
-					phaseNow += phaseIncrement;
-					resetterPhaseNow += resetterPhaseIncrement;
-
-					// Do the reset
-					if (resetterPhaseNow < resetterPhaseIncrement) {
-						phaseNow = (multiply_32x32_rshift32(multiply_32x32_rshift32(resetterPhaseNow, phaseIncrement),
-						                                    resetterDivideByPhaseIncrement)
-						            << 17)
-						           + 1 + retriggerPhase;
-					}
-
-					int32_t value = getTriangleSmall(phaseNow);
-
-					if (applyAmplitude) {
-						amplitudeNow += amplitudeIncrement;
-						*thisSample = multiply_accumulate_32x32_rshift32_rounded(*thisSample, value, amplitudeNow);
-					}
-					else {
-						*thisSample = value << 1;
-					}
-				} while (++thisSample != bufferEnd);
-
-				phase = phaseNow;
-				goto storePhase;
-			}
-			else {
-				int32_t amplitudeNow = amplitude << 1;
-				uint32_t phaseNow = phase;
-				int32_t* thisSample = bufferStart;
-				amplitudeIncrement <<= 1;
-				do {
-					phaseNow += phaseIncrement;
-
-					int32_t value = getTriangleSmall(phaseNow);
-
-					if (applyAmplitude) {
-						amplitudeNow += amplitudeIncrement;
-						*thisSample = multiply_accumulate_32x32_rshift32_rounded(*thisSample, value, amplitudeNow);
-					}
-					else {
-						*thisSample = value << 1;
-					}
-				} while (++thisSample != bufferEnd);
-				return;
-			}
+			goto renderDirect;
 		}
 
 		else {
@@ -3003,51 +2945,7 @@ doSine:
 doSaw:
 			// If frequency low enough, we just use a crude calculation for the wave without anti-aliasing
 			if (tableNumber < AudioEngine::cpuDireness + 6) {
-
-				if (!doOscSync) {
-					if (applyAmplitude) {
-						renderCrudeSawWaveWithAmplitude(bufferStart, bufferEnd, phase, phaseIncrement, amplitude,
-						                                amplitudeIncrement, numSamples);
-					}
-					else {
-						renderCrudeSawWaveWithoutAmplitude(bufferStart, bufferEnd, phase, phaseIncrement, numSamples);
-					}
-					return;
-				}
-
-				else {
-					int32_t amplitudeNow = amplitude;
-					uint32_t phaseNow = phase;
-					uint32_t resetterPhaseNow = resetterPhase;
-					int32_t* thisSample = bufferStart;
-
-					do {
-						phaseNow += phaseIncrement;
-						resetterPhaseNow += resetterPhaseIncrement;
-
-						// Do the reset
-						if (resetterPhaseNow < resetterPhaseIncrement) {
-							phaseNow =
-							    (multiply_32x32_rshift32(multiply_32x32_rshift32(resetterPhaseNow, phaseIncrement),
-							                             resetterDivideByPhaseIncrement)
-							     << 17)
-							    + 1 + retriggerPhase;
-						}
-
-						if (applyAmplitude) {
-							amplitudeNow += amplitudeIncrement;
-							*thisSample = multiply_accumulate_32x32_rshift32_rounded(
-							    *thisSample, (int32_t)phaseNow,
-							    amplitudeNow); // Using multiply_accumulate saves like 10% here!
-						}
-						else {
-							*thisSample = (int32_t)phaseNow >> 1;
-						}
-					} while (++thisSample != bufferEnd);
-
-					phase = phaseNow;
-					goto storePhase;
-				}
+				goto renderDirect;
 			}
 
 			else {
@@ -3058,85 +2956,7 @@ doSaw:
 		else if (type == OscType::SQUARE) {
 			// If frequency low enough, we just use a crude calculation for the wave without anti-aliasing
 			if (tableNumber < AudioEngine::cpuDireness + 6) {
-
-				int32_t amplitudeNow = amplitude;
-				uint32_t phaseNow = phase;
-				uint32_t resetterPhaseNow = resetterPhase;
-				int32_t* thisSample = bufferStart;
-
-				if (!doOscSync) {
-
-					if (applyAmplitude) {
-
-						do {
-							phaseNow += phaseIncrement;
-							amplitudeNow += amplitudeIncrement;
-							*thisSample = multiply_accumulate_32x32_rshift32_rounded(
-							    *thisSample, getSquare(phaseNow, pulseWidth),
-							    amplitudeNow); // Using multiply_accumulate saves like 20% here, WTF!!!!
-							++thisSample;
-						} while (thisSample != bufferEnd);
-					}
-
-					else {
-						int32_t* remainderSamplesEnd = bufferStart + (numSamples & 3);
-
-						while (thisSample != remainderSamplesEnd) {
-							phaseNow += phaseIncrement;
-							*thisSample = getSquareSmall(phaseNow, pulseWidth);
-							++thisSample;
-						}
-
-						while (thisSample != bufferEnd) {
-							phaseNow += phaseIncrement;
-							*thisSample = getSquareSmall(phaseNow, pulseWidth);
-							++thisSample;
-
-							phaseNow += phaseIncrement;
-							*thisSample = getSquareSmall(phaseNow, pulseWidth);
-							++thisSample;
-
-							phaseNow += phaseIncrement;
-							*thisSample = getSquareSmall(phaseNow, pulseWidth);
-							++thisSample;
-
-							phaseNow += phaseIncrement;
-							*thisSample = getSquareSmall(phaseNow, pulseWidth);
-							++thisSample;
-						}
-					}
-					return;
-				}
-
-				else {
-					do {
-
-						phaseNow += phaseIncrement;
-
-						resetterPhaseNow += resetterPhaseIncrement;
-
-						// Do the reset
-						if (resetterPhaseNow < resetterPhaseIncrement) {
-							phaseNow =
-							    (multiply_32x32_rshift32(multiply_32x32_rshift32(resetterPhaseNow, phaseIncrement),
-							                             resetterDivideByPhaseIncrement)
-							     << 17)
-							    + 1 + retriggerPhase;
-						}
-
-						if (applyAmplitude) {
-							amplitudeNow += amplitudeIncrement;
-							*thisSample = multiply_accumulate_32x32_rshift32_rounded(
-							    *thisSample, getSquare(phaseNow, pulseWidth), amplitudeNow);
-						}
-						else {
-							*thisSample = getSquareSmall(phaseNow, pulseWidth);
-						}
-					} while (++thisSample != bufferEnd);
-
-					phase = phaseNow;
-					goto storePhase;
-				}
+				goto renderDirect;
 			}
 
 			else {
@@ -3201,7 +3021,25 @@ callRenderWave:
 		}
 	}
 
-	// We never get here. Only by jumping to labels below, which will usually only be if osc sync on. Or wavetable.
+	// We never get here. Only by jumping to labels below, which will usually only be if osc sync on. Or wavetable. Or
+	// for the waves that don't need a table.
+
+renderDirect: {
+	// Picked by Sound::getOscKernels() for this source's wave and synth mode, so only sync is left to choose
+	deluge::dsp::DirectOscParams params{
+	    .phaseIncrement = phaseIncrement,
+	    .pulseWidth = pulseWidth,
+	    .amplitude = amplitude,
+	    .amplitudeIncrement = amplitudeIncrement,
+	    .resetterPhase = resetterPhase,
+	    .resetterPhaseIncrement = resetterPhaseIncrement,
+	    .resetterDivideByPhaseIncrement = resetterDivideByPhaseIncrement,
+	    .retriggerPhase = retriggerPhase,
+	};
+	phase = assignedToSound->getOscKernels(s).direct[doOscSync](bufferStart, numSamples, phase, params);
+	goto storePhase;
+}
+
 
 doNeedToApplyAmplitude:
 	if (applyAmplitude) {
@@ -19,6 +19,8 @@
 
 #include "definitions_cxx.hpp"
 #include "dsp/filter/filter_set.h"
+#include "dsp/oversampling/oversampler.h"
+#include "dsp/voice_batch.h"
 #include "model/voice/voice_sample_playback_guide.h"
 #include "model/voice/voice_unison_part.h"
 #include "modulation/envelope.h"
@@ -59,6 +61,8 @@ public:
 	LFO lfo;
 
 	dsp::filter::FilterSet filterSet;
+	dsp::Oversampler oversampler;
+	uint8_t oversamplingMagnitude = 0; // Decided in noteOn(), for the whole note
 	int32_t inputCharacteristics[2]; // Contains what used to be called noteCodeBeforeArpeggiation, and fromMIDIChannel
 	int32_t noteCodeAfterArpeggiation;
 
@@ -85,11 +89,18 @@ public:
 
 	Voice* nextUnassigned;
 
+	// Links for AudioEngine::activeVoices - see VoiceVector
+	Voice* nextInSound;
+	Voice** prevPointerInSound;
+	int32_t activeVoicesIndex;
+	// This Voice's share of VoiceVector::getPredictedCyclesPerSample()
+	uint32_t predictedCyclesPerSample;
+
 	uint32_t getLocalLFOPhaseIncrement();
 	void setAsUnassigned(ModelStackWithVoice* modelStack, bool deletingSong = false);
 	bool render(ModelStackWithVoice* modelStack, int32_t* soundBuffer, int32_t numSamples, bool soundRenderingInStereo,
 	            bool applyingPanAtVoiceLevel, uint32_t sourcesChanged, bool doLPF, bool doHPF,
-	            int32_t externalPitchAdjust);
+	            int32_t externalPitchAdjust, dsp::VoiceBatch* batch = nullptr);
 
 	void calculatePhaseIncrements(ModelStackWithVoice* modelStack);
 	bool sampleZoneChanged(ModelStackWithVoice* modelStack, int32_t s, MarkerType markerType);
@@ -128,7 +139,14 @@ private:
 	                       bool* unisonPartBecameInactive, int32_t overallPitchAdjust, bool doOscSync,
 	                       uint32_t* oscSyncPos, uint32_t* oscSyncPhaseIncrements, int32_t amplitudeIncrement,
 	                       uint32_t* getPhaseIncrements, bool getOutAfterPhaseIncrements, int32_t waveIndexIncrement);
+	bool renderUnisonWave(Sound* sound, int32_t s, int32_t* oscBuffer, int32_t numSamples, bool stereoBuffer,
+	                      int32_t sourceAmplitude, int32_t amplitudeIncrement, int32_t overallPitchAdjust,
+	                      uint32_t* getPhaseIncrements);
 	bool adjustPitch(uint32_t* phaseIncrement, int32_t adjustment);
+	bool mayBeNonlinear(Sound* sound, ParamManagerForTimeline* paramManager);
+	void renderOversampled(Sound* sound, int32_t* oscBuffer, int32_t numSamples, int32_t numChannels,
+	                       int32_t magnitude, q31_t foldAmount, bool applyAmplitude, int32_t amplitude,
+	                       int32_t amplitudeIncrement);
 
 	void renderSineWaveWithFeedback(int32_t* thisSample, int32_t numSamples, uint32_t* phase, int32_t amplitude,
 	                                uint32_t phaseIncrement, int32_t feedbackAmount, int32_t* lastFeedbackValue,
@@ -17,30 +17,69 @@
 
 #include "model/voice/voice_vector.h"
 #include "definitions_cxx.hpp"
+#include "processing/sound/sound.h"
 
 VoiceVector::VoiceVector() {
 }
 
-void VoiceVector::checkVoiceExists(Voice* voice, Sound* sound, char const* errorCode) {
+bool VoiceVector::add(Voice* voice, Sound* sound) {
+	int32_t index = voices.getNumElements();
+	Error error = voices.insertPointerAtIndex(voice, index);
+	if (error != Error::NONE) {
+		return false;
+	}
+	voice->activeVoicesIndex = index;
+	voice->predictedCyclesPerSample = sound->voiceCost.cyclesPerVoiceSample();
+	predictedCyclesPerSample += voice->predictedCyclesPerSample;
 
-	if (ALPHA_OR_BETA_VERSION) {
-		uint32_t searchWords[2];
-		searchWords[0] = (uint32_t)sound;
-		searchWords[1] = (uint32_t)voice;
-		int32_t i = searchMultiWordExact(searchWords);
+	voice->nextInSound = sound->firstAssignedVoice;
+	if (voice->nextInSound) {
+		voice->nextInSound->prevPointerInSound = &voice->nextInSound;
+	}
+	voice->prevPointerInSound = &sound->firstAssignedVoice;
+	sound->firstAssignedVoice = voice;
+	return true;
+}
 
-		if (i == -1) {
-			FREEZE_WITH_ERROR(errorCode);
-		}
+void VoiceVector::remove(Voice* voice) {
+	*voice->prevPointerInSound = voice->nextInSound;
+	if (voice->nextInSound) {
+		voice->nextInSound->prevPointerInSound = voice->prevPointerInSound;
+	}
+
+	int32_t lastIndex = voices.getNumElements() - 1;
+	if (voice->activeVoicesIndex != lastIndex) {
+		Voice* lastVoice = getVoice(lastIndex);
+		voices.setPointerAtIndex(lastVoice, voice->activeVoicesIndex);
+		lastVoice->activeVoicesIndex = voice->activeVoicesIndex;
 	}
+	voices.deleteAtIndex(lastIndex);
+	voice->activeVoicesIndex = -1;
+	predictedCyclesPerSample -= voice->predictedCyclesPerSample;
 }
 
-// Returns results as if GREAT_OR_EQUAL had been supplied to search. To turn this into LESS, subtract 1
-void VoiceVector::getRangeForSound(Sound* sound, int32_t* __restrict__ ends) {
+uint32_t VoiceVector::refreshPredictedCyclesPerSample() {
+	predictedCyclesPerSample = 0;
+	for (int32_t v = 0; v < voices.getNumElements(); v++) {
+		Voice* thisVoice = getVoice(v);
+		thisVoice->predictedCyclesPerSample = (thisVoice->envelopes[0].state == EnvelopeStage::FAST_RELEASE)
+		                                          ? 0
+		                                          : thisVoice->assignedToSound->voiceCost.cyclesPerVoiceSample();
+		predictedCyclesPerSample += thisVoice->predictedCyclesPerSample;
+	}
+	return predictedCyclesPerSample;
+}
 
-	int32_t searchTerms[2];
-	searchTerms[0] = (uint32_t)sound;
-	searchTerms[1] = (uint32_t)sound + 1;
+VoiceVector::SoundVoices VoiceVector::forSound(Sound* sound) {
+	return SoundVoices(sound->firstAssignedVoice);
+}
+
+void VoiceVector::checkVoiceExists(Voice* voice, Sound* sound, char const* errorCode) {
 
-	searchDual(searchTerms, ends);
+	if (ALPHA_OR_BETA_VERSION) {
+		int32_t i = voice->activeVoicesIndex;
+		if (i < 0 || i >= voices.getNumElements() || getVoice(i) != voice || voice->assignedToSound != sound) {
+			FREEZE_WITH_ERROR(errorCode);
+		}
+	}
 }
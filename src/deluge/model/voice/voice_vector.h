@@ -17,22 +17,68 @@
 
 #pragma once
 
-#include "util/container/array/ordered_resizeable_array_with_multi_word_key.h"
+#include "model/voice/voice.h"
+#include "util/container/array/resizeable_pointer_array.h"
 
-class Voice;
 class Sound;
 
-struct VoiceVectorElement {
-	Sound* sound;
-	Voice* voice;
-};
-
-class VoiceVector : public OrderedResizeableArrayWithMultiWordKey {
+/// All the Voices currently assigned to Sounds.
+///
+/// Each Sound keeps its own Voices in an intrusive list (Sound::firstAssignedVoice, Voice::nextInSound), so getting
+/// at a Sound's Voices, or adding or removing one, takes no searching or shuffling of elements. Every Voice is also
+/// in an unordered array, for the few things (culling, counting) which need to look at all of them. Removing from
+/// that moves the last Voice into the gap, and each Voice remembers its index, so that's O(1) too.
+class VoiceVector {
 public:
+	/// Iterates over one Sound's Voices. It's fine to unassign the Voice currently being visited, but not any others.
+	class SoundVoices {
+	public:
+		class Iterator {
+		public:
+			Iterator(Voice* voice) : voice_(voice), next_(voice ? voice->nextInSound : nullptr) {}
+			Voice* operator*() const { return voice_; }
+			Iterator& operator++() {
+				voice_ = next_;
+				next_ = voice_ ? voice_->nextInSound : nullptr;
+				return *this;
+			}
+			bool operator!=(const Iterator& other) const { return voice_ != other.voice_; }
+
+		private:
+			Voice* voice_;
+			Voice* next_; // Grabbed in advance in case voice_ gets removed
+		};
+
+		SoundVoices(Voice* first) : first_(first) {}
+		Iterator begin() const { return Iterator(first_); }
+		Iterator end() const { return Iterator(nullptr); }
+
+	private:
+		Voice* first_;
+	};
+
 	VoiceVector();
 
-	void getRangeForSound(Sound* sound, int32_t* __restrict__ ends);
+	/// Returns false if there wasn't the memory to add it
+	bool add(Voice* voice, Sound* sound);
+	void remove(Voice* voice);
+
+	SoundVoices forSound(Sound* sound);
 	void checkVoiceExists(Voice* voice, Sound* sound, char const* errorCode);
 
-	inline Voice* getVoice(int32_t index) { return ((VoiceVectorElement*)getElementAddress(index))->voice; }
+	/// Sum of the learned per-sample cost of the Voices we'll be rendering, kept up to date as they're added and
+	/// removed. Each one's cost is as it was when it was added or last refreshed
+	[[nodiscard]] uint32_t getPredictedCyclesPerSample() const { return predictedCyclesPerSample; }
+	/// Re-read every Voice's cost, as the Sounds' estimates get learned and Voices begin fast-releasing. Voices already
+	/// fast-releasing are left out, since they're on their way out - otherwise we'd keep culling more for the few
+	/// windows they take to finish
+	uint32_t refreshPredictedCyclesPerSample();
+
+	[[gnu::always_inline]] inline int32_t getNumElements() { return voices.getNumElements(); }
+	/// Voices are in no particular order
+	[[gnu::always_inline]] inline Voice* getVoice(int32_t index) { return (Voice*)voices.getPointerAtIndex(index); }
+
+private:
+	ResizeablePointerArray voices;
+	uint32_t predictedCyclesPerSample = 0;
 };
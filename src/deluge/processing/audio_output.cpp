@@ -383,6 +383,12 @@ Error AudioOutput::readFromFile(Deserializer& reader, Song* song, Clip* clip, in
 	return Error::NONE;
 }
 
+Error AudioOutput::loadAllAudioFiles(bool mayActuallyReadFiles) {
+	// The clips' own samples are loaded by the Song
+	convolution.loadImpulseResponse(mayActuallyReadFiles); // A missing impulse response just means no convolution
+	return Error::NONE;
+}
+
 void AudioOutput::deleteBackedUpParamManagers(Song* song) {
 	song->deleteBackedUpParamManagersForModControllable(this);
 }
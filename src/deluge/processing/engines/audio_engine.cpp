@@ -32,6 +32,7 @@
 #include "hid/encoders.h"
 #include "hid/led/indicator_leds.h"
 #include "io/debug/log.h"
+#include "io/debug/print.h"
 #include "io/midi/midi_engine.h"
 #include "memory/general_memory_allocator.h"
 #include "model/instrument/kit.h"
@@ -44,6 +45,7 @@
 #include "modulation/patch/patch_cable_set.h"
 #include "processing/audio_output.h"
 #include "processing/engines/cv_engine.h"
+#include "processing/engines/render_cost_model.h"
 #include "processing/live/live_input_buffer.h"
 #include "processing/metronome/metronome.h"
 #include "processing/sound/sound.h"
@@ -92,17 +94,11 @@ extern bool inSpamMode;
 extern bool anythingProbablyPressed;
 extern int32_t spareRenderingBuffer[][SSI_TX_BUFFER_NUM_SAMPLES];
 
+// Prints a summary of renderStats once a second
 // #define REPORT_CPU_USAGE 1
 
-#define NUM_SAMPLES_FOR_CPU_USAGE_REPORT 32
-
 #define AUDIO_OUTPUT_GAIN_DOUBLINGS 8
 
-#ifdef REPORT_CPU_USAGE
-#define REPORT_AVERAGE_NUM 10
-int32_t usageTimes[REPORT_AVERAGE_NUM];
-#endif
-
 extern "C" uint32_t getAudioSampleTimerMS() {
 	return AudioEngine::audioSampleTimer / 44.1;
 }
@@ -129,6 +125,20 @@ constexpr int32_t direnessThreshold = numSamplesLimit - 30;
 // to the limit
 constexpr int MIN_VOICES = 7;
 
+// Lookahead culling - see render_cost_model.h. A full 128-sample window taking longer than numSamplesLimit samples of
+// realtime is where cullVoices() steps in, so that's the budget we try to keep the predicted cost under...
+constexpr uint32_t kCyclesPerSampleRealtime = Debug::sec / kSampleRate;
+constexpr uint32_t kSoftLimitCyclesPerSample =
+    kCyclesPerSampleRealtime * numSamplesLimit / SSI_TX_BUFFER_NUM_SAMPLES;
+// ...and this is where cullVoices() would start hard-culling, so we'd rather not start a new voice past it
+constexpr uint32_t kHardLimitCyclesPerSample =
+    kCyclesPerSampleRealtime * (numSamplesLimit + 20) / SSI_TX_BUFFER_NUM_SAMPLES;
+// Predictions can be off, e.g. right after a patch change, so don't release more than this many voices per window
+constexpr int32_t kMaxLookaheadCullsPerWindow = 2;
+
+RenderCostPredictor renderCostPredictor{kSoftLimitCyclesPerSample, kHardLimitCyclesPerSample};
+uint32_t voiceRenderCyclesThisWindow = 0;
+
 dsp::Reverb reverb{};
 PLACE_INTERNAL_FRUNK SideChain reverbSidechain{};
 int32_t reverbSidechainVolume;
@@ -180,6 +190,10 @@ uint8_t numHopsEndedThisRoutineCall;
 
 VoiceVector activeVoices{};
 
+// Counted in CPU cycles, from the PMU cycle counter
+RenderStats renderStats{Debug::sec, kSampleRate};
+uint32_t timeLastRenderStatsReport = 0;
+
 LiveInputBuffer* liveInputBuffers[3];
 
 // For debugging
@@ -210,6 +224,9 @@ Voice* firstUnassignedVoice = staticVoices;
 
 // You must set up dynamic memory allocation before calling this, because of its call to setupWithPatching()
 void init() {
+	// Enables the PMU cycle counter, which renderStats relies on
+	Debug::init();
+
 	paramManagerForSamplePreview = new ((void*)paramManagerForSamplePreviewMemory) ParamManagerForTimeline();
 	paramManagerForSamplePreview->setupWithPatching(); // Shouldn't be an error at init time...
 	Sound::initParams(paramManagerForSamplePreview);
@@ -248,11 +265,11 @@ void init() {
 
 void unassignAllVoices(bool deletingSong) {
 
-	for (int32_t v = 0; v < activeVoices.getNumElements(); v++) {
-		Voice* thisVoice = activeVoices.getVoice(v);
-		unassignVoice(thisVoice, thisVoice->assignedToSound, nullptr, false);
+	// From the end, so each removal from activeVoices is just a shortening of it
+	while (activeVoices.getNumElements()) {
+		Voice* thisVoice = activeVoices.getVoice(activeVoices.getNumElements() - 1);
+		unassignVoice(thisVoice, thisVoice->assignedToSound, nullptr);
 	}
-	activeVoices.empty();
 
 	// Because we unfortunately don't have a master list of VoiceSamples or actively sounding AudioClips,
 	// we have to unassign all of those by going through all AudioOutputs.
@@ -296,9 +313,7 @@ Voice* cullVoice(bool saveVoice, CullType type, size_t numSamples, Sound* stopFr
 	bool skipReleasing = (type == SOFT_ALWAYS);
 	uint32_t bestRating = 0;
 	Voice* bestVoice = NULL;
-	for (int32_t v = 0; v < activeVoices.getNumElements(); v++) {
-		Voice* thisVoice = activeVoices.getVoice(v);
-
+	auto considerVoice = [&](Voice* thisVoice) {
 		uint32_t ratingThisVoice = thisVoice->getPriorityRating();
 
 		if (ratingThisVoice > bestRating) {
@@ -306,12 +321,23 @@ Voice* cullVoice(bool saveVoice, CullType type, size_t numSamples, Sound* stopFr
 			if (!skipReleasing
 			    || (thisVoice->envelopes[0].state <= EnvelopeStage::FAST_RELEASE
 			        && thisVoice->envelopes[0].fastReleaseIncrement < SOFT_CULL_INCREMENT)) {
-				if (stopFrom == nullptr || thisVoice->assignedToSound == stopFrom) {
-					bestRating = ratingThisVoice;
-					bestVoice = thisVoice;
-				}
+				bestRating = ratingThisVoice;
+				bestVoice = thisVoice;
 			}
 		}
+	};
+
+	// Priority ratings change with every envelope stage and every voice a Sound gains or loses, so there's no keeping
+	// them sorted - but if we're only stopping from one Sound, at least we only need to look at its voices
+	if (stopFrom) {
+		for (Voice* thisVoice : activeVoices.forSound(stopFrom)) {
+			considerVoice(thisVoice);
+		}
+	}
+	else {
+		for (int32_t v = 0; v < activeVoices.getNumElements(); v++) {
+			considerVoice(activeVoices.getVoice(v));
+		}
 	}
 
 	if (bestVoice) {
@@ -355,7 +381,7 @@ Voice* cullVoice(bool saveVoice, CullType type, size_t numSamples, Sound* stopFr
 			break;
 		}
 		case HARD:
-			unassignVoice(bestVoice, bestVoice->assignedToSound, NULL, true, !saveVoice);
+			unassignVoice(bestVoice, bestVoice->assignedToSound, NULL, !saveVoice);
 			D_PRINTLN("hard-culled 1 voice.  numSamples:  %d. Voices left: %d. Audio clips left: %d", numSamples,
 			          getNumVoices(), getNumAudio());
 		}
@@ -373,6 +399,7 @@ Voice* cullVoice(bool saveVoice, CullType type, size_t numSamples, Sound* stopFr
 int32_t getNumAudio() {
 	return currentSong ? currentSong->countAudioClips() : 0;
 }
+
 int32_t getNumVoices() {
 	return activeVoices.getNumElements();
 }
@@ -448,6 +475,10 @@ inline void cullVoices(size_t numSamples, int32_t numAudio, int32_t numVoice) {
 			culled = true;
 		}
 	}
+	if (culled) {
+		renderStats.noteCull(numAudio + numVoice);
+	}
+
 	// blink LED to alert the user
 	if (culled && FlashStorage::highCPUUsageIndicator) {
 		if (indicator_leds::getLedBlinkerIndex(IndicatorLED::PLAY) == 255) {
@@ -456,6 +487,42 @@ inline void cullVoices(size_t numSamples, int32_t numAudio, int32_t numVoice) {
 	}
 }
 
+// not in header (private to audio engine)
+/// Lookahead counterpart to cullVoices(): if the voices about to be rendered are predicted to take us past the point
+/// where cullVoices() would have to step in, start releasing the lowest priority ones now while it can still be done
+/// gracefully. cullVoices() stays as the backstop for when the prediction was wrong.
+inline void cullVoicesAhead() {
+	if (bypassCulling) {
+		return;
+	}
+	int32_t numVoices = getNumVoices();
+	if (numVoices <= MIN_VOICES) {
+		return;
+	}
+	// Once a window is enough to keep up with the Sounds' learned costs and Voices starting to fast-release
+	uint32_t voiceCycles = activeVoices.refreshPredictedCyclesPerSample();
+	uint32_t cyclesOver = renderCostPredictor.cyclesPerSampleOverSoftLimit(voiceCycles);
+	if (!cyclesOver) {
+		return;
+	}
+
+	// We can't ask a culled voice what it cost - it may be gone already - so go by the average
+	uint32_t averageVoiceCycles = voiceCycles / numVoices;
+	bool culled = false;
+	for (int32_t i = 0; i < kMaxLookaheadCullsPerWindow && cyclesOver && numVoices > MIN_VOICES; i++) {
+		if (!cullVoice(false, SOFT_ALWAYS, numSamplesLastTime, nullptr)) {
+			break;
+		}
+		renderStats.noteCull(numVoices);
+		numVoices--;
+		cyclesOver = (cyclesOver > averageVoiceCycles) ? cyclesOver - averageVoiceCycles : 0;
+		culled = true;
+	}
+	if (culled) {
+		logAction("lookahead cull");
+	}
+}
+
 // not in header (private to audio engine)
 /// set the direness level and cull any voices
 inline void setDireness(size_t numSamples) { // Consider direness and culling - before increasing the number of samples
@@ -520,6 +587,15 @@ void tickSongFinalizeWindows(size_t& numSamples, int32_t& timeWithinWindowAtWhic
 void flushMIDIGateBuffers();
 void renderAudio(size_t numSamples);
 void renderAudioForStemExport(size_t numSamples);
+void routineOffline();
+void outputOffline(size_t numSamples);
+void feedDACSilence();
+bool anyRecorderBackedUp();
+extern bool createdNewRecorder;
+
+// Offline rendering runs windows as long as the render buffers allow, for this many seconds at a time
+constexpr size_t kOfflineRenderWindowSize = SSI_TX_BUFFER_NUM_SAMPLES;
+constexpr double kOfflineRenderTimeSlice = 0.002;
 /// inner loop of audio rendering, deliberately not in header
 [[gnu::hot]] void routine_() {
 
@@ -572,8 +648,14 @@ void renderAudioForStemExport(size_t numSamples);
 	int32_t timeWithinWindowAtWhichMIDIOrGateOccurs;
 	tickSongFinalizeWindows(numSamples, timeWithinWindowAtWhichMIDIOrGateOccurs);
 
+	cullVoicesAhead();
+
 	numSamplesLastTime = numSamples;
+	uint32_t renderStartTime = Debug::readCycleCounter();
 	renderAudio(numSamples);
+	uint32_t renderCycles = Debug::readCycleCounter() - renderStartTime;
+	renderStats.noteWindow(numSamples, renderCycles, getNumVoices());
+	renderCostPredictor.noteWindow(renderCycles, voiceRenderCyclesThisWindow, numSamples);
 
 	scheduleMidiGateOutISR(saddrPosAtStart, unadjustedNumSamplesBeforeLappingPlayHead,
 	                       timeWithinWindowAtWhichMIDIOrGateOccurs);
@@ -582,12 +664,21 @@ void renderAudioForStemExport(size_t numSamples);
 	dumpAudioLog();
 #endif
 
+#ifdef REPORT_CPU_USAGE
+	if ((uint32_t)(audioSampleTimer - timeLastRenderStatsReport) >= kSampleRate) {
+		timeLastRenderStatsReport = audioSampleTimer;
+		logRenderStats();
+		renderStats.reset();
+	}
+#endif
+
 	sideChainHitPending = 0;
 	audioSampleTimer += numSamples;
 
 	bypassCulling = false;
 }
 void renderAudio(size_t numSamples) {
+	voiceRenderCyclesThisWindow = 0;
 	memset(&renderingBuffer, 0, numSamples * sizeof(StereoSample));
 	memset(&reverbBuffer, 0, numSamples * sizeof(StereoSample));
 
@@ -621,6 +712,7 @@ void renderAudio(size_t numSamples) {
 }
 
 void renderAudioForStemExport(size_t numSamples) {
+	voiceRenderCyclesThisWindow = 0;
 	memset(&renderingBuffer, 0, numSamples * sizeof(StereoSample));
 	memset(&reverbBuffer, 0, numSamples * sizeof(StereoSample));
 
@@ -980,29 +1072,100 @@ void routine() {
 			numRoutines += 1;
 		}
 	}
-	else {
-		if (!sdRoutineLock) {
-			auto timeNow = getSystemTime();
-			while (getSystemTime() < timeNow + 32 / 44100.) {
-				size_t numSamples = 32;
-				int32_t timeWithinWindowAtWhichMIDIOrGateOccurs;
-				tickSongFinalizeWindows(numSamples, timeWithinWindowAtWhichMIDIOrGateOccurs);
-
-				numSamplesLastTime = numSamples;
-				renderAudioForStemExport(numSamples);
-				audioSampleTimer += numSamples;
-				doSomeOutputting();
-				// gross and hacky way to make sure the audio recorder writes all of its data so it can't be stolen
-				while (audioRecorder.recorder->firstUnwrittenClusterIndex
-				       < audioRecorder.recorder->currentRecordClusterIndex) {
-					doRecorderCardRoutines();
-				}
+	else if (!sdRoutineLock) {
+		routineOffline();
+	}
+	audioRoutineLocked = false;
+}
 
-				audioFileManager.loadAnyEnqueuedClusters(128, false);
-			}
+/// Renders as fast as the CPU and card allow, rather than when the DAC wants more. Windows are as long as the render
+/// buffers allow, and only get cut short by ticks. Gives up after a slice of time so everything else gets a go
+void routineOffline() {
+	auto timeStarted = getSystemTime();
+	do {
+		// Back-pressure - if the card's falling behind, let it catch up before rendering any more. Each pass writes
+		// out the completed clusters of every recorder together
+		while (anyRecorderBackedUp()) {
+			createdNewRecorder = false; // We're not mid-traversal, so no need for the card routine to bail
+			doRecorderCardRoutines();
 		}
+
+		size_t numSamples = kOfflineRenderWindowSize;
+		int32_t timeWithinWindowAtWhichMIDIOrGateOccurs;
+		tickSongFinalizeWindows(numSamples, timeWithinWindowAtWhichMIDIOrGateOccurs);
+
+		numSamplesLastTime = numSamples;
+		renderAudioForStemExport(numSamples);
+		audioSampleTimer += numSamples;
+		outputOffline(numSamples);
+
+		audioFileManager.loadAnyEnqueuedClusters(128, false);
+	} while (getSystemTime() < timeStarted + kOfflineRenderTimeSlice);
+
+	feedDACSilence();
+}
+
+/// Takes a rendered sample to output level: master volume, then the output gain, with clipping. Anything being
+/// monitored gets mixed in, as monitorL and monitorR, before the gain
+[[gnu::always_inline]] inline void applyOutputLevel(StereoSample const& rendered, StereoSample& output,
+                                                    int32_t monitorL = 0, int32_t monitorR = 0) {
+	// Here we're going to do something equivalent to a multiply_32x32_rshift32(), but add dithering.
+	// Because dithering is good, and also because the annoying codec chip freaks out if it sees the same 0s for
+	// too long.
+	int64_t lAdjustedBig = (int64_t)rendered.l * (int64_t)masterVolumeAdjustmentL + (int64_t)getNoise();
+	int64_t rAdjustedBig = (int64_t)rendered.r * (int64_t)masterVolumeAdjustmentR + (int64_t)getNoise();
+
+	int32_t lAdjusted = (int32_t)(lAdjustedBig >> 32) + monitorL;
+	int32_t rAdjusted = (int32_t)(rAdjustedBig >> 32) + monitorR;
+
+	output.l = lshiftAndSaturate<AUDIO_OUTPUT_GAIN_DOUBLINGS>(lAdjusted);
+	output.r = lshiftAndSaturate<AUDIO_OUTPUT_GAIN_DOUBLINGS>(rAdjusted);
+}
+
+/// The offline equivalent of doSomeOutputting(). Nothing's waiting on the DAC, so the whole window is always taken
+/// at once, and only goes to the SampleRecorders
+void outputOffline(size_t numSamples) {
+	StereoSample* __restrict__ outputBufferForResampling = (StereoSample*)spareRenderingBuffer;
+
+	for (size_t i = 0; i < numSamples; i++) {
+		applyOutputLevel(renderingBuffer[i], outputBufferForResampling[i]);
+	}
+
+	// There's no live input to record while offline - only the final output
+	for (SampleRecorder* recorder = firstRecorder; recorder; recorder = recorder->next) {
+		if (recorder->status < RecorderStatus::FINISHED_CAPTURING_BUT_STILL_WRITING
+		    && recorder->mode == AudioInputChannel::OUTPUT) {
+			recorder->feedAudio((int32_t*)outputBufferForResampling, numSamples);
+		}
+	}
+
+	renderingBufferOutputPos = renderingBufferOutputEnd;
+}
+
+/// While rendering offline, the DAC gets 0s and 1s for silence - it doesn't like all zeroes
+void feedDACSilence() {
+	int32_t* __restrict__ i2sTXBufferPosNow = (int32_t*)i2sTXBufferPos;
+	saddr = (uint32_t)getTxBufferCurrentPlace();
+
+	int32_t numSamplesOutputted = 0;
+	while (((uint32_t)((uint32_t)i2sTXBufferPosNow - saddr) >> (2 + NUM_MONO_OUTPUT_CHANNELS_MAGNITUDE))
+	       & (SSI_TX_BUFFER_NUM_SAMPLES - 1)) {
+		i2sTXBufferPosNow[0] = numSamplesOutputted % 2;
+		i2sTXBufferPosNow[1] = numSamplesOutputted % 2;
+
+		i2sTXBufferPosNow += NUM_MONO_OUTPUT_CHANNELS;
+		if (i2sTXBufferPosNow == getTxBufferEnd()) {
+			i2sTXBufferPosNow = getTxBufferStart();
+		}
+		numSamplesOutputted++;
+	}
+	i2sTXBufferPos = (uint32_t)i2sTXBufferPosNow;
+
+	// Keep the input side in step, same as doSomeOutputting() does
+	i2sRXBufferPos += (numSamplesOutputted << (NUM_MONO_INPUT_CHANNELS_MAGNITUDE + 2));
+	if (i2sRXBufferPos >= (uint32_t)getRxBufferEnd()) {
+		i2sRXBufferPos -= (SSI_RX_BUFFER_NUM_SAMPLES << (NUM_MONO_INPUT_CHANNELS_MAGNITUDE + 2));
 	}
-	audioRoutineLocked = false;
 }
 
 int32_t getNumSamplesLeftToOutputFromPreviousRender() {
@@ -1036,34 +1199,26 @@ bool doSomeOutputting() {
 			}
 		}
 
-		// Here we're going to do something equivalent to a multiply_32x32_rshift32(), but add dithering.
-		// Because dithering is good, and also because the annoying codec chip freaks out if it sees the same 0s for
-		// too long.
-		int64_t lAdjustedBig =
-		    (int64_t)renderingBufferOutputPosNow->l * (int64_t)masterVolumeAdjustmentL + (int64_t)getNoise();
-		int64_t rAdjustedBig =
-		    (int64_t)renderingBufferOutputPosNow->r * (int64_t)masterVolumeAdjustmentR + (int64_t)getNoise();
-
-		int32_t lAdjusted = lAdjustedBig >> 32;
-		int32_t rAdjusted = rAdjustedBig >> 32;
+		int32_t monitorL = 0;
+		int32_t monitorR = 0;
 
 		if (doMonitoring) {
 
 			if (monitoringAction == MonitoringAction::SUBTRACT_RIGHT_CHANNEL) {
 				int32_t value = (inputReadPos[0] >> (AUDIO_OUTPUT_GAIN_DOUBLINGS + 1))
 				                - (inputReadPos[1] >> (AUDIO_OUTPUT_GAIN_DOUBLINGS));
-				lAdjusted += value;
-				rAdjusted += value;
+				monitorL = value;
+				monitorR = value;
 			}
 
 			else {
-				lAdjusted += inputReadPos[0] >> (AUDIO_OUTPUT_GAIN_DOUBLINGS);
+				monitorL = inputReadPos[0] >> (AUDIO_OUTPUT_GAIN_DOUBLINGS);
 
 				if (monitoringAction == MonitoringAction::NONE) {
-					rAdjusted += inputReadPos[1] >> (AUDIO_OUTPUT_GAIN_DOUBLINGS);
+					monitorR = inputReadPos[1] >> (AUDIO_OUTPUT_GAIN_DOUBLINGS);
 				}
 				else { // Remove right channel
-					rAdjusted += inputReadPos[0] >> (AUDIO_OUTPUT_GAIN_DOUBLINGS);
+					monitorR = inputReadPos[0] >> (AUDIO_OUTPUT_GAIN_DOUBLINGS);
 				}
 			}
 
@@ -1092,17 +1247,10 @@ bool doSomeOutputting() {
 		}
 
 #else
-		outputBufferForResampling[numSamplesOutputted].l = lshiftAndSaturate<AUDIO_OUTPUT_GAIN_DOUBLINGS>(lAdjusted);
-		outputBufferForResampling[numSamplesOutputted].r = lshiftAndSaturate<AUDIO_OUTPUT_GAIN_DOUBLINGS>(rAdjusted);
-		if (!stemExport.processStarted || (stemExport.processStarted && !stemExport.renderOffline)) {
-			i2sTXBufferPosNow[0] = outputBufferForResampling[numSamplesOutputted].l;
-			i2sTXBufferPosNow[1] = outputBufferForResampling[numSamplesOutputted].r;
-		}
-		// otherwise output 0 or 1 for silence, the DAC doesn't like all zeroes
-		else {
-			i2sTXBufferPosNow[0] = numSamplesOutputted % 2;
-			i2sTXBufferPosNow[1] = numSamplesOutputted % 2;
-		}
+		applyOutputLevel(*renderingBufferOutputPosNow, outputBufferForResampling[numSamplesOutputted], monitorL,
+		                 monitorR);
+		i2sTXBufferPosNow[0] = outputBufferForResampling[numSamplesOutputted].l;
+		i2sTXBufferPosNow[1] = outputBufferForResampling[numSamplesOutputted].r;
 #endif
 
 #if ALLOW_SPAM_MODE
@@ -1195,6 +1343,16 @@ void logAction(int32_t number) {
 #endif
 }
 
+void logRenderStats() {
+	D_PRINTLN("render: %d windows, cycles/window min %d avg %d max %d, cycles/sample avg %d max %d",
+	          renderStats.numWindows(), renderStats.minTicksPerWindow(), renderStats.averageTicksPerWindow(),
+	          renderStats.maxTicksPerWindow(), renderStats.averageTicksPerSample(), renderStats.maxTicksPerSample());
+	D_PRINTLN("render: %d samples/s, max voices %d, culls %d (first at %d voices), est. cull from %d voices",
+	          (int32_t)renderStats.samplesPerSecond(), renderStats.maxVoices(), renderStats.numCulls(),
+	          renderStats.voicesAtFirstCull(),
+	          renderStats.estimateVoicesAtCull(numSamplesLimit, SSI_TX_BUFFER_NUM_SAMPLES));
+}
+
 void dumpAudioLog() {
 #if DO_AUDIO_LOG
 	uint16_t currentTime = *TCNT[TIMER_SYSTEM_FAST];
@@ -1340,6 +1498,25 @@ void getReverbParamsFromSong(Song* song) {
 
 Voice* solicitVoice(Sound* forSound) {
 
+	// Rather than let this voice push the next window over budget and have cullVoices() cut things hard after the
+	// fact, release the lowest priority voice gracefully now. And if we'd be way over and there's nothing left to
+	// release, refuse the new voice - a note not starting is less noticeable than several being cut off.
+	if (!bypassCulling && activeVoices.getNumElements() >= MIN_VOICES) {
+		uint32_t voiceCycles = activeVoices.getPredictedCyclesPerSample();
+		uint32_t newVoiceCycles = forSound->voiceCost.cyclesPerVoiceSample();
+		if (renderCostPredictor.wouldExceedSoftLimit(voiceCycles, newVoiceCycles)) {
+			Voice* culled = cullVoice(false, SOFT_ALWAYS, numSamplesLastTime, nullptr);
+			if (culled) {
+				renderStats.noteCull(activeVoices.getNumElements());
+			}
+			else if (renderCostPredictor.wouldExceedHardLimit(voiceCycles, newVoiceCycles)) {
+				D_PRINTLN("refused voice, predicted %d cycles/sample",
+				          renderCostPredictor.predictCyclesPerSample(voiceCycles + newVoiceCycles));
+				return NULL;
+			}
+		}
+	}
+
 	Voice* newVoice;
 
 	if (firstUnassignedVoice) {
@@ -1366,12 +1543,7 @@ Voice* solicitVoice(Sound* forSound) {
 
 	newVoice->assignedToSound = forSound;
 
-	uint32_t keyWords[2];
-	keyWords[0] = (uint32_t)forSound;
-	keyWords[1] = (uint32_t)newVoice;
-
-	int32_t i = activeVoices.insertAtKeyMultiWord(keyWords);
-	if (i == -1) {
+	if (!activeVoices.add(newVoice, forSound)) {
 		// if (ALPHA_OR_BETA_VERSION) FREEZE_WITH_ERROR("E193"); // No, having run out of RAM here isn't a reason to
 		// not continue.
 		disposeOfVoice(newVoice);
@@ -1385,20 +1557,13 @@ Voice* solicitVoice(Sound* forSound) {
 }
 
 // **** This is the main function that enacts the unassigning of the Voice
-// sound only required if removing from vector
 // modelStack can be NULL if you really insist
-void unassignVoice(Voice* voice, Sound* sound, ModelStackWithSoundFlags* modelStack, bool removeFromVector,
-                   bool shouldDispose) {
+void unassignVoice(Voice* voice, Sound* sound, ModelStackWithSoundFlags* modelStack, bool shouldDispose) {
 
 	activeVoices.checkVoiceExists(voice, sound, "E195");
 
 	voice->setAsUnassigned(modelStack ? modelStack->addVoice(voice) : nullptr);
-	if (removeFromVector) {
-		uint32_t keyWords[2];
-		keyWords[0] = (uint32_t)sound;
-		keyWords[1] = (uint32_t)voice;
-		activeVoices.deleteAtKeyMultiWord(keyWords);
-	}
+	activeVoices.remove(voice);
 
 	if (shouldDispose) {
 		if (voice >= staticVoices && voice < &staticVoices[kNumVoicesStatic]) {
@@ -1496,6 +1661,15 @@ LiveInputBuffer* getOrCreateLiveInputBuffer(OscType inputType, bool mayCreate) {
 
 bool createdNewRecorder;
 
+bool anyRecorderBackedUp() {
+	for (SampleRecorder* recorder = firstRecorder; recorder; recorder = recorder->next) {
+		if (recorder->status < RecorderStatus::COMPLETE && !recorder->hadCardError && recorder->isBackedUp()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void doRecorderCardRoutines() {
 
 	SampleRecorder** prevPointer = &firstRecorder;
@@ -21,6 +21,7 @@
 #include "dsp/compressor/rms_feedback.h"
 #include "dsp/envelope_follower/absolute_value.h"
 #include "model/output.h"
+#include "processing/engines/render_stats.h"
 #include <cstdint>
 
 extern "C" {
@@ -137,8 +138,7 @@ void previewSample(String* path, FilePointer* filePointer, bool shouldActuallySo
 void stopAnyPreviewing();
 
 Voice* solicitVoice(Sound* forSound);
-void unassignVoice(Voice* voice, Sound* sound, ModelStackWithSoundFlags* modelStack = NULL,
-                   bool removeFromVector = true, bool shouldDispose = true);
+void unassignVoice(Voice* voice, Sound* sound, ModelStackWithSoundFlags* modelStack = NULL, bool shouldDispose = true);
 void disposeOfVoice(Voice* voice);
 
 void songSwapAboutToHappen();
@@ -181,6 +181,9 @@ int32_t getNumVoices();
 bool doSomeOutputting();
 void updateReverbParams();
 
+/// Prints renderStats over the debug output
+void logRenderStats();
+
 extern bool headphonesPluggedIn;
 extern bool micPluggedIn;
 extern bool lineInPluggedIn;
@@ -210,4 +213,8 @@ extern uint32_t timeLastSideChainHit;
 extern int32_t sizeLastSideChainHit;
 extern StereoFloatSample approxRMSLevel;
 extern AbsValueFollower envelopeFollower;
+/// Cost of each audio window rendered by routine_(), in CPU cycles
+extern RenderStats renderStats;
+/// Cycles spent in Voice::render() so far this window - Sounds add to this so the rest can be attributed to overhead
+extern uint32_t voiceRenderCyclesThisWindow;
 } // namespace AudioEngine
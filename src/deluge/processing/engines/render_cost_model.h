@@ -0,0 +1,118 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/*
+ * Render cost model used for lookahead voice culling.
+ *
+ * Reactive culling (AudioEngine's setDireness() / cullVoices()) only notices a problem once a window has already taken
+ * too long, by which point it has to cut voices hard. Instead, each Sound learns what one of its voices costs to render
+ * per sample, from the cycle counts it measures while rendering, and the AudioEngine learns what everything else
+ * (song FX, reverb, clips etc.) costs per sample. Summing those for the voices currently sounding predicts the cost of
+ * the next window before it's rendered, so voices can be released gracefully - or not started in the first place -
+ * while there's still headroom.
+ *
+ * All costs are in CPU cycles per sample, held with kFractionalBits of fraction and rounded at each step so that the
+ * smoothing settles on the measured value rather than just short of it.
+ */
+
+/// Running estimate of the cycles it takes to render one voice of a Sound for one sample
+class VoiceCostEstimate {
+public:
+	static constexpr int32_t kFractionalBits = 4;
+	/// Each new measurement moves the estimate 1/(2^kSmoothingShift) of the way towards it
+	static constexpr int32_t kSmoothingShift = 3;
+	/// Where Sounds start out until they've rendered something. Deliberately on the pessimistic side of a simple synth
+	/// voice, so a newly loaded heavy patch doesn't get a free pass for its first few windows
+	static constexpr uint32_t kInitialCyclesPerVoiceSample = 160;
+
+	constexpr void noteRender(uint32_t cycles, int32_t numVoices, int32_t numSamples) {
+		if (numVoices <= 0 || numSamples <= 0) {
+			return;
+		}
+		int32_t measured = (int32_t)((cycles << kFractionalBits) / (uint32_t)(numVoices * numSamples));
+		cost_ += (measured - cost_ + (1 << (kSmoothingShift - 1))) >> kSmoothingShift;
+	}
+
+	[[nodiscard]] constexpr uint32_t cyclesPerVoiceSample() const {
+		return (uint32_t)(cost_ + (1 << (kFractionalBits - 1))) >> kFractionalBits;
+	}
+
+	constexpr void reset() { cost_ = kInitialCyclesPerVoiceSample << kFractionalBits; }
+
+private:
+	int32_t cost_ = kInitialCyclesPerVoiceSample << kFractionalBits;
+};
+
+/// Predicts the cost of the next window from the voices about to be rendered plus what the rest of the engine has
+/// been costing lately, and compares it against the budget beyond which the reactive culling would kick in.
+class RenderCostPredictor {
+public:
+	static constexpr int32_t kFractionalBits = VoiceCostEstimate::kFractionalBits;
+	static constexpr int32_t kSmoothingShift = 4;
+
+	/// @param softLimitCyclesPerSample cost per sample above which we start releasing voices early
+	/// @param hardLimitCyclesPerSample cost per sample above which we'd rather not start a new voice at all
+	constexpr RenderCostPredictor(uint32_t softLimitCyclesPerSample, uint32_t hardLimitCyclesPerSample)
+	    : softLimit_(softLimitCyclesPerSample), hardLimit_(hardLimitCyclesPerSample) {}
+
+	/// Learn the non-voice overhead from a rendered window
+	/// @param totalCycles cycles the whole window took
+	/// @param voiceCycles of which were spent rendering voices (as reported to the VoiceCostEstimates)
+	constexpr void noteWindow(uint32_t totalCycles, uint32_t voiceCycles, int32_t numSamples) {
+		if (numSamples <= 0) {
+			return;
+		}
+		uint32_t otherCycles = (totalCycles > voiceCycles) ? totalCycles - voiceCycles : 0;
+		int32_t measured = (int32_t)((otherCycles << kFractionalBits) / (uint32_t)numSamples);
+		overhead_ += (measured - overhead_ + (1 << (kSmoothingShift - 1))) >> kSmoothingShift;
+	}
+
+	[[nodiscard]] constexpr uint32_t overheadCyclesPerSample() const {
+		return (uint32_t)(overhead_ + (1 << (kFractionalBits - 1))) >> kFractionalBits;
+	}
+
+	/// Predicted cycles per sample for a window with voices costing voiceCyclesPerSample in total
+	[[nodiscard]] constexpr uint32_t predictCyclesPerSample(uint32_t voiceCyclesPerSample) const {
+		return overheadCyclesPerSample() + voiceCyclesPerSample;
+	}
+
+	/// How many cycles per sample over the soft limit we'd be - 0 if within it
+	[[nodiscard]] constexpr uint32_t cyclesPerSampleOverSoftLimit(uint32_t voiceCyclesPerSample) const {
+		uint32_t predicted = predictCyclesPerSample(voiceCyclesPerSample);
+		return (predicted > softLimit_) ? predicted - softLimit_ : 0;
+	}
+
+	/// Whether adding a voice of the given cost would take us past the soft / hard limits
+	[[nodiscard]] constexpr bool wouldExceedSoftLimit(uint32_t voiceCyclesPerSample, uint32_t newVoiceCost) const {
+		return predictCyclesPerSample(voiceCyclesPerSample + newVoiceCost) > softLimit_;
+	}
+	[[nodiscard]] constexpr bool wouldExceedHardLimit(uint32_t voiceCyclesPerSample, uint32_t newVoiceCost) const {
+		return predictCyclesPerSample(voiceCyclesPerSample + newVoiceCost) > hardLimit_;
+	}
+
+	[[nodiscard]] constexpr uint32_t softLimit() const { return softLimit_; }
+	[[nodiscard]] constexpr uint32_t hardLimit() const { return hardLimit_; }
+
+private:
+	uint32_t softLimit_;
+	uint32_t hardLimit_;
+	int32_t overhead_ = 0;
+};
@@ -0,0 +1,139 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+/// Accumulates the cost of rendering audio windows, so we can put actual numbers on render performance rather than
+/// finding regressions by ear. The same accounting is used by AudioEngine::routine_() on the hardware (counting CPU
+/// cycles) and by the host-side benchmarks in tests/benchmark (counting nanoseconds) - hence the "ticks", whose rate is
+/// supplied by whoever owns the stats.
+///
+/// Deliberately free of any hardware or engine dependencies so it can be compiled anywhere.
+class RenderStats {
+public:
+	/// @param ticksPerSecond rate of whatever the window times are measured in
+	/// @param sampleRate audio sample rate the windows are rendered at
+	constexpr RenderStats(uint32_t ticksPerSecond, uint32_t sampleRate)
+	    : ticksPerSecond_(ticksPerSecond), sampleRate_(sampleRate) {}
+
+	/// Record one rendered window
+	/// @param numSamples length of the window in samples
+	/// @param ticks time taken to render it
+	/// @param numVoices voices (plus audio clips) sounding while it was rendered
+	constexpr void noteWindow(uint32_t numSamples, uint32_t ticks, int32_t numVoices) {
+		if (numSamples == 0) {
+			return;
+		}
+		numWindows_++;
+		totalSamples_ += numSamples;
+		totalTicks_ += ticks;
+		totalVoiceSamples_ += (uint64_t)std::max<int32_t>(numVoices, 0) * numSamples;
+		minTicks_ = std::min(minTicks_, ticks);
+		maxTicks_ = std::max(maxTicks_, ticks);
+		maxVoices_ = std::max(maxVoices_, numVoices);
+		uint32_t ticksPerSampleThisWindow = ticks / numSamples;
+		maxTicksPerSample_ = std::max(maxTicksPerSample_, ticksPerSampleThisWindow);
+	}
+
+	/// Record that the engine had to start culling, and how many voices were sounding when it did
+	constexpr void noteCull(int32_t numVoices) {
+		numCulls_++;
+		if (voicesAtFirstCull_ < 0) {
+			voicesAtFirstCull_ = numVoices;
+		}
+	}
+
+	constexpr void reset() {
+		numWindows_ = 0;
+		numCulls_ = 0;
+		totalSamples_ = 0;
+		totalTicks_ = 0;
+		totalVoiceSamples_ = 0;
+		minTicks_ = UINT32_MAX;
+		maxTicks_ = 0;
+		maxTicksPerSample_ = 0;
+		maxVoices_ = 0;
+		voicesAtFirstCull_ = -1;
+	}
+
+	[[nodiscard]] constexpr uint32_t numWindows() const { return numWindows_; }
+	[[nodiscard]] constexpr uint32_t numCulls() const { return numCulls_; }
+	[[nodiscard]] constexpr uint64_t totalSamples() const { return totalSamples_; }
+	[[nodiscard]] constexpr uint64_t totalTicks() const { return totalTicks_; }
+	[[nodiscard]] constexpr uint32_t minTicksPerWindow() const { return numWindows_ ? minTicks_ : 0; }
+	[[nodiscard]] constexpr uint32_t maxTicksPerWindow() const { return maxTicks_; }
+	[[nodiscard]] constexpr uint32_t maxTicksPerSample() const { return maxTicksPerSample_; }
+	[[nodiscard]] constexpr int32_t maxVoices() const { return maxVoices_; }
+	/// -1 if no culling has happened since the last reset
+	[[nodiscard]] constexpr int32_t voicesAtFirstCull() const { return voicesAtFirstCull_; }
+
+	[[nodiscard]] constexpr uint32_t averageTicksPerWindow() const {
+		return numWindows_ ? (uint32_t)(totalTicks_ / numWindows_) : 0;
+	}
+
+	[[nodiscard]] constexpr uint32_t averageTicksPerSample() const {
+		return totalSamples_ ? (uint32_t)(totalTicks_ / totalSamples_) : 0;
+	}
+
+	/// Average number of voices sounding, weighted by window length
+	[[nodiscard]] constexpr float averageVoices() const {
+		return totalSamples_ ? (float)totalVoiceSamples_ / (float)totalSamples_ : 0;
+	}
+
+	/// How many samples of audio we'd render per second of CPU time. Above sampleRate means faster than realtime
+	[[nodiscard]] constexpr float samplesPerSecond() const {
+		return totalTicks_ ? (float)totalSamples_ * (float)ticksPerSecond_ / (float)totalTicks_ : 0;
+	}
+
+	/// Proportion of realtime spent rendering - 1 means we only just kept up
+	[[nodiscard]] constexpr float load() const {
+		float sps = samplesPerSecond();
+		return sps ? (float)sampleRate_ / sps : 0;
+	}
+
+	/// Estimate how many voices could sound before a render takes longer than cullLimitSamples worth of realtime for a
+	/// window of windowSamples - i.e. where AudioEngine's culling would kick in. This assumes cost is linear in voices,
+	/// which is near enough for a corpus of one song at a time. Returns -1 if there weren't any voices to go by.
+	[[nodiscard]] constexpr int32_t estimateVoicesAtCull(uint32_t cullLimitSamples, uint32_t windowSamples) const {
+		float voices = averageVoices();
+		if (voices < 1 || !totalSamples_) {
+			return -1;
+		}
+		float ticksPerSample = (float)totalTicks_ / (float)totalSamples_;
+		float limitTicksPerSample =
+		    (float)ticksPerSecond_ / (float)sampleRate_ * (float)cullLimitSamples / (float)windowSamples;
+		return (int32_t)(voices * limitTicksPerSample / ticksPerSample);
+	}
+
+private:
+	uint32_t ticksPerSecond_;
+	uint32_t sampleRate_;
+
+	uint32_t numWindows_ = 0;
+	uint32_t numCulls_ = 0;
+	uint64_t totalSamples_ = 0;
+	uint64_t totalTicks_ = 0;
+	uint64_t totalVoiceSamples_ = 0;
+	uint32_t minTicks_ = UINT32_MAX;
+	uint32_t maxTicks_ = 0;
+	uint32_t maxTicksPerSample_ = 0;
+	int32_t maxVoices_ = 0;
+	int32_t voicesAtFirstCull_ = -1;
+};
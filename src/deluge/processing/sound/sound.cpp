@@ -18,6 +18,7 @@
 #include "processing/sound/sound.h"
 #include "definitions_cxx.hpp"
 #include "dsp/dx/engine.h"
+#include "dsp/voice_batch.h"
 #include "gui/l10n/l10n.h"
 #include "gui/ui/root_ui.h"
 #include "gui/ui/sound_editor.h"
@@ -27,6 +28,7 @@
 #include "hid/led/indicator_leds.h"
 #include "hid/matrix/matrix_driver.h"
 #include "io/debug/log.h"
+#include "io/debug/print.h"
 #include "memory/general_memory_allocator.h"
 #include "model/action/action.h"
 #include "model/action/action_logger.h"
@@ -48,6 +50,7 @@
 #include "playback/playback_handler.h"
 #include "processing/engines/audio_engine.h"
 #include "processing/sound/sound_instrument.h"
+#include "processing/stem_export/stem_export.h"
 #include "storage/audio/audio_file_manager.h"
 #include "storage/flash_storage.h"
 #include "storage/multi_range/multi_wave_table_range.h"
@@ -63,6 +66,8 @@ namespace params = deluge::modulation::params;
 extern "C" {
 #include "RZA1/mtu/mtu.h"
 }
+
+extern int32_t voiceBatchRenderingBuffer[][SSI_TX_BUFFER_NUM_SAMPLES * 2];
 #pragma GCC diagnostic push
 // This is supported by GCC and other compilers should error (not warn), so turn off for this file
 #pragma GCC diagnostic ignored "-Winvalid-offsetof"
@@ -92,6 +97,7 @@ Sound::Sound() : patcher(&patchableInfoForSound) {
 	}
 
 	numVoicesAssigned = 0;
+	firstAssignedVoice = nullptr;
 
 	sideChainSendLevel = 0;
 	polyphonic = PolyphonyMode::POLY;
@@ -445,10 +451,7 @@ void Sound::recalculatePatchingToParam(uint8_t p, ParamManagerForTimeline* param
 		// Or local (do to each voice)...
 		else {
 			if (numVoicesAssigned) {
-				int32_t ends[2];
-				AudioEngine::activeVoices.getRangeForSound(this, ends);
-				for (int32_t v = ends[0]; v < ends[1]; v++) {
-					Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+				for (Voice* thisVoice : AudioEngine::activeVoices.forSound(this)) {
 					thisVoice->patcher.recalculateFinalValueForParamWithNoCables(p, this, paramManager);
 				}
 			}
@@ -1303,6 +1306,11 @@ Error Sound::readTagFromFile(Deserializer& reader, char const* tagName, ParamMan
 		reader.exitTag("maxVoices");
 	}
 
+	else if (!strcmp(tagName, "preloadSamplesUpToKB")) {
+		preloadSamplesUpToKB = reader.readTagOrAttributeValueInt();
+		reader.exitTag("preloadSamplesUpToKB");
+	}
+
 	else if (!strcmp(tagName, "voicePriority")) {
 		voicePriority = static_cast<VoicePriority>(reader.readTagOrAttributeValueInt());
 		reader.exitTag("voicePriority");
@@ -1575,10 +1583,7 @@ void Sound::noteOnPostArpeggiator(ModelStackWithSoundFlags* modelStack, int32_t
 	// If not polyphonic, stop any notes which are releasing, now
 	if (numVoicesAssigned && polyphonic != PolyphonyMode::POLY) [[unlikely]] {
 
-		int32_t ends[2];
-		AudioEngine::activeVoices.getRangeForSound(this, ends);
-		for (int32_t v = ends[0]; v < ends[1]; v++) {
-			Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+		for (Voice* thisVoice : AudioEngine::activeVoices.forSound(this)) {
 
 			// If we're proper-MONO, or it's releasing OR has no sustain / note tails
 			if (polyphonic == PolyphonyMode::MONO || thisVoice->envelopes[0].state >= EnvelopeStage::RELEASE
@@ -1602,8 +1607,6 @@ justUnassign:
 							AudioEngine::activeVoices.checkVoiceExists(thisVoice, this, "E198");
 						}
 						AudioEngine::unassignVoice(thisVoice, this, modelStack);
-						v--;
-						ends[1]--;
 					}
 				}
 				else {
@@ -1712,10 +1715,7 @@ void Sound::noteOffPostArpeggiator(ModelStackWithSoundFlags* modelStack, int32_t
 		return;
 	}
 
-	int32_t ends[2];
-	AudioEngine::activeVoices.getRangeForSound(this, ends);
-	for (int32_t v = ends[0]; v < ends[1]; v++) {
-		Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+	for (Voice* thisVoice : AudioEngine::activeVoices.forSound(this)) {
 		if ((thisVoice->noteCodeAfterArpeggiation == noteCode || noteCode == ALL_NOTES_OFF)
 		    && thisVoice->envelopes[0].state < EnvelopeStage::RELEASE) { // Don't bother if it's already "releasing"
 
@@ -1772,6 +1772,26 @@ justSwitchOff:
 	}
 }
 
+void Sound::prefetchForUpcomingNote(int32_t noteCode, uint32_t timeTilNeeded) {
+	if (synthMode == SynthMode::FM) {
+		return;
+	}
+
+	for (int32_t s = 0; s < kNumSources; s++) {
+		Source* source = &sources[s];
+		if (source->oscType != OscType::SAMPLE) {
+			continue;
+		}
+
+		// Same Range as Voice::noteOn() will pick
+		MultiRange* range = source->getRange(noteCode + transpose);
+		if (range) {
+			audioFileManager.prefetchClustersForNote((SampleHolder*)range->getAudioFileHolder(),
+			                                         source->sampleControls.reversed, timeTilNeeded);
+		}
+	}
+}
+
 bool Sound::allowNoteTails(ModelStackWithSoundFlags* modelStack, bool disregardSampleLoop) {
 	// Return yes unless all active sources are play-once samples, or envelope 0 has no sustain
 
@@ -2000,17 +2020,12 @@ void Sound::sampleZoneChanged(MarkerType markerType, int32_t s, ModelStackWithSo
 		markerType = static_cast<MarkerType>(kNumMarkerTypes - 1 - util::to_underlying(markerType));
 	}
 
-	int32_t ends[2];
-	AudioEngine::activeVoices.getRangeForSound(this, ends);
-	for (int32_t v = ends[0]; v < ends[1]; v++) {
-		Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+	for (Voice* thisVoice : AudioEngine::activeVoices.forSound(this)) {
 		ModelStackWithVoice* modelStackWithVoice = modelStack->addVoice(thisVoice);
 		bool stillGoing = thisVoice->sampleZoneChanged(modelStackWithVoice, s, markerType);
 		if (!stillGoing) {
 			AudioEngine::activeVoices.checkVoiceExists(thisVoice, this, "E200");
 			AudioEngine::unassignVoice(thisVoice, this, modelStack);
-			v--;
-			ends[1]--;
 		}
 	}
 }
@@ -2032,7 +2047,7 @@ void Sound::reassessRenderSkippingStatus(ModelStackWithSoundFlags* modelStack, b
 		if (skippingStatusNow) {
 
 			// We wanna start, skipping, but if MOD fx are on...
-			if ((modFXType != ModFXType::NONE) || compressor.getThreshold() > 0) {
+			if ((modFXType != ModFXType::NONE) || compressor.getThreshold() > 0 || convolution.isActive()) {
 
 				// If we didn't start the wait-time yet, start it now
 				if (!startSkippingRenderingAtTime) {
@@ -2041,6 +2056,7 @@ void Sound::reassessRenderSkippingStatus(ModelStackWithSoundFlags* modelStack, b
 					if (shouldJustCutModFX) {
 doCutModFXTail:
 						clearModFXMemory();
+						convolution.reset();
 						goto yupStartSkipping;
 					}
 
@@ -2337,10 +2353,13 @@ void Sound::render(ModelStackWithThreeMainThings* modelStack, StereoSample* outp
 		bool doneFirstVoice = false;
 		*/
 
-		int32_t ends[2];
-		AudioEngine::activeVoices.getRangeForSound(this, ends);
-		for (int32_t v = ends[0]; v < ends[1]; v++) {
-			Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+		// Plain mono voices get mixed in groups rather than one at a time - see dsp::VoiceBatch
+		dsp::VoiceBatch voiceBatch{{voiceBatchRenderingBuffer[0], voiceBatchRenderingBuffer[1],
+		                            voiceBatchRenderingBuffer[2], voiceBatchRenderingBuffer[3]}};
+
+		int32_t numVoicesRendered = numVoicesAssigned;
+		uint32_t voicesStartTime = Debug::readCycleCounter();
+		for (Voice* thisVoice : AudioEngine::activeVoices.forSound(this)) {
 			/*
 			if (!doneFirstVoice) {
 			    if (numVoicesAssigned > 1) {
@@ -2355,14 +2374,21 @@ void Sound::render(ModelStackWithThreeMainThings* modelStack, StereoSample* outp
 			ModelStackWithVoice* modelStackWithVoice = modelStackWithSoundFlags->addVoice(thisVoice);
 
 			bool stillGoing = thisVoice->render(modelStackWithVoice, soundBuffer, numSamples, renderingInStereo,
-			                                    applyingPanAtVoiceLevel, sourcesChanged, doLPF, doHPF, pitchAdjust);
+			                                    applyingPanAtVoiceLevel, sourcesChanged, doLPF, doHPF, pitchAdjust,
+			                                    &voiceBatch);
+			// The batch may be holding on to this voice's filter, so it has to be done with it before it's unassigned
+			if (voiceBatch.full() || !stillGoing) {
+				voiceBatch.render(soundBuffer, numSamples, renderingInStereo);
+			}
 			if (!stillGoing) {
 				AudioEngine::activeVoices.checkVoiceExists(thisVoice, this, "E201");
 				AudioEngine::unassignVoice(thisVoice, this, modelStackWithSoundFlags);
-				v--;
-				ends[1]--;
 			}
 		}
+		voiceBatch.render(soundBuffer, numSamples, renderingInStereo);
+		uint32_t voicesCycles = Debug::readCycleCounter() - voicesStartTime;
+		voiceCost.noteRender(voicesCycles, numVoicesRendered, numSamples);
+		AudioEngine::voiceRenderCyclesThisWindow += voicesCycles;
 
 		// If just rendered in mono, double that up to stereo now
 		if (!renderingInStereo) {
@@ -2452,7 +2478,7 @@ void Sound::render(ModelStackWithThreeMainThings* modelStack, StereoSample* outp
 
 	if (recorder && recorder->status < RecorderStatus::FINISHED_CAPTURING_BUT_STILL_WRITING) {
 		// we need to double it because for reasons I don't understand audio clips max volume is half the sample volume
-		recorder->feedAudio(soundBuffer, numSamples, true, 2);
+		recorder->feedAudio(soundBuffer, numSamples, true, stemExport.getOutputRecorderGain(2));
 	}
 	addAudio((StereoSample*)soundBuffer, outputBuffer, numSamples);
 
@@ -2548,19 +2574,10 @@ void Sound::unassignAllVoices() {
 		return;
 	}
 
-	int32_t ends[2];
-	AudioEngine::activeVoices.getRangeForSound(this, ends);
-	for (int32_t v = ends[0]; v < ends[1]; v++) {
-		Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+	for (Voice* thisVoice : AudioEngine::activeVoices.forSound(this)) {
 		// ronronsen got error! https://forums.synthstrom.com/discussion/4090/e203-by-changing-a-drum-kit#latest
 		AudioEngine::activeVoices.checkVoiceExists(thisVoice, this, "E203");
-		AudioEngine::unassignVoice(thisVoice, this, NULL,
-		                           false); // Don't remove from Vector - we'll do that below, in bulk
-	}
-
-	int32_t numToDelete = ends[1] - ends[0];
-	if (numToDelete) {
-		AudioEngine::activeVoices.deleteAtIndex(ends[0], numToDelete);
+		AudioEngine::unassignVoice(thisVoice, this, NULL);
 	}
 
 	if (ALPHA_OR_BETA_VERSION) {
@@ -2864,6 +2881,7 @@ void Sound::ensureParamPresetValueWithoutKnobIsZeroWithMinimalDetails(ParamManag
 
 void Sound::doneReadingFromFile() {
 	calculateEffectiveVolume();
+	oscKernelsValid = false;
 
 	for (int32_t s = 0; s < kNumSources; s++) {
 		sources[s].doneReadingFromFile(this);
@@ -2932,6 +2950,15 @@ void Sound::calculateEffectiveVolume() {
 	volumeNeutralValueForUnison = (float)134217728 / sqrtf(numUnison);
 }
 
+void Sound::recalculateOscKernels() {
+	// Ring modulation renders the oscillators at a fixed level and multiplies them together before applying amplitude
+	bool applyAmplitude = (synthMode != SynthMode::RINGMOD);
+	for (int32_t s = 0; s < kNumSources; s++) {
+		oscKernels[s] = deluge::dsp::getOscKernels(sources[s].oscType, applyAmplitude, numUnison);
+	}
+	oscKernelsValid = true;
+}
+
 // May change mod knob functions. You must update mod knob levels after calling this
 void Sound::setSynthMode(SynthMode value, Song* song) {
 
@@ -2939,6 +2966,7 @@ void Sound::setSynthMode(SynthMode value, Song* song) {
 
 	SynthMode oldSynthMode = synthMode;
 	synthMode = value;
+	oscKernelsValid = false;
 	setupPatchingForAllParamManagers(song);
 
 	// Change mod knob functions over. Switching *to* FM...
@@ -3004,10 +3032,7 @@ void Sound::recalculateAllVoicePhaseIncrements(ModelStackWithSoundFlags* modelSt
 		return; // These two "should" always be false in tandem...
 	}
 
-	int32_t ends[2];
-	AudioEngine::activeVoices.getRangeForSound(this, ends);
-	for (int32_t v = ends[0]; v < ends[1]; v++) {
-		Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+	for (Voice* thisVoice : AudioEngine::activeVoices.forSound(this)) {
 		ModelStackWithVoice* modelStackWithVoice = modelStack->addVoice(thisVoice);
 		thisVoice->calculatePhaseIncrements(modelStackWithVoice);
 	}
@@ -3017,6 +3042,7 @@ void Sound::setNumUnison(int32_t newNum, ModelStackWithSoundFlags* modelStack) {
 	int32_t oldNum = numUnison;
 
 	numUnison = newNum;
+	oscKernelsValid = false;
 	setupUnisonDetuners(modelStack); // Can handle NULL. Also calls recalculateAllVoicePhaseIncrements()
 	setupUnisonStereoSpread();
 	calculateEffectiveVolume();
@@ -3024,10 +3050,7 @@ void Sound::setNumUnison(int32_t newNum, ModelStackWithSoundFlags* modelStack) {
 	// Effective volume has changed. Need to pass that change onto Voices
 	if (numVoicesAssigned) {
 
-		int32_t ends[2];
-		AudioEngine::activeVoices.getRangeForSound(this, ends);
-		for (int32_t v = ends[0]; v < ends[1]; v++) {
-			Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+		for (Voice* thisVoice : AudioEngine::activeVoices.forSound(this)) {
 
 			if (synthMode == SynthMode::SUBTRACTIVE) {
 
@@ -4035,6 +4058,9 @@ void Sound::writeToFile(Serializer& writer, bool savingSong, ParamManager* param
 		writer.writeAttribute("path", pathAttribute);
 	}
 	writer.writeAttribute("maxVoices", maxVoiceCount);
+	if (preloadSamplesUpToKB != 0) {
+		writer.writeAttribute("preloadSamplesUpToKB", preloadSamplesUpToKB);
+	}
 
 	writer.writeOpeningTagEnd(); // -------------------------------------------------------------------------
 
@@ -4185,9 +4211,33 @@ Error Sound::loadAllAudioFiles(bool mayActuallyReadFiles) {
 		}
 	}
 
+	convolution.loadImpulseResponse(mayActuallyReadFiles); // A missing impulse response just means no convolution
+
+	if (mayActuallyReadFiles) {
+		preloadSamples();
+	}
+
 	return Error::NONE;
 }
 
+void Sound::preloadSamples() {
+	if (preloadSamplesUpToKB == 0) {
+		return;
+	}
+
+	for (int32_t s = 0; s < kNumSources; s++) {
+		if (sources[s].oscType != OscType::SAMPLE) {
+			continue;
+		}
+		for (int32_t e = 0; e < sources[s].ranges.getNumElements(); e++) {
+			Sample* sample = (Sample*)sources[s].ranges.getElement(e)->getAudioFileHolder()->audioFile;
+			if (sample && sample->audioDataLengthBytes <= (uint64_t)preloadSamplesUpToKB << 10) {
+				audioFileManager.preloadSample(sample);
+			}
+		}
+	}
+}
+
 bool Sound::envelopeHasSustainCurrently(int32_t e, ParamManagerForTimeline* paramManager) {
 
 	PatchedParamSet* patchedParams = paramManager->getPatchedParamSet();
@@ -4570,17 +4620,12 @@ void Sound::fastReleaseAllVoices(ModelStackWithSoundFlags* modelStack) {
 		return;
 	}
 
-	int32_t ends[2];
-	AudioEngine::activeVoices.getRangeForSound(this, ends);
-	for (int32_t v = ends[0]; v < ends[1]; v++) {
-		Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+	for (Voice* thisVoice : AudioEngine::activeVoices.forSound(this)) {
 		bool stillGoing = thisVoice->doFastRelease();
 
 		if (!stillGoing) {
 			AudioEngine::activeVoices.checkVoiceExists(thisVoice, this, "E212");
 			AudioEngine::unassignVoice(thisVoice, this, modelStack); // Accepts NULL
-			v--;
-			ends[1]--;
 		}
 	}
 }
@@ -4686,10 +4731,7 @@ bool Sound::renderingVoicesInStereo(ModelStackWithSoundFlags* modelStack) {
 	// investigate each Voice
 	if (mustExamineSourceInEachVoice) {
 
-		int32_t ends[2];
-		AudioEngine::activeVoices.getRangeForSound(this, ends);
-		for (int32_t v = ends[0]; v < ends[1]; v++) {
-			Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+		for (Voice* thisVoice : AudioEngine::activeVoices.forSound(this)) {
 
 			for (int32_t s = 0; s < kNumSources; s++) {
 				if (mustExamineSourceInEachVoice & (1 << s)) {
@@ -18,6 +18,8 @@
 #pragma once
 
 #include "definitions_cxx.hpp"
+#include "dsp/osc_kernels.h"
+#include "dsp/voice_output.h"
 #include "model/mod_controllable/mod_controllable_audio.h"
 #include "model/sample/sample_recorder.h"
 #include "modulation/arpeggiator.h"
@@ -28,6 +30,7 @@
 #include "modulation/params/param_set.h"
 #include "modulation/patch/patcher.h"
 #include "modulation/sidechain/sidechain.h"
+#include "processing/engines/render_cost_model.h"
 #include "processing/source.h"
 #include "util/misc.h"
 
@@ -91,6 +94,9 @@ public:
 
 	PolyphonyMode polyphonic;
 	uint8_t maxVoiceCount{8};
+	/// Samples whose audio is no bigger than this get loaded whole and kept in RAM, rather than streamed - see
+	/// AudioFileManager::preloadSample(). 0 means never
+	uint32_t preloadSamplesUpToKB{0};
 
 	int16_t transpose;
 
@@ -178,6 +184,9 @@ public:
 	void writeToFile(Serializer& writer, bool savingSong, ParamManager* paramManager, ArpeggiatorSettings* arpSettings,
 	                 const char* pathAttribute = NULL);
 	bool allowNoteTails(ModelStackWithSoundFlags* modelStack, bool disregardSampleLoop = false);
+	/// Called by the sequencer when it knows noteCode will be played in timeTilNeeded samples, to get the sample data
+	/// beyond what each SampleHolder already keeps loaded on its way from the card in time
+	void prefetchForUpcomingNote(int32_t noteCode, uint32_t timeTilNeeded);
 
 	void voiceUnassigned(ModelStackWithVoice* modelStack);
 	bool isSourceActiveCurrently(int32_t s, ParamManagerForTimeline* paramManager);
@@ -204,6 +213,7 @@ public:
 	void setupAsSample(ParamManagerForTimeline* paramManager);
 	void recalculateAllVoicePhaseIncrements(ModelStackWithSoundFlags* modelStack);
 	Error loadAllAudioFiles(bool mayActuallyReadFiles);
+	void preloadSamples();
 	bool envelopeHasSustainCurrently(int32_t e, ParamManagerForTimeline* paramManager);
 	bool envelopeHasSustainEver(int32_t e, ParamManagerForTimeline* paramManager);
 	bool renderingOscillatorSyncCurrently(ParamManagerForTimeline* paramManager);
@@ -263,15 +273,27 @@ public:
 	inline void saturate(int32_t* data, uint32_t* workingValue) {
 		// Clipping
 		if (clippingAmount) {
-			int32_t shiftAmount = (clippingAmount >= 2) ? (clippingAmount - 2) : 0;
-			//*data = getTanHUnknown(*data, 5 + clippingAmount) << (shiftAmount);
-			*data = getTanHAntialiased(*data, workingValue, 5 + clippingAmount) << (shiftAmount);
+			deluge::dsp::saturate(data, workingValue, clippingAmount);
 		}
 	}
 	int32_t numVoicesAssigned;
+	/// Head of the list of our voices in AudioEngine::activeVoices - iterate them with activeVoices.forSound()
+	Voice* firstAssignedVoice;
+	/// What one of our voices costs to render, learned in render(). Used by AudioEngine to cull ahead of overloads
+	VoiceCostEstimate voiceCost;
 	uint32_t getSyncedLFOPhaseIncrement(const LFOConfig& config);
 
+	/// The kernels Voice::renderOsc() uses for source s. Worked out again on the first render after setSynthMode(),
+	/// setNumUnison() or reading from file, or after the source's osc type changes
+	inline deluge::dsp::OscKernels const& getOscKernels(int32_t s) {
+		if (!oscKernelsValid || oscKernels[s].type != sources[s].oscType) [[unlikely]] {
+			recalculateOscKernels();
+		}
+		return oscKernels[s];
+	}
+
 private:
+	void recalculateOscKernels();
 	uint32_t getGlobalLFOPhaseIncrement();
 	void recalculateModulatorTransposer(uint8_t m, ModelStackWithSoundFlags* modelStack);
 	void setupUnisonDetuners(ModelStackWithSoundFlags* modelStack);
@@ -295,4 +317,7 @@ private:
 	ModelStackWithAutoParam* getParamFromModEncoderDeeper(int32_t whichModEncoder,
 	                                                      ModelStackWithThreeMainThings* modelStack,
 	                                                      bool allowCreation = true);
+
+	deluge::dsp::OscKernels oscKernels[kNumSources];
+	bool oscKernelsValid{false};
 };
@@ -82,10 +82,7 @@ bool SoundDrum::hasAnyVoices() {
 void SoundDrum::resetTimeEnteredState() {
 
 	// the sound drum might have multiple voices sounding, but only one will be sustaining and switched to hold
-	int32_t ends[2];
-	AudioEngine::activeVoices.getRangeForSound(this, ends);
-	for (int32_t v = ends[0]; v < ends[1]; v++) {
-		Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+	for (Voice* thisVoice : AudioEngine::activeVoices.forSound(this)) {
 		thisVoice->envelopes[0].resetTimeEntered();
 	}
 }
@@ -113,10 +110,7 @@ void SoundDrum::expressionEvent(int32_t newValue, int32_t whichExpressionDimensi
 
 	// sourcesChanged |= 1 << s; // We'd ideally not want to apply this to all voices though...
 
-	int32_t ends[2];
-	AudioEngine::activeVoices.getRangeForSound(this, ends);
-	for (int32_t v = ends[0]; v < ends[1]; v++) {
-		Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+	for (Voice* thisVoice : AudioEngine::activeVoices.forSound(this)) {
 		if (expressionValueChangesMustBeDoneSmoothly) {
 			thisVoice->expressionEventSmooth(newValue, s);
 		}
@@ -332,10 +332,7 @@ void SoundInstrument::polyphonicExpressionEventOnChannelOrNote(int32_t newValue,
 
 	// sourcesChanged |= 1 << s; // We'd ideally not want to apply this to all voices though...
 
-	int32_t ends[2];
-	AudioEngine::activeVoices.getRangeForSound(this, ends);
-	for (int32_t v = ends[0]; v < ends[1]; v++) {
-		Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+	for (Voice* thisVoice : AudioEngine::activeVoices.forSound(this)) {
 		if (thisVoice->inputCharacteristics[util::to_underlying(whichCharacteristic)] == channelOrNoteNumber) {
 			if (expressionValueChangesMustBeDoneSmoothly) {
 				thisVoice->expressionEventSmooth(newValue, s);
@@ -511,10 +508,7 @@ bool SoundInstrument::noteIsOn(int32_t noteCode, bool resetTimeEntered) {
 		return false;
 	}
 
-	int32_t ends[2];
-	AudioEngine::activeVoices.getRangeForSound(this, ends);
-	for (int32_t v = ends[0]; v < ends[1]; v++) {
-		Voice* thisVoice = AudioEngine::activeVoices.getVoice(v);
+	for (Voice* thisVoice : AudioEngine::activeVoices.forSound(this)) {
 		if ((thisVoice->noteCodeAfterArpeggiation == noteCode)
 		    && thisVoice->envelopes[0].state < EnvelopeStage::RELEASE) { // Ignore releasing notes. Is this right?
 			if (resetTimeEntered) {
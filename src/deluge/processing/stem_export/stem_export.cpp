@@ -27,9 +27,11 @@
 #include "hid/display/display.h"
 #include "hid/display/oled.h"
 #include "hid/led/indicator_leds.h"
+#include "io/debug/log.h"
 #include "model/clip/clip.h"
 #include "model/clip/instrument_clip.h"
 #include "model/note/note_row.h"
+#include "model/sample/sample_recorder.h"
 #include "model/song/song.h"
 #include "playback/mode/arrangement.h"
 #include "playback/mode/session.h"
@@ -68,6 +70,7 @@ StemExport::StemExport() {
 	exportToSilence = true;
 	includeSongFX = false;
 	renderOffline = true;
+	exportInSinglePass = false;
 
 	timePlaybackStopped = 0xFFFFFFFF;
 
@@ -101,7 +104,12 @@ void StemExport::startStemExportProcess(StemExportType stemExportType) {
 		elementsProcessed = exportClipStems(stemExportType);
 	}
 	else if (stemExportType == StemExportType::TRACK) {
-		elementsProcessed = exportInstrumentStems(stemExportType);
+		if (exportInSinglePass) {
+			elementsProcessed = exportInstrumentStemsInSinglePass(stemExportType);
+		}
+		else {
+			elementsProcessed = exportInstrumentStems(stemExportType);
+		}
 	}
 
 	// if process wasn't cancelled, then we got here because we finished
@@ -170,7 +178,12 @@ void StemExport::stopOutputRecording() {
 		// if not exporting to silence, stop recording soon
 		// if you cancelled stem export and exited out of UI mode, stop recording soon
 		if (!isUIModeActive(UI_MODE_STEM_EXPORT) || !exportToSilence || (exportToSilence && checkForSilence())) {
-			audioRecorder.endRecordingSoon();
+			if (exportInSinglePass && currentStemExportType == StemExportType::TRACK) {
+				endSinglePassRecordingsSoon();
+			}
+			else {
+				audioRecorder.endRecordingSoon();
+			}
 			stopRecording = false;
 		}
 	}
@@ -316,6 +329,133 @@ int32_t StemExport::exportInstrumentStems(StemExportType stemExportType) {
 	return totalNumOutputs;
 }
 
+/// exports every instrument stem from a single playback of the arrangement. rather than soloing each instrument in
+/// turn, every instrument being exported is unmuted and gets its own recorder, fed straight from that instrument's
+/// render buffer, so the whole export takes one song length instead of one per stem. the recorders all get their
+/// clusters written to the card together, in the recorder card routine
+/// song FX can't be included here, as they only ever apply to the whole mix
+int32_t StemExport::exportInstrumentStemsInSinglePass(StemExportType stemExportType) {
+	// prepare all the instruments for stem export
+	int32_t totalNumOutputs = disarmAllInstrumentsForStemExport();
+
+	if (totalNumStemsToExport) {
+		// unmute everything we're exporting
+		for (int32_t idxOutput = 0; idxOutput < totalNumOutputs; ++idxOutput) {
+			Output* output = currentSong->getOutputFromIndex(idxOutput);
+			if (output && output->exportStem) {
+				output->mutedInArrangementMode = false;
+			}
+		}
+		uiNeedsRendering(getCurrentUI());
+
+		timePlaybackStopped = 0xFFFFFFFF;
+		playbackHandler.playButtonPressed(kInternalButtonPressLatency);
+		if (playbackHandler.isEitherClockActive()) {
+			if (startSinglePassRecorders(totalNumOutputs)) {
+				stopRecording = true;
+				displayStemExportProgress(stemExportType);
+
+				// wait until every recording is done and playback is turned off
+				yield([]() {
+					if (stemExport.stopRecording) {
+						stemExport.stopOutputRecording();
+					}
+					return !(playbackHandler.recording != RecordingMode::OFF
+					         || stemExport.anySinglePassRecordingUnfinished() || playbackHandler.isEitherClockActive());
+				});
+			}
+			// couldn't record anything, so there's no point playing
+			else if (playbackHandler.isEitherClockActive()) {
+				playbackHandler.playButtonPressed(kInternalButtonPressLatency);
+			}
+		}
+
+		numStemsExported = discardSinglePassRecorders();
+	}
+
+	// set instrument mutes back to their previous state (before exporting stems)
+	restoreAllInstrumentMutes(totalNumOutputs);
+
+	return totalNumOutputs;
+}
+
+/// gives every instrument being exported its own recorder, attached to that instrument's output
+/// returns how many recorders were started
+int32_t StemExport::startSinglePassRecorders(int32_t totalNumOutputs) {
+	int32_t numRecorders = 0;
+	for (int32_t idxOutput = totalNumOutputs - 1; idxOutput >= 0; --idxOutput) {
+		Output* output = currentSong->getOutputFromIndex(idxOutput);
+		if (!output || !output->exportStem) {
+			continue;
+		}
+		// An output can only feed one recorder. If it's already being recorded, e.g. into an audio clip, leave it out
+		// rather than failing the whole export
+		if (output->hasRecorder()) {
+			D_PRINTLN("stem export skipping output which already has a recorder");
+			continue;
+		}
+		SampleRecorder* recorder =
+		    AudioEngine::getNewRecorder(2, AudioRecordingFolder::STEMS, AudioInputChannel::SPECIFIC_OUTPUT, false,
+		                                false, kInternalButtonPressLatency, false, output);
+		if (!recorder) {
+			display->displayError(Error::INSUFFICIENT_RAM);
+			break;
+		}
+		recorder->allowFileAlterationAfter = true;
+		recorder->allowNormalization = allowNormalization;
+		numRecorders++;
+	}
+
+	if (numRecorders) {
+		indicator_leds::blinkLed(IndicatorLED::RECORD, 255, 1);
+		// same as when resampling - don't want voices culled right as recording begins
+		AudioEngine::bypassCulling = true;
+	}
+	return numRecorders;
+}
+
+/// the single pass equivalent of AudioRecorder::endRecordingSoon()
+void StemExport::endSinglePassRecordingsSoon() {
+	for (SampleRecorder* recorder = AudioEngine::firstRecorder; recorder; recorder = recorder->next) {
+		if (recorder->mode == AudioInputChannel::SPECIFIC_OUTPUT
+		    && recorder->status == RecorderStatus::CAPTURING_DATA) {
+			recorder->endSyncedRecording(0);
+		}
+	}
+	display->displayLoadingAnimationText("Working");
+}
+
+/// a recording is finished once its file is complete, or once the card's given up on it
+bool StemExport::anySinglePassRecordingUnfinished() {
+	for (SampleRecorder* recorder = AudioEngine::firstRecorder; recorder; recorder = recorder->next) {
+		if (recorder->mode == AudioInputChannel::SPECIFIC_OUTPUT && recorder->status < RecorderStatus::COMPLETE
+		    && !recorder->hadCardError) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/// gets rid of the single pass recorders once they're done with. returns how many stems were written successfully
+int32_t StemExport::discardSinglePassRecorders() {
+	int32_t numStemsWritten = 0;
+	SampleRecorder* recorder = AudioEngine::firstRecorder;
+	while (recorder) {
+		SampleRecorder* nextRecorder = recorder->next;
+		if (recorder->mode == AudioInputChannel::SPECIFIC_OUTPUT) {
+			if (recorder->status == RecorderStatus::COMPLETE && !recorder->hadCardError) {
+				numStemsWritten++;
+			}
+			recorder->pointerHeldElsewhere = false;
+			AudioEngine::discardRecorder(recorder);
+		}
+		recorder = nextRecorder;
+	}
+	indicator_leds::setLedState(IndicatorLED::RECORD, (playbackHandler.recording == RecordingMode::NORMAL));
+	display->removeLoadingAnimation();
+	return numStemsWritten;
+}
+
 /// disarms and prepares all the clips so that they can be exported
 int32_t StemExport::disarmAllClipsForStemExport() {
 	// when we begin stem export, we haven't exported any clips yet, so initialize these variables
@@ -596,7 +736,7 @@ void StemExport::displayStemExportProgress7SEG() {
 }
 
 // creates the full file path for stem exporting including the stem folder structure and wav file name
-Error StemExport::getUnusedStemRecordingFilePath(String* filePath, AudioRecordingFolder folder) {
+Error StemExport::getUnusedStemRecordingFilePath(String* filePath, AudioRecordingFolder folder, Output* output) {
 	const auto folderID = util::to_underlying(folder);
 
 	Error error = StorageManager::initSD();
@@ -609,6 +749,11 @@ Error StemExport::getUnusedStemRecordingFilePath(String* filePath, AudioRecordin
 		return error;
 	}
 
+	// when all the stems are recorded at once, each recorder says which output its file is for
+	if (output) {
+		setWavFileNameForStemExport(currentStemExportType, output, currentSong->getOutputIndex(output));
+	}
+
 	// wavFileName is uniquely set for each stem export
 	// when this flag is true, there is a valid wavFileName that has been set for stem exporting
 	if (wavFileNameForStemExportSet) {
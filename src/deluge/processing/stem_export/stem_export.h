@@ -46,11 +46,19 @@ public:
 	bool exportToSilence;
 	bool includeSongFX;
 	bool renderOffline;
+	bool exportInSinglePass;
 
 	// export instruments
 	int32_t disarmAllInstrumentsForStemExport();
 	int32_t exportInstrumentStems(StemExportType stemExportType);
 	void restoreAllInstrumentMutes(int32_t totalNumOutputs);
+	int32_t exportInstrumentStemsInSinglePass(StemExportType stemExportType);
+	int32_t startSinglePassRecorders(int32_t totalNumOutputs);
+	void endSinglePassRecordingsSoon();
+	bool anySinglePassRecordingUnfinished();
+	int32_t discardSinglePassRecorders();
+	// a stem taken straight from its output goes to file at the level the mix recorder would have had it at
+	uint8_t getOutputRecorderGain(uint8_t gainOtherwise) { return processStarted ? 5 : gainOtherwise; }
 
 	// export clips
 	int32_t disarmAllClipsForStemExport();
@@ -79,7 +87,7 @@ public:
 	int32_t totalNumStemsToExport;
 
 	// audio file management
-	Error getUnusedStemRecordingFilePath(String* filePath, AudioRecordingFolder folder);
+	Error getUnusedStemRecordingFilePath(String* filePath, AudioRecordingFolder folder, Output* output = nullptr);
 	Error getUnusedStemRecordingFolderPath(String* filePath, AudioRecordingFolder folder);
 	int32_t highestUsedStemFolderNumber;
 	String lastFolderNameForStemExport;
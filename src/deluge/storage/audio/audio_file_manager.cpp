@@ -26,7 +26,9 @@
 #include "memory/general_memory_allocator.h"
 #include "model/sample/sample.h"
 #include "model/sample/sample_cache.h"
+#include "model/sample/sample_holder.h"
 #include "model/sample/sample_reader.h"
+#include "model/settings/runtime_feature_settings.h"
 #include "model/song/song.h"
 #include "playback/playback_handler.h"
 #include "processing/engines/audio_engine.h"
@@ -34,7 +36,9 @@
 #include "storage/storage_manager.h"
 #include "storage/wave_table/wave_table.h"
 #include "storage/wave_table/wave_table_reader.h"
+#include <algorithm>
 #include <new>
+#include <span>
 #include <string.h>
 
 extern "C" {
@@ -51,8 +55,11 @@ LBA_t clst2sect(           /* !=0:Sector number, 0:Failed (invalid cluster#) */
 );
 
 DRESULT disk_read_without_streaming_first(BYTE pdrv, BYTE* buff, DWORD sector, UINT count);
+DRESULT disk_read_scatter(BYTE pdrv, BYTE* const* buffs, UINT sectorsPerBuff, LBA_t sector, UINT count,
+                          void (*buffFilled)(int, void*), void* context);
 
 extern uint8_t currentlyAccessingCard;
+void routineForSD(void);
 }
 
 AudioFileManager audioFileManager{};
@@ -428,6 +435,7 @@ void AudioFileManager::deleteUnusedAudioFileFromMemoryIndexUnknown(AudioFile* au
 }
 
 void AudioFileManager::deleteUnusedAudioFileFromMemory(AudioFile* audioFile, int32_t i) {
+	bool wasFlac = audioFile->type == AudioFileType::SAMPLE && ((Sample*)audioFile)->isFlac();
 
 	// Remove AudioFile from memory
 	audioFiles.removeElement(i);
@@ -435,6 +443,10 @@ void AudioFileManager::deleteUnusedAudioFileFromMemory(AudioFile* audioFile, int
 	// no, the destructor does this anyway.
 	audioFile->~AudioFile();
 	delugeDealloc(audioFile);
+
+	if (wasFlac) {
+		releaseFlacScratchIfUnused();
+	}
 }
 
 bool AudioFileManager::ensureEnoughMemoryForOneMoreAudioFile() {
@@ -830,29 +842,57 @@ ramError:
 	reader->fileSize = effectiveFilePointer.objsize;
 	reader->byteIndexWithinCluster = clusterSize;
 
+	// The path of the file we actually opened, for its cluster map sidecar
+	char const* openedFilePath = usingAlternateLocation.isEmpty() ? filePath->get() : usingAlternateLocation.get();
+	ClusterExtentMap<>::FileIdentity fileIdentity{clst2sect(&fileSystem, effectiveFilePointer.sclust),
+	                                              effectiveFilePointer.objsize, (uint32_t)fileSystem.database,
+	                                              fileSystem.csize};
+	bool shouldWriteClusterMapSidecar = false;
+	// Short files' chains are quick enough to walk that a sidecar would just be clutter
+	bool mayUseClusterMapSidecar = runtimeFeatureSettings.isOn(RuntimeFeatureSettingType::CacheSampleClusterMaps)
+	                               && numClusters >= kMinNumClustersForClusterMapSidecar;
+
 	// If Sample, we go directly to god-mode and get the cluster addresses.
 	if (type == AudioFileType::SAMPLE) {
+		Sample* sample = (Sample*)audioFile;
+
+		// If a sidecar says where the file is, that saves walking the whole FAT chain
+		if (mayUseClusterMapSidecar && readClusterMapSidecar(sample, openedFilePath, fileIdentity, numClusters)) {
+			for (ClusterExtent const& extent : sample->clusterExtents.extents()) {
+				for (uint32_t c = 0; c < extent.numClusters; c++) {
+					sample->clusters.getElement(extent.firstClusterIndex + c)->sdAddress =
+					    extent.sdAddress + c * fileSystem.csize;
+				}
+			}
+		}
 
-		// Store the address of each of the file's clusters.
-		uint32_t currentClusterIndex = 0;
-		uint32_t currentSDCluster =
-		    effectiveFilePointer.sclust; // Start with first cluster, whose address we already got.
+		else {
+			// Store the address of each of the file's clusters.
+			sample->clusterExtents.clear(fileSystem.csize);
+			uint32_t currentClusterIndex = 0;
+			uint32_t currentSDCluster =
+			    effectiveFilePointer.sclust; // Start with first cluster, whose address we already got.
 
-		while (true) {
+			while (true) {
 
-			((Sample*)audioFile)->clusters.getElement(currentClusterIndex)->sdAddress =
-			    clst2sect(&fileSystem, currentSDCluster);
+				uint32_t sdAddress = clst2sect(&fileSystem, currentSDCluster);
+				sample->clusters.getElement(currentClusterIndex)->sdAddress = sdAddress;
+				sample->clusterExtents.append(sdAddress);
 
-			currentClusterIndex++;
-			if (currentClusterIndex >= numClusters) {
-				break;
-			}
+				currentClusterIndex++;
+				if (currentClusterIndex >= numClusters) {
+					break;
+				}
 
-			currentSDCluster = get_fat_from_fs(&fileSystem, currentSDCluster);
+				currentSDCluster = get_fat_from_fs(&fileSystem, currentSDCluster);
 
-			if (currentSDCluster == 0xFFFFFFFF || currentSDCluster < 2) {
-				break;
+				if (currentSDCluster == 0xFFFFFFFF || currentSDCluster < 2) {
+					break;
+				}
 			}
+
+			// Only worth remembering if the chain was all there
+			shouldWriteClusterMapSidecar = mayUseClusterMapSidecar && sample->clusterExtents.numClusters() == numClusters;
 		}
 
 		// if (!suppliedFilePointer) f_close(&fileSystemStuff.currentFile);
@@ -880,6 +920,14 @@ ramError:
 	         && topHeader[2] == 0x46464941) { // "AIFF"
 		*error = audioFile->loadFile(reader, true, makeWaveTableWorkAtAllCosts);
 	}
+	else if (topHeader[0] == FlacDecoder::kMagic && type == AudioFileType::SAMPLE) {
+		// What the reader's loaded is the compressed file, not the decoded audio the Sample's Clusters will hold
+		if (((SampleReader*)reader)->currentCluster) {
+			removeReasonFromCluster(((SampleReader*)reader)->currentCluster, "E460");
+			((SampleReader*)reader)->currentCluster = NULL;
+		}
+		*error = loadFlacSample((Sample*)audioFile, effectiveFilePointer.objsize);
+	}
 	else {
 		*error = Error::FILE_UNSUPPORTED;
 	}
@@ -907,13 +955,508 @@ audioFileError:
 		goto audioFileError;
 	}
 
-	audioFile->finalizeAfterLoad(effectiveFilePointer.objsize);
+	if (shouldWriteClusterMapSidecar) {
+		writeClusterMapSidecar((Sample*)audioFile, openedFilePath, fileIdentity);
+	}
+
+	// A FLAC's decoded audio is all its Clusters hold, and is longer than the file
+	uint32_t audioDataFileSize = effectiveFilePointer.objsize;
+	if (type == AudioFileType::SAMPLE && ((Sample*)audioFile)->isFlac()) {
+		audioDataFileSize = ((Sample*)audioFile)->audioDataLengthBytes;
+	}
+	audioFile->finalizeAfterLoad(audioDataFileSize);
 
 	audioFile->removeReason("E399");
 
 	return audioFile;
 }
 
+Error AudioFileManager::getClusterMapSidecarPath(String* sidecarPath, char const* filePath) {
+	char const* fileName = getFileNameFromEndOfPath(filePath);
+	Error error = sidecarPath->set(filePath, fileName - filePath);
+	if (error != Error::NONE) {
+		return error;
+	}
+	error = sidecarPath->concatenate(".");
+	if (error != Error::NONE) {
+		return error;
+	}
+	error = sidecarPath->concatenate(fileName);
+	if (error != Error::NONE) {
+		return error;
+	}
+	return sidecarPath->concatenate(".cmap");
+}
+
+void AudioFileManager::deleteClusterMapSidecar(char const* filePath) {
+	String sidecarPath;
+	if (getClusterMapSidecarPath(&sidecarPath, filePath) == Error::NONE) {
+		f_unlink(sidecarPath.get()); // Usually there isn't one, and that's fine
+	}
+}
+
+bool AudioFileManager::readClusterMapSidecar(Sample* sample, char const* filePath,
+                                             ClusterExtentMap<>::FileIdentity const& identity, uint32_t numClusters) {
+	String sidecarPath;
+	if (getClusterMapSidecarPath(&sidecarPath, filePath) != Error::NONE) {
+		return false;
+	}
+	if (f_open(&clusterMapSidecarFile, sidecarPath.get(), FA_READ) != FR_OK) {
+		return false;
+	}
+
+	uint32_t sidecarSize = f_size(&clusterMapSidecarFile);
+	bool success = false;
+	if (sidecarSize && sidecarSize <= ClusterExtentMap<>::maxSidecarSize(numClusters)) {
+		uint8_t* buffer = (uint8_t*)GeneralMemoryAllocator::get().allocLowSpeed(sidecarSize);
+		if (buffer) {
+			UINT bytesRead;
+			if (f_read(&clusterMapSidecarFile, buffer, sidecarSize, &bytesRead) == FR_OK && bytesRead == sidecarSize) {
+				success = sample->clusterExtents.readSidecar(identity, numClusters, {buffer, sidecarSize});
+			}
+			delugeDealloc(buffer);
+		}
+	}
+	f_close(&clusterMapSidecarFile);
+
+	// The file may have been replaced by one of the same size in the same place, but laid out differently
+	if (success && !clusterExtentsMatchFAT(sample)) {
+		D_PRINTLN("stale cluster map: %s", sidecarPath.get());
+		sample->clusterExtents.clear(fileSystem.csize);
+		success = false;
+	}
+	return success;
+}
+
+// Checks the FAT entry at the end of each run - one lookup per run rather than one per cluster, which is the saving
+bool AudioFileManager::clusterExtentsMatchFAT(Sample* sample) {
+	auto extents = sample->clusterExtents.extents();
+	for (size_t e = 0; e < extents.size(); e++) {
+		uint32_t lastSDCluster =
+		    (extents[e].sdAddress - fileSystem.database) / fileSystem.csize + 2 + extents[e].numClusters - 1;
+		uint32_t nextSDCluster = get_fat_from_fs(&fileSystem, lastSDCluster);
+		// 0 is a free cluster, 1 an internal error and 0xFFFFFFFF a disk error. We can't trust the map after any of
+		// them
+		if (nextSDCluster < 2 || nextSDCluster == 0xFFFFFFFF) {
+			return false;
+		}
+		if (e + 1 < extents.size()) {
+			if (nextSDCluster != (extents[e + 1].sdAddress - fileSystem.database) / fileSystem.csize + 2) {
+				return false;
+			}
+		}
+		// The chain must end here - end-of-chain markers are all beyond the last cluster number
+		else if (nextSDCluster < fileSystem.n_fatent) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void AudioFileManager::writeClusterMapSidecar(Sample* sample, char const* filePath,
+                                              ClusterExtentMap<>::FileIdentity const& identity) {
+	String sidecarPath;
+	if (getClusterMapSidecarPath(&sidecarPath, filePath) != Error::NONE) {
+		return;
+	}
+
+	uint32_t sidecarSize = sample->clusterExtents.sidecarSize();
+	uint8_t* buffer = (uint8_t*)GeneralMemoryAllocator::get().allocLowSpeed(sidecarSize);
+	if (!buffer) {
+		return;
+	}
+	sample->clusterExtents.writeSidecar(identity, buffer);
+
+	// If this fails - say the card's locked - we'll just walk the FAT chain again next time
+	if (f_open(&clusterMapSidecarFile, sidecarPath.get(), FA_WRITE | FA_CREATE_ALWAYS) == FR_OK) {
+		UINT bytesWritten;
+		FRESULT result = f_write(&clusterMapSidecarFile, buffer, sidecarSize, &bytesWritten);
+		f_close(&clusterMapSidecarFile);
+		if (result != FR_OK || bytesWritten != sidecarSize) {
+			f_unlink(sidecarPath.get());
+		}
+	}
+	delugeDealloc(buffer);
+}
+
+// Reads a FLAC file's metadata, and sets up the seek table which lets any one of the decoded Clusters later be loaded
+// by decoding just the frames it needs. When STREAMINFO says how long the stream is, only as much of the table as the
+// file's SEEKTABLE gives is filled in now, and the rest as Clusters are loaded - see findFlacSeekPoint(). Otherwise,
+// the whole file gets scanned now to find out. Replaces the Sample's Clusters, which were set up for the file itself,
+// with ones for the decoded audio.
+Error AudioFileManager::loadFlacSample(Sample* sample, uint32_t fileSize) {
+	FlacDecoder& decoder = sample->flacDecoder;
+
+	FlacReadWindow window{(uint8_t*)GeneralMemoryAllocator::get().allocLowSpeed(clusterSize), clusterSize};
+	if (!window.buffer) {
+		return Error::INSUFFICIENT_RAM;
+	}
+
+	Error error = Error::NONE;
+	uint32_t pos = 4; // After "fLaC"
+	uint32_t seekTableStart = 0;
+	uint32_t seekTableEnd = 0;
+	uint64_t numSamples = 0;
+	uint32_t bytesPerSample;
+	uint64_t audioDataLengthBytes;
+	uint8_t* scratch;
+
+	// The STREAMINFO block always comes first
+	if (!readFlacWindow(sample, window, 0, 8 + FlacDecoder::kStreamInfoSize)) {
+		error = Error::SD_CARD;
+		goto getOut;
+	}
+	if (window.numBytes < 8 + FlacDecoder::kStreamInfoSize || (window.buffer[4] & 0x7F) != 0
+	    || !decoder.readStreamInfo(window.from(8))) {
+		error = Error::FILE_UNSUPPORTED;
+		goto getOut;
+	}
+	if (decoder.streamInfo().sampleRate < 5000 || decoder.streamInfo().sampleRate > 96000) {
+		error = Error::FILE_UNSUPPORTED;
+		goto getOut;
+	}
+
+	// Skip the rest of the metadata - tags, pictures and so on - except for noting where any SEEKTABLE is
+	while (true) {
+		if (pos + 4 > fileSize) {
+			error = Error::FILE_CORRUPTED;
+			goto getOut;
+		}
+		if (!readFlacWindow(sample, window, pos, 4)) {
+			error = Error::SD_CARD;
+			goto getOut;
+		}
+		uint8_t const* blockHeader = window.from(pos).data();
+		bool isLastBlock = blockHeader[0] & 0x80;
+		bool isSeekTable = (blockHeader[0] & 0x7F) == FlacDecoder::kSeekTableBlockType;
+		uint32_t blockSize = (blockHeader[1] << 16) | (blockHeader[2] << 8) | blockHeader[3];
+		pos += 4;
+		if (isSeekTable) {
+			seekTableStart = pos;
+			seekTableEnd = pos + blockSize;
+		}
+		pos += blockSize;
+		if (isLastBlock) {
+			break;
+		}
+	}
+
+	sample->numChannels = decoder.streamInfo().numChannels;
+	sample->byteDepth = decoder.byteDepth();
+	sample->sampleRate = decoder.streamInfo().sampleRate;
+	sample->rawDataFormat = RAW_DATA_FINE;
+	sample->flacFileSize = fileSize;
+	bytesPerSample = sample->byteDepth * sample->numChannels;
+	sample->flacSeekTable.clear(clusterSize, bytesPerSample);
+	sample->flacSeekTable.addAnchor(pos, 0);
+
+	if (decoder.streamInfo().totalSamples) {
+		numSamples = decoder.streamInfo().totalSamples;
+		if (numSamples * bytesPerSample > kMaxFileSize) {
+			error = Error::FILE_TOO_BIG;
+			goto getOut;
+		}
+		sample->flacSeekTable.setNumSamples(numSamples);
+
+		// Each point is a sample number and a byte offset from the first frame, 8 bytes each, then the number of
+		// samples in the frame there. Placeholder points have all 1s for their sample number
+		for (uint32_t pointPos = seekTableStart; pointPos + FlacDecoder::kSeekPointSize <= seekTableEnd;
+		     pointPos += FlacDecoder::kSeekPointSize) {
+			if (!readFlacWindow(sample, window, pointPos, FlacDecoder::kSeekPointSize)) {
+				error = Error::SD_CARD;
+				goto getOut;
+			}
+			uint8_t const* point = window.from(pointPos).data();
+			uint64_t firstSample = 0;
+			uint64_t offset = 0;
+			for (int32_t i = 0; i < 8; i++) {
+				firstSample = (firstSample << 8) | point[i];
+				offset = (offset << 8) | point[8 + i];
+			}
+			if (firstSample >= numSamples || pos + offset >= fileSize) {
+				continue; // Including placeholders
+			}
+			sample->flacSeekTable.addAnchor(pos + offset, firstSample);
+		}
+	}
+
+	// Find the first frame now, which makes sure there is one. Or all of them, if that's the only way to find out how
+	// long the stream is
+	scratch = getFlacScratch(sample);
+	if (!scratch) {
+		error = Error::INSUFFICIENT_RAM;
+		goto getOut;
+	}
+	{
+		FlacReadWindow scanWindow{scratch, getFlacReadWindowCapacity(sample)};
+		uint64_t numSamplesFound;
+		bool success = scanFlacFrames(sample, scanWindow, {pos, 0}, numSamples ? 0 : 0xFFFFFFFF, &numSamplesFound);
+		doneWithFlacScratch(scratch);
+		if (!success) {
+			error = Error::SD_CARD;
+			goto getOut;
+		}
+		if (!numSamples) {
+			numSamples = numSamplesFound;
+		}
+	}
+	if (!sample->flacSeekTable.find(0)) {
+		error = Error::FILE_CORRUPTED;
+		goto getOut;
+	}
+	D_PRINTLN("FLAC: %d samples, %d Clusters", (int32_t)numSamples, sample->flacSeekTable.numClusters());
+
+	audioDataLengthBytes = numSamples * bytesPerSample;
+	if (audioDataLengthBytes > kMaxFileSize) {
+		error = Error::FILE_TOO_BIG;
+		goto getOut;
+	}
+	sample->audioDataStartPosBytes = 0;
+	sample->audioDataLengthBytes = audioDataLengthBytes;
+
+	error = sample->reinitializeClusters(sample->flacSeekTable.numClusters());
+	if (error == Error::NONE) {
+		// Only the first one's address means anything now - it's how we spot the file being replaced while the card
+		// was out
+		sample->clusters.getElement(0)->sdAddress = sample->clusterExtents.sdAddressOf(0);
+	}
+
+getOut:
+	delugeDealloc(window.buffer);
+	if (error != Error::NONE) {
+		releaseFlacScratchIfUnused();
+	}
+	return error;
+}
+
+// Frames don't say how long they are, so the only way to find the next one is to look for its header. We know which
+// sample it'll start at, so anything else that just happens to look like one doesn't fool us. Adds each frame to the
+// seek table, from the one at start until the one clusterIndex starts in - or the end of the stream. numSamples gets
+// where that got to. Returns false if the card couldn't be read, or start wasn't a frame after all.
+bool AudioFileManager::scanFlacFrames(Sample* sample, FlacReadWindow& window, FlacSeekPoint start,
+                                      uint32_t clusterIndex, uint64_t* numSamples) {
+	FlacDecoder const& decoder = sample->flacDecoder;
+	uint32_t fileSize = sample->flacFileSize;
+	uint32_t pos = start.fileBytePos;
+	*numSamples = start.firstSample;
+
+	while (pos < fileSize) {
+		if (!readFlacWindow(sample, window, pos, FlacDecoder::kMaxFrameHeaderSize)) {
+			return false;
+		}
+		std::span<uint8_t const> in = window.from(pos).first(std::min(window.end(), fileSize) - pos);
+
+		FlacFrameHeader header;
+		uint32_t framePos = decoder.findFrame(in, *numSamples, &header);
+
+		// start has to be a frame - except for the stream's first one, which is only somewhere after the metadata
+		if (start.firstSample && *numSamples == start.firstSample && framePos) {
+			return false;
+		}
+		if (framePos == in.size()) {
+			if (window.end() >= fileSize) {
+				break;
+			}
+			// One might start right at the end of what we've got, so look again from there once there's more
+			pos = std::max(pos + 1, window.end() - (FlacDecoder::kMaxFrameHeaderSize - 1));
+			continue;
+		}
+
+		sample->flacSeekTable.addFrame(pos + framePos, *numSamples, header.blockSize);
+		*numSamples += header.blockSize;
+		pos += framePos + std::max<uint32_t>(header.numBytes, decoder.streamInfo().minFrameSize);
+
+		if (decoder.streamInfo().totalSamples && *numSamples >= decoder.streamInfo().totalSamples) {
+			break;
+		}
+		if (sample->flacSeekTable.find(clusterIndex)) {
+			break;
+		}
+	}
+	return true;
+}
+
+// Where to decode a Cluster from, scanning for it if the seek table doesn't have it yet. That's usually just from
+// the Cluster before, since they mostly get loaded in order as the Sample plays
+FlacSeekPoint const* AudioFileManager::findFlacSeekPoint(Sample* sample, FlacReadWindow& window,
+                                                         uint32_t clusterIndex) {
+	FlacSeekTable<>& seekTable = sample->flacSeekTable;
+	FlacSeekPoint const* seekPoint = seekTable.find(clusterIndex);
+	if (seekPoint || clusterIndex >= seekTable.numClusters()) {
+		return seekPoint;
+	}
+
+	FlacSeekPoint start = *seekTable.startPointForScan(clusterIndex);
+	uint64_t numSamples;
+	if (!scanFlacFrames(sample, window, start, clusterIndex, &numSamples)) {
+		// The SEEKTABLE might have been wrong, so try again with only the frames we found ourselves
+		seekTable.forgetAnchors();
+		FlacSeekPoint const* retryStart = seekTable.startPointForScan(clusterIndex);
+		if (retryStart->fileBytePos == start.fileBytePos
+		    || !scanFlacFrames(sample, window, *retryStart, clusterIndex, &numSamples)) {
+			return nullptr;
+		}
+	}
+	return seekTable.find(clusterIndex);
+}
+
+// Decoding only happens in the card routine, so one lot of memory does for every FLAC Sample: a read window, then a
+// block's worth of samples per channel. It's kept between Clusters, since allocating it each time could mean stealing a
+// Cluster we'd rather have kept, and only replaced if a Sample needs it bigger
+uint8_t* AudioFileManager::getFlacScratch(Sample* sample) {
+	uint32_t size =
+	    getFlacReadWindowCapacity(sample) + sample->flacDecoder.streamInfo().maxBlockSize * sizeof(int32_t) * 2;
+
+	// Only if decoding got back in here through routineForSD(), which it shouldn't
+	if (flacScratchInUse) {
+		return (uint8_t*)GeneralMemoryAllocator::get().allocLowSpeed(size);
+	}
+
+	if (flacScratchSize < size) {
+		if (flacScratch) {
+			delugeDealloc(flacScratch);
+		}
+		flacScratch = (uint8_t*)GeneralMemoryAllocator::get().allocLowSpeed(size);
+		flacScratchSize = flacScratch ? size : 0;
+		if (!flacScratch) {
+			return NULL;
+		}
+	}
+	flacScratchInUse = true;
+	return flacScratch;
+}
+
+void AudioFileManager::doneWithFlacScratch(uint8_t* scratch) {
+	if (scratch == flacScratch) {
+		flacScratchInUse = false;
+	}
+	else {
+		delugeDealloc(scratch);
+	}
+}
+
+void AudioFileManager::releaseFlacScratchIfUnused() {
+	if (!flacScratch || flacScratchInUse) {
+		return;
+	}
+	for (int32_t e = 0; e < audioFiles.getNumElements(); e++) {
+		AudioFile* audioFile = (AudioFile*)audioFiles.getElement(e);
+		if (audioFile->type == AudioFileType::SAMPLE && ((Sample*)audioFile)->isFlac()) {
+			return;
+		}
+	}
+	delugeDealloc(flacScratch);
+	flacScratch = NULL;
+	flacScratchSize = 0;
+}
+
+// Enough for a whole frame wherever in the window it starts, and at least a Cluster's worth for the sake of fewer reads
+uint32_t AudioFileManager::getFlacReadWindowCapacity(Sample* sample) {
+	uint32_t frameSectors = ((sample->flacDecoder.maxFrameSize() - 1) >> 9) + 1;
+	return std::max<uint32_t>((frameSectors + 1) << 9, clusterSize);
+}
+
+// Makes sure the window holds numBytes from pos onwards, or as many as there are, reading the card if it doesn't. It
+// starts again from the sector pos is in, keeping whatever it already has from there on
+bool AudioFileManager::readFlacWindow(Sample* sample, FlacReadWindow& window, uint32_t pos, uint32_t numBytes) {
+	uint32_t fileEnd = sample->clusterExtents.numClusters() << clusterSizeMagnitude;
+	if (pos >= window.fileBytePos && pos + numBytes <= window.end()) {
+		return true;
+	}
+	if (pos >= window.fileBytePos && window.end() >= fileEnd) {
+		return true;
+	}
+
+	uint32_t newFileBytePos = pos & ~511;
+	uint32_t numBytesKept = 0;
+	if (newFileBytePos >= window.fileBytePos && newFileBytePos < window.end()) {
+		numBytesKept = window.end() - newFileBytePos;
+		memmove(window.buffer, window.buffer + (newFileBytePos - window.fileBytePos), numBytesKept);
+	}
+	window.fileBytePos = newFileBytePos;
+	window.numBytes = numBytesKept;
+
+	uint32_t sectorsPerCluster = clusterSize >> 9;
+	uint32_t sector = window.end() >> 9;
+	uint32_t endSector = std::min(window.fileBytePos + window.capacity, fileEnd) >> 9;
+	while (sector < endSector) {
+		ClusterExtent const* extent = sample->clusterExtents.findExtent(sector / sectorsPerCluster);
+		if (!extent) {
+			return false;
+		}
+		uint32_t extentStartSector = extent->firstClusterIndex * sectorsPerCluster;
+		uint32_t numSectors = std::min(endSector, extentStartSector + extent->numClusters * sectorsPerCluster) - sector;
+		DRESULT result = disk_read_without_streaming_first(SD_PORT, window.buffer + window.numBytes,
+		                                                   extent->sdAddress + sector - extentStartSector, numSectors);
+		if (result) {
+			return false;
+		}
+		window.numBytes += numSectors << 9;
+		sector += numSectors;
+	}
+	return true;
+}
+
+// The FLAC equivalent of reading a Cluster off the card: decodes the frames which the Cluster's audio is in, starting
+// from the one the seek table says. The bytes of any sample straddling either end of the Cluster get split with its
+// neighbour, just as they would be in a WAV file.
+bool AudioFileManager::decodeFlacCluster(Cluster* cluster) {
+	Sample* sample = cluster->sample;
+	FlacDecoder const& decoder = sample->flacDecoder;
+	uint8_t* scratch = getFlacScratch(sample);
+	if (!scratch) {
+		return false;
+	}
+	uint32_t capacity = getFlacReadWindowCapacity(sample);
+	uint32_t channelSize = decoder.streamInfo().maxBlockSize * sizeof(int32_t);
+	FlacReadWindow window{scratch, capacity};
+	int32_t* channels[2] = {(int32_t*)(scratch + capacity), (int32_t*)(scratch + capacity + channelSize)};
+
+	FlacSeekPoint const* seekPoint = findFlacSeekPoint(sample, window, cluster->clusterIndex);
+	if (!seekPoint) {
+		doneWithFlacScratch(scratch);
+		return false;
+	}
+
+	uint32_t bytesPerSample = sample->byteDepth * sample->numChannels;
+	uint64_t rangeStart = (uint64_t)cluster->clusterIndex << clusterSizeMagnitude;
+	uint64_t rangeEnd = std::min<uint64_t>(rangeStart + clusterSize, sample->audioDataLengthBytes);
+
+	bool success = true;
+	uint32_t pos = seekPoint->fileBytePos;
+	uint64_t firstSample = seekPoint->firstSample;
+	while (firstSample * bytesPerSample < rangeEnd) {
+		if (!readFlacWindow(sample, window, pos, decoder.maxFrameSize())) {
+			success = false;
+			break;
+		}
+
+		FlacFrameHeader header;
+		uint32_t frameSize = decoder.decodeFrame(window.from(pos), channels, &header);
+
+		// If the file's damaged, silence is better than giving up on the whole Sample
+		if (!frameSize) {
+			D_PRINTLN("FLAC frame corrupt: %s %d", sample->filePath.get(), pos);
+			uint64_t silenceStart = std::max(firstSample * bytesPerSample, rangeStart);
+			memset(&cluster->data[silenceStart - rangeStart], 0, rangeEnd - silenceStart);
+			break;
+		}
+
+		decoder.writePCM(channels, header.blockSize, firstSample * bytesPerSample, rangeStart, rangeEnd,
+		                 (uint8_t*)cluster->data);
+		// So when the next Cluster gets loaded, it won't need scanning for
+		sample->flacSeekTable.addFrame(pos, firstSample, header.blockSize);
+		pos += frameSize;
+		firstSample += header.blockSize;
+
+		// Decoding a frame takes a while, like reading one does, so the audio gets a look in between them too
+		routineForSD();
+	}
+
+	doneWithFlacScratch(scratch);
+	return success;
+}
+
 void AudioFileManager::testQueue() {
 
 	/*
@@ -972,51 +1515,9 @@ void AudioFileManager::deallocateCluster(Cluster* cluster) {
 
 #define REPORT_LOAD_TIME 0
 
-bool AudioFileManager::loadCluster(Cluster* cluster, int32_t minNumReasonsAfter) {
-
-	if (currentlyAccessingCard) {
-		return false; // Could happen if we're trying to render a waveform but we're actually already inside the SD
-		              // routine
-	}
-
-	// I don't think these should happen...
-	if (clusterBeingLoaded) {
-		return false;
-	}
-	if (AudioEngine::audioRoutineLocked) {
-		return false;
-	}
-
-	clusterBeingLoaded = cluster;
-	minNumReasonsForClusterBeingLoaded = minNumReasonsAfter + 1;
-
+// Returns 0 if there's nothing to read, which shouldn't really happen
+int32_t AudioFileManager::getNumSectorsToLoad(Cluster* cluster) {
 	Sample* sample = cluster->sample;
-
-	if (cluster->type != ClusterType::Sample) {
-		FREEZE_WITH_ERROR("E205"); // Chris F got this, so gonna leave checking in release build
-	}
-
-#if ALPHA_OR_BETA_VERSION
-	if (cluster->numReasonsToBeLoaded <= 0) {
-		// Ok, I think we know there's at least 1 reason at the point this function's called, because
-		FREEZE_WITH_ERROR("E204");
-	}
-	// it'd only be in the loading queue if it had a "reason".
-	if (!sample) {
-		FREEZE_WITH_ERROR("E206");
-	}
-#endif
-
-	addReasonToCluster(cluster); // So that it can't accidentally hit 0 reasons while we're loading it, cos then it
-	                             // might get deallocated.
-
-	if (false) {
-getOutEarly:
-		clusterBeingLoaded = NULL;
-		removeReasonFromCluster(cluster, "E033");
-		return false;
-	}
-
 	int32_t clusterIndex = cluster->clusterIndex;
 
 	int32_t numSectors = clusterSize >> 9;
@@ -1028,7 +1529,7 @@ getOutEarly:
 		int32_t bytesToRead = audioDataEndPosBytes - startByteThisCluster;
 		if (bytesToRead <= 0) {
 			D_PRINTLN("fail thing"); // Shouldn't really still happen
-			goto getOutEarly;
+			return 0;
 		}
 		if (bytesToRead < clusterSize) {
 			numSectors = ((bytesToRead - 1) >> 9) + 1;
@@ -1036,65 +1537,14 @@ getOutEarly:
 		// Otherwise, just leave it at the normal number of sectors
 	}
 
-#if ALPHA_OR_BETA_VERSION
-	if ((uint32_t)cluster->data & 0b11) {
-		D_PRINTLN("SD read address misaligned by  %d", (int32_t)((uint32_t)cluster->data & 0b11));
-	}
-#endif
-
-	AudioEngine::logAction("loadCluster");
-
-#if REPORT_LOAD_TIME
-	uint16_t startTime = MTU2.TCNT_0;
-#endif
-
-#if ALPHA_OR_BETA_VERSION
-	if (cluster->type != ClusterType::Sample) {
-		FREEZE_WITH_ERROR("i023"); // Happened to me while thrash testing with reduced RAM
-	}
-
-	if (cluster->numReasonsToBeLoaded < minNumReasonsAfter + 1) {
-		FREEZE_WITH_ERROR("i039"); // It's +1 because we haven't removed this function's "reason" yet.
-	}
-#endif
-
-	DRESULT result = disk_read_without_streaming_first(
-	    SD_PORT, (BYTE*)cluster->data, sample->clusters.getElement(cluster->clusterIndex)->sdAddress, numSectors);
-
-#if REPORT_LOAD_TIME
-	uint16_t endTime = MTU2.TCNT_0;
-	uint16_t duration = endTime - startTime;
-	int32_t uSec = timerCountToUS(duration);
-	if (uSec > 7000) {
-		D_PRINTLN(uSec);
-	}
-#endif
-
-#if ALPHA_OR_BETA_VERSION
-	if (cluster->type != ClusterType::Sample) {
-		FREEZE_WITH_ERROR("E207");
-	}
-	if (!cluster->sample) {
-		FREEZE_WITH_ERROR("E208");
-	}
-
-	if (cluster->numReasonsToBeLoaded < minNumReasonsAfter + 1) {
-		FREEZE_WITH_ERROR("i038"); // It's +1 because we haven't removed this function's "reason" yet.
-	}
-#endif
-
-	// If that failed, get out
-	if (result) {
-		goto getOutEarly;
-	}
-
-	cluster->convertDataIfNecessary();
+	return numSectors;
+}
 
-#if ALPHA_OR_BETA_VERSION
-	if (cluster->numReasonsToBeLoaded < minNumReasonsAfter + 1) {
-		FREEZE_WITH_ERROR("i040"); // It's +1 because we haven't removed this function's "reason" yet.
-	}
-#endif
+// Once a Cluster's data is loaded and converted, swaps the extra bytes either side with any neighbouring Clusters which
+// are loaded too, so that a read which overhangs the end of a Cluster gets valid data
+void AudioFileManager::joinClusterToNeighbours(Cluster* cluster) {
+	Sample* sample = cluster->sample;
+	int32_t clusterIndex = cluster->clusterIndex;
 
 	int32_t misalignment = sample->audioDataStartPosBytes & 0b11;
 
@@ -1276,6 +1726,125 @@ copy7ToMe:
 			cluster->extraBytesAtEndConverted = true;
 		}
 	}
+}
+
+bool AudioFileManager::loadCluster(Cluster* cluster, int32_t minNumReasonsAfter) {
+
+	if (currentlyAccessingCard) {
+		return false; // Could happen if we're trying to render a waveform but we're actually already inside the SD
+		              // routine
+	}
+
+	// I don't think these should happen...
+	if (clusterBeingLoaded) {
+		return false;
+	}
+	if (AudioEngine::audioRoutineLocked) {
+		return false;
+	}
+
+	clusterBeingLoaded = cluster;
+	minNumReasonsForClusterBeingLoaded = minNumReasonsAfter + 1;
+
+	Sample* sample = cluster->sample;
+
+	if (cluster->type != ClusterType::Sample) {
+		FREEZE_WITH_ERROR("E205"); // Chris F got this, so gonna leave checking in release build
+	}
+
+#if ALPHA_OR_BETA_VERSION
+	if (cluster->numReasonsToBeLoaded <= 0) {
+		// Ok, I think we know there's at least 1 reason at the point this function's called, because
+		FREEZE_WITH_ERROR("E204");
+	}
+	// it'd only be in the loading queue if it had a "reason".
+	if (!sample) {
+		FREEZE_WITH_ERROR("E206");
+	}
+#endif
+
+	addReasonToCluster(cluster); // So that it can't accidentally hit 0 reasons while we're loading it, cos then it
+	                             // might get deallocated.
+
+	if (false) {
+getOutEarly:
+		clusterBeingLoaded = NULL;
+		removeReasonFromCluster(cluster, "E033");
+		return false;
+	}
+
+	int32_t numSectors = getNumSectorsToLoad(cluster);
+	if (!numSectors) {
+		goto getOutEarly;
+	}
+
+#if ALPHA_OR_BETA_VERSION
+	if ((uint32_t)cluster->data & 0b11) {
+		D_PRINTLN("SD read address misaligned by  %d", (int32_t)((uint32_t)cluster->data & 0b11));
+	}
+#endif
+
+	AudioEngine::logAction("loadCluster");
+
+#if REPORT_LOAD_TIME
+	uint16_t startTime = MTU2.TCNT_0;
+#endif
+
+#if ALPHA_OR_BETA_VERSION
+	if (cluster->type != ClusterType::Sample) {
+		FREEZE_WITH_ERROR("i023"); // Happened to me while thrash testing with reduced RAM
+	}
+
+	if (cluster->numReasonsToBeLoaded < minNumReasonsAfter + 1) {
+		FREEZE_WITH_ERROR("i039"); // It's +1 because we haven't removed this function's "reason" yet.
+	}
+#endif
+
+	DRESULT result;
+	if (sample->isFlac()) {
+		result = decodeFlacCluster(cluster) ? RES_OK : RES_ERROR;
+	}
+	else {
+		result = disk_read_without_streaming_first(
+		    SD_PORT, (BYTE*)cluster->data, sample->clusters.getElement(cluster->clusterIndex)->sdAddress, numSectors);
+	}
+
+#if REPORT_LOAD_TIME
+	uint16_t endTime = MTU2.TCNT_0;
+	uint16_t duration = endTime - startTime;
+	int32_t uSec = timerCountToUS(duration);
+	if (uSec > 7000) {
+		D_PRINTLN(uSec);
+	}
+#endif
+
+#if ALPHA_OR_BETA_VERSION
+	if (cluster->type != ClusterType::Sample) {
+		FREEZE_WITH_ERROR("E207");
+	}
+	if (!cluster->sample) {
+		FREEZE_WITH_ERROR("E208");
+	}
+
+	if (cluster->numReasonsToBeLoaded < minNumReasonsAfter + 1) {
+		FREEZE_WITH_ERROR("i038"); // It's +1 because we haven't removed this function's "reason" yet.
+	}
+#endif
+
+	// If that failed, get out
+	if (result) {
+		goto getOutEarly;
+	}
+
+	cluster->convertDataIfNecessary();
+
+#if ALPHA_OR_BETA_VERSION
+	if (cluster->numReasonsToBeLoaded < minNumReasonsAfter + 1) {
+		FREEZE_WITH_ERROR("i040"); // It's +1 because we haven't removed this function's "reason" yet.
+	}
+#endif
+
+	joinClusterToNeighbours(cluster);
 
 	cluster->loaded = true;
 
@@ -1294,6 +1863,107 @@ copy7ToMe:
 	return true;
 }
 
+// Puts cluster in the ClusterReadBatch, along with any further Clusters of its Sample waiting in the loadingQueue which
+// follow straight on from it both in the file and on the card. Those get taken off the queue.
+void AudioFileManager::gatherClustersToLoadWith(Cluster* cluster, ClusterReadBatch& batch) {
+	Sample* sample = cluster->sample;
+	// A FLAC's Clusters get decoded one at a time rather than read straight off the card
+	if (sample->isFlac()) {
+		return;
+	}
+	SampleCluster* sampleCluster = sample->clusters.getElement(cluster->clusterIndex);
+	int32_t numSectors = getNumSectorsToLoad(cluster);
+	if (!batch.canAppend(sampleCluster->sdAddress, numSectors)) {
+		return;
+	}
+	clustersBeingLoaded[0] = cluster;
+	batch.append((uint8_t*)cluster->data, sampleCluster->sdAddress, numSectors);
+
+	for (int32_t i = cluster->clusterIndex + 1; i < sample->clusters.getNumElements(); i++) {
+		sampleCluster = sample->clusters.getElement(i);
+		Cluster* nextCluster = sampleCluster->cluster;
+		if (!nextCluster || nextCluster->loaded || nextCluster->type != ClusterType::Sample) {
+			break;
+		}
+
+		numSectors = getNumSectorsToLoad(nextCluster);
+		if (!batch.canAppend(sampleCluster->sdAddress, numSectors) || !loadingQueue.removeIfPresent(nextCluster)) {
+			break;
+		}
+		clustersBeingLoaded[batch.size()] = nextCluster;
+		batch.append((uint8_t*)nextCluster->data, sampleCluster->sdAddress, numSectors);
+	}
+}
+
+// Loads the Clusters put together by gatherClustersToLoadWith() with a single read, converting each one's data while
+// the next one's still coming in. If that doesn't work, any which are still wanted go back in the loadingQueue.
+bool AudioFileManager::loadClusterBatch(ClusterReadBatch& batch) {
+	auto clusters = std::span{clustersBeingLoaded}.first(batch.size());
+
+	bool holdingReasons = false;
+	bool success = false;
+
+	if (!currentlyAccessingCard && !clusterBeingLoaded && !AudioEngine::audioRoutineLocked) {
+		clusterBeingLoaded = clusters.front();
+		numClustersBeingLoaded = batch.size();
+		minNumReasonsForClusterBeingLoaded = 1;
+
+		// As in loadCluster(), so that none of them can get deallocated mid-read
+		for (Cluster* cluster : clusters) {
+			addReasonToCluster(cluster);
+		}
+		holdingReasons = true;
+
+		AudioEngine::logAction("loadClusterBatch");
+
+		DRESULT result = disk_read_scatter(SD_PORT, (BYTE* const*)batch.buffers(), batch.sectorsPerCluster(),
+		                                   batch.firstSector(), batch.numSectors(), convertClusterInBatch, this);
+		success = (result == RES_OK);
+
+		if (success) {
+			// In file order, so that each one finds the one before it already loaded - same as loading them one by one
+			for (Cluster* cluster : clusters) {
+				joinClusterToNeighbours(cluster);
+				cluster->loaded = true;
+			}
+		}
+
+		clusterBeingLoaded = NULL;
+		numClustersBeingLoaded = 0;
+	}
+
+	for (Cluster* cluster : clusters) {
+		// Re-enqueue before giving up our own reason, so that any which nobody wants anymore get deallocated from the
+		// queue rather than filed away as if they'd loaded
+		if (!success && cluster->numReasonsToBeLoaded > (holdingReasons ? 1 : 0)) {
+			// If the queue can't take it back, there's no way to get it loaded - whoever's waiting on it will find
+			// it never arrives, so at least say why
+			Error error = enqueueCluster(cluster);
+			if (error != Error::NONE) {
+				D_PRINTLN("couldn't re-enqueue Cluster");
+				display->displayError(error);
+			}
+		}
+		if (holdingReasons) {
+			removeReasonFromCluster(cluster, "E457");
+		}
+	}
+
+	return success;
+}
+
+void AudioFileManager::convertClusterInBatch(int batchIndex, void* audioFileManager) {
+	((AudioFileManager*)audioFileManager)->clustersBeingLoaded[batchIndex]->convertDataIfNecessary();
+}
+
+bool AudioFileManager::isClusterBeingLoaded(Cluster* cluster) {
+	if (cluster == clusterBeingLoaded) {
+		return true;
+	}
+	auto batchEnd = clustersBeingLoaded.begin() + numClustersBeingLoaded;
+	return std::ranges::find(clustersBeingLoaded.begin(), batchEnd, cluster) != batchEnd;
+}
+
 // Only needs calling a couple times per second. Must be called outside of the audio / SD-reading routine
 // Call this repeatedly so SD card is re-initialized on re-insert before we actually urgently need audio from it
 void AudioFileManager::slowRoutine() {
@@ -1306,6 +1976,9 @@ void AudioFileManager::slowRoutine() {
 		}
 	}
 
+	releaseFinishedPrefetches();
+	releaseUnusedSamplePreloads();
+
 	// NOTE: (Kate) There was dead code here referencing things that no longer
 	// exist (NUM_LOADED_SAMPLE_CHUNK_ALLOCATION_QUEUES, availableClusterQueues)
 	// It has been removed.
@@ -1380,17 +2053,27 @@ performActionsAndGetOut:
 			FREEZE_WITH_ERROR("E235"); // Cos Chris F got an E205
 		}
 
+		// Anything else queued which follows straight on from it, in the file and on the card, gets read along with it
+		ClusterReadBatch batch{clusterSize >> 9};
+		gatherClustersToLoadWith(cluster, batch);
+		bool loadingBatch = batch.worthReadingTogether();
+
 		allowSomeUserActionsEvenWhenInCardRoutine = true; // Sorry!!
-		bool success = loadCluster(cluster);
+		bool success = loadingBatch ? loadClusterBatch(batch) : loadCluster(cluster);
 		allowSomeUserActionsEvenWhenInCardRoutine = false;
 
 		// If that didn't work, presumably because the SD card got ejected...
 		if (!success) {
 			D_PRINTLN("load Cluster fail");
 
+			// loadClusterBatch() has already put back in the queue any which are still wanted. Don't keep trying
+			if (loadingBatch) {
+				break;
+			}
+
 			// If the Cluster is now down to 0 reasons (i.e. it lost a reason while being loaded), then it's already
 			// been made "available" and we don't have a problem
-			if (!cluster->numReasonsToBeLoaded) {}
+			else if (!cluster->numReasonsToBeLoaded) {}
 
 			// Otherwise, there are still "reasons" waiting for this Cluster to become loaded, so we need to put it
 			// back in the loading queue. Presumably it won't actually get loaded for a while - only when the user
@@ -1426,6 +2109,166 @@ Error AudioFileManager::enqueueCluster(Cluster* cluster, uint32_t priorityRating
 	return loadingQueue.add(cluster, priorityRating);
 }
 
+void AudioFileManager::prefetchClustersForNote(SampleHolder* holder, bool reversed, uint32_t timeTilNeeded) {
+	Sample* sample = (Sample*)holder->audioFile;
+	if (!sample || sample->type != AudioFileType::SAMPLE || sample->unplayable || sample->unloadable
+	    || timeTilNeeded > kMaxClusterPrefetchTime) {
+		return;
+	}
+
+	int32_t playDirection = reversed ? -1 : 1;
+
+	// Skip the Clusters the SampleHolder already keeps loaded
+	int32_t clusterIndex = (int32_t)(holder->getStartPlaybackAtByte(reversed) >> clusterSizeMagnitude)
+	                       + kNumClustersLoadedAhead * playDirection;
+
+	// Bits 30-31 are the same as for a low-priority Voice - see Voice::getPriorityRating(). It can never reach
+	// 0xFFFFFFFF, which is what loadingQueueHasAnyLowestPriorityElements() looks for.
+	uint32_t priorityRating = 0xC0000000 | timeTilNeeded;
+	uint32_t releaseAtTime = AudioEngine::audioSampleTimer + timeTilNeeded + kClusterPrefetchGraceTime;
+
+	for (int32_t l = 0; l < kNumClustersPrefetchedAhead; l++) {
+		if (clusterIndex < sample->getFirstClusterIndexWithAudioData()
+		    || clusterIndex >= sample->getFirstClusterIndexWithNoAudioData()) {
+			break;
+		}
+
+		SampleCluster* sampleCluster = sample->clusters.getElement(clusterIndex);
+		clusterIndex += playDirection;
+
+		if (sampleCluster->cluster) {
+			if (sampleCluster->cluster->loaded) {
+				continue;
+			}
+
+			// If we're already prefetching it for another note, just make sure we hold onto it for long enough
+			auto prefetchesEnd = clusterPrefetches.begin() + numClusterPrefetches;
+			auto existing = std::ranges::find(clusterPrefetches.begin(), prefetchesEnd, sampleCluster->cluster,
+			                                  &ClusterPrefetch::cluster);
+			if (existing != prefetchesEnd) {
+				if ((int32_t)(releaseAtTime - existing->releaseAtTime) > 0) {
+					existing->releaseAtTime = releaseAtTime;
+				}
+				continue;
+			}
+		}
+
+		if (numClusterPrefetches == kMaxNumClusterPrefetches) {
+			break;
+		}
+
+		Cluster* cluster = sampleCluster->getCluster(sample, clusterIndex - playDirection, CLUSTER_ENQUEUE,
+		                                             priorityRating); // Adds 1 reason
+		if (!cluster) {
+			break;
+		}
+
+		// The Sample mustn't be deleted while one of its Clusters still has a reason
+		sample->addReason();
+		clusterPrefetches[numClusterPrefetches++] = {cluster, releaseAtTime};
+	}
+}
+
+void AudioFileManager::releaseFinishedPrefetches() {
+	for (int32_t i = 0; i < numClusterPrefetches;) {
+		ClusterPrefetch* prefetch = &clusterPrefetches[i];
+		Cluster* cluster = prefetch->cluster;
+
+		bool finished = cluster->loaded || (int32_t)(AudioEngine::audioSampleTimer - prefetch->releaseAtTime) >= 0;
+		if (!finished || isClusterBeingLoaded(cluster)) {
+			i++;
+			continue;
+		}
+
+		Sample* sample = cluster->sample;
+		removeReasonFromCluster(cluster, "E454");
+		sample->removeReason("E455");
+
+		*prefetch = clusterPrefetches[--numClusterPrefetches];
+	}
+}
+
+bool AudioFileManager::preloadSample(Sample* sample) {
+	if (sample->type != AudioFileType::SAMPLE || sample->unplayable || sample->unloadable) {
+		return false;
+	}
+
+	auto preloadsEnd = samplePreloads.begin() + numSamplePreloads;
+	if (std::ranges::find(samplePreloads.begin(), preloadsEnd, sample, &SamplePreload::sample) != preloadsEnd) {
+		return true;
+	}
+
+	int32_t firstClusterIndex = sample->getFirstClusterIndexWithAudioData();
+	int32_t numClusters = sample->getFirstClusterIndexWithNoAudioData() - firstClusterIndex;
+	if (numClusters <= 0) {
+		return false;
+	}
+
+	uint32_t numBytes = numClusters * clusterObjectSize;
+	uint32_t budget = runtimeFeatureSettings.get(RuntimeFeatureSettingType::SamplePreloadBudget) << 20;
+
+	if (numSamplePreloads == kMaxNumSamplePreloads || samplePreloadBytes + numBytes > budget) {
+		releaseUnusedSamplePreloads();
+		if (numSamplePreloads == kMaxNumSamplePreloads || samplePreloadBytes + numBytes > budget) {
+			D_PRINTLN("no preload budget left for %s", sample->filePath.get());
+			return false;
+		}
+	}
+
+	for (int32_t c = 0; c < numClusters; c++) {
+		int32_t clusterIndex = firstClusterIndex + c;
+		Cluster* cluster = sample->clusters.getElement(clusterIndex)->getCluster(sample, clusterIndex,
+		                                                                         CLUSTER_ENQUEUE); // Adds 1 reason
+		if (!cluster) {
+			// Out of RAM. Don't leave part of it held
+			for (int32_t r = firstClusterIndex; r < clusterIndex; r++) {
+				removeReasonFromCluster(sample->clusters.getElement(r)->cluster, "E463");
+			}
+			D_PRINTLN("couldn't preload %s", sample->filePath.get());
+			return false;
+		}
+	}
+
+	// The Sample mustn't be deleted while its Clusters still have our reasons
+	sample->addReason();
+	samplePreloads[numSamplePreloads++] = {sample, firstClusterIndex, numClusters};
+	samplePreloadBytes += numBytes;
+
+	D_PRINTLN("preloaded %s - %d samples, %d bytes", sample->filePath.get(), numSamplePreloads, samplePreloadBytes);
+	return true;
+}
+
+void AudioFileManager::releaseSamplePreload(int32_t i) {
+	SamplePreload* preload = &samplePreloads[i];
+	Sample* sample = preload->sample;
+
+	for (int32_t c = 0; c < preload->numClusters; c++) {
+		removeReasonFromCluster(sample->clusters.getElement(preload->firstClusterIndex + c)->cluster, "E461");
+	}
+	samplePreloadBytes -= preload->numClusters * clusterObjectSize;
+	sample->removeReason("E462");
+
+	*preload = samplePreloads[--numSamplePreloads];
+}
+
+void AudioFileManager::releaseUnusedSamplePreloads() {
+	for (int32_t i = 0; i < numSamplePreloads;) {
+		// If our reason is its only one, no Song uses it anymore
+		if (samplePreloads[i].sample->numReasonsToBeLoaded == 1) {
+			releaseSamplePreload(i);
+		}
+		else {
+			i++;
+		}
+	}
+}
+
+void AudioFileManager::releaseAllSamplePreloads() {
+	while (numSamplePreloads) {
+		releaseSamplePreload(numSamplePreloads - 1);
+	}
+}
+
 void AudioFileManager::addReasonToCluster(Cluster* cluster) {
 	// If it's going to cease to be zero, it's become unavailable
 	if (cluster->numReasonsToBeLoaded == 0) {
@@ -1439,7 +2282,7 @@ void AudioFileManager::addReasonToCluster(Cluster* cluster) {
 void AudioFileManager::removeReasonFromCluster(Cluster* cluster, char const* errorCode, bool deletingSong) {
 	cluster->numReasonsToBeLoaded--;
 
-	if (cluster == clusterBeingLoaded && cluster->numReasonsToBeLoaded < minNumReasonsForClusterBeingLoaded) {
+	if (isClusterBeingLoaded(cluster) && cluster->numReasonsToBeLoaded < minNumReasonsForClusterBeingLoaded) {
 		FREEZE_WITH_ERROR("E041"); // Sven got this!
 	}
 
@@ -18,8 +18,12 @@
 #pragma once
 #include "definitions_cxx.hpp"
 #include "storage/audio/audio_file_vector.h"
+#include "storage/cluster/cluster_extent_map.h"
 #include "storage/cluster/cluster_priority_queue.h"
+#include "storage/cluster/cluster_read_batch.h"
+#include <array>
 #include <cstdint>
+#include <span>
 #include <stdint.h>
 
 extern "C" {
@@ -27,10 +31,12 @@ extern "C" {
 }
 
 class Sample;
+class SampleHolder;
 class Cluster;
 class SampleCache;
 class String;
 class SampleRecorder;
+struct FlacSeekPoint;
 class Output;
 
 enum class AlternateLoadDirStatus {
@@ -59,6 +65,10 @@ char const* const audioRecordingFolderNames[] = {"SAMPLES/CLIPS", "SAMPLES/RECOR
  * Sample may begin instantly when the Sound or AudioClip is played. And if the Sample has a loop-start point,
  * it keeps the first two Clusters from that point permanently loaded too.
  *
+ * A Sound may also ask for its short Samples to be "preloaded" - see Sound::preloadSamplesUpToKB. Then all
+ * of that Sample's Clusters are kept loaded, up to an overall budget, and it never needs the card again while
+ * it plays. This suits one-shots which get triggered constantly, like hi-hats.
+ *
  * Then as the Sample plays, the currently-playing Cluster and the next one are kept loaded in RAM.
  * Or rather, as soon as the “play-head” enters a new Cluster, the Deluge immediately enqueues
  * the following Cluster to be loaded from the card ASAP.
@@ -91,6 +101,8 @@ public:
 	void loadAnyEnqueuedClusters(int32_t maxNum = 128, bool mayProcessUserActionsBetween = false);
 	void addReasonToCluster(Cluster* cluster);
 	void removeReasonFromCluster(Cluster* cluster, char const* errorCode, bool deletingSong = false);
+	/// Whether cluster is being read from the card right now - by itself or as part of a ClusterReadBatch
+	bool isClusterBeingLoaded(Cluster* cluster);
 	void testQueue();
 
 	bool ensureEnoughMemoryForOneMoreAudioFile();
@@ -100,6 +112,28 @@ public:
 	Error setupAlternateAudioFilePath(String* newPath, int32_t dirPathLength, String* oldPath);
 	Error setupAlternateAudioFileDir(String* newPath, char const* rootDir, String* songFilenameWithoutExtension);
 	bool loadingQueueHasAnyLowestPriorityElements();
+	/// Start loading the kNumClustersPrefetchedAhead Clusters which follow the ones a SampleHolder already holds for its
+	/// start, because the sequencer knows a note will play it in timeTilNeeded samples. They're queued behind any
+	/// Voices of normal or high priority, in order of how soon they're needed, and held until loaded or until a little
+	/// after the note was due.
+	void prefetchClustersForNote(SampleHolder* holder, bool reversed, uint32_t timeTilNeeded);
+	/// Let go of prefetched Clusters which have now loaded - they'll stay cached until stolen - or whose note never
+	/// came
+	void releaseFinishedPrefetches();
+	/// Load all of a Sample's Clusters and hold onto them, out of the steal queues, so it never needs the card again
+	/// while it plays. They're enqueued together, so they get read in as few multi-Cluster reads as the file's layout
+	/// allows. Gives up, leaving the Sample streamed as normal, if that would take the preloaded total over the Sample
+	/// Preload Budget community feature. Returns whether the Sample is now preloaded
+	bool preloadSample(Sample* sample);
+	/// Let go of preloaded Samples which nothing else uses anymore
+	void releaseUnusedSamplePreloads();
+	/// Let go of all preloaded Samples, e.g. so a Song being loaded can have the whole budget
+	void releaseAllSamplePreloads();
+	[[nodiscard]] int32_t getNumPreloadedSamples() const { return numSamplePreloads; }
+	/// In no particular order
+	[[nodiscard]] Sample* getPreloadedSample(int32_t i) const { return samplePreloads[i].sample; }
+	/// The RAM the preloaded Samples' Clusters take up, in bytes
+	[[nodiscard]] uint32_t getPreloadedSampleBytes() const { return samplePreloadBytes; }
 	/// If songname isn't supplied the file is placed in the main recording folder and named as samples/folder/REC###.
 	/// If song and channel are supplied then it's placed in samples/folder/song/channel_###
 	Error getUnusedAudioRecordingFilePath(String* filePath, String* tempFilePathForRecording,
@@ -109,6 +143,9 @@ public:
 	void deleteUnusedAudioFileFromMemory(AudioFile* audioFile, int32_t i);
 	void deleteUnusedAudioFileFromMemoryIndexUnknown(AudioFile* audioFile);
 	bool tryToDeleteAudioFileFromMemoryIfItExists(char const* filePath);
+	/// Removes the cluster map sidecar kept next to an audio file, if there is one, so it isn't left behind when the
+	/// file is deleted or moved
+	void deleteClusterMapSidecar(char const* filePath);
 
 	void thingBeginningLoading(ThingType newThingType);
 	void thingFinishedLoading();
@@ -125,7 +162,7 @@ public:
 	bool cardEjected;
 	bool cardDisabled;
 
-	Cluster* clusterBeingLoaded;
+	Cluster* clusterBeingLoaded; // When loading a ClusterReadBatch, the first one of it
 	int32_t minNumReasonsForClusterBeingLoaded; // Only valid when clusterBeingLoaded is set. And this exists for bug
 	                                            // hunting only.
 
@@ -139,6 +176,79 @@ public:
 	void firstCardRead();
 
 private:
+	/// Notes further off than this aren't worth tying up memory for yet
+	static constexpr uint32_t kMaxClusterPrefetchTime = kSampleRate * 8;
+	/// How long after its note was due a prefetched Cluster which hasn't loaded yet is given up on
+	static constexpr uint32_t kClusterPrefetchGraceTime = kSampleRate;
+	static constexpr int32_t kMaxNumClusterPrefetches = 48;
+
+	/// A "reason" we hold on a Cluster, and its Sample, until it's loaded
+	struct ClusterPrefetch {
+		Cluster* cluster;
+		uint32_t releaseAtTime;
+	};
+	std::array<ClusterPrefetch, kMaxNumClusterPrefetches> clusterPrefetches;
+	int32_t numClusterPrefetches{0};
+
+	static constexpr int32_t kMaxNumSamplePreloads = 128;
+
+	/// A "reason" we hold on a Sample, and on each of its Clusters which has audio data
+	struct SamplePreload {
+		Sample* sample;
+		int32_t firstClusterIndex;
+		int32_t numClusters;
+	};
+	std::array<SamplePreload, kMaxNumSamplePreloads> samplePreloads;
+	int32_t numSamplePreloads{0};
+	uint32_t samplePreloadBytes{0};
+	void releaseSamplePreload(int32_t i);
+
+	std::array<Cluster*, ClusterReadBatch::kMaxNumClusters> clustersBeingLoaded;
+	int32_t numClustersBeingLoaded{0}; // Only when loading a ClusterReadBatch
+
+	int32_t getNumSectorsToLoad(Cluster* cluster);
+	void joinClusterToNeighbours(Cluster* cluster);
+	void gatherClustersToLoadWith(Cluster* cluster, ClusterReadBatch& batch);
+	bool loadClusterBatch(ClusterReadBatch& batch);
+	static void convertClusterInBatch(int batchIndex, void* audioFileManager);
+
+	static constexpr uint32_t kMinNumClustersForClusterMapSidecar = 64;
+	/// Where a Sample's sidecar goes: next to it, hidden from the browser by a leading "."
+	Error getClusterMapSidecarPath(String* sidecarPath, char const* filePath);
+	bool readClusterMapSidecar(Sample* sample, char const* filePath, ClusterExtentMap<>::FileIdentity const& identity,
+	                           uint32_t numClusters);
+	bool clusterExtentsMatchFAT(Sample* sample);
+	void writeClusterMapSidecar(Sample* sample, char const* filePath,
+	                            ClusterExtentMap<>::FileIdentity const& identity);
+	FIL clusterMapSidecarFile;
+
+	/// Whole sectors of a FLAC Sample's file, read in to decode frames from
+	struct FlacReadWindow {
+		uint8_t* buffer;
+		uint32_t capacity;        ///< In bytes, a multiple of 512
+		uint32_t fileBytePos = 0; ///< Of buffer[0]
+		uint32_t numBytes = 0;
+
+		[[nodiscard]] uint32_t end() const { return fileBytePos + numBytes; }
+		[[nodiscard]] std::span<uint8_t const> from(uint32_t pos) const {
+			return {buffer + pos - fileBytePos, end() - pos};
+		}
+	};
+	Error loadFlacSample(Sample* sample, uint32_t fileSize);
+	bool scanFlacFrames(Sample* sample, FlacReadWindow& window, FlacSeekPoint start, uint32_t clusterIndex,
+	                    uint64_t* numSamples);
+	FlacSeekPoint const* findFlacSeekPoint(Sample* sample, FlacReadWindow& window, uint32_t clusterIndex);
+	bool decodeFlacCluster(Cluster* cluster);
+	bool readFlacWindow(Sample* sample, FlacReadWindow& window, uint32_t pos, uint32_t numBytes);
+	uint32_t getFlacReadWindowCapacity(Sample* sample);
+	uint8_t* getFlacScratch(Sample* sample);
+	void doneWithFlacScratch(uint8_t* scratch);
+	/// Once there are no FLAC Samples left
+	void releaseFlacScratchIfUnused();
+	uint8_t* flacScratch{nullptr};
+	uint32_t flacScratchSize{0};
+	bool flacScratchInUse{false};
+
 	void setClusterSize(uint32_t newSize);
 	void cardReinserted();
 	int32_t readBytes(char* buffer, int32_t num, int32_t* byteIndexWithinCluster, Cluster** currentCluster,
@@ -0,0 +1,504 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "storage/audio/flac_decoder.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace {
+
+constexpr auto kCrc8Table = [] {
+	std::array<uint8_t, 256> table{};
+	for (uint32_t i = 0; i < 256; i++) {
+		uint32_t crc = i;
+		for (int32_t b = 0; b < 8; b++) {
+			crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+		}
+		table[i] = crc;
+	}
+	return table;
+}();
+
+constexpr auto kCrc16Table = [] {
+	std::array<uint16_t, 256> table{};
+	for (uint32_t i = 0; i < 256; i++) {
+		uint32_t crc = i << 8;
+		for (int32_t b = 0; b < 8; b++) {
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x8005 : crc << 1;
+		}
+		table[i] = crc;
+	}
+	return table;
+}();
+
+constexpr uint8_t kSampleSizes[8] = {0, 8, 12, 0, 16, 20, 24, 32}; // 0 means "see STREAMINFO", or reserved
+
+enum ChannelAssignment : uint8_t {
+	LEFT_SIDE = 8,
+	SIDE_RIGHT = 9,
+	MID_SIDE = 10,
+};
+
+/// Reads big-endian bit fields. Reading past the end gives 0s, and overrun() says whether that's happened
+class BitReader {
+public:
+	explicit BitReader(std::span<uint8_t const> in) : data_(in.data()), size_(in.size()) {}
+
+	/// numBits may be 0 to 32
+	uint32_t read(int32_t numBits) {
+		if (!numBits) {
+			return 0;
+		}
+		if (numBits > bits_) {
+			refill();
+		}
+		uint32_t value = cache_ >> (64 - numBits);
+		cache_ <<= numBits;
+		bits_ -= numBits;
+		return value;
+	}
+
+	/// numBits may be 0 to 32
+	int32_t readSigned(int32_t numBits) {
+		if (!numBits) {
+			return 0;
+		}
+		if (numBits > bits_) {
+			refill();
+		}
+		int32_t value = (int64_t)cache_ >> (64 - numBits);
+		cache_ <<= numBits;
+		bits_ -= numBits;
+		return value;
+	}
+
+	/// Counts the 0 bits up to the next 1 bit, which gets skipped too
+	uint32_t readUnary() {
+		uint32_t count = 0;
+		while (true) {
+			// Bits below the ones we've got are always 0, so any 1 is one of ours
+			if (cache_) {
+				int32_t zeros = __builtin_clzll(cache_);
+				cache_ <<= zeros;
+				cache_ <<= 1;
+				bits_ -= zeros + 1;
+				return count + zeros;
+			}
+			count += bits_;
+			bits_ = 0;
+			if (overrun()) {
+				return count;
+			}
+			refill();
+		}
+	}
+
+	void alignToByte() {
+		int32_t numBits = bits_ & 7;
+		cache_ <<= numBits;
+		bits_ -= numBits;
+	}
+
+	/// Only meaningful once aligned to a byte
+	[[nodiscard]] uint32_t bytePos() const { return pos_ - (bits_ >> 3); }
+
+	[[nodiscard]] bool overrun() const { return (uint64_t)pos_ * 8 - bits_ > (uint64_t)size_ * 8; }
+
+private:
+	void refill() {
+		while (bits_ <= 56) {
+			uint64_t byte = (pos_ < size_) ? data_[pos_] : 0;
+			pos_++;
+			cache_ |= byte << (56 - bits_);
+			bits_ += 8;
+		}
+	}
+
+	uint8_t const* data_;
+	uint32_t size_;
+	uint32_t pos_ = 0;
+	uint64_t cache_ = 0; ///< Left-aligned
+	int32_t bits_ = 0;   ///< How many of cache_'s top bits are ones we've read in but not handed out yet
+};
+
+/// Reads the residual of a predicted subframe into out[order] to out[blockSize - 1]
+bool readResidual(BitReader& bits, uint32_t blockSize, uint32_t order, int32_t* out) {
+	uint32_t codingMethod = bits.read(2);
+	if (codingMethod > 1) {
+		return false;
+	}
+	int32_t numParameterBits = codingMethod ? 5 : 4;
+	uint32_t escapeParameter = (1 << numParameterBits) - 1;
+
+	uint32_t partitionOrder = bits.read(4);
+	uint32_t partitionSize = blockSize >> partitionOrder;
+	if ((partitionSize << partitionOrder) != blockSize || partitionSize < order) {
+		return false;
+	}
+
+	uint32_t i = order;
+	for (uint32_t partitionEnd = partitionSize; partitionEnd <= blockSize; partitionEnd += partitionSize) {
+		uint32_t parameter = bits.read(numParameterBits);
+
+		// Unencoded
+		if (parameter == escapeParameter) {
+			int32_t numBits = bits.read(5);
+			for (; i < partitionEnd; i++) {
+				out[i] = bits.readSigned(numBits);
+			}
+		}
+
+		// Rice coded, and zigzagged to make it unsigned
+		else {
+			for (; i < partitionEnd; i++) {
+				uint32_t value = (bits.readUnary() << parameter) | bits.read(parameter);
+				out[i] = (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+			}
+		}
+
+		if (bits.overrun()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool readSubframe(BitReader& bits, uint32_t blockSize, int32_t bitsPerSample, int32_t* out) {
+	if (bits.read(1)) {
+		return false; // Padding, which must be 0
+	}
+	uint32_t type = bits.read(6);
+
+	int32_t wastedBits = 0;
+	if (bits.read(1)) {
+		wastedBits = bits.readUnary() + 1;
+		if (wastedBits >= bitsPerSample) {
+			return false;
+		}
+		bitsPerSample -= wastedBits;
+	}
+
+	// Constant
+	if (type == 0) {
+		std::fill_n(out, blockSize, bits.readSigned(bitsPerSample));
+	}
+
+	// Verbatim
+	else if (type == 1) {
+		for (uint32_t i = 0; i < blockSize; i++) {
+			out[i] = bits.readSigned(bitsPerSample);
+		}
+	}
+
+	// Fixed polynomial prediction
+	else if (type >= 8 && type <= 12) {
+		uint32_t order = type - 8;
+		if (order > blockSize) {
+			return false;
+		}
+		for (uint32_t i = 0; i < order; i++) {
+			out[i] = bits.readSigned(bitsPerSample);
+		}
+		if (!readResidual(bits, blockSize, order, out)) {
+			return false;
+		}
+
+		switch (order) {
+		case 1:
+			for (uint32_t i = 1; i < blockSize; i++) {
+				out[i] += out[i - 1];
+			}
+			break;
+		case 2:
+			for (uint32_t i = 2; i < blockSize; i++) {
+				out[i] += 2 * out[i - 1] - out[i - 2];
+			}
+			break;
+		case 3:
+			for (uint32_t i = 3; i < blockSize; i++) {
+				out[i] += 3 * out[i - 1] - 3 * out[i - 2] + out[i - 3];
+			}
+			break;
+		case 4:
+			for (uint32_t i = 4; i < blockSize; i++) {
+				out[i] += 4 * out[i - 1] - 6 * out[i - 2] + 4 * out[i - 3] - out[i - 4];
+			}
+			break;
+		}
+	}
+
+	// Linear prediction
+	else if (type >= 32) {
+		uint32_t order = type - 31;
+		if (order > blockSize) {
+			return false;
+		}
+		for (uint32_t i = 0; i < order; i++) {
+			out[i] = bits.readSigned(bitsPerSample);
+		}
+
+		uint32_t precision = bits.read(4) + 1;
+		int32_t shift = bits.readSigned(5);
+		if (precision == 16 || shift < 0) {
+			return false;
+		}
+		int32_t coefficients[32];
+		for (uint32_t j = 0; j < order; j++) {
+			coefficients[j] = bits.readSigned(precision);
+		}
+		if (!readResidual(bits, blockSize, order, out)) {
+			return false;
+		}
+
+		for (uint32_t i = order; i < blockSize; i++) {
+			int64_t prediction = 0;
+			for (uint32_t j = 0; j < order; j++) {
+				prediction += (int64_t)coefficients[j] * out[i - 1 - j];
+			}
+			out[i] += (int32_t)(prediction >> shift);
+		}
+	}
+
+	else {
+		return false; // Reserved
+	}
+
+	if (wastedBits) {
+		for (uint32_t i = 0; i < blockSize; i++) {
+			out[i] = (int32_t)((uint32_t)out[i] << wastedBits);
+		}
+	}
+
+	return !bits.overrun();
+}
+
+} // namespace
+
+bool FlacDecoder::readStreamInfo(std::span<uint8_t const> in) {
+	if (in.size() < kStreamInfoSize) {
+		return false;
+	}
+	BitReader bits(in);
+	FlacStreamInfo info;
+	info.minBlockSize = bits.read(16);
+	info.maxBlockSize = bits.read(16);
+	info.minFrameSize = bits.read(24);
+	info.maxFrameSize = bits.read(24);
+	info.sampleRate = bits.read(20);
+	info.numChannels = bits.read(3) + 1;
+	info.bitsPerSample = bits.read(5) + 1;
+	info.totalSamples = (uint64_t)bits.read(4) << 32;
+	info.totalSamples |= bits.read(32);
+
+	if (info.minBlockSize < 16 || info.maxBlockSize < info.minBlockSize || info.maxBlockSize > kMaxBlockSize
+	    || info.numChannels > kMaxNumChannels || info.bitsPerSample < 4 || info.bitsPerSample > kMaxBitsPerSample) {
+		return false;
+	}
+	streamInfo_ = info;
+	return true;
+}
+
+bool FlacDecoder::readFrameHeader(std::span<uint8_t const> in, FlacFrameHeader* header) const {
+	if (in.size() < 6 || in[0] != 0xFF || (in[1] & 0xFE) != 0xF8) {
+		return false;
+	}
+	bool variableBlockSize = in[1] & 1;
+	uint32_t blockSizeCode = in[2] >> 4;
+	uint32_t sampleRateCode = in[2] & 0x0F;
+	uint32_t channelAssignment = in[3] >> 4;
+	uint32_t sampleSizeCode = (in[3] >> 1) & 0b111;
+
+	if (!blockSizeCode || sampleRateCode == 0x0F || channelAssignment > MID_SIDE || sampleSizeCode == 3
+	    || (in[3] & 1)) {
+		return false;
+	}
+
+	// We don't cope with any of these changing mid-stream
+	uint32_t numChannels = (channelAssignment < LEFT_SIDE) ? channelAssignment + 1 : 2;
+	if (numChannels != streamInfo_.numChannels
+	    || (sampleSizeCode && kSampleSizes[sampleSizeCode] != streamInfo_.bitsPerSample)) {
+		return false;
+	}
+
+	// The frame or sample number, coded the same way as UTF-8
+	uint32_t pos = 4;
+	uint64_t number = in[pos++];
+	if (number & 0x80) {
+		int32_t numLeadingOnes = __builtin_clz(~((uint32_t)number << 24));
+		if (numLeadingOnes < 2 || numLeadingOnes > (variableBlockSize ? 7 : 6)) {
+			return false;
+		}
+		number &= 0x7F >> numLeadingOnes;
+		for (int32_t i = 1; i < numLeadingOnes; i++) {
+			if (pos >= in.size() || (in[pos] & 0xC0) != 0x80) {
+				return false;
+			}
+			number = (number << 6) | (in[pos++] & 0x3F);
+		}
+	}
+
+	uint32_t blockSize;
+	if (blockSizeCode == 1) {
+		blockSize = 192;
+	}
+	else if (blockSizeCode <= 5) {
+		blockSize = 576 << (blockSizeCode - 2);
+	}
+	else if (blockSizeCode == 6) {
+		if (pos + 1 > in.size()) {
+			return false;
+		}
+		blockSize = in[pos] + 1;
+		pos += 1;
+	}
+	else if (blockSizeCode == 7) {
+		if (pos + 2 > in.size()) {
+			return false;
+		}
+		blockSize = ((in[pos] << 8) | in[pos + 1]) + 1;
+		pos += 2;
+	}
+	else {
+		blockSize = 256 << (blockSizeCode - 8);
+	}
+
+	// We take the sample rate from STREAMINFO, but still have to skip past any given here
+	if (sampleRateCode == 12) {
+		pos += 1;
+	}
+	else if (sampleRateCode == 13 || sampleRateCode == 14) {
+		pos += 2;
+	}
+
+	if (pos >= in.size() || blockSize > streamInfo_.maxBlockSize) {
+		return false;
+	}
+
+	uint8_t crc = 0;
+	for (uint32_t i = 0; i < pos; i++) {
+		crc = kCrc8Table[crc ^ in[i]];
+	}
+	if (crc != in[pos]) {
+		return false;
+	}
+
+	header->firstSample = variableBlockSize ? number : number * streamInfo_.maxBlockSize;
+	header->blockSize = blockSize;
+	header->channelAssignment = channelAssignment;
+	header->numBytes = pos + 1;
+	return true;
+}
+
+uint32_t FlacDecoder::findFrame(std::span<uint8_t const> in, uint64_t firstSample, FlacFrameHeader* header) const {
+	uint8_t const* start = in.data();
+	uint8_t const* end = start + in.size();
+	for (uint8_t const* sync = start; (sync = (uint8_t const*)memchr(sync, 0xFF, end - sync)) != nullptr; sync++) {
+		if (readFrameHeader(in.subspan(sync - start), header) && header->firstSample == firstSample) {
+			return sync - start;
+		}
+	}
+	return in.size();
+}
+
+uint32_t FlacDecoder::decodeFrame(std::span<uint8_t const> in, int32_t* const* channels,
+                                  FlacFrameHeader* header) const {
+	if (!readFrameHeader(in, header)) {
+		return 0;
+	}
+	uint32_t blockSize = header->blockSize;
+	uint8_t assignment = header->channelAssignment;
+
+	BitReader bits(in.subspan(header->numBytes));
+	for (int32_t c = 0; c < streamInfo_.numChannels; c++) {
+		// A side channel - the difference between the two - needs an extra bit
+		bool isSide = (assignment == LEFT_SIDE && c == 1) || (assignment == SIDE_RIGHT && c == 0)
+		              || (assignment == MID_SIDE && c == 1);
+		if (!readSubframe(bits, blockSize, streamInfo_.bitsPerSample + isSide, channels[c])) {
+			return 0;
+		}
+	}
+
+	bits.alignToByte();
+	uint32_t footerPos = header->numBytes + bits.bytePos();
+	if (footerPos + 2 > in.size()) {
+		return 0;
+	}
+	uint16_t crc = 0;
+	for (uint32_t i = 0; i < footerPos; i++) {
+		crc = (crc << 8) ^ kCrc16Table[(crc >> 8) ^ in[i]];
+	}
+	if (crc != ((in[footerPos] << 8) | in[footerPos + 1])) {
+		return 0;
+	}
+
+	int32_t* left = channels[0];
+	int32_t* right = channels[1];
+	if (assignment == LEFT_SIDE) {
+		for (uint32_t i = 0; i < blockSize; i++) {
+			right[i] = left[i] - right[i];
+		}
+	}
+	else if (assignment == SIDE_RIGHT) {
+		for (uint32_t i = 0; i < blockSize; i++) {
+			left[i] += right[i];
+		}
+	}
+	else if (assignment == MID_SIDE) {
+		for (uint32_t i = 0; i < blockSize; i++) {
+			int32_t side = right[i];
+			int32_t mid = (int32_t)((uint32_t)left[i] << 1) | (side & 1);
+			left[i] = (mid + side) >> 1;
+			right[i] = (mid - side) >> 1;
+		}
+	}
+
+	return footerPos + 2;
+}
+
+uint32_t FlacDecoder::maxFrameSize() const {
+	// Encoders fall back on verbatim subframes rather than ever make anything bigger than those
+	uint32_t verbatimSubframeSize = (streamInfo_.maxBlockSize * (streamInfo_.bitsPerSample + 1) + 7) / 8 + 2;
+	uint32_t verbatimFrameSize = kMaxFrameHeaderSize + streamInfo_.numChannels * verbatimSubframeSize + 2;
+	return std::max(verbatimFrameSize, streamInfo_.maxFrameSize);
+}
+
+void FlacDecoder::writePCM(int32_t const* const* channels, uint32_t numSamples, uint64_t pcmBytePos,
+                           uint64_t rangeStart, uint64_t rangeEnd, uint8_t* out) const {
+	uint32_t depth = byteDepth();
+	int32_t shift = depth * 8 - streamInfo_.bitsPerSample;
+	uint32_t bytesPerSample = depth * streamInfo_.numChannels;
+
+	uint32_t s = 0;
+	if (pcmBytePos < rangeStart) {
+		s = (rangeStart - pcmBytePos) / bytesPerSample;
+		pcmBytePos += (uint64_t)s * bytesPerSample;
+	}
+
+	for (; s < numSamples && pcmBytePos < rangeEnd; s++, pcmBytePos += bytesPerSample) {
+		bool straddles = pcmBytePos < rangeStart || pcmBytePos + bytesPerSample > rangeEnd;
+		uint64_t bytePos = pcmBytePos;
+		for (int32_t c = 0; c < streamInfo_.numChannels; c++) {
+			uint32_t value = (uint32_t)channels[c][s] << shift;
+			for (uint32_t b = 0; b < depth; b++, bytePos++) {
+				if (!straddles || (bytePos >= rangeStart && bytePos < rangeEnd)) {
+					out[bytePos - rangeStart] = value >> (b * 8);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+/// What a FLAC file's STREAMINFO block says about the audio in it
+struct FlacStreamInfo {
+	uint32_t minBlockSize; ///< In samples per channel
+	uint32_t maxBlockSize;
+	uint32_t minFrameSize; ///< In bytes. 0 means the encoder didn't say
+	uint32_t maxFrameSize;
+	uint32_t sampleRate;
+	uint8_t numChannels;
+	uint8_t bitsPerSample;
+	uint64_t totalSamples; ///< Per channel. 0 means the encoder didn't say
+};
+
+/// The header at the start of each FLAC frame
+struct FlacFrameHeader {
+	uint64_t firstSample; ///< Which sample of the stream the frame starts at
+	uint32_t blockSize;   ///< How many samples (per channel) the frame holds
+	uint8_t channelAssignment;
+	uint8_t numBytes; ///< Including the CRC-8 at its end
+};
+
+/// Decodes FLAC frames held in memory, one at a time, into a block of samples per channel. It does no reading of its
+/// own, so it can be pointed at frames anywhere in a file without decoding everything before them - see
+/// FlacSeekTable. Only what a Sample can play is supported: up to 24 bits and up to 2 channels.
+class FlacDecoder {
+public:
+	static constexpr uint32_t kMagic = 0x43614C66; ///< "fLaC", read as a little-endian word
+	static constexpr uint32_t kStreamInfoSize = 34;
+	static constexpr uint8_t kSeekTableBlockType = 3;
+	static constexpr uint32_t kSeekPointSize = 18;
+	static constexpr uint32_t kMaxFrameHeaderSize = 16;
+	static constexpr uint32_t kMaxBlockSize = 16384;
+	static constexpr uint8_t kMaxNumChannels = 2;
+	static constexpr uint8_t kMaxBitsPerSample = 24;
+
+	/// Reads the body of a STREAMINFO metadata block. Returns false if it's not one we can decode
+	bool readStreamInfo(std::span<uint8_t const> in);
+	[[nodiscard]] FlacStreamInfo const& streamInfo() const { return streamInfo_; }
+
+	/// Whether a frame header which agrees with the stream's STREAMINFO, and has a correct CRC-8, starts at the
+	/// beginning of in. If so, fills in header
+	bool readFrameHeader(std::span<uint8_t const> in, FlacFrameHeader* header) const;
+
+	/// Finds the first frame header in in which starts the given sample of the stream. Any other seeming frame headers
+	/// are taken to be part of some frame's audio data which happened to look like one. Returns its position in in, or
+	/// in.size() if there isn't one - though one may still start in the last kMaxFrameHeaderSize - 1 bytes
+	uint32_t findFrame(std::span<uint8_t const> in, uint64_t firstSample, FlacFrameHeader* header) const;
+
+	/// Decodes the frame at the beginning of in, writing header->blockSize samples to each of channels, which must
+	/// each have room for maxBlockSize of them. Samples come out at the stream's bit depth, right-aligned. Returns how
+	/// many bytes the frame took up, or 0 if it's corrupt or doesn't all fit in in
+	uint32_t decodeFrame(std::span<uint8_t const> in, int32_t* const* channels, FlacFrameHeader* header) const;
+
+	/// The most bytes a single frame of this stream can take up, so a buffer this big can always hold a whole one
+	[[nodiscard]] uint32_t maxFrameSize() const;
+
+	/// How many bytes each sample takes up in decoded PCM, which is how a Sample stores it in its Clusters
+	[[nodiscard]] uint8_t byteDepth() const { return (streamInfo_.bitsPerSample + 7) >> 3; }
+
+	/// Interleaves numSamples decoded samples of each channel into little-endian PCM, byteDepth() bytes each and
+	/// left-aligned within those. pcmBytePos is where in the PCM the first of them goes; only the bytes which fall
+	/// between rangeStart and rangeEnd get written, to out, which is where rangeStart goes. This is how a sample which
+	/// straddles the boundary between two Clusters gets split between them
+	void writePCM(int32_t const* const* channels, uint32_t numSamples, uint64_t pcmBytePos, uint64_t rangeStart,
+	              uint64_t rangeEnd, uint8_t* out) const;
+
+private:
+	FlacStreamInfo streamInfo_{};
+};
@@ -0,0 +1,134 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "memory/fallback_allocator.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/// Where, for one Cluster of a compressed Sample's decoded audio, to start decoding from
+struct FlacSeekPoint {
+	uint32_t fileBytePos; ///< Of the frame holding the first sample which is at least partly in the Cluster
+	uint32_t firstSample; ///< Which sample that frame starts at
+};
+
+/// Maps each Cluster of a FLAC Sample's decoded PCM to the frame it has to start decoding at. The PCM is laid out
+/// as it would be in a headerless WAV file, so a Cluster's first byte is always at the same place whichever frames
+/// it ends up holding. Each frame that gets added gives a seek point to every Cluster starting within it, so loading
+/// any one Cluster means decoding only a couple of frames.
+///
+/// When STREAMINFO says how long the stream is, the table is sized up front and frames get added as they're first
+/// needed, by scanning forward from the nearest frame already known - see startPointForScan(). The file's own
+/// SEEKTABLE, if it has one, gives some of those frames without any scanning at all.
+template <typename Alloc = deluge::memory::fallback_allocator<FlacSeekPoint>>
+class FlacSeekTable {
+public:
+	FlacSeekTable() = default;
+
+	/// bytesPerSample is for all channels together. The table then grows as frames are added, which must be in order
+	void clear(uint32_t clusterSize, uint32_t bytesPerSample) {
+		seekPoints_.clear();
+		anchors_.clear();
+		clusterSize_ = clusterSize;
+		bytesPerSample_ = bytesPerSample;
+		growable_ = true;
+	}
+
+	/// Sizes the table for a stream of numSamples, with no Cluster's seek point known yet. Frames may then be added in
+	/// any order, and any beyond the end are ignored
+	void setNumSamples(uint64_t numSamples) {
+		uint64_t numBytes = numSamples * bytesPerSample_;
+		seekPoints_.assign((numBytes + clusterSize_ - 1) / clusterSize_, {kUnknown, 0});
+		growable_ = false;
+	}
+
+	/// Add a frame of the stream
+	void addFrame(uint32_t fileBytePos, uint32_t firstSample, uint32_t blockSize) {
+		uint64_t endSample = (uint64_t)firstSample + blockSize;
+		uint64_t c = ((uint64_t)firstSample * bytesPerSample_ + clusterSize_ - 1) / clusterSize_;
+		for (; firstSampleOfCluster(c) < endSample; c++) {
+			if (c >= seekPoints_.size()) {
+				if (!growable_ || c > seekPoints_.size()) {
+					return;
+				}
+				seekPoints_.push_back({fileBytePos, firstSample});
+			}
+			else {
+				seekPoints_[c] = {fileBytePos, firstSample};
+			}
+		}
+	}
+
+	/// Somewhere a frame is known to start, though maybe not one any Cluster starts in - like the points in the file's
+	/// SEEKTABLE. Must be added in order
+	void addAnchor(uint32_t fileBytePos, uint32_t firstSample) {
+		if (anchors_.empty() || anchors_.back().firstSample < firstSample) {
+			anchors_.push_back({fileBytePos, firstSample});
+		}
+	}
+
+	/// For when an anchor turns out not to be where a frame starts after all
+	void forgetAnchors() { anchors_.clear(); }
+
+	[[nodiscard]] uint32_t numClusters() const { return seekPoints_.size(); }
+
+	/// Or nullptr if the stream doesn't reach that Cluster, or its frame hasn't been added yet
+	[[nodiscard]] FlacSeekPoint const* find(uint32_t clusterIndex) const {
+		if (clusterIndex >= seekPoints_.size() || seekPoints_[clusterIndex].fileBytePos == kUnknown) {
+			return nullptr;
+		}
+		return &seekPoints_[clusterIndex];
+	}
+
+	/// The latest frame that's known, and at or before the one the Cluster starts in, to scan forward from to find
+	/// that one. Or nullptr if there's none - which can't happen once the stream's first frame has been added
+	[[nodiscard]] FlacSeekPoint const* startPointForScan(uint32_t clusterIndex) const {
+		uint64_t targetSample = firstSampleOfCluster(clusterIndex);
+		FlacSeekPoint const* best = nullptr;
+		for (int32_t c = std::min<int32_t>(clusterIndex, (int32_t)seekPoints_.size() - 1); c >= 0; c--) {
+			if (seekPoints_[c].fileBytePos != kUnknown) {
+				best = &seekPoints_[c];
+				break;
+			}
+		}
+		for (FlacSeekPoint const& anchor : anchors_) {
+			if (anchor.firstSample > targetSample) {
+				break;
+			}
+			if (!best || anchor.firstSample > best->firstSample) {
+				best = &anchor;
+			}
+		}
+		return best;
+	}
+
+	/// The sample whose bytes the Cluster starts with - or with the end of, if it straddles two Clusters
+	[[nodiscard]] uint64_t firstSampleOfCluster(uint32_t clusterIndex) const {
+		return (uint64_t)clusterIndex * clusterSize_ / bytesPerSample_;
+	}
+
+private:
+	static constexpr uint32_t kUnknown = 0xFFFFFFFF;
+
+	std::vector<FlacSeekPoint, Alloc> seekPoints_;
+	std::vector<FlacSeekPoint, Alloc> anchors_;
+	uint32_t clusterSize_ = 1;
+	uint32_t bytesPerSample_ = 1;
+	bool growable_ = true;
+};
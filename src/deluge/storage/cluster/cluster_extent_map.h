@@ -0,0 +1,175 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "memory/fallback_allocator.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+/// A run of a file's Clusters which lie one after another on the card
+struct ClusterExtent {
+	uint32_t firstClusterIndex; ///< Which of the file's Clusters the run starts with
+	uint32_t sdAddress;         ///< In sectors
+	uint32_t numClusters;
+};
+
+/// Where a file is on the card, as runs of contiguous Clusters rather than one address per Cluster. A file that was
+/// copied onto a freshly formatted card is typically one single run, and even badly fragmented ones have far fewer
+/// runs than Clusters.
+///
+/// It can be saved to and loaded back from a small sidecar file, so the FAT chain needn't be walked again next time
+/// the file is loaded. Since the sidecar could be stale - the file it describes may have been replaced by a computer
+/// since - it records which file it was made for, and the caller should still check the FAT at each run's end (see
+/// AudioFileManager::readClusterMapSidecar()).
+template <typename Alloc = deluge::memory::fallback_allocator<ClusterExtent>>
+class ClusterExtentMap {
+public:
+	/// What the file looked like from its directory entry and the file system it's on, so a stale sidecar can be told
+	/// apart from a current one
+	struct FileIdentity {
+		uint32_t firstSector;
+		uint32_t fileSize;
+		uint32_t dataStartSector; ///< Changes if the card gets reformatted
+		uint32_t sectorsPerCluster;
+
+		bool operator==(FileIdentity const&) const = default;
+	};
+
+	static constexpr uint32_t kSidecarMagic = 0x50414D43; // "CMAP"
+	static constexpr uint32_t kSidecarVersion = 1;
+
+	ClusterExtentMap() = default;
+	explicit ClusterExtentMap(uint32_t sectorsPerCluster) : sectorsPerCluster_(sectorsPerCluster) {}
+
+	void clear(uint32_t sectorsPerCluster) {
+		extents_.clear();
+		sectorsPerCluster_ = sectorsPerCluster;
+		numClusters_ = 0;
+	}
+
+	/// Add the file's next Cluster, in file order
+	void append(uint32_t sdAddress) {
+		if (!extents_.empty()) {
+			ClusterExtent& last = extents_.back();
+			if (sdAddress == last.sdAddress + last.numClusters * sectorsPerCluster_) {
+				last.numClusters++;
+				numClusters_++;
+				return;
+			}
+		}
+		extents_.push_back({numClusters_, sdAddress, 1});
+		numClusters_++;
+	}
+
+	[[nodiscard]] uint32_t numClusters() const { return numClusters_; }
+	[[nodiscard]] std::span<ClusterExtent const> extents() const { return extents_; }
+
+	/// The run containing the given Cluster of the file, or nullptr if the file isn't that long
+	[[nodiscard]] ClusterExtent const* findExtent(uint32_t clusterIndex) const {
+		if (clusterIndex >= numClusters_) {
+			return nullptr;
+		}
+		auto after = std::upper_bound(extents_.begin(), extents_.end(), clusterIndex,
+		                              [](uint32_t index, ClusterExtent const& e) { return index < e.firstClusterIndex; });
+		return &*(after - 1);
+	}
+
+	/// In sectors, or 0 if the file isn't that long - which is also what SampleCluster::sdAddress uses for "invalid"
+	[[nodiscard]] uint32_t sdAddressOf(uint32_t clusterIndex) const {
+		ClusterExtent const* extent = findExtent(clusterIndex);
+		if (!extent) {
+			return 0;
+		}
+		return extent->sdAddress + (clusterIndex - extent->firstClusterIndex) * sectorsPerCluster_;
+	}
+
+	[[nodiscard]] uint32_t sidecarSize() const { return sizeof(SidecarHeader) + extents_.size() * 2 * sizeof(uint32_t); }
+
+	/// The biggest a sidecar for a file of numClusters Clusters can be - one with a separate run for every Cluster
+	[[nodiscard]] static constexpr uint32_t maxSidecarSize(uint32_t numClusters) {
+		return sizeof(SidecarHeader) + numClusters * 2 * sizeof(uint32_t);
+	}
+
+	/// Write the sidecar's contents into out, which must be sidecarSize() long
+	void writeSidecar(FileIdentity const& identity, uint8_t* out) const {
+		SidecarHeader header{kSidecarMagic, kSidecarVersion, identity, numClusters_, (uint32_t)extents_.size()};
+		memcpy(out, &header, sizeof(header));
+		out += sizeof(header);
+		for (ClusterExtent const& extent : extents_) {
+			uint32_t stored[2] = {extent.sdAddress, extent.numClusters};
+			memcpy(out, stored, sizeof(stored));
+			out += sizeof(stored);
+		}
+	}
+
+	/// Replace the map with a sidecar's contents. Returns false, leaving the map empty, if the sidecar isn't one, or
+	/// was made for a different file, or doesn't add up to numClusters Clusters starting where the file does
+	bool readSidecar(FileIdentity const& identity, uint32_t numClusters, std::span<uint8_t const> in) {
+		clear(identity.sectorsPerCluster);
+
+		SidecarHeader header;
+		if (in.size() < sizeof(header)) {
+			return false;
+		}
+		memcpy(&header, in.data(), sizeof(header));
+		if (header.magic != kSidecarMagic || header.version != kSidecarVersion || !(header.identity == identity)
+		    || header.numClusters != numClusters || header.numExtents == 0 || header.numExtents > numClusters
+		    || in.size() != sizeof(header) + header.numExtents * 2 * sizeof(uint32_t)) {
+			return false;
+		}
+
+		extents_.reserve(header.numExtents);
+		uint8_t const* pos = in.data() + sizeof(header);
+		for (uint32_t e = 0; e < header.numExtents; e++, pos += 2 * sizeof(uint32_t)) {
+			uint32_t stored[2];
+			memcpy(stored, pos, sizeof(stored));
+			uint32_t sdAddress = stored[0];
+			uint32_t numClustersInExtent = stored[1];
+			if (numClustersInExtent == 0 || numClustersInExtent > numClusters - numClusters_
+			    || sdAddress < identity.dataStartSector
+			    || (sdAddress - identity.dataStartSector) % identity.sectorsPerCluster) {
+				clear(identity.sectorsPerCluster);
+				return false;
+			}
+			extents_.push_back({numClusters_, sdAddress, numClustersInExtent});
+			numClusters_ += numClustersInExtent;
+		}
+
+		if (numClusters_ != numClusters || extents_.front().sdAddress != identity.firstSector) {
+			clear(identity.sectorsPerCluster);
+			return false;
+		}
+		return true;
+	}
+
+private:
+	struct SidecarHeader {
+		uint32_t magic;
+		uint32_t version;
+		FileIdentity identity;
+		uint32_t numClusters;
+		uint32_t numExtents;
+	};
+
+	std::vector<ClusterExtent, Alloc> extents_;
+	uint32_t sectorsPerCluster_ = 1;
+	uint32_t numClusters_ = 0;
+};
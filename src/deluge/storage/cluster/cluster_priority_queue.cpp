@@ -26,9 +26,25 @@ ClusterPriorityQueue::ClusterPriorityQueue()
 
 // Returns error
 Error ClusterPriorityQueue::add(Cluster* cluster, uint32_t priorityRating) {
-	int32_t i = insertAtKey((int32_t)cluster);
-	if (i == -1) {
-		return Error::INSUFFICIENT_RAM;
+	// Keep the queue in order of priorityRating, lowest (most urgent) first, and first-come-first-served among equals.
+	// That's an unsigned comparison, so we can't use search(), which compares keys as signed - and the key's the
+	// priorityRating, not the Cluster
+	int32_t i = 0;
+	int32_t rangeEnd = numElements;
+	while (i < rangeEnd) {
+		int32_t proposedIndex = (i + rangeEnd) >> 1;
+		uint32_t ratingHere = ((PriorityQueueElement*)getElementAddress(proposedIndex))->priorityRating;
+		if (ratingHere <= priorityRating) {
+			i = proposedIndex + 1;
+		}
+		else {
+			rangeEnd = proposedIndex;
+		}
+	}
+
+	Error error = insertAtIndex(i);
+	if (error != Error::NONE) {
+		return error;
 	}
 
 	PriorityQueueElement* element = (PriorityQueueElement*)getElementAddress(i);
@@ -0,0 +1,84 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/// A run of Clusters of one file which also lie one after another on the card, so that they can all be read with a
+/// single multiple-block read, each into its own buffer (see disk_read_scatter()), rather than paying for a separate
+/// command - and the card's access time - for each one.
+///
+/// Clusters must be appended in file order, and only the last one may be shorter than a whole cluster - that'll be the
+/// end of the file.
+class ClusterReadBatch {
+public:
+	static constexpr int32_t kMaxNumClusters = 4;
+	/// The most the SD driver will read into several buffers in one transfer
+	static constexpr uint32_t kMaxNumSectors = 256;
+
+	constexpr explicit ClusterReadBatch(uint32_t sectorsPerCluster) : sectorsPerCluster_(sectorsPerCluster) {}
+
+	/// Whether a Cluster starting at sector sdAddress and numSectors long follows straight on from the batch on the
+	/// card, and there's room for it
+	[[nodiscard]] constexpr bool canAppend(uint32_t sdAddress, uint32_t numSectors) const {
+		if (numSectors == 0 || numSectors > sectorsPerCluster_ || numSectors_ + numSectors > kMaxNumSectors) {
+			return false;
+		}
+		if (numClusters_ == 0) {
+			return true;
+		}
+		// The SD driver does reads of 2 sectors or fewer one sector at a time, so single-sector Clusters are never worth
+		// batching
+		return sectorsPerCluster_ > 1 && numClusters_ < kMaxNumClusters
+		       && numSectors_ == (uint32_t)numClusters_ * sectorsPerCluster_ // Nothing can follow a short Cluster
+		       && sdAddress == firstSector_ + numSectors_;
+	}
+
+	/// Add a Cluster's buffer to the batch. Check canAppend() first
+	constexpr void append(uint8_t* buffer, uint32_t sdAddress, uint32_t numSectors) {
+		if (numClusters_ == 0) {
+			firstSector_ = sdAddress;
+		}
+		buffers_[numClusters_++] = buffer;
+		numSectors_ += numSectors;
+	}
+
+	constexpr void clear() {
+		numClusters_ = 0;
+		numSectors_ = 0;
+	}
+
+	[[nodiscard]] constexpr int32_t size() const { return numClusters_; }
+	[[nodiscard]] constexpr bool empty() const { return numClusters_ == 0; }
+
+	/// Whether there's more than one Cluster - otherwise it may as well just be loaded by itself
+	[[nodiscard]] constexpr bool worthReadingTogether() const { return numClusters_ > 1; }
+
+	[[nodiscard]] constexpr uint32_t firstSector() const { return firstSector_; }
+	[[nodiscard]] constexpr uint32_t numSectors() const { return numSectors_; }
+	[[nodiscard]] constexpr uint32_t sectorsPerCluster() const { return sectorsPerCluster_; }
+	[[nodiscard]] constexpr uint8_t* const* buffers() const { return buffers_.data(); }
+
+private:
+	std::array<uint8_t*, kMaxNumClusters> buffers_{};
+	uint32_t sectorsPerCluster_;
+	uint32_t firstSector_ = 0;
+	uint32_t numSectors_ = 0;
+	int32_t numClusters_ = 0;
+};
@@ -0,0 +1,62 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "storage/wave_table/linear_mip.h"
+#include "util/fixedpoint.h"
+
+// The same headroom WaveTable gives its own FFTs
+constexpr int32_t kMagnitudeReductionForFFT = 12;
+
+// Padding the spectrum with zeroes gives the same harmonics at twice the length. With everything under half the
+// Nyquist frequency of that, linear interpolation between its samples is clean enough
+void renderLinearMipCycle(int16_t const* source, int32_t bandCycleSizeMagnitude, int16_t* destination,
+                          int32_t* timeDomainData, ne10_fft_cpx_int32_t* frequencyDomainData,
+                          ne10_fft_r2c_cfg_int32_t fftConfigBand, ne10_fft_r2c_cfg_int32_t fftConfigMip) {
+	int32_t bandCycleSize = 1 << bandCycleSizeMagnitude;
+	int32_t mipCycleSize = bandCycleSize << 1;
+
+	for (int32_t i = 0; i < bandCycleSize; i++) {
+		timeDomainData[i] = (int32_t)source[i] << (16 - kMagnitudeReductionForFFT);
+	}
+#if defined(__ARM_NEON)
+	ne10_fft_r2c_1d_int32_neon(frequencyDomainData, timeDomainData, fftConfigBand, false);
+#else
+	ne10_fft_r2c_1d_int32_c(frequencyDomainData, timeDomainData, fftConfigBand, false);
+#endif
+
+	// What was the band's Nyquist frequency becomes an ordinary harmonic, which the inverse FFT counts twice (for it
+	// and its mirror image) rather than once
+	frequencyDomainData[bandCycleSize >> 1].r >>= 1;
+	frequencyDomainData[bandCycleSize >> 1].i = 0;
+	for (int32_t i = (bandCycleSize >> 1) + 1; i <= bandCycleSize; i++) {
+		frequencyDomainData[i].r = 0;
+		frequencyDomainData[i].i = 0;
+	}
+#if defined(__ARM_NEON)
+	ne10_fft_c2r_1d_int32_neon(timeDomainData, frequencyDomainData, fftConfigMip, false);
+#else
+	ne10_fft_c2r_1d_int32_c(timeDomainData, frequencyDomainData, fftConfigMip, false);
+#endif
+
+	for (int32_t i = 0; i < mipCycleSize; i++) {
+		destination[i] = signed_saturate<32 - 16>(timeDomainData[i]
+		                                          >> (16 - kMagnitudeReductionForFFT + bandCycleSizeMagnitude));
+	}
+	for (int32_t i = 0; i < kLinearMipNumDuplicateSamplesAtEndOfCycle; i++) {
+		destination[mipCycleSize + i] = destination[i];
+	}
+}
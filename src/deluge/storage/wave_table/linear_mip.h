@@ -0,0 +1,114 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "NE10.h"
+#include "definitions_cxx.hpp"
+#include <cstdint>
+
+/// A linear mip's cycle is followed by this many copies of its first samples, so readLinearMip() can always read the
+/// sample after the one it's at without wrapping
+constexpr int32_t kLinearMipNumDuplicateSamplesAtEndOfCycle = 1;
+
+/// In samples, from one of a linear mip's cycles to the next. Padded so every cycle starts on a cache line
+constexpr int32_t getLinearMipCycleStride(int32_t mipCycleSize) {
+	constexpr int32_t kSamplesPerCacheLine = CACHE_LINE_SIZE / sizeof(int16_t);
+	return (mipCycleSize + kLinearMipNumDuplicateSamplesAtEndOfCycle + kSamplesPerCacheLine - 1)
+	       & ~(kSamplesPerCacheLine - 1);
+}
+
+/// Renders one of a band's cycles, of (1 << bandCycleSizeMagnitude) samples, out again at twice that length with the
+/// same harmonics, followed by its duplicate samples. timeDomainData needs room for the longer cycle, and
+/// frequencyDomainData for one more than half of that. fftConfigBand and fftConfigMip are FFTConfigManager's configs
+/// for the two lengths
+void renderLinearMipCycle(int16_t const* source, int32_t bandCycleSizeMagnitude, int16_t* destination,
+                          int32_t* timeDomainData, ne10_fft_cpx_int32_t* frequencyDomainData,
+                          ne10_fft_r2c_cfg_int32_t fftConfigBand, ne10_fft_r2c_cfg_int32_t fftConfigMip);
+
+/// One linearly interpolated value from a linear mip's cycle, at about the same magnitude as the windowed sinc gives
+/// between two cycles
+[[gnu::always_inline]] inline int32_t readLinearMip(int16_t const* __restrict__ table, uint32_t phase,
+                                                    int32_t mipCycleSizeMagnitude) {
+	uint32_t whichValue = phase >> (32 - mipCycleSizeMagnitude);
+	int32_t strength2 = (phase << mipCycleSizeMagnitude) >> 18;
+	int32_t value1 = table[whichValue];
+	int32_t value2 = table[whichValue + 1];
+	return (value1 << 14) + (value2 - value1) * strength2;
+}
+
+/// Which of a WaveTable's bands have linear mips to crossfade between for a phaseIncrement, by index
+struct LinearMipBands {
+	int32_t lower;
+	int32_t upper;          ///< -1 when lower alone is bandlimited enough
+	uint32_t upperStrength; ///< 31-bit
+};
+
+/// A band's linear mip holds harmonics up to a quarter of its own sample rate. We want those to stay below the
+/// output's Nyquist frequency, and most of the time to stay below half of it, which leaves room to crossfade to the
+/// next band up across the octave before the top harmonic would get there. So, the lower band is the first one where
+/// the top harmonic is below Nyquist, and the crossfade goes by how far it is above half Nyquist.
+/// getCycleSize(b) gives band b's cycle size without duplicates. Returns false if there's no band, or no band to
+/// crossfade to, which is bandlimited enough
+template <typename GetCycleSize>
+bool chooseLinearMipBands(uint32_t phaseIncrement, int32_t numBands, GetCycleSize getCycleSize,
+                          LinearMipBands* choice) {
+	int32_t b = 0;
+	uint64_t topHarmonicRelativeToNyquist; // 32-bit fractional
+	while (true) {
+		if (b == numBands) {
+			return false;
+		}
+		topHarmonicRelativeToNyquist = (uint64_t)phaseIncrement * getCycleSize(b);
+		if (topHarmonicRelativeToNyquist < ((uint64_t)1 << 32)) {
+			break;
+		}
+		b++;
+	}
+	choice->lower = b;
+
+	if (topHarmonicRelativeToNyquist < ((uint64_t)1 << 31)) { // Only happens for the first band, at very low pitches
+		choice->upper = -1;
+		choice->upperStrength = 0;
+		return true;
+	}
+
+	if (b + 1 == numBands) {
+		return false;
+	}
+	choice->upper = b + 1;
+	choice->upperStrength = topHarmonicRelativeToNyquist - ((uint64_t)1 << 31);
+	return true;
+}
+
+/// chooseLinearMipBands(), but only if the bands it picks still have their linear mips - they may never have got the
+/// memory, or had it stolen since the WaveTable stopped being used - and are an octave apart. Otherwise returns false,
+/// and the WaveTable renders with the windowed sinc, just as it would with no mips at all. hasLinearMip(b) and
+/// getCycleSizeMagnitude(b) describe band b
+template <typename GetCycleSize, typename HasLinearMip, typename GetCycleSizeMagnitude>
+bool chooseAvailableLinearMipBands(uint32_t phaseIncrement, int32_t numBands, GetCycleSize getCycleSize,
+                                   HasLinearMip hasLinearMip, GetCycleSizeMagnitude getCycleSizeMagnitude,
+                                   LinearMipBands* choice) {
+	if (!chooseLinearMipBands(phaseIncrement, numBands, getCycleSize, choice) || !hasLinearMip(choice->lower)) {
+		return false;
+	}
+	if (choice->upper < 0) {
+		return true;
+	}
+	return hasLinearMip(choice->upper)
+	       && getCycleSizeMagnitude(choice->upper) == getCycleSizeMagnitude(choice->lower) - 1;
+}
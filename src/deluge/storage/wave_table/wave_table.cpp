@@ -28,6 +28,7 @@
 #include "storage/audio/audio_file_manager.h"
 #include "storage/cluster/cluster.h"
 #include "storage/storage_manager.h"
+#include "storage/wave_table/linear_mip.h"
 #include "storage/wave_table/wave_table_reader.h"
 #include <new>
 
@@ -38,6 +39,10 @@ WaveTableBand::~WaveTableBand() {
 		data->~WaveTableBandData();
 		delugeDealloc(data);
 	}
+	if (linearMipData) {
+		linearMipData->~WaveTableBandData();
+		delugeDealloc(linearMipData);
+	}
 }
 
 WaveTable::WaveTable() : bands(sizeof(WaveTableBand)), AudioFile(AudioFileType::WAVETABLE) {
@@ -62,6 +67,10 @@ void WaveTable::bandDataBeingStolen(WaveTableBandData* bandData) {
 			band->data = NULL;
 			break;
 		}
+		if (band->linearMipData == bandData) {
+			band->linearMipData = NULL;
+			break;
+		}
 	}
 }
 
@@ -278,6 +287,7 @@ gotError2:
 		band->data = new (bandDataMemory) WaveTableBandData(this);
 
 		band->dataAccessAddress = (int16_t*)(band->data + 1);
+		band->linearMipData = NULL;
 
 		band->fromCycleNumber = 0;
 		band->toCycleNumber = 0;
@@ -806,9 +816,79 @@ transformBandToTimeDomain:
 		}
 	}
 
+	buildLinearMips();
+
 	return Error::NONE;
 }
 
+// Each band only has its cycles at the size that just fits its harmonics, which is why they need the windowed sinc to
+// read them back. Here we render each band's cycles out again at twice that size, with the same harmonics - see
+// renderLinearMipCycle(). Linear interpolation between their samples is then clean enough, at a fraction of the sinc's
+// cost - see render() for where they're used.
+// None of this is essential: a band we can't do it for (no RAM, or no FFT config big enough) just keeps being rendered
+// with the sinc.
+void WaveTable::buildLinearMips() {
+	int32_t biggestCycleSize = 0;
+	for (int32_t b = 0; b < bands.getNumElements(); b++) {
+		WaveTableBand* band = (WaveTableBand*)bands.getElementAddress(b);
+		if (FFTConfigManager::getConfig(band->cycleSizeMagnitude + 1)) {
+			biggestCycleSize = std::max<int32_t>(biggestCycleSize, band->cycleSizeNoDuplicates);
+		}
+	}
+	if (!biggestCycleSize) {
+		return;
+	}
+
+	AudioEngine::logAction("allocating linear mip working memory");
+	int32_t* __restrict__ timeDomainData =
+	    (int32_t*)GeneralMemoryAllocator::get().allocMaxSpeed((biggestCycleSize << 1) * sizeof(int32_t));
+	if (!timeDomainData) {
+		return;
+	}
+	ne10_fft_cpx_int32_t* __restrict__ frequencyDomainData = (ne10_fft_cpx_int32_t*)GeneralMemoryAllocator::get()
+	                                                             .allocMaxSpeed((biggestCycleSize + 1)
+	                                                                            * sizeof(ne10_fft_cpx_int32_t));
+	if (!frequencyDomainData) {
+		delugeDealloc(timeDomainData);
+		return;
+	}
+
+	for (int32_t b = 0; b < bands.getNumElements(); b++) {
+		WaveTableBand* band = (WaveTableBand*)bands.getElementAddress(b);
+		ne10_fft_r2c_cfg_int32_t fftCFGBand = FFTConfigManager::getConfig(band->cycleSizeMagnitude);
+		ne10_fft_r2c_cfg_int32_t fftCFGMip = FFTConfigManager::getConfig(band->cycleSizeMagnitude + 1);
+		if (!fftCFGBand || !fftCFGMip) {
+			continue;
+		}
+
+		int32_t bandCycleSizeWithDuplicates =
+		    band->cycleSizeNoDuplicates + WAVETABLE_NUM_DUPLICATE_SAMPLES_AT_END_OF_CYCLE;
+		int32_t stride = getLinearMipCycleStride(band->cycleSizeNoDuplicates << 1);
+		int32_t numCyclesHere = band->toCycleNumber - band->fromCycleNumber;
+
+		void* mipMemory = GeneralMemoryAllocator::get().allocStealable(
+		    sizeof(WaveTableBandData) + CACHE_LINE_SIZE + numCyclesHere * stride * sizeof(int16_t));
+		if (!mipMemory) {
+			continue; // Smaller bands might still fit
+		}
+		band->linearMipData = new (mipMemory) WaveTableBandData(this);
+		uint32_t firstCycleAddress =
+		    ((uint32_t)(band->linearMipData + 1) + CACHE_LINE_SIZE - 1) & ~(uint32_t)(CACHE_LINE_SIZE - 1);
+		band->linearMipAccessAddress = (int16_t*)firstCycleAddress - band->fromCycleNumber * stride;
+		band->linearMipCycleStride = stride;
+
+		for (int32_t c = band->fromCycleNumber; c < band->toCycleNumber; c++) {
+			AudioEngine::routineWithClusterLoading();
+			renderLinearMipCycle(&band->dataAccessAddress[c * bandCycleSizeWithDuplicates], band->cycleSizeMagnitude,
+			                     &band->linearMipAccessAddress[c * stride], timeDomainData, frequencyDomainData,
+			                     fftCFGBand, fftCFGMip);
+		}
+	}
+
+	delugeDealloc(timeDomainData);
+	delugeDealloc(frequencyDomainData);
+}
+
 __attribute__((optimize("unroll-loops"))) void
 WaveTable::doRenderingLoopSingleCycle(int32_t* __restrict__ thisSample, int32_t const* bufferEnd,
                                       WaveTableBand* __restrict__ bandHere, uint32_t phase, uint32_t phaseIncrement,
@@ -1045,6 +1125,97 @@ const int16_t* getKernel(int32_t phaseIncrement, int32_t bandMaxPhaseIncrement)
 	return &windowedSincKernel[whichKernel][0][0];
 }
 
+template <bool kCrossCycle, bool kCrossfadeMips>
+[[gnu::hot]] static void doLinearMipRenderingLoop(int32_t* __restrict__ thisSample, int32_t const* bufferEnd,
+                                                  int16_t const* __restrict__ lowerTable1,
+                                                  int16_t const* __restrict__ lowerTable2,
+                                                  int16_t const* __restrict__ upperTable1,
+                                                  int16_t const* __restrict__ upperTable2,
+                                                  int32_t lowerCycleSizeMagnitude, uint32_t upperStrength,
+                                                  uint32_t phase, uint32_t phaseIncrement,
+                                                  uint32_t crossCycleStrength2, int32_t crossCycleStrength2Increment) {
+	do {
+		phase += phaseIncrement;
+
+		int32_t value = readLinearMip(lowerTable1, phase, lowerCycleSizeMagnitude);
+		if constexpr (kCrossCycle) {
+			int32_t value2 = readLinearMip(lowerTable2, phase, lowerCycleSizeMagnitude);
+			value += multiply_32x32_rshift32(value2 - value, crossCycleStrength2 >> 1) << 1;
+		}
+
+		if constexpr (kCrossfadeMips) {
+			int32_t upperValue = readLinearMip(upperTable1, phase, lowerCycleSizeMagnitude - 1);
+			if constexpr (kCrossCycle) {
+				int32_t upperValue2 = readLinearMip(upperTable2, phase, lowerCycleSizeMagnitude - 1);
+				upperValue += multiply_32x32_rshift32(upperValue2 - upperValue, crossCycleStrength2 >> 1) << 1;
+			}
+			value += multiply_32x32_rshift32(upperValue - value, upperStrength) << 1;
+		}
+
+		if constexpr (kCrossCycle) {
+			crossCycleStrength2 += crossCycleStrength2Increment;
+			*thisSample = value;
+		}
+		else {
+			*thisSample = value << 1; // The sinc gives single-cycle waveforms at twice the magnitude
+		}
+	} while (++thisSample != bufferEnd);
+}
+
+// See chooseAvailableLinearMipBands(). The choice is the same for the whole window, since phaseIncrement is.
+bool WaveTable::chooseLinearMips(uint32_t phaseIncrement, LinearMipChoice* choice) {
+	auto getBand = [this](int32_t b) { return (WaveTableBand*)bands.getElementAddress(b); };
+	LinearMipBands chosen;
+	if (!chooseAvailableLinearMipBands(
+	        phaseIncrement, bands.getNumElements(), [&](int32_t b) { return getBand(b)->cycleSizeNoDuplicates; },
+	        [&](int32_t b) { return getBand(b)->linearMipData != NULL; },
+	        [&](int32_t b) { return getBand(b)->cycleSizeMagnitude; }, &chosen)) {
+		return false;
+	}
+
+	choice->lower = getBand(chosen.lower);
+	choice->upper = (chosen.upper < 0) ? NULL : getBand(chosen.upper);
+	choice->upperStrength = chosen.upperStrength;
+	return true;
+}
+
+void WaveTable::renderLinearMips(int32_t* outputBuffer, int32_t numSamples, LinearMipChoice const& choice,
+                                 int32_t firstCycleNumber, uint32_t phase, uint32_t phaseIncrement,
+                                 uint32_t crossCycleStrength2, int32_t crossCycleStrength2Increment) {
+	int32_t const* bufferEnd = outputBuffer + numSamples;
+	WaveTableBand* lower = choice.lower;
+	WaveTableBand* upper = choice.upper;
+	int16_t const* lowerTable1 = &lower->linearMipAccessAddress[firstCycleNumber * lower->linearMipCycleStride];
+	int16_t const* lowerTable2 = lowerTable1 + lower->linearMipCycleStride;
+	int32_t lowerCycleSizeMagnitude = lower->cycleSizeMagnitude + 1;
+
+	if (upper) {
+		int16_t const* upperTable1 = &upper->linearMipAccessAddress[firstCycleNumber * upper->linearMipCycleStride];
+		int16_t const* upperTable2 = upperTable1 + upper->linearMipCycleStride;
+		if (numCycles > 1) {
+			doLinearMipRenderingLoop<true, true>(outputBuffer, bufferEnd, lowerTable1, lowerTable2, upperTable1,
+			                                     upperTable2, lowerCycleSizeMagnitude, choice.upperStrength, phase,
+			                                     phaseIncrement, crossCycleStrength2, crossCycleStrength2Increment);
+		}
+		else {
+			doLinearMipRenderingLoop<false, true>(outputBuffer, bufferEnd, lowerTable1, NULL, upperTable1, NULL,
+			                                      lowerCycleSizeMagnitude, choice.upperStrength, phase,
+			                                      phaseIncrement, 0, 0);
+		}
+	}
+	else {
+		if (numCycles > 1) {
+			doLinearMipRenderingLoop<true, false>(outputBuffer, bufferEnd, lowerTable1, lowerTable2, NULL, NULL,
+			                                      lowerCycleSizeMagnitude, 0, phase, phaseIncrement,
+			                                      crossCycleStrength2, crossCycleStrength2Increment);
+		}
+		else {
+			doLinearMipRenderingLoop<false, false>(outputBuffer, bufferEnd, lowerTable1, NULL, NULL, NULL,
+			                                       lowerCycleSizeMagnitude, 0, phase, phaseIncrement, 0, 0);
+		}
+	}
+}
+
 // waveIndex comes in as a 31-bit number
 uint32_t WaveTable::render(int32_t* __restrict__ outputBuffer, int32_t numSamples, uint32_t phaseIncrement,
                            uint32_t phase, bool doOscSync, uint32_t resetterPhaseThisCycle,
@@ -1058,6 +1229,10 @@ uint32_t WaveTable::render(int32_t* __restrict__ outputBuffer, int32_t numSample
 	}
 	WaveTableBand* bandHere = (WaveTableBand*)bands.getElementAddress(bHere);
 
+	// Osc sync needs to re-render parts of the window, which only the sinc loops are set up for
+	LinearMipChoice linearMips;
+	bool useLinearMips = !doOscSync && chooseLinearMips(phaseIncrement, &linearMips);
+
 	// If we're an actual wave table with more than one cycle...
 	if (numCycles > 1) [[likely]] {
 		int32_t numSamplesLeftToDo = numSamples;
@@ -1105,6 +1280,13 @@ startRenderingACycle:
 
 		uint32_t crossCycleStrength2 = waveIndexScaled << lshiftAmountToGetCrossCycleStrength;
 
+		if (useLinearMips && linearMips.haveCycles(firstCycleNumber)) [[likely]] {
+			renderLinearMips(outputBuffer, numSamplesThisCycle, linearMips, firstCycleNumber, phase, phaseIncrement,
+			                 crossCycleStrength2, crossCycleStrength2Increment);
+			phase += phaseIncrement * numSamplesThisCycle;
+			goto doneRenderingACycle;
+		}
+
 		// If this band doesn't have data for either of the two cycle indexes we'll be interpolating between...
 		while (bandHere->fromCycleNumber > firstCycleNumber || bandHere->toCycleNumber <= firstCycleNumber + 1) {
 
@@ -1145,6 +1327,10 @@ doneRenderingACycle:
 	}
 
 	// Or, if we're actually a single-cycle waveform, with only one cycle...
+	else if (useLinearMips) {
+		renderLinearMips(outputBuffer, numSamples, linearMips, 0, phase, phaseIncrement, 0, 0);
+		phase += phaseIncrement * numSamples;
+	}
 	else {
 		const int16_t* kernel = getKernel(phaseIncrement, bandHere->maxPhaseIncrement);
 		if (doOscSync) {
@@ -1171,6 +1357,9 @@ void WaveTable::numReasonsIncreasedFromZero() {
 		if (band->data) {
 			band->data->remove();
 		}
+		if (band->linearMipData) {
+			band->linearMipData->remove();
+		}
 	}
 }
 
@@ -1187,6 +1376,15 @@ void WaveTable::numReasonsDecreasedToZero(char const* errorCode) {
 #endif
 			GeneralMemoryAllocator::get().putStealableInQueue(band->data, StealableQueue::NO_SONG_WAVETABLE_BAND_DATA);
 		}
+		if (band->linearMipData) {
+#if ALPHA_OR_BETA_VERSION
+			if (band->linearMipData->list) {
+				FREEZE_WITH_ERROR("E464");
+			}
+#endif
+			GeneralMemoryAllocator::get().putStealableInQueue(band->linearMipData,
+			                                                  StealableQueue::NO_SONG_WAVETABLE_BAND_DATA);
+		}
 	}
 }
 
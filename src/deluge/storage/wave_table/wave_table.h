@@ -36,6 +36,12 @@ public:
 	bool intendedForLinearInterpolation;
 	int16_t* dataAccessAddress;
 	WaveTableBandData* data; // Might be different than the above if memory has been shortened
+
+	/// The same cycles again, rendered out at twice the length so they can be read with plain linear interpolation -
+	/// see WaveTable::buildLinearMips(). NULL if there wasn't the RAM or FFT config for it
+	WaveTableBandData* linearMipData;
+	int16_t* linearMipAccessAddress; // Indexed by cycle number, like dataAccessAddress
+	uint16_t linearMipCycleStride;   // In samples. Padded so every cycle starts on a cache line
 };
 
 class WaveTable final : public AudioFile {
@@ -66,6 +72,27 @@ protected:
 	void numReasonsDecreasedToZero(char const* errorCode);
 
 private:
+	/// The linear mips render() would crossfade between for this phaseIncrement, if it can use them at all
+	struct LinearMipChoice {
+		WaveTableBand* lower;
+		WaveTableBand* upper;   // NULL when lower alone is bandlimited enough
+		uint32_t upperStrength; // 31-bit
+
+		/// Whether the mips have both the cycles we'd be interpolating between, like render() checks for the sinc
+		[[nodiscard]] bool haveCycles(int32_t firstCycleNumber) const {
+			return hasCycles(lower, firstCycleNumber) && (!upper || hasCycles(upper, firstCycleNumber));
+		}
+		static bool hasCycles(WaveTableBand const* band, int32_t firstCycleNumber) {
+			return band->fromCycleNumber <= firstCycleNumber && band->toCycleNumber > firstCycleNumber + 1;
+		}
+	};
+
+	void buildLinearMips();
+	bool chooseLinearMips(uint32_t phaseIncrement, LinearMipChoice* choice);
+	void renderLinearMips(int32_t* outputBuffer, int32_t numSamples, LinearMipChoice const& choice,
+	                      int32_t firstCycleNumber, uint32_t phase, uint32_t phaseIncrement,
+	                      uint32_t crossCycleStrength2, int32_t crossCycleStrength2Increment);
+
 	void doRenderingLoop(int32_t* __restrict__ thisSample, int32_t const* bufferEnd, int32_t firstCycleNumber,
 	                     WaveTableBand* __restrict__ bandHere, uint32_t phase, uint32_t phaseIncrement,
 	                     uint32_t waveIndexScaled, int32_t waveIndexIncrementScaled,
@@ -0,0 +1,71 @@
+/*
+ * Copyright © 2024 Synthstrom Audible Limited
+ *
+ * This file is part of The Synthstrom Audible Deluge Firmware.
+ *
+ * The Synthstrom Audible Deluge Firmware is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+namespace deluge {
+
+/// A fixed-capacity FIFO for handing things from exactly one producer to exactly one consumer, either of which may
+/// interrupt the other - e.g. the audio routine and the card routine. Each side only ever writes its own index, so
+/// no locking or disabling of interrupts is needed.
+template <typename T, size_t kCapacity>
+class SPSCRing {
+	static_assert(kCapacity && !(kCapacity & (kCapacity - 1)), "Capacity must be a power of two");
+
+public:
+	/// Producer only. Returns false, leaving the ring untouched, if it's full
+	bool push(T value) {
+		size_t head = head_.load(std::memory_order_relaxed);
+		if (head - tail_.load(std::memory_order_acquire) == kCapacity) {
+			return false;
+		}
+		slots_[head & (kCapacity - 1)] = value;
+		head_.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// Consumer only. Returns nothing if the ring's empty
+	std::optional<T> pop() {
+		size_t tail = tail_.load(std::memory_order_relaxed);
+		if (head_.load(std::memory_order_acquire) == tail) {
+			return std::nullopt;
+		}
+		T value = slots_[tail & (kCapacity - 1)];
+		tail_.store(tail + 1, std::memory_order_release);
+		return value;
+	}
+
+	/// Either side may call these, but the answer can be out of date by the time the other side's had a go
+	[[nodiscard]] size_t size() const {
+		return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+	}
+	[[nodiscard]] bool empty() const { return size() == 0; }
+	[[nodiscard]] bool full() const { return size() == kCapacity; }
+	[[nodiscard]] static constexpr size_t capacity() { return kCapacity; }
+
+private:
+	std::array<T, kCapacity> slots_{};
+	// Free-running - only ever wrapped to the capacity when indexing slots_
+	std::atomic<size_t> head_{0};
+	std::atomic<size_t> tail_{0};
+};
+
+} // namespace deluge
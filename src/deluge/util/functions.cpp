@@ -1328,7 +1328,8 @@ bool isAudioFilename(char const* filename) {
 		return false;
 	}
 	char* dotPos = strrchr(filename, '.');
-	return (!strcasecmp(dotPos, ".WAV") || !strcasecmp(dotPos, ".AIF") || !strcasecmp(dotPos, ".AIFF"));
+	return (!strcasecmp(dotPos, ".WAV") || !strcasecmp(dotPos, ".AIF") || !strcasecmp(dotPos, ".AIFF")
+	        || !strcasecmp(dotPos, ".FLAC"));
 }
 
 bool isAiffFilename(char const* filename) {
@@ -2,6 +2,7 @@
 #include "CppUTestExt/MockSupport.h"
 #include "definitions_cxx.hpp"
 #include "memory/memory_region.h"
+#include "memory/slab_allocator.h"
 #include "model/sample/sample.h"
 #include "storage/cluster/cluster.h"
 #include "storage/wave_table/wave_table.h"
@@ -298,6 +299,59 @@ TEST(MemoryAllocation, RandomAllocFragmentation) {
 	CHECK(averageSize / numRepeats > 0.685 * mem_size);
 };
 
+TEST(MemoryAllocation, stealableRunIndex) {
+	CacheManager& cacheManager = memreg.cache_manager();
+	StealableTest* stealables[CacheManager::kNumIndexedRunsPerQueue + 2];
+	for (int i = 0; i < CacheManager::kNumIndexedRunsPerQueue + 2; i++) {
+		void* testalloc = memreg.alloc(1000 << i, true, NULL);
+		stealables[i] = new (testalloc) StealableTest();
+		cacheManager.QueueForReclamation(StealableQueue{0}, stealables[i]);
+	}
+
+	// Only the biggest ones are kept, longest first
+	auto& runs = cacheManager.indexed_runs(StealableQueue{0});
+	for (int i = 0; i < CacheManager::kNumIndexedRunsPerQueue; i++) {
+		StealableTest* expected = stealables[CacheManager::kNumIndexedRunsPerQueue + 1 - i];
+		CHECK(runs[i].stealable == expected);
+		CHECK_EQUAL(getAllocatedSize(expected), runs[i].length);
+	}
+	CHECK(stealables[0]->runIndexedBy == NULL);
+
+	// Moving to another queue takes it out of the old queue's index
+	StealableTest* biggest = stealables[CacheManager::kNumIndexedRunsPerQueue + 1];
+	biggest->remove();
+	cacheManager.QueueForReclamation(StealableQueue{1}, biggest);
+	CHECK(runs[0].stealable == stealables[CacheManager::kNumIndexedRunsPerQueue]);
+	CHECK(cacheManager.indexed_runs(StealableQueue{1})[0].stealable == biggest);
+
+	// Destroying one takes it out of the index altogether
+	biggest->~StealableTest();
+	CHECK(cacheManager.indexed_runs(StealableQueue{1})[0].stealable == NULL);
+	memreg.dealloc(biggest);
+};
+
+TEST(MemoryAllocation, stealableRunIndexOnlyHoldsLiveStealables) {
+	mock().ignoreOtherCalls();
+	CacheManager& cacheManager = memreg.cache_manager();
+	for (int i = 0; i < NUM_TEST_ALLOCATIONS; i += 1) {
+		uint32_t size = (i % 3 == 0) ? 1000 : 30000;
+		void* testalloc = memreg.alloc(size, (i % 5 != 0), NULL);
+		if (i % 5 != 0) {
+			StealableTest* stealable = new (testalloc) StealableTest();
+			cacheManager.QueueForReclamation(StealableQueue{0}, stealable);
+		}
+	}
+	// Plenty has been stolen to get here. Whatever's left in the index must still be in the queue
+	CHECK(nSteals > 0);
+	for (auto& run : cacheManager.indexed_runs(StealableQueue{0})) {
+		if (run.stealable != NULL) {
+			CHECK(run.stealable->list == &cacheManager.queue(StealableQueue{0}));
+			CHECK(run.stealable->runIndexedBy == &cacheManager);
+		}
+	}
+	mock().clear();
+};
+
 // allocate 512 1m stealables
 TEST(MemoryAllocation, stealableAllocations) {
 	srand(1);
@@ -331,4 +385,83 @@ TEST(MemoryAllocation, stealableAllocations) {
 	CHECK(efficiency > 0.994);
 	mock().checkExpectations();
 };
+TEST(MemoryAllocation, slabAllocationSizes) {
+	SlabAllocator slabs{memreg};
+	void* testalloc = slabs.alloc(100);
+	CHECK(testalloc != NULL);
+	CHECK(SlabAllocator::isSlabAllocation(testalloc));
+	CHECK_EQUAL(128, getAllocatedSize(testalloc));
+
+	CHECK(slabs.alloc(SlabAllocator::kMaxSize + 1) == NULL);
+	CHECK(!SlabAllocator::isSlabAllocation(memreg.alloc(100, false, NULL)));
+
+	// A freed slot is the next one handed out
+	slabs.dealloc(testalloc);
+	CHECK(slabs.alloc(65) == testalloc);
+};
+
+TEST(MemoryAllocation, slabAllocations) {
+	SlabAllocator slabs{memreg};
+	void* testAllocations[NUM_TEST_ALLOCATIONS];
+	uint32_t testSizes[NUM_TEST_ALLOCATIONS];
+	for (int i = 0; i < NUM_TEST_ALLOCATIONS; i++) {
+		testSizes[i] = 1 + (getRandom255() << 2);
+		testAllocations[i] = slabs.alloc(testSizes[i]);
+		CHECK(testAllocations[i] != NULL);
+		CHECK(getAllocatedSize(testAllocations[i]) >= testSizes[i]);
+		testWritingMemory(testAllocations[i], testSizes[i]);
+	}
+
+	uint32_t numSlabs = 0;
+	uint32_t numInUse = 0;
+	for (size_t c = 0; c < SlabAllocator::kNumSizeClasses; c++) {
+		numSlabs += slabs.stats(c).numSlabs;
+		numInUse += slabs.stats(c).numInUse;
+		CHECK_EQUAL(slabs.stats(c).numInUse, slabs.stats(c).peakInUse);
+	}
+	CHECK_EQUAL(NUM_TEST_ALLOCATIONS, numInUse);
+	CHECK(numSlabs > SlabAllocator::kNumSizeClasses);
+
+	// Free every other one, then check the rest weren't touched
+	for (int i = 0; i < NUM_TEST_ALLOCATIONS; i += 2) {
+		slabs.dealloc(testAllocations[i]);
+	}
+	for (int i = 1; i < NUM_TEST_ALLOCATIONS; i += 2) {
+		CHECK(testReadingMemory(testAllocations[i], testSizes[i]));
+		slabs.dealloc(testAllocations[i]);
+	}
+
+	// Empty slabs go back to the region, apart from one per size class
+	for (size_t c = 0; c < SlabAllocator::kNumSizeClasses; c++) {
+		CHECK_EQUAL(0, slabs.stats(c).numInUse);
+		CHECK(slabs.stats(c).numSlabs <= 1);
+	}
+};
+TEST(MemoryAllocation, regionStats) {
+	MemoryRegionStats stats = memreg.getStats();
+	CHECK_EQUAL(0, stats.bytesAllocated);
+	CHECK_EQUAL(1, stats.numEmptySpaces);
+	CHECK_EQUAL(stats.size - 8, stats.largestFreeRun);
+
+	// Fill it up with stealables, and keep going so some get stolen
+	mock().ignoreOtherCalls();
+	uint32_t size = 1 << 16;
+	int32_t numAllocations = 2 * mem_size / size;
+	for (int i = 0; i < numAllocations; i++) {
+		void* testalloc = memreg.alloc(size, true, NULL);
+		CHECK(testalloc != NULL);
+		StealableTest* stealable = new (testalloc) StealableTest();
+		memreg.cache_manager().QueueForReclamation(StealableQueue{0}, stealable);
+	}
+	mock().clear();
+
+	stats = memreg.getStats();
+	CHECK(stats.bytesAllocated > stats.size - 2 * size);
+	CHECK(stats.largestFreeRun < size);
+	CHECK_EQUAL(nSteals, memreg.cache_manager().steals(StealableQueue{0}));
+	CHECK_EQUAL(0, memreg.cache_manager().steals(StealableQueue{1}));
+	CHECK_EQUAL(numAllocations, memreg.allocLatency.total());
+
+	memreg.printStats("test", [](char const* line) { std::cout << line << std::endl; });
+};
 } // namespace
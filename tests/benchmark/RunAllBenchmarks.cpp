@@ -0,0 +1,78 @@
+#include "benchmark.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace benchmark {
+namespace {
+struct Entry {
+	const char* name;
+	BenchmarkFunction function;
+};
+
+std::vector<Entry>& registry() {
+	static std::vector<Entry> entries;
+	return entries;
+}
+} // namespace
+
+Registration::Registration(const char* name, BenchmarkFunction function) {
+	registry().push_back({name, function});
+}
+} // namespace benchmark
+
+/// Usage: RenderBenchmarks [--filter <substring>] [--max-load <fraction of realtime>]
+///
+/// With --max-load, exits with failure if any result took more than that fraction of realtime to render, so a fixed
+/// set of benchmarks can be used to gate changes on a given build machine.
+int main(int argc, char** argv) {
+	const char* filter = nullptr;
+	float maxLoad = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+			filter = argv[++i];
+		}
+		else if (!strcmp(argv[i], "--max-load") && i + 1 < argc) {
+			maxLoad = strtof(argv[++i], nullptr);
+		}
+		else {
+			fprintf(stderr, "unknown argument %s\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	int failures = 0;
+	printf("%-40s %10s %10s %10s %10s %14s %8s %10s\n", "benchmark", "ns/win min", "avg", "max", "ns/sample",
+	       "samples/s", "load", "cull from");
+
+	for (auto& entry : benchmark::registry()) {
+		if (filter && !strstr(entry.name, filter)) {
+			continue;
+		}
+		std::vector<benchmark::Result> results;
+		entry.function(results);
+
+		for (auto& result : results) {
+			const RenderStats& stats = result.stats;
+			// Where there were voices, roughly how many of them would fit before AudioEngine started culling
+			int32_t voicesAtCull =
+			    stats.estimateVoicesAtCull(benchmark::kCullLimitSamples, benchmark::kDefaultWindowSize);
+			printf("%-40s %10u %10u %10u %10u %14.0f %8.4f ", result.name, stats.minTicksPerWindow(),
+			       stats.averageTicksPerWindow(), stats.maxTicksPerWindow(), stats.averageTicksPerSample(),
+			       stats.samplesPerSecond(), stats.load());
+			if (voicesAtCull >= 0) {
+				printf("%10d\n", voicesAtCull);
+			}
+			else {
+				printf("%10s\n", "-");
+			}
+			if (maxLoad > 0 && stats.load() > maxLoad) {
+				printf("  FAILED: load %.4f exceeds %.4f\n", stats.load(), maxLoad);
+				failures++;
+			}
+		}
+	}
+
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "processing/engines/render_stats.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/// Minimal harness for timing render code on the host. Each benchmark renders a fixed number of windows through some
+/// part of the audio engine, and the cost of each window is recorded in the same RenderStats the firmware uses, counted
+/// in nanoseconds rather than CPU cycles.
+///
+/// Absolute numbers obviously don't carry over to the Deluge, but ratios between two builds (or between two
+/// implementations of the same kernel) are a decent first indication of whether a change is a regression.
+namespace benchmark {
+
+constexpr uint32_t kNanosecondsPerSecond = 1000000000;
+constexpr uint32_t kBenchmarkSampleRate = 44100;
+
+/// The window lengths AudioEngine::routine_() typically ends up rendering - see audio_engine.h
+constexpr size_t kDefaultWindowSize = 128;
+constexpr size_t kDefaultNumWindows = 4096;
+/// AudioEngine culls voices once a window takes longer than this many samples' worth of realtime - its numSamplesLimit
+constexpr uint32_t kCullLimitSamples = 80;
+
+/// Renders one window of the given number of samples
+using RenderFunction = std::function<void(size_t numSamples)>;
+
+class Runner {
+public:
+	Runner(size_t windowSize = kDefaultWindowSize, size_t numWindows = kDefaultNumWindows)
+	    : windowSize_(windowSize), numWindows_(numWindows) {}
+
+	/// Render numWindows windows and return what they cost. numVoices is just recorded alongside for reporting
+	RenderStats run(const RenderFunction& render, int32_t numVoices = 0) const {
+		RenderStats stats{kNanosecondsPerSecond, kBenchmarkSampleRate};
+
+		// One untimed window, to get everything into cache the way it would be in steady state
+		render(windowSize_);
+
+		for (size_t w = 0; w < numWindows_; w++) {
+			auto start = std::chrono::steady_clock::now();
+			render(windowSize_);
+			auto end = std::chrono::steady_clock::now();
+			uint32_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+			stats.noteWindow(windowSize_, ns, numVoices);
+		}
+		return stats;
+	}
+
+	[[nodiscard]] size_t windowSize() const { return windowSize_; }
+
+private:
+	size_t windowSize_;
+	size_t numWindows_;
+};
+
+struct Result {
+	const char* name;
+	RenderStats stats;
+};
+
+/// A benchmark reports one or more results, e.g. one per window size or per voice count
+using BenchmarkFunction = void (*)(std::vector<Result>& results);
+
+struct Registration {
+	Registration(const char* name, BenchmarkFunction function);
+};
+
+} // namespace benchmark
+
+/// Defines and registers a benchmark. The body gets a std::vector<benchmark::Result>& called results to append to
+#define BENCHMARK(name)                                                                                                \
+	static void benchmark_##name(std::vector<benchmark::Result>& results);                                             \
+	static benchmark::Registration benchmark_registration_##name{#name, benchmark_##name};                             \
+	static void benchmark_##name(std::vector<benchmark::Result>& results)
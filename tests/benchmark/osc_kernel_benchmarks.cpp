@@ -0,0 +1,99 @@
+#include "benchmark.h"
+#include "dsp/osc_kernels.h"
+#include "util/fixedpoint.h"
+#include "util/waves.h"
+#include <array>
+
+using deluge::dsp::DirectOscParams;
+
+namespace {
+constexpr int32_t kNumVoices = 16;
+
+std::array<std::array<int32_t, benchmark::kDefaultWindowSize>, kNumVoices> voiceBuffers;
+std::array<uint32_t, kNumVoices> phases;
+
+struct Configuration {
+	const char* branchingName;
+	const char* specialisedName;
+	OscType type;
+	bool sync;
+	bool applyAmplitude;
+};
+
+constexpr std::array kConfigurations{
+    Configuration{"osc/triangle/branching", "osc/triangle/specialised", OscType::TRIANGLE, false, true},
+    Configuration{"osc/saw sync/branching", "osc/saw sync/specialised", OscType::SAW, true, true},
+    Configuration{"osc/square/branching", "osc/square/specialised", OscType::SQUARE, false, true},
+    Configuration{"osc/square sync/branching", "osc/square sync/specialised", OscType::SQUARE, true, true},
+    Configuration{"osc/square ringmod/branching", "osc/square ringmod/specialised", OscType::SQUARE, false, false},
+};
+
+// The direct oscillators as Voice::renderOsc() used to do them, checking amplitude and sync per sample
+uint32_t renderBranching(int32_t* buffer, size_t numSamples, uint32_t phase, Configuration const& configuration,
+                         DirectOscParams const& params) {
+	int32_t amplitude = params.amplitude;
+	uint32_t resetterPhase = params.resetterPhase;
+	for (size_t i = 0; i < numSamples; i++) {
+		phase += params.phaseIncrement;
+		if (configuration.sync) {
+			resetterPhase += params.resetterPhaseIncrement;
+			if (resetterPhase < params.resetterPhaseIncrement) {
+				phase = (multiply_32x32_rshift32(multiply_32x32_rshift32(resetterPhase, params.phaseIncrement),
+				                                 params.resetterDivideByPhaseIncrement)
+				         << 17)
+				        + 1 + params.retriggerPhase;
+			}
+		}
+		int32_t value = (configuration.type == OscType::TRIANGLE) ? getTriangleSmall(phase)
+		                : (configuration.type == OscType::SAW)    ? (int32_t)phase
+		                                                          : getSquare(phase, params.pulseWidth);
+		if (configuration.applyAmplitude) {
+			amplitude += params.amplitudeIncrement;
+			buffer[i] = multiply_accumulate_32x32_rshift32_rounded(buffer[i], value, amplitude);
+		}
+		else {
+			buffer[i] = value >> 1;
+		}
+	}
+	return phase;
+}
+} // namespace
+
+// The oscillators Voice::renderOsc() renders without a table, for a Sound's worth of voices - with per-sample checks
+// of sync and amplitude, versus the kernel Sound::getOscKernels() picks
+BENCHMARK(oscKernels) {
+	benchmark::Runner runner;
+	DirectOscParams params{
+	    .phaseIncrement = 7654321,
+	    .pulseWidth = 2147483648u + 300000000,
+	    .amplitude = 1 << 26,
+	    .amplitudeIncrement = 1000,
+	    .resetterPhase = 0,
+	    .resetterPhaseIncrement = 3000000,
+	    .resetterDivideByPhaseIncrement = (int32_t)(2147483648u / (uint16_t)((3000000 + 65535) >> 16)),
+	    .retriggerPhase = 0,
+	};
+
+	for (Configuration const& configuration : kConfigurations) {
+		RenderStats branching = runner.run(
+		    [&](size_t numSamples) {
+			    for (int32_t v = 0; v < kNumVoices; v++) {
+				    phases[v] = renderBranching(voiceBuffers[v].data(), numSamples, phases[v], configuration, params);
+			    }
+		    },
+		    kNumVoices);
+
+		deluge::dsp::DirectOscKernel kernel =
+		    deluge::dsp::getOscKernels(configuration.type, configuration.applyAmplitude, 1).direct[configuration.sync];
+		RenderStats specialised = runner.run(
+		    [&](size_t numSamples) {
+			    for (int32_t v = 0; v < kNumVoices; v++) {
+				    phases[v] = kernel(voiceBuffers[v].data(), numSamples, phases[v], params);
+			    }
+		    },
+		    kNumVoices);
+
+		results.push_back({configuration.branchingName, branching});
+		results.push_back({configuration.specialisedName, specialised});
+	}
+}
@@ -0,0 +1,60 @@
+#include "benchmark.h"
+#include "dsp/reverb/freeverb/freeverb.hpp"
+#include "dsp/reverb/mutable/half_rate_reverb.hpp"
+#include "dsp/reverb/mutable/reverb.hpp"
+#include <array>
+#include <memory>
+#include <utility>
+
+namespace {
+std::array<int32_t, benchmark::kDefaultWindowSize> reverbInput;
+std::array<StereoSample, benchmark::kDefaultWindowSize> renderBuffer;
+
+void fillWithNoise(std::span<int32_t> buffer) {
+	static uint32_t seed = 1;
+	for (int32_t& sample : buffer) {
+		seed = seed * 1664525 + 1013904223;
+		sample = (int32_t)seed >> 4;
+	}
+}
+
+// Renders 128-sample windows through each model, so their cost per window can be compared directly
+template <typename ReverbModel>
+void benchmarkModel(std::vector<benchmark::Result>& results, const char* name) {
+	auto reverb = std::make_unique<ReverbModel>();
+	reverb->setPanLevels(ONE_Q31 >> 2, ONE_Q31 >> 2);
+
+	benchmark::Runner runner;
+	RenderStats stats = runner.run([&](size_t numSamples) {
+		fillWithNoise({reverbInput.data(), numSamples});
+		reverb->process({reverbInput.data(), numSamples}, {renderBuffer.data(), numSamples});
+	});
+	results.push_back({name, stats});
+}
+} // namespace
+
+BENCHMARK(freeverb) {
+	auto reverb = std::make_unique<deluge::dsp::reverb::Freeverb>();
+	reverb->setPanLevels(ONE_Q31 >> 2, ONE_Q31 >> 2);
+
+	constexpr std::pair<const char*, size_t> windowSizes[] = {
+	    {"freeverb/32", 32},
+	    {"freeverb/64", 64},
+	    {"freeverb/128", 128},
+	};
+
+	for (auto [name, windowSize] : windowSizes) {
+		benchmark::Runner runner{windowSize};
+		RenderStats stats = runner.run([&](size_t numSamples) {
+			fillWithNoise({reverbInput.data(), numSamples});
+			reverb->process({reverbInput.data(), numSamples}, {renderBuffer.data(), numSamples});
+		});
+		results.push_back({name, stats});
+	}
+}
+
+BENCHMARK(reverb_models) {
+	benchmarkModel<deluge::dsp::reverb::Freeverb>(results, "reverb_models/freeverb");
+	benchmarkModel<deluge::dsp::reverb::Mutable>(results, "reverb_models/mutable");
+	benchmarkModel<deluge::dsp::reverb::MutableHalfRate>(results, "reverb_models/mutable_half_rate");
+}
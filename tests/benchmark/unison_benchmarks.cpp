@@ -0,0 +1,83 @@
+#include "benchmark.h"
+#include "dsp/unison_oscillator.h"
+#include "util/fixedpoint.h"
+#include <array>
+#include <cmath>
+
+using deluge::dsp::UnisonOscillator;
+
+namespace {
+constexpr int32_t kTableSizeMagnitude = 10;
+constexpr int32_t kNumParts = UnisonOscillator::kMaxNumParts;
+
+std::array<int16_t, (1 << kTableSizeMagnitude) + 1> sawTable;
+std::array<int32_t, benchmark::kDefaultWindowSize> partBuffer;
+std::array<int32_t, benchmark::kDefaultWindowSize * 2> oscBuffer;
+std::array<uint32_t, kNumParts> phases;
+std::array<uint32_t, kNumParts> phaseIncrements;
+std::array<int32_t, kNumParts> amplitudesL;
+std::array<int32_t, kNumParts> amplitudesR;
+
+void setUp() {
+	int32_t size = 1 << kTableSizeMagnitude;
+	for (int32_t i = 0; i <= size; i++) {
+		double value = 0;
+		for (int32_t h = 1; h <= 30; h++) {
+			value += std::sin(2 * M_PI * h * (i % size) / size) / h;
+		}
+		sawTable[i] = (int16_t)(value * 16000);
+	}
+	for (int32_t p = 0; p < kNumParts; p++) {
+		phases[p] = p * 0x1F2E3D4Cu;
+		phaseIncrements[p] = 9000000 + p * 60000;
+		amplitudesL[p] = 1073741823 - p * 120000000;
+		amplitudesR[p] = 1073741823 - (kNumParts - 1 - p) * 120000000;
+	}
+}
+
+// A supersaw as Voice::renderBasicSource() used to do it: each part rendered with the window's amplitude into a spare
+// buffer by renderWave(), then panned into the stereo osc buffer
+void renderEachPart(size_t numSamples) {
+	for (int32_t p = 0; p < kNumParts; p++) {
+		uint32_t phase = phases[p];
+		int32_t amplitude = 1 << 26;
+		for (size_t i = 0; i < numSamples; i++) {
+			phase += phaseIncrements[p];
+			amplitude += 1000;
+			uint32_t whichValue = phase >> (32 - kTableSizeMagnitude);
+			int32_t strength2 = (uint16_t)(phase >> (16 - kTableSizeMagnitude)) >> 1;
+			int32_t value1 = sawTable[whichValue];
+			int16_t difference = sawTable[whichValue + 1] - value1;
+			int32_t value = (value1 << 16) + 2 * difference * strength2;
+			partBuffer[i] = ((int64_t)value * amplitude) >> 31;
+		}
+		phases[p] = phase;
+		for (size_t i = 0; i < numSamples; i++) {
+			oscBuffer[i << 1] += multiply_32x32_rshift32(partBuffer[i], amplitudesL[p]) << 2;
+			oscBuffer[(i << 1) + 1] += multiply_32x32_rshift32(partBuffer[i], amplitudesR[p]) << 2;
+		}
+	}
+}
+
+void renderTogether(size_t numSamples) {
+	UnisonOscillator unison;
+	for (int32_t p = 0; p < kNumParts; p++) {
+		unison.addPart(phases[p], phaseIncrements[p], sawTable.data(), kTableSizeMagnitude, amplitudesL[p],
+		               amplitudesR[p]);
+	}
+	unison.render(UnisonOscillator::Wave::TABLE, oscBuffer.data(), numSamples, true, 1 << 26, 1000);
+	for (int32_t p = 0; p < kNumParts; p++) {
+		phases[p] = unison.getPhase(p);
+	}
+}
+} // namespace
+
+// An 8-part stereo-spread unison saw, one part at a time versus all the parts in one pass. On the host that's the scalar
+// fallback, which also goes a part at a time, so this mostly shows the spare buffer and mixing pass being gone - the
+// four-parts-per-vector saving only shows up on the hardware
+BENCHMARK(unisonSaw) {
+	setUp();
+	benchmark::Runner runner;
+	results.push_back({"unison saw/each part", runner.run(renderEachPart, 1)});
+	results.push_back({"unison saw/together", runner.run(renderTogether, 1)});
+}
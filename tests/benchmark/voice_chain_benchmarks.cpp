@@ -0,0 +1,118 @@
+#include "benchmark.h"
+#include "dsp/osc_kernels.h"
+#include "dsp/reverb/freeverb/freeverb.hpp"
+#include "dsp/stereo_sample.h"
+#include "dsp/voice_batch.h"
+#include <array>
+#include <cstring>
+#include <memory>
+
+using deluge::dsp::DirectOscParams;
+using deluge::dsp::VoiceBatch;
+using deluge::dsp::filter::SVFilter;
+
+namespace {
+constexpr int32_t kMaxNumVoices = 16;
+constexpr size_t kWindowSize = benchmark::kDefaultWindowSize;
+
+/// A Sound, as far as the parts of Sound::render() and Voice::render() that build on the host go
+struct Patch {
+	const char* name;
+	int32_t numVoices;
+	/// Each voice's oscillators. Only the ones renderDirectOsc() does, since the table ones live in voice.cpp
+	std::array<OscType, kNumSources> oscTypes;
+	int32_t numSources;
+	bool sync;
+	bool filter;
+	bool reverb;
+};
+
+// The corpus. Fixed, so results can be compared from one build to the next
+constexpr std::array kPatches{
+    Patch{"chain/pad: 16 voices, 2 saws, SVF, reverb", 16, {OscType::SAW, OscType::SAW}, 2, false, true, true},
+    Patch{"chain/keys: 8 voices, triangle, SVF", 8, {OscType::TRIANGLE, OscType::TRIANGLE}, 1, false, true, false},
+    Patch{"chain/lead: 4 voices, synced square", 4, {OscType::SQUARE, OscType::SQUARE}, 2, true, false, true},
+    Patch{"chain/bass: 1 voice, saw + square, SVF", 1, {OscType::SAW, OscType::SQUARE}, 2, false, true, false},
+};
+
+std::array<std::array<q31_t, kWindowSize * 2>, VoiceBatch::kNumLanes> laneBuffers;
+std::array<StereoSample, kWindowSize> soundBuffer;
+std::array<int32_t, kWindowSize> reverbInput;
+std::array<StereoSample, kWindowSize> outputBuffer;
+
+std::array<SVFilter, kMaxNumVoices> filters;
+std::array<std::array<uint32_t, kNumSources>, kMaxNumVoices> phases;
+
+// A chord's worth of pitches, with the second oscillator a little sharp of the first
+uint32_t getPhaseIncrement(int32_t v, int32_t s) {
+	return 5000000 + v * 700000 + s * 1300000;
+}
+
+// The second oscillator is synced to the first, if at all, as in Voice::render()
+DirectOscParams makeOscParams(int32_t v, int32_t s, uint32_t resetterPhase) {
+	uint32_t resetterPhaseIncrement = getPhaseIncrement(v, 0);
+	return {
+	    .phaseIncrement = getPhaseIncrement(v, s),
+	    .pulseWidth = 2147483648u,
+	    .amplitude = 1 << 26,
+	    .amplitudeIncrement = 100,
+	    .resetterPhase = resetterPhase,
+	    .resetterPhaseIncrement = resetterPhaseIncrement,
+	    .resetterDivideByPhaseIncrement = (int32_t)(2147483648u / (uint16_t)((resetterPhaseIncrement + 65535) >> 16)),
+	    .retriggerPhase = 0,
+	};
+}
+
+// What Sound::render() does for one window of a Sound whose voices are all plain mono: each voice renders its
+// oscillators and hands them to the batch with its filter, the batch filters and mixes them into the Sound's buffer,
+// and then the Sound's reverb send
+void renderPatch(Patch const& patch, deluge::dsp::reverb::Freeverb& reverb, size_t numSamples) {
+	memset(soundBuffer.data(), 0, numSamples * sizeof(StereoSample));
+	VoiceBatch batch{{laneBuffers[0].data(), laneBuffers[1].data(), laneBuffers[2].data(), laneBuffers[3].data()}};
+
+	for (int32_t v = 0; v < patch.numVoices; v++) {
+		q31_t* buffer = batch.buffer();
+		memset(buffer, 0, numSamples * sizeof(q31_t));
+		uint32_t resetterPhase = phases[v][0];
+		for (int32_t s = 0; s < patch.numSources; s++) {
+			DirectOscParams params = makeOscParams(v, s, resetterPhase);
+			deluge::dsp::DirectOscKernel kernel =
+			    deluge::dsp::getOscKernels(patch.oscTypes[s], true, 1).direct[patch.sync && s == 1];
+			phases[v][s] = kernel(buffer, numSamples, phases[v][s], params);
+		}
+		batch.commit(1 << 28, 1000, patch.filter ? &filters[v] : nullptr);
+		if (batch.full()) {
+			batch.render((q31_t*)soundBuffer.data(), numSamples, true);
+		}
+	}
+	batch.render((q31_t*)soundBuffer.data(), numSamples, true);
+
+	if (patch.reverb) {
+		for (size_t i = 0; i < numSamples; i++) {
+			reverbInput[i] = (soundBuffer[i].l >> 1) + (soundBuffer[i].r >> 1);
+		}
+		reverb.process({reverbInput.data(), numSamples}, {outputBuffer.data(), numSamples});
+	}
+}
+} // namespace
+
+// A fixed corpus of patches through as much of the Sound -> Voice chain as builds on the host: the oscillators that
+// need no tables, the voice batch with its filters, amplitude and mix, and the reverb. Each result counts the patch's
+// voices, so the report says roughly how many of them would fit before culling
+BENCHMARK(voiceChain) {
+	auto reverb = std::make_unique<deluge::dsp::reverb::Freeverb>();
+	reverb->setPanLevels(ONE_Q31 >> 2, ONE_Q31 >> 2);
+	benchmark::Runner runner{kWindowSize};
+
+	for (Patch const& patch : kPatches) {
+		for (int32_t v = 0; v < patch.numVoices; v++) {
+			filters[v].reset();
+			filters[v].configure(100000000 + v * 10000000, 200000000, FilterMode::SVF_NOTCH, 0, ONE_Q31 >> 2);
+			filters[v].dryFade = 0;
+			phases[v] = {};
+		}
+		RenderStats stats = runner.run([&](size_t numSamples) { renderPatch(patch, *reverb, numSamples); },
+		                               patch.numVoices);
+		results.push_back({patch.name, stats});
+	}
+}
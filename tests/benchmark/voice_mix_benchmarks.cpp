@@ -0,0 +1,101 @@
+#include "benchmark.h"
+#include "dsp/voice_batch.h"
+#include <array>
+
+using deluge::dsp::filter::SVFilter;
+
+// What the filters need from the firmware. The real tan only changes which frequency we end up at
+int32_t instantTan(int32_t input) {
+	return input;
+}
+
+namespace {
+constexpr int32_t kNumVoices = 16;
+
+std::array<SVFilter, kNumVoices> filters;
+
+std::array<std::array<int32_t, benchmark::kDefaultWindowSize>, kNumVoices> voiceBuffers;
+std::array<int32_t, benchmark::kDefaultWindowSize * 2> soundBuffer;
+
+void fillVoices() {
+	uint32_t seed = 1;
+	for (auto& buffer : voiceBuffers) {
+		for (int32_t& sample : buffer) {
+			seed = seed * 1664525 + 1013904223;
+			sample = (int32_t)seed >> 4;
+		}
+	}
+	for (int32_t v = 0; v < kNumVoices; v++) {
+		filters[v].reset();
+		filters[v].configure(100000000 + v * 10000000, 200000000, FilterMode::SVF_NOTCH, 0, ONE_Q31 >> 2);
+		filters[v].dryFade = 0;
+	}
+}
+} // namespace
+
+// The filter, amplitude and mixing stages at the end of Voice::render(), for a Sound's worth of plain mono voices - one
+// voice at a time as the voices do themselves, versus four at a time through a dsp::VoiceBatch
+BENCHMARK(voiceMix) {
+	fillVoices();
+	benchmark::Runner runner;
+
+	RenderStats individual = runner.run(
+	    [](size_t numSamples) {
+		    for (auto& buffer : voiceBuffers) {
+			    int32_t amplitude = 1 << 28;
+			    for (size_t i = 0; i < numSamples; i++) {
+				    amplitude += 1000;
+				    int32_t sample = multiply_32x32_rshift32_rounded(buffer[i], amplitude) << 1;
+				    soundBuffer[(i << 1)] += sample;
+				    soundBuffer[(i << 1) + 1] += sample;
+			    }
+		    }
+	    },
+	    kNumVoices);
+	results.push_back({"voice mix/individual", individual});
+
+	RenderStats batched = runner.run(
+	    [](size_t numSamples) {
+		    for (int32_t v = 0; v < kNumVoices; v += deluge::dsp::VoiceBatch::kNumLanes) {
+			    deluge::dsp::VoiceBatch batch{{voiceBuffers[v].data(), voiceBuffers[v + 1].data(),
+			                                   voiceBuffers[v + 2].data(), voiceBuffers[v + 3].data()}};
+			    while (!batch.full()) {
+				    batch.commit(1 << 28, 1000);
+			    }
+			    batch.render(soundBuffer.data(), numSamples, true);
+		    }
+	    },
+	    kNumVoices);
+	results.push_back({"voice mix/batched", batched});
+
+	RenderStats individualFiltered = runner.run(
+	    [](size_t numSamples) {
+		    for (int32_t v = 0; v < kNumVoices; v++) {
+			    int32_t* buffer = voiceBuffers[v].data();
+			    filters[v].doFilter(buffer, buffer + numSamples, 1);
+			    int32_t amplitude = 1 << 28;
+			    for (size_t i = 0; i < numSamples; i++) {
+				    amplitude += 1000;
+				    int32_t sample = multiply_32x32_rshift32_rounded(buffer[i], amplitude) << 1;
+				    soundBuffer[(i << 1)] += sample;
+				    soundBuffer[(i << 1) + 1] += sample;
+			    }
+		    }
+	    },
+	    kNumVoices);
+	results.push_back({"voice mix/individual, SVF", individualFiltered});
+
+	RenderStats batchedFiltered = runner.run(
+	    [](size_t numSamples) {
+		    for (int32_t v = 0; v < kNumVoices; v += deluge::dsp::VoiceBatch::kNumLanes) {
+			    deluge::dsp::VoiceBatch batch{{voiceBuffers[v].data(), voiceBuffers[v + 1].data(),
+			                                   voiceBuffers[v + 2].data(), voiceBuffers[v + 3].data()}};
+			    while (!batch.full()) {
+				    batch.commit(1 << 28, 1000, &filters[v + batch.size()]);
+			    }
+			    batch.render(soundBuffer.data(), numSamples, true);
+		    }
+	    },
+	    kNumVoices);
+	results.push_back({"voice mix/batched, SVF", batchedFiltered});
+}
@@ -0,0 +1,103 @@
+#include "benchmark.h"
+#include "dsp/stereo_sample.h"
+#include "dsp/voice_output.h"
+#include <array>
+
+namespace {
+constexpr int32_t kNumVoices = 16;
+
+std::array<std::array<int32_t, benchmark::kDefaultWindowSize * 2>, kNumVoices> voiceBuffers;
+std::array<int32_t, benchmark::kDefaultWindowSize * 2> soundBuffer;
+std::array<uint32_t, 2> saturationWorkingValues;
+
+struct Configuration {
+	const char* flagsName;
+	const char* specialisedName;
+	bool stereoVoice;
+	bool applyAmplitude;
+	bool saturate;
+	bool pan;
+};
+
+constexpr std::array kConfigurations{
+    Configuration{"voice output/mono/flags", "voice output/mono/specialised", false, true, false, false},
+    Configuration{"voice output/mono pan/flags", "voice output/mono pan/specialised", false, true, false, true},
+    Configuration{"voice output/mono pan sat/flags", "voice output/mono pan sat/specialised", false, true, true, true},
+    Configuration{"voice output/stereo/flags", "voice output/stereo/specialised", true, true, false, false},
+    Configuration{"voice output/stereo pan sat/flags", "voice output/stereo pan sat/specialised", true, true, true,
+                  true},
+};
+
+void fillVoices() {
+	uint32_t seed = 1;
+	for (auto& buffer : voiceBuffers) {
+		for (int32_t& sample : buffer) {
+			seed = seed * 1664525 + 1013904223;
+			sample = (int32_t)seed >> 4;
+		}
+	}
+}
+
+// The output stage as Voice::render() used to do it, deciding everything as it goes
+void renderWithFlags(int32_t const* voiceBuffer, size_t numSamples, Configuration const& configuration,
+                     deluge::dsp::VoiceOutputParams const& params) {
+	int32_t amplitude = params.amplitude;
+	StereoSample* output = (StereoSample*)soundBuffer.data();
+	for (size_t i = 0; i < numSamples; i++) {
+		amplitude += params.amplitudeIncrement;
+		int32_t numChannels = configuration.stereoVoice ? 2 : 1;
+		q31_t samples[2];
+		for (int32_t c = 0; c < numChannels; c++) {
+			samples[c] = voiceBuffer[i * numChannels + c];
+			if (configuration.applyAmplitude) {
+				samples[c] = multiply_32x32_rshift32_rounded(samples[c], amplitude) << 1;
+			}
+			if (configuration.saturate) {
+				deluge::dsp::saturate(&samples[c], &params.saturationWorkingValues[c], params.clippingAmount);
+			}
+		}
+		if (!configuration.stereoVoice) {
+			samples[1] = samples[0];
+		}
+		if (configuration.pan) {
+			output[i].addPannedStereo(samples[0], samples[1], params.panAmplitudeL, params.panAmplitudeR);
+		}
+		else {
+			output[i].addStereo(samples[0], samples[1]);
+		}
+	}
+}
+} // namespace
+
+// The amplitude, saturation and panning stage at the end of Voice::render(), for a Sound's worth of voices - with
+// per-sample checks of the Sound's configuration, versus the loop dsp::getVoiceOutputFunction() picks for it
+BENCHMARK(voiceOutput) {
+	fillVoices();
+	benchmark::Runner runner;
+
+	for (Configuration const& configuration : kConfigurations) {
+		deluge::dsp::VoiceOutputParams params{1 << 28, 1000, 1 << 29, 1 << 28, 3, saturationWorkingValues.data()};
+
+		RenderStats flags = runner.run(
+		    [&](size_t numSamples) {
+			    for (auto& buffer : voiceBuffers) {
+				    renderWithFlags(buffer.data(), numSamples, configuration, params);
+			    }
+		    },
+		    kNumVoices);
+
+		deluge::dsp::VoiceOutputFunction renderOutput =
+		    deluge::dsp::getVoiceOutputFunction(configuration.stereoVoice, true, configuration.applyAmplitude,
+		                                        configuration.saturate, configuration.pan);
+		RenderStats specialised = runner.run(
+		    [&](size_t numSamples) {
+			    for (auto& buffer : voiceBuffers) {
+				    renderOutput(buffer.data(), soundBuffer.data(), numSamples, params);
+			    }
+		    },
+		    kNumVoices);
+
+		results.push_back({configuration.flagsName, flags});
+		results.push_back({configuration.specialisedName, specialised});
+	}
+}
@@ -0,0 +1,117 @@
+#include "CppUTest/TestHarness.h"
+#include "storage/cluster/cluster_extent_map.h"
+#include <memory>
+#include <vector>
+
+namespace {
+
+using ExtentMap = ClusterExtentMap<std::allocator<ClusterExtent>>;
+
+constexpr uint32_t kSectorsPerCluster = 4;
+constexpr uint32_t kDataStartSector = 67;
+
+// Where a fragmented file's clusters are on the card, as FAT cluster numbers
+constexpr uint32_t kFileClusters[] = {2, 3, 4, 5, 6, 9, 10, 20, 12, 13};
+constexpr uint32_t kNumClusters = std::size(kFileClusters);
+
+uint32_t sdAddressOfCluster(uint32_t sdCluster) {
+	return kDataStartSector + (sdCluster - 2) * kSectorsPerCluster;
+}
+
+constexpr ExtentMap::FileIdentity kIdentity{kDataStartSector, 9 * 2048 + 700, kDataStartSector, kSectorsPerCluster};
+
+ExtentMap buildMap() {
+	ExtentMap map{kSectorsPerCluster};
+	for (uint32_t sdCluster : kFileClusters) {
+		map.append(sdAddressOfCluster(sdCluster));
+	}
+	return map;
+}
+
+std::vector<uint8_t> writeSidecar(ExtentMap const& map, ExtentMap::FileIdentity const& identity) {
+	std::vector<uint8_t> sidecar(map.sidecarSize());
+	map.writeSidecar(identity, sidecar.data());
+	return sidecar;
+}
+
+} // namespace
+
+TEST_GROUP(ClusterExtentMapTest){};
+
+TEST(ClusterExtentMapTest, contiguousClustersMergeIntoRuns) {
+	ExtentMap map = buildMap();
+	CHECK_EQUAL(kNumClusters, map.numClusters());
+
+	// 2-6 | 9, 10 | 20 | 12, 13
+	auto extents = map.extents();
+	CHECK_EQUAL(4, extents.size());
+	uint32_t expectedFirstIndices[] = {0, 5, 7, 8};
+	uint32_t expectedLengths[] = {5, 2, 1, 2};
+	for (size_t e = 0; e < extents.size(); e++) {
+		CHECK_EQUAL(expectedFirstIndices[e], extents[e].firstClusterIndex);
+		CHECK_EQUAL(expectedLengths[e], extents[e].numClusters);
+		CHECK_EQUAL(sdAddressOfCluster(kFileClusters[expectedFirstIndices[e]]), extents[e].sdAddress);
+	}
+}
+
+TEST(ClusterExtentMapTest, everyClusterLooksUpToWhereItIs) {
+	ExtentMap map = buildMap();
+	for (uint32_t c = 0; c < kNumClusters; c++) {
+		CHECK_EQUAL(sdAddressOfCluster(kFileClusters[c]), map.sdAddressOf(c));
+	}
+	CHECK_EQUAL(0, map.sdAddressOf(kNumClusters));
+	CHECK(map.findExtent(kNumClusters) == nullptr);
+}
+
+TEST(ClusterExtentMapTest, sidecarRoundTrips) {
+	ExtentMap map = buildMap();
+	std::vector<uint8_t> sidecar = writeSidecar(map, kIdentity);
+	CHECK(sidecar.size() <= ExtentMap::maxSidecarSize(kNumClusters));
+
+	ExtentMap readBack;
+	CHECK(readBack.readSidecar(kIdentity, kNumClusters, sidecar));
+	CHECK_EQUAL(map.numClusters(), readBack.numClusters());
+	CHECK_EQUAL(map.extents().size(), readBack.extents().size());
+	for (uint32_t c = 0; c < kNumClusters; c++) {
+		CHECK_EQUAL(map.sdAddressOf(c), readBack.sdAddressOf(c));
+	}
+}
+
+TEST(ClusterExtentMapTest, sidecarForAnotherFileIsRejected) {
+	ExtentMap map = buildMap();
+	std::vector<uint8_t> sidecar = writeSidecar(map, kIdentity);
+	ExtentMap readBack;
+
+	ExtentMap::FileIdentity resized = kIdentity;
+	resized.fileSize += 1;
+	CHECK_FALSE(readBack.readSidecar(resized, kNumClusters, sidecar));
+	CHECK_EQUAL(0, readBack.numClusters());
+
+	ExtentMap::FileIdentity reformatted = kIdentity;
+	reformatted.dataStartSector += kSectorsPerCluster;
+	CHECK_FALSE(readBack.readSidecar(reformatted, kNumClusters, sidecar));
+
+	CHECK_FALSE(readBack.readSidecar(kIdentity, kNumClusters + 1, sidecar));
+}
+
+TEST(ClusterExtentMapTest, damagedSidecarIsRejected) {
+	ExtentMap map = buildMap();
+	std::vector<uint8_t> sidecar = writeSidecar(map, kIdentity);
+	ExtentMap readBack;
+
+	std::vector<uint8_t> truncated(sidecar.begin(), sidecar.end() - 1);
+	CHECK_FALSE(readBack.readSidecar(kIdentity, kNumClusters, truncated));
+
+	CHECK_FALSE(readBack.readSidecar(kIdentity, kNumClusters, std::span<uint8_t const>{}));
+
+	// A run which doesn't start on a cluster boundary
+	std::vector<uint8_t> misaligned = sidecar;
+	misaligned[misaligned.size() - 8] += 1;
+	CHECK_FALSE(readBack.readSidecar(kIdentity, kNumClusters, misaligned));
+	CHECK_EQUAL(0, readBack.numClusters());
+
+	// Runs adding up to more than the file
+	std::vector<uint8_t> tooLong = sidecar;
+	tooLong[tooLong.size() - 4] += 1;
+	CHECK_FALSE(readBack.readSidecar(kIdentity, kNumClusters, tooLong));
+}
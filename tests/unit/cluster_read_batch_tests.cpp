@@ -0,0 +1,249 @@
+#include "CppUTest/TestHarness.h"
+#include "storage/cluster/cluster_read_batch.h"
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "fatfs/diskio.h"
+#include "fatfs/ff.h"
+
+DWORD get_fat_from_fs(FATFS* fs, DWORD clst);
+LBA_t clst2sect(FATFS* fs, DWORD clst);
+}
+
+namespace {
+
+// A small FAT16 volume, with 4-sector clusters so that a batch is made of multi-sector reads
+constexpr uint32_t kSectorSize = 512;
+constexpr uint32_t kSectorsPerCluster = 4;
+constexpr uint32_t kClusterSize = kSectorSize * kSectorsPerCluster;
+constexpr uint32_t kNumSectors = 16800;
+constexpr uint32_t kNumReservedSectors = 1;
+constexpr uint32_t kSectorsPerFAT = 17;
+constexpr uint32_t kNumRootEntries = 512;
+constexpr uint32_t kRootDirSector = kNumReservedSectors + 2 * kSectorsPerFAT;
+constexpr uint32_t kFirstDataSector = kRootDirSector + kNumRootEntries * 32 / kSectorSize;
+
+// Where the file's clusters are on the card - fragmented, the way a well-used card's files are
+constexpr DWORD kFileClusters[] = {2, 3, 4, 5, 6, 9, 10, 20, 12, 13};
+constexpr uint32_t kFileSize = 9 * kClusterSize + 700; // So the last cluster isn't full
+
+std::vector<uint8_t> image;
+int32_t numSectorReads = 0;
+
+void put16(uint8_t* at, uint16_t value) {
+	at[0] = value;
+	at[1] = value >> 8;
+}
+
+void put32(uint8_t* at, uint32_t value) {
+	put16(at, value);
+	put16(at + 2, value >> 16);
+}
+
+uint8_t* sector(uint32_t sectorNumber) {
+	return &image[sectorNumber * kSectorSize];
+}
+
+uint8_t fileByte(uint32_t pos) {
+	return (pos * 7 + (pos >> 9)) & 0xFF;
+}
+
+void buildImage() {
+	image.assign(kNumSectors * kSectorSize, 0);
+
+	uint8_t* bootSector = sector(0);
+	bootSector[0] = 0xEB;
+	bootSector[1] = 0x3C;
+	bootSector[2] = 0x90;
+	memcpy(&bootSector[3], "DELUGE  ", 8);
+	put16(&bootSector[11], kSectorSize);
+	bootSector[13] = kSectorsPerCluster;
+	put16(&bootSector[14], kNumReservedSectors);
+	bootSector[16] = 2;
+	put16(&bootSector[17], kNumRootEntries);
+	put16(&bootSector[19], kNumSectors);
+	bootSector[21] = 0xF8;
+	put16(&bootSector[22], kSectorsPerFAT);
+	bootSector[38] = 0x29;
+	memcpy(&bootSector[43], "NO NAME    FAT16   ", 19);
+	put16(&bootSector[510], 0xAA55);
+
+	for (int32_t fat = 0; fat < 2; fat++) {
+		uint8_t* table = sector(kNumReservedSectors + fat * kSectorsPerFAT);
+		put16(&table[0], 0xFFF8);
+		put16(&table[2], 0xFFFF);
+		for (size_t c = 0; c < std::size(kFileClusters); c++) {
+			uint16_t next = (c + 1 < std::size(kFileClusters)) ? kFileClusters[c + 1] : 0xFFFF;
+			put16(&table[kFileClusters[c] * 2], next);
+		}
+	}
+
+	uint8_t* entry = sector(kRootDirSector);
+	memcpy(entry, "SAMPLE  WAV", 11);
+	entry[11] = AM_ARC;
+	put16(&entry[26], kFileClusters[0]);
+	put32(&entry[28], kFileSize);
+
+	for (uint32_t pos = 0; pos < kFileSize; pos++) {
+		DWORD cluster = kFileClusters[pos / kClusterSize];
+		sector(kFirstDataSector + (cluster - 2) * kSectorsPerCluster)[pos % kClusterSize] = fileByte(pos);
+	}
+}
+
+struct FileOnCard {
+	std::vector<uint32_t> sdAddresses;
+	std::vector<uint32_t> numSectors;
+};
+
+// Finds where each of the file's clusters is the same way AudioFileManager does, then how many sectors of each hold
+// file data
+FileOnCard mountAndFindFile() {
+	static FATFS fileSystem;
+	static FIL file;
+	CHECK_EQUAL(FR_OK, f_mount(&fileSystem, "", 1));
+	CHECK_EQUAL(FR_OK, f_open(&file, "SAMPLE.WAV", FA_READ));
+	CHECK_EQUAL(kFileSize, (uint32_t)f_size(&file));
+
+	FileOnCard onCard;
+	DWORD sdCluster = file.obj.sclust;
+	uint32_t bytesLeft = kFileSize;
+	while (bytesLeft) {
+		onCard.sdAddresses.push_back(clst2sect(&fileSystem, sdCluster));
+		uint32_t bytesThisCluster = std::min(bytesLeft, kClusterSize);
+		onCard.numSectors.push_back((bytesThisCluster - 1) / kSectorSize + 1);
+		bytesLeft -= bytesThisCluster;
+		sdCluster = get_fat_from_fs(&fileSystem, sdCluster);
+	}
+	f_close(&file);
+	return onCard;
+}
+
+// Stands in for disk_read_scatter(): one read, filling each buffer in turn
+std::vector<int32_t> buffersFilled;
+void readBatch(ClusterReadBatch const& batch) {
+	numSectorReads++;
+	for (uint32_t s = 0; s < batch.numSectors(); s++) {
+		uint32_t buffer = s / batch.sectorsPerCluster();
+		memcpy(&batch.buffers()[buffer][(s % batch.sectorsPerCluster()) * kSectorSize],
+		       sector(batch.firstSector() + s), kSectorSize);
+		if ((s + 1) % batch.sectorsPerCluster() == 0 || s + 1 == batch.numSectors()) {
+			buffersFilled.push_back(buffer);
+		}
+	}
+}
+
+} // namespace
+
+extern "C" {
+DSTATUS disk_initialize(BYTE pdrv) {
+	return 0;
+}
+DSTATUS disk_status(BYTE pdrv) {
+	return 0;
+}
+DRESULT disk_read(BYTE pdrv, BYTE* buff, LBA_t sectorNumber, UINT count) {
+	memcpy(buff, sector(sectorNumber), count * kSectorSize);
+	return RES_OK;
+}
+DRESULT disk_write(BYTE pdrv, const BYTE* buff, LBA_t sectorNumber, UINT count) {
+	memcpy(sector(sectorNumber), buff, count * kSectorSize);
+	return RES_OK;
+}
+DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void* buff) {
+	return RES_OK;
+}
+DWORD get_fattime() {
+	return 0;
+}
+int pendingGlobalMIDICommandNumClustersWritten;
+}
+
+TEST_GROUP(ClusterReadBatchTest) {
+	void setup() {
+		buildImage();
+		numSectorReads = 0;
+		buffersFilled.clear();
+	}
+};
+
+TEST(ClusterReadBatchTest, batchesFollowFileAcrossFragmentedCard) {
+	FileOnCard onCard = mountAndFindFile();
+	CHECK_EQUAL(std::size(kFileClusters), onCard.sdAddresses.size());
+
+	static uint8_t clusterData[std::size(kFileClusters)][kClusterSize];
+	std::vector<int32_t> batchSizes;
+
+	// Greedily batch the clusters up, as AudioFileManager::gatherClustersToLoadWith() does when they're all queued
+	size_t c = 0;
+	while (c < onCard.sdAddresses.size()) {
+		ClusterReadBatch batch{kSectorsPerCluster};
+		while (c < onCard.sdAddresses.size() && batch.canAppend(onCard.sdAddresses[c], onCard.numSectors[c])) {
+			batch.append(clusterData[c], onCard.sdAddresses[c], onCard.numSectors[c]);
+			c++;
+		}
+		CHECK(!batch.empty());
+		readBatch(batch);
+		batchSizes.push_back(batch.size());
+	}
+
+	// 2-5 are contiguous, but only kMaxNumClusters fit in a batch. Then 6 | 9, 10 | 20 | 12, 13
+	std::vector<int32_t> expectedBatchSizes{4, 1, 2, 1, 2};
+	CHECK(expectedBatchSizes == batchSizes);
+	CHECK_EQUAL(5, numSectorReads);
+
+	// Each buffer was handed over in order, and holds the same as reading the file through FatFS does
+	std::vector<int32_t> expectedBuffersFilled{0, 1, 2, 3, 0, 0, 1, 0, 0, 1};
+	CHECK(expectedBuffersFilled == buffersFilled);
+
+	static FIL file;
+	static uint8_t fileData[kFileSize];
+	UINT bytesRead;
+	CHECK_EQUAL(FR_OK, f_open(&file, "SAMPLE.WAV", FA_READ));
+	CHECK_EQUAL(FR_OK, f_read(&file, fileData, kFileSize, &bytesRead));
+	CHECK_EQUAL(kFileSize, bytesRead);
+	f_close(&file);
+
+	for (uint32_t pos = 0; pos < kFileSize; pos += kClusterSize) {
+		MEMCMP_EQUAL(&fileData[pos], clusterData[pos / kClusterSize], std::min(kClusterSize, kFileSize - pos));
+	}
+}
+
+TEST(ClusterReadBatchTest, nothingFollowsAShortCluster) {
+	uint8_t buffers[2][kClusterSize];
+	ClusterReadBatch batch{kSectorsPerCluster};
+	CHECK(batch.canAppend(100, 2));
+	batch.append(buffers[0], 100, 2);
+	CHECK_FALSE(batch.canAppend(102, kSectorsPerCluster));
+	CHECK_FALSE(batch.worthReadingTogether());
+}
+
+TEST(ClusterReadBatchTest, limits) {
+	uint8_t buffer[kSectorSize];
+
+	// Too many sectors for one read
+	ClusterReadBatch bigClusters{ClusterReadBatch::kMaxNumSectors};
+	bigClusters.append(buffer, 0, ClusterReadBatch::kMaxNumSectors);
+	CHECK_FALSE(bigClusters.canAppend(ClusterReadBatch::kMaxNumSectors, 1));
+
+	// Single-sector clusters would get read a sector at a time anyway
+	ClusterReadBatch tinyClusters{1};
+	tinyClusters.append(buffer, 0, 1);
+	CHECK_FALSE(tinyClusters.canAppend(1, 1));
+
+	// Nothing past the end of a cluster, and not an empty one
+	ClusterReadBatch batch{kSectorsPerCluster};
+	CHECK_FALSE(batch.canAppend(0, kSectorsPerCluster + 1));
+	CHECK_FALSE(batch.canAppend(0, 0));
+
+	// Full
+	for (int32_t c = 0; c < ClusterReadBatch::kMaxNumClusters; c++) {
+		CHECK(batch.canAppend(c * kSectorsPerCluster, kSectorsPerCluster));
+		batch.append(buffer, c * kSectorsPerCluster, kSectorsPerCluster);
+	}
+	CHECK_FALSE(batch.canAppend(ClusterReadBatch::kMaxNumClusters * kSectorsPerCluster, kSectorsPerCluster));
+	CHECK(batch.worthReadingTogether());
+
+	batch.clear();
+	CHECK(batch.empty());
+}
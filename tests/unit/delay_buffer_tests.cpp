@@ -0,0 +1,144 @@
+#include "CppUTest/TestHarness.h"
+#include "dsp/delay/delay_buffer.h"
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kNeutralRate = 1 << 24; // kMaxSampleValue - gives a kNeutralSize buffer
+
+// Two buffers with the same contents: one driven a sample at a time, as Delay::process() used to, and one through the
+// block functions
+class BufferPair {
+public:
+	explicit BufferPair(uint32_t nativeRate) {
+		perSample.init(nativeRate);
+		block.init(nativeRate);
+		uint32_t seed = nativeRate;
+		for (size_t i = 0; i < perSample.sizeIncludingExtra; i++) {
+			seed = seed * 1664525 + 1013904223;
+			perSample.begin()[i] = block.begin()[i] = {(int32_t)seed >> 2, (int32_t)(seed * 3) >> 2};
+		}
+	}
+
+	void setupForRender(int32_t rate) {
+		perSample.setupForRender(rate);
+		block.setupForRender(rate);
+	}
+
+	void checkSame() {
+		CHECK_EQUAL(&perSample.current() - perSample.begin(), &block.current() - block.begin());
+		for (size_t i = 0; i < perSample.sizeIncludingExtra; i++) {
+			CHECK_EQUAL(perSample.begin()[i].l, block.begin()[i].l);
+			CHECK_EQUAL(perSample.begin()[i].r, block.begin()[i].r);
+		}
+	}
+
+	DelayBuffer perSample;
+	DelayBuffer block;
+};
+
+std::vector<StereoSample> makeInput(size_t numSamples) {
+	std::vector<StereoSample> input(numSamples);
+	for (size_t i = 0; i < numSamples; i++) {
+		input[i] = {(int32_t)(i * 0x1234567), -(int32_t)(i * 0x7654321)};
+	}
+	return input;
+}
+
+void checkSameSamples(std::vector<StereoSample> const& expected, std::vector<StereoSample> const& actual) {
+	for (size_t i = 0; i < expected.size(); i++) {
+		CHECK_EQUAL(expected[i].l, actual[i].l);
+		CHECK_EQUAL(expected[i].r, actual[i].r);
+	}
+}
+
+// Reads and writes windows of several sizes, for long enough that the buffer wraps a few times
+void checkNativeMatches(uint32_t nativeRate) {
+	BufferPair buffers(nativeRate);
+	bool everWrapped = false;
+	for (int32_t w = 0; w < 1000; w++) {
+		size_t numSamples = (w % 3 == 0) ? 128 : (w % 3 == 1) ? 7 : 1;
+
+		std::vector<StereoSample> expected(numSamples);
+		bool expectedWrapped = false;
+		for (StereoSample& sample : expected) {
+			expectedWrapped = buffers.perSample.clearAndMoveOn() || expectedWrapped;
+			sample = buffers.perSample.current();
+		}
+		std::vector<StereoSample> actual(numSamples);
+		bool wrapped = buffers.block.clearAndReadNative(actual);
+		CHECK_EQUAL(expectedWrapped, wrapped);
+		checkSameSamples(expected, actual);
+		everWrapped = everWrapped || wrapped;
+
+		std::vector<StereoSample> input = makeInput(numSamples);
+		expectedWrapped = false;
+		for (StereoSample sample : input) {
+			expectedWrapped = buffers.perSample.clearAndMoveOn() || expectedWrapped;
+			buffers.perSample.writeNative(sample);
+		}
+		CHECK_EQUAL(expectedWrapped, buffers.block.clearAndWriteNative(input));
+		buffers.checkSame();
+	}
+	CHECK(everWrapped);
+}
+
+} // namespace
+
+TEST_GROUP(DelayBufferTests){};
+
+TEST(DelayBufferTests, nativeBlocksMatchSampleBySample) {
+	checkNativeMatches(kNeutralRate * 32); // Small enough to wrap often
+}
+
+TEST(DelayBufferTests, nativeBlocksMatchForBufferShorterThanWindow) {
+	checkNativeMatches(0xFFFFFFFF); // The smallest buffer there can be
+}
+
+TEST(DelayBufferTests, nativeWriteFromPositionMatches) {
+	BufferPair buffers(kNeutralRate * 16);
+	std::vector<StereoSample> input = makeInput(128);
+	for (size_t start : {(size_t)0, buffers.perSample.sizeIncludingExtra - 50}) {
+		StereoSample* writePos = buffers.perSample.begin() + start;
+		for (StereoSample sample : input) {
+			buffers.perSample.writeNativeAndMoveOn(sample, &writePos);
+		}
+		buffers.block.writeNative(input, buffers.block.begin() + start);
+		buffers.checkSame();
+	}
+}
+
+TEST(DelayBufferTests, resampledReadMatchesSampleBySample) {
+	for (int32_t rate : {(int32_t)(kNeutralRate * 16 * 0.7), (int32_t)(kNeutralRate * 16 * 2.3)}) {
+		BufferPair buffers(kNeutralRate * 16);
+		buffers.setupForRender(rate);
+
+		for (int32_t w = 0; w < 200; w++) {
+			size_t numSamples = (w & 1) ? 128 : 45;
+			std::vector<StereoSample> expected(numSamples);
+			bool expectedWrapped = false;
+			for (StereoSample& sample : expected) {
+				int32_t strength2 = buffers.perSample.advance([&] {
+					expectedWrapped = buffers.perSample.clearAndMoveOn() || expectedWrapped; //<
+				});
+				int32_t strength1 = 65536 - strength2;
+				StereoSample* nextPos = &buffers.perSample.current() + 1;
+				if (nextPos == buffers.perSample.end()) {
+					nextPos = buffers.perSample.begin();
+				}
+				StereoSample fromDelay1 = buffers.perSample.current();
+				sample.l = (multiply_32x32_rshift32(fromDelay1.l, strength1 << 14)
+				            + multiply_32x32_rshift32(nextPos->l, strength2 << 14))
+				           << 2;
+				sample.r = (multiply_32x32_rshift32(fromDelay1.r, strength1 << 14)
+				            + multiply_32x32_rshift32(nextPos->r, strength2 << 14))
+				           << 2;
+			}
+
+			std::vector<StereoSample> actual(numSamples);
+			CHECK_EQUAL(expectedWrapped, buffers.block.clearAndReadResampled(actual));
+			checkSameSamples(expected, actual);
+			buffers.checkSame();
+		}
+	}
+}
@@ -0,0 +1,433 @@
+#include "CppUTest/TestHarness.h"
+#include "storage/audio/flac_decoder.h"
+#include "storage/audio/flac_seek_table.h"
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Just enough of a FLAC encoder to make frames using each kind of subframe, so the decoder can be checked against
+// known samples
+
+class BitWriter {
+public:
+	void write(uint32_t value, int32_t numBits) {
+		for (int32_t b = numBits - 1; b >= 0; b--) {
+			pushBit((value >> b) & 1);
+		}
+	}
+	void writeSigned(int32_t value, int32_t numBits) {
+		write((uint32_t)value & (numBits == 32 ? 0xFFFFFFFF : (1u << numBits) - 1), numBits);
+	}
+	void writeUnary(uint32_t numZeros) {
+		for (uint32_t i = 0; i < numZeros; i++) {
+			pushBit(0);
+		}
+		pushBit(1);
+	}
+	void writeRice(int32_t value, int32_t parameter) {
+		uint32_t zigzagged = (value < 0) ? ((uint32_t)(-(value + 1)) << 1) | 1 : (uint32_t)value << 1;
+		writeUnary(zigzagged >> parameter);
+		write(zigzagged & ((1u << parameter) - 1), parameter);
+	}
+	void align() {
+		while (numBits_ & 7) {
+			pushBit(0);
+		}
+	}
+
+	std::vector<uint8_t> bytes;
+
+private:
+	void pushBit(uint32_t bit) {
+		if (!(numBits_ & 7)) {
+			bytes.push_back(0);
+		}
+		bytes.back() |= bit << (7 - (numBits_ & 7));
+		numBits_++;
+	}
+	uint32_t numBits_ = 0;
+};
+
+uint8_t crc8(uint8_t const* data, size_t size) {
+	uint8_t crc = 0;
+	for (size_t i = 0; i < size; i++) {
+		crc ^= data[i];
+		for (int32_t b = 0; b < 8; b++) {
+			crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+		}
+	}
+	return crc;
+}
+
+uint16_t crc16(uint8_t const* data, size_t size) {
+	uint16_t crc = 0;
+	for (size_t i = 0; i < size; i++) {
+		crc ^= data[i] << 8;
+		for (int32_t b = 0; b < 8; b++) {
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x8005 : crc << 1;
+		}
+	}
+	return crc;
+}
+
+constexpr uint32_t kBlockSize = 256;
+
+std::vector<uint8_t> makeStreamInfo(uint8_t numChannels, uint8_t bitsPerSample, uint32_t blockSize = kBlockSize) {
+	BitWriter bits;
+	bits.write(blockSize, 16);
+	bits.write(blockSize, 16);
+	bits.write(0, 24);
+	bits.write(0, 24);
+	bits.write(44100, 20);
+	bits.write(numChannels - 1, 3);
+	bits.write(bitsPerSample - 1, 5);
+	bits.write(0, 4);
+	bits.write(0, 32);
+	for (int32_t i = 0; i < 4; i++) {
+		bits.write(0, 32); // MD5
+	}
+	return bits.bytes;
+}
+
+FlacDecoder makeDecoder(uint8_t numChannels, uint8_t bitsPerSample, uint32_t blockSize = kBlockSize) {
+	FlacDecoder decoder;
+	CHECK(decoder.readStreamInfo(makeStreamInfo(numChannels, bitsPerSample, blockSize)));
+	return decoder;
+}
+
+using Samples = std::vector<int32_t>;
+using SubframeWriter = void (*)(BitWriter& bits, Samples const& samples, int32_t bitsPerSample);
+
+void writeSubframeHeader(BitWriter& bits, uint32_t type, int32_t wastedBits = 0) {
+	bits.write(0, 1);
+	bits.write(type, 6);
+	if (wastedBits) {
+		bits.write(1, 1);
+		bits.writeUnary(wastedBits - 1);
+	}
+	else {
+		bits.write(0, 1);
+	}
+}
+
+void writeVerbatim(BitWriter& bits, Samples const& samples, int32_t bitsPerSample) {
+	writeSubframeHeader(bits, 1);
+	for (int32_t sample : samples) {
+		bits.writeSigned(sample, bitsPerSample);
+	}
+}
+
+void writeFixed2(BitWriter& bits, Samples const& samples, int32_t bitsPerSample) {
+	writeSubframeHeader(bits, 8 + 2);
+	bits.writeSigned(samples[0], bitsPerSample);
+	bits.writeSigned(samples[1], bitsPerSample);
+	bits.write(0, 2); // 4-bit Rice parameters
+	bits.write(0, 4); // One partition
+	bits.write(9, 4);
+	for (size_t i = 2; i < samples.size(); i++) {
+		bits.writeRice(samples[i] - (2 * samples[i - 1] - samples[i - 2]), 9);
+	}
+}
+
+void writeLPC2(BitWriter& bits, Samples const& samples, int32_t bitsPerSample) {
+	constexpr int32_t kCoefficients[] = {1800, -800};
+	constexpr int32_t kShift = 10;
+	writeSubframeHeader(bits, 32 + 2 - 1);
+	bits.writeSigned(samples[0], bitsPerSample);
+	bits.writeSigned(samples[1], bitsPerSample);
+	bits.write(12 - 1, 4);
+	bits.writeSigned(kShift, 5);
+	for (int32_t coefficient : kCoefficients) {
+		bits.writeSigned(coefficient, 12);
+	}
+
+	// Two partitions, the second of them unencoded
+	bits.write(1, 2); // 5-bit Rice parameters
+	bits.write(1, 4);
+	bits.write(11, 5);
+	size_t half = samples.size() / 2;
+	for (size_t i = 2; i < samples.size(); i++) {
+		if (i == half) {
+			bits.write(31, 5);
+			bits.write(bitsPerSample + 2, 5);
+		}
+		int64_t prediction = (int64_t)kCoefficients[0] * samples[i - 1] + (int64_t)kCoefficients[1] * samples[i - 2];
+		int32_t residual = samples[i] - (int32_t)(prediction >> kShift);
+		if (i < half) {
+			bits.writeRice(residual, 11);
+		}
+		else {
+			bits.writeSigned(residual, bitsPerSample + 2);
+		}
+	}
+}
+
+std::vector<uint8_t> makeFrame(uint32_t frameNumber, uint8_t channelAssignment, int32_t bitsPerSample,
+                               std::vector<Samples> const& subframes, SubframeWriter writeSubframe,
+                               uint32_t blockSize = kBlockSize) {
+	constexpr uint8_t kSampleSizeCodes[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 4, 0, 0, 0, 5, 0, 0, 0, 6};
+
+	BitWriter bits;
+	bits.write(0xFFF8, 16);
+	bits.write(7, 4); // Block size in 16 bits at the end of the header
+	bits.write(0, 4); // Sample rate from STREAMINFO
+	bits.write(channelAssignment, 4);
+	bits.write(kSampleSizeCodes[bitsPerSample], 3);
+	bits.write(0, 1);
+	if (frameNumber < 0x80) {
+		bits.write(frameNumber, 8);
+	}
+	else {
+		bits.write(0xC0 | (frameNumber >> 6), 8);
+		bits.write(0x80 | (frameNumber & 0x3F), 8);
+	}
+	bits.write(blockSize - 1, 16);
+	bits.write(crc8(bits.bytes.data(), bits.bytes.size()), 8);
+
+	for (size_t c = 0; c < subframes.size(); c++) {
+		bool isSide = (channelAssignment == 8 && c == 1) || (channelAssignment == 9 && c == 0)
+		              || (channelAssignment == 10 && c == 1);
+		writeSubframe(bits, subframes[c], bitsPerSample + isSide);
+	}
+	bits.align();
+	bits.write(crc16(bits.bytes.data(), bits.bytes.size()), 16);
+	return bits.bytes;
+}
+
+Samples makeSignal(int32_t bitsPerSample, double frequency, uint32_t seed, uint32_t numSamples = kBlockSize) {
+	Samples samples(numSamples);
+	double amplitude = (1 << (bitsPerSample - 1)) * 0.7;
+	for (uint32_t i = 0; i < numSamples; i++) {
+		seed = seed * 1664525 + 1013904223;
+		int32_t noise = (int32_t)(seed >> 20) - 2048;
+		samples[i] = (int32_t)(amplitude * std::sin(i * frequency)) + (noise >> (24 - bitsPerSample + 4));
+	}
+	return samples;
+}
+
+struct DecodeBuffers {
+	explicit DecodeBuffers(uint32_t blockSize = kBlockSize) : left(blockSize), right(blockSize) {}
+	Samples left;
+	Samples right;
+	int32_t* channels[2] = {left.data(), right.data()};
+};
+
+} // namespace
+
+TEST_GROUP(FlacDecoderTest){};
+
+TEST(FlacDecoderTest, readsStreamInfo) {
+	FlacDecoder decoder = makeDecoder(2, 24);
+	CHECK_EQUAL(kBlockSize, decoder.streamInfo().maxBlockSize);
+	CHECK_EQUAL(44100, decoder.streamInfo().sampleRate);
+	CHECK_EQUAL(2, decoder.streamInfo().numChannels);
+	CHECK_EQUAL(24, decoder.streamInfo().bitsPerSample);
+	CHECK_EQUAL(3, decoder.byteDepth());
+
+	// More channels than a Sample can have
+	FlacDecoder other;
+	CHECK_FALSE(other.readStreamInfo(makeStreamInfo(6, 16)));
+}
+
+TEST(FlacDecoderTest, decodesEachKindOfSubframe) {
+	FlacDecoder decoder = makeDecoder(1, 16);
+	Samples signal = makeSignal(16, 0.05, 1);
+
+	SubframeWriter writers[] = {writeVerbatim, writeFixed2, writeLPC2};
+	for (SubframeWriter writer : writers) {
+		std::vector<uint8_t> frame = makeFrame(0, 0, 16, {signal}, writer);
+		DecodeBuffers out;
+		FlacFrameHeader header;
+		CHECK_EQUAL(frame.size(), decoder.decodeFrame(frame, out.channels, &header));
+		CHECK_EQUAL(kBlockSize, header.blockSize);
+		CHECK(out.left == signal);
+	}
+}
+
+TEST(FlacDecoderTest, decodesConstantAndWastedBitsSubframes) {
+	FlacDecoder decoder = makeDecoder(1, 16);
+
+	// Constant
+	Samples signal(kBlockSize, -1234);
+	std::vector<uint8_t> frame = makeFrame(0, 0, 16, {signal}, [](BitWriter& bits, Samples const&, int32_t) {
+		writeSubframeHeader(bits, 0);
+		bits.writeSigned(-1234, 16);
+	});
+	DecodeBuffers out;
+	FlacFrameHeader header;
+	CHECK_EQUAL(frame.size(), decoder.decodeFrame(frame, out.channels, &header));
+	CHECK(out.left == signal);
+
+	// Verbatim, but with the bottom 3 bits of every sample left out
+	signal = makeSignal(16, 0.02, 2);
+	for (int32_t& sample : signal) {
+		sample &= ~0b111;
+	}
+	frame = makeFrame(0, 0, 16, {signal}, [](BitWriter& bits, Samples const& samples, int32_t bitsPerSample) {
+		writeSubframeHeader(bits, 1, 3);
+		for (int32_t sample : samples) {
+			bits.writeSigned(sample >> 3, bitsPerSample - 3);
+		}
+	});
+	CHECK_EQUAL(frame.size(), decoder.decodeFrame(frame, out.channels, &header));
+	CHECK(out.left == signal);
+}
+
+TEST(FlacDecoderTest, undoesStereoDecorrelation) {
+	FlacDecoder decoder = makeDecoder(2, 24);
+	Samples left = makeSignal(24, 0.03, 3);
+	Samples right = makeSignal(24, 0.07, 4);
+	Samples side(kBlockSize);
+	Samples mid(kBlockSize);
+	for (uint32_t i = 0; i < kBlockSize; i++) {
+		side[i] = left[i] - right[i];
+		mid[i] = (left[i] + right[i]) >> 1;
+	}
+
+	std::vector<Samples> encodings[] = {{left, right}, {left, side}, {side, right}, {mid, side}};
+	uint8_t assignments[] = {1, 8, 9, 10};
+	for (size_t e = 0; e < std::size(assignments); e++) {
+		std::vector<uint8_t> frame = makeFrame(0, assignments[e], 24, encodings[e], writeFixed2);
+		DecodeBuffers out;
+		FlacFrameHeader header;
+		CHECK_EQUAL(frame.size(), decoder.decodeFrame(frame, out.channels, &header));
+		CHECK(out.left == left);
+		CHECK(out.right == right);
+	}
+}
+
+TEST(FlacDecoderTest, rejectsCorruptFrames) {
+	FlacDecoder decoder = makeDecoder(1, 16);
+	std::vector<uint8_t> frame = makeFrame(0, 0, 16, {makeSignal(16, 0.05, 5)}, writeLPC2);
+	DecodeBuffers out;
+	FlacFrameHeader header;
+
+	std::vector<uint8_t> corrupt = frame;
+	corrupt[frame.size() / 2] ^= 0x10;
+	CHECK_EQUAL(0, decoder.decodeFrame(corrupt, out.channels, &header));
+
+	// Cut short
+	CHECK_EQUAL(0, decoder.decodeFrame(std::span{frame}.first(frame.size() - 3), out.channels, &header));
+
+	// A different bit depth to the stream's
+	frame = makeFrame(0, 0, 24, {makeSignal(24, 0.05, 5)}, writeVerbatim);
+	CHECK_EQUAL(0, decoder.decodeFrame(frame, out.channels, &header));
+}
+
+TEST(FlacDecoderTest, findsFramesPastThingsThatLookLikeThem) {
+	FlacDecoder decoder = makeDecoder(1, 16);
+	std::vector<uint8_t> frame199 = makeFrame(199, 0, 16, {makeSignal(16, 0.05, 6)}, writeFixed2);
+	std::vector<uint8_t> frame200 = makeFrame(200, 0, 16, {makeSignal(16, 0.05, 7)}, writeFixed2);
+
+	std::vector<uint8_t> stream = {0xFF, 0x00, 0xFF, 0xF8, 0x12};
+	uint32_t frame199Pos = stream.size();
+	stream.insert(stream.end(), frame199.begin(), frame199.end());
+	uint32_t frame200Pos = stream.size();
+	stream.insert(stream.end(), frame200.begin(), frame200.end());
+
+	// Looking for frame 200, frame 199's header is valid but not the one we want
+	FlacFrameHeader header;
+	CHECK_EQUAL(frame199Pos, decoder.findFrame(stream, 199 * kBlockSize, &header));
+	CHECK_EQUAL(frame200Pos, decoder.findFrame(stream, 200 * kBlockSize, &header));
+	CHECK_EQUAL(200 * kBlockSize, header.firstSample);
+	CHECK_EQUAL(stream.size(), decoder.findFrame(stream, 201 * kBlockSize, &header));
+
+	DecodeBuffers out;
+	CHECK_EQUAL(frame200.size(), decoder.decodeFrame(std::span{stream}.subspan(frame200Pos), out.channels, &header));
+}
+
+TEST(FlacDecoderTest, writesPCMSplitAcrossRanges) {
+	FlacDecoder decoder = makeDecoder(2, 20);
+	Samples left = {0x12345, -2, 0x7FFFF};
+	Samples right = {-0x80000, 1, 0x00F0F};
+	int32_t* channels[] = {left.data(), right.data()};
+
+	// 20-bit samples go in 3 bytes, left-aligned
+	std::vector<uint8_t> whole(3 * 6);
+	decoder.writePCM(channels, 3, 0, 0, whole.size(), whole.data());
+	uint8_t expectedFirstSample[] = {0x50, 0x34, 0x12, 0x00, 0x00, 0x80};
+	MEMCMP_EQUAL(expectedFirstSample, whole.data(), 6);
+
+	// Split part way through the second sample's right channel, as if by a Cluster boundary
+	std::vector<uint8_t> split(whole.size());
+	decoder.writePCM(channels, 3, 0, 0, 10, split.data());
+	decoder.writePCM(channels, 3, 0, 10, split.size(), &split[10]);
+	CHECK(split == whole);
+
+	// Or starting from some later part of the stream
+	std::vector<uint8_t> later(whole.size());
+	decoder.writePCM(channels, 3, 600, 600, 600 + later.size(), later.data());
+	CHECK(later == whole);
+}
+
+TEST(FlacDecoderTest, seekTablePointsEachClusterAtItsFirstFrame) {
+	FlacSeekTable<std::allocator<FlacSeekPoint>> table;
+
+	// 16-bit stereo, so each 64-byte Cluster holds 16 samples. Frames of 20
+	table.clear(64, 4);
+	uint32_t frameBytePositions[] = {100, 180, 250, 333};
+	for (uint32_t f = 0; f < std::size(frameBytePositions); f++) {
+		table.addFrame(frameBytePositions[f], f * 20, 20);
+	}
+
+	// 80 samples is 5 Clusters. Cluster 1 starts at sample 16, in frame 0; cluster 2 at 32, in frame 1
+	CHECK_EQUAL(5, table.numClusters());
+	uint32_t expectedFrames[] = {0, 0, 1, 2, 3};
+	for (uint32_t c = 0; c < 5; c++) {
+		FlacSeekPoint const* point = table.find(c);
+		CHECK(point != nullptr);
+		CHECK_EQUAL(frameBytePositions[expectedFrames[c]], point->fileBytePos);
+		CHECK_EQUAL(expectedFrames[c] * 20, point->firstSample);
+	}
+	CHECK(table.find(5) == nullptr);
+
+	// 24-bit stereo. Cluster 1 starts with the last 2 bytes of sample 10
+	table.clear(64, 6);
+	table.addFrame(0, 0, 20);
+	CHECK_EQUAL(10, table.firstSampleOfCluster(1));
+	CHECK_EQUAL(2, table.numClusters());
+}
+
+TEST(FlacDecoderTest, seekTableFillsInLazilyFromTheNearestKnownFrame) {
+	FlacSeekTable<std::allocator<FlacSeekPoint>> table;
+
+	// As before: 16 samples a Cluster, frames of 20. 200 samples is 13 Clusters, none known yet
+	table.clear(64, 4);
+	table.setNumSamples(200);
+	CHECK_EQUAL(13, table.numClusters());
+	CHECK(table.find(0) == nullptr);
+	table.addAnchor(100, 0); // Where the metadata ends
+
+	// A SEEKTABLE point for frame 6, which starts at sample 120
+	table.addAnchor(700, 120);
+
+	// Nothing's been scanned, so Cluster 3 (sample 48) gets scanned for from the start of the stream, and Cluster 9
+	// (sample 144) from the SEEKTABLE's point
+	CHECK_EQUAL(100, table.startPointForScan(3)->fileBytePos);
+	CHECK_EQUAL(700, table.startPointForScan(9)->fileBytePos);
+	CHECK_EQUAL(120, table.startPointForScan(9)->firstSample);
+
+	// Frames can be added in any order, and only give seek points to the Clusters starting in them
+	table.addFrame(820, 140, 20); // Frame 7: Cluster 9 starts at sample 144
+	table.addFrame(100, 0, 20);   // Frame 0: Clusters 0 and 1
+	CHECK(table.find(0) != nullptr);
+	CHECK_EQUAL(100, table.find(1)->fileBytePos);
+	CHECK(table.find(2) == nullptr);
+	CHECK_EQUAL(820, table.find(9)->fileBytePos);
+	CHECK_EQUAL(140, table.find(9)->firstSample);
+
+	// A known Cluster closer than any anchor is better to scan from
+	CHECK_EQUAL(820, table.startPointForScan(10)->fileBytePos);
+	CHECK_EQUAL(100, table.startPointForScan(2)->fileBytePos);
+
+	// If the SEEKTABLE turns out to be wrong, only the frames we found ourselves are left
+	table.forgetAnchors();
+	CHECK_EQUAL(100, table.startPointForScan(8)->fileBytePos);
+
+	// A frame which runs past where STREAMINFO says the stream ends doesn't make the table any longer
+	table.addFrame(2000, 200, 20);
+	CHECK_EQUAL(13, table.numClusters());
+}
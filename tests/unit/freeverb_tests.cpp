@@ -0,0 +1,70 @@
+#include "CppUTest/TestHarness.h"
+#include "dsp/reverb/freeverb/freeverb.hpp"
+#include <array>
+#include <cstring>
+#include <memory>
+
+using deluge::dsp::reverb::Freeverb;
+
+namespace {
+
+constexpr size_t kMaxWindowSize = 300;
+
+void fillWithNoise(std::span<int32_t> buffer, uint32_t& seed) {
+	for (int32_t& sample : buffer) {
+		seed = seed * 1664525 + 1013904223;
+		sample = (int32_t)seed >> 4;
+	}
+}
+
+// Runs the block version and the sample-by-sample reference side by side, window after window, and checks they stay
+// identical - long enough for everything to have gone all the way round every delay line several times
+void checkBlocksMatchReference(std::span<size_t const> windowSizes, int32_t numWindows) {
+	auto block = std::make_unique<Freeverb>();
+	auto reference = std::make_unique<Freeverb>();
+	for (Freeverb* reverb : {block.get(), reference.get()}) {
+		reverb->setPanLevels(ONE_Q31 >> 2, ONE_Q31 >> 3);
+		reverb->setRoomSize(0.9f);
+		reverb->setDamping(0.3f);
+		reverb->setWidth(0.7f);
+	}
+
+	static std::array<int32_t, kMaxWindowSize> blockInput;
+	static std::array<int32_t, kMaxWindowSize> referenceInput;
+	static std::array<StereoSample, kMaxWindowSize> blockOutput;
+	static std::array<StereoSample, kMaxWindowSize> referenceOutput;
+	uint32_t seed = 1;
+
+	for (int32_t w = 0; w < numWindows; w++) {
+		size_t windowSize = windowSizes[w % windowSizes.size()];
+		fillWithNoise({blockInput.data(), windowSize}, seed);
+		referenceInput = blockInput;
+		for (size_t i = 0; i < windowSize; i++) {
+			blockOutput[i] = referenceOutput[i] = {(int32_t)i * 1000, -(int32_t)i * 1000};
+		}
+
+		block->process({blockInput.data(), windowSize}, {blockOutput.data(), windowSize});
+		reference->processSampleBySample({referenceInput.data(), windowSize}, {referenceOutput.data(), windowSize});
+
+		MEMCMP_EQUAL(referenceOutput.data(), blockOutput.data(), windowSize * sizeof(StereoSample));
+	}
+}
+
+} // namespace
+
+TEST_GROUP(FreeverbTest){};
+
+TEST(FreeverbTest, blocksMatchSampleBySample) {
+	constexpr size_t windowSizes[] = {128};
+	checkBlocksMatchReference(windowSizes, 200);
+}
+
+TEST(FreeverbTest, unevenWindowSizes) {
+	constexpr size_t windowSizes[] = {1, 37, 128, 5, 64, 127, 3};
+	checkBlocksMatchReference(windowSizes, 700);
+}
+
+TEST(FreeverbTest, windowsLongerThanABlock) {
+	constexpr size_t windowSizes[] = {kMaxWindowSize, 129, 256};
+	checkBlocksMatchReference(windowSizes, 100);
+}
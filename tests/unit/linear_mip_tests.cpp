@@ -0,0 +1,220 @@
+#include "CppUTest/TestHarness.h"
+#include "dsp/fft/fft_config_manager.h"
+#include "storage/wave_table/linear_mip.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+// Like a WaveTable's bands: each an octave up from the last, with cycles half the size
+constexpr int32_t kNumBands = 5;
+constexpr int32_t kFirstBandCycleSizeMagnitude = 11;
+
+uint32_t getCycleSize(int32_t b) {
+	return 1 << (kFirstBandCycleSizeMagnitude - b);
+}
+
+int32_t getCycleSizeMagnitude(int32_t b) {
+	return kFirstBandCycleSizeMagnitude - b;
+}
+
+// The phaseIncrement at which band b's top harmonic reaches fraction (32-bit) of Nyquist
+uint32_t phaseIncrementFor(int32_t b, uint64_t fraction) {
+	return fraction / getCycleSize(b);
+}
+
+constexpr uint64_t kNyquist = (uint64_t)1 << 32;
+
+// A band's cycle with harmonics up to its own Nyquist frequency, as WaveTable keeps them
+std::vector<int16_t> makeCycle(int32_t cycleSizeMagnitude, int32_t numHarmonics) {
+	int32_t size = 1 << cycleSizeMagnitude;
+	std::vector<int16_t> cycle(size);
+	for (int32_t i = 0; i < size; i++) {
+		double value = 0;
+		for (int32_t h = 1; h <= numHarmonics; h++) {
+			value += std::sin(2 * M_PI * h * i / size) / h;
+		}
+		cycle[i] = (int16_t)(value * 12000);
+	}
+	return cycle;
+}
+
+std::vector<int16_t> renderMip(std::vector<int16_t> const& cycle, int32_t cycleSizeMagnitude) {
+	int32_t mipCycleSize = 2 << cycleSizeMagnitude;
+	std::vector<int16_t> mip(getLinearMipCycleStride(mipCycleSize));
+	std::vector<int32_t> timeDomainData(mipCycleSize);
+	std::vector<ne10_fft_cpx_int32_t> frequencyDomainData((mipCycleSize >> 1) + 1);
+	renderLinearMipCycle(cycle.data(), cycleSizeMagnitude, mip.data(), timeDomainData.data(),
+	                     frequencyDomainData.data(), FFTConfigManager::getConfig(cycleSizeMagnitude),
+	                     FFTConfigManager::getConfig(cycleSizeMagnitude + 1));
+	return mip;
+}
+
+} // namespace
+
+TEST_GROUP(LinearMipChoiceTests){};
+
+TEST(LinearMipChoiceTests, veryLowPitchUsesFirstBandAlone) {
+	LinearMipBands choice;
+	CHECK(chooseLinearMipBands(phaseIncrementFor(0, kNyquist / 4), kNumBands, getCycleSize, &choice));
+	LONGS_EQUAL(0, choice.lower);
+	LONGS_EQUAL(-1, choice.upper);
+}
+
+TEST(LinearMipChoiceTests, crossfadesToNextBandAcrossTheOctave) {
+	LinearMipBands choice;
+
+	CHECK(chooseLinearMipBands(phaseIncrementFor(0, kNyquist / 2), kNumBands, getCycleSize, &choice));
+	LONGS_EQUAL(0, choice.lower);
+	LONGS_EQUAL(1, choice.upper);
+	CHECK(choice.upperStrength < 4096);
+
+	CHECK(chooseLinearMipBands(phaseIncrementFor(0, kNyquist * 3 / 4), kNumBands, getCycleSize, &choice));
+	LONGS_EQUAL(0, choice.lower);
+	LONGS_EQUAL(1, choice.upper);
+	CHECK(std::abs((int64_t)choice.upperStrength - ((int64_t)1 << 30)) < 4096);
+}
+
+TEST(LinearMipChoiceTests, topHarmonicNeverReachesNyquist) {
+	LinearMipBands choice;
+	for (int32_t b = 0; b < kNumBands - 1; b++) {
+		uint32_t phaseIncrement = phaseIncrementFor(b, kNyquist * 9 / 10);
+		CHECK(chooseLinearMipBands(phaseIncrement, kNumBands, getCycleSize, &choice));
+		LONGS_EQUAL(b, choice.lower);
+		CHECK((uint64_t)phaseIncrement * getCycleSize(choice.lower) < kNyquist);
+		CHECK((uint64_t)phaseIncrement * getCycleSize(choice.upper) < kNyquist / 2);
+	}
+}
+
+// Just below a band's top harmonic reaching Nyquist, it's crossfaded almost all the way to the next band, and just
+// above, the next band is used alone. So there's no jump in the sound as the pitch rises past that point
+TEST(LinearMipChoiceTests, choiceIsContinuousAcrossBands) {
+	LinearMipBands below;
+	LinearMipBands above;
+	uint32_t phaseIncrement = phaseIncrementFor(0, kNyquist);
+	CHECK(chooseLinearMipBands(phaseIncrement - 1, kNumBands, getCycleSize, &below));
+	CHECK(chooseLinearMipBands(phaseIncrement, kNumBands, getCycleSize, &above));
+
+	LONGS_EQUAL(0, below.lower);
+	LONGS_EQUAL(1, below.upper);
+	CHECK(below.upperStrength > (1u << 31) - 4096);
+
+	LONGS_EQUAL(1, above.lower);
+	LONGS_EQUAL(2, above.upper);
+	CHECK(above.upperStrength < 4096);
+}
+
+TEST(LinearMipChoiceTests, givesUpWhenNoBandIsBandlimitedEnough) {
+	LinearMipBands choice;
+	// The last band would need crossfading into a band there isn't
+	CHECK_FALSE(chooseLinearMipBands(phaseIncrementFor(kNumBands - 1, kNyquist * 3 / 4), kNumBands, getCycleSize,
+	                                 &choice));
+	// Even the last band's top harmonic would be above Nyquist
+	CHECK_FALSE(chooseLinearMipBands(phaseIncrementFor(kNumBands - 1, kNyquist * 3 / 2), kNumBands, getCycleSize,
+	                                 &choice));
+	CHECK_FALSE(chooseLinearMipBands(1000, 0, getCycleSize, &choice));
+}
+
+TEST(LinearMipChoiceTests, usesMipsWhenTheyAreAllThere) {
+	LinearMipBands expected;
+	LinearMipBands choice;
+	uint32_t phaseIncrement = phaseIncrementFor(1, kNyquist * 3 / 4);
+	CHECK(chooseLinearMipBands(phaseIncrement, kNumBands, getCycleSize, &expected));
+	CHECK(chooseAvailableLinearMipBands(
+	    phaseIncrement, kNumBands, getCycleSize, [](int32_t b) { return true; }, getCycleSizeMagnitude, &choice));
+	LONGS_EQUAL(expected.lower, choice.lower);
+	LONGS_EQUAL(expected.upper, choice.upper);
+	LONGS_EQUAL(expected.upperStrength, choice.upperStrength);
+}
+
+// A band whose mip never got memory, or had it stolen, leaves the WaveTable to the windowed sinc
+TEST(LinearMipChoiceTests, fallsBackToSincWithoutABandsMip) {
+	LinearMipBands choice;
+	uint32_t crossfading = phaseIncrementFor(1, kNyquist * 3 / 4);
+	uint32_t alone = phaseIncrementFor(0, kNyquist / 4);
+
+	CHECK_FALSE(chooseAvailableLinearMipBands(
+	    crossfading, kNumBands, getCycleSize, [](int32_t b) { return b != 1; }, getCycleSizeMagnitude, &choice));
+	CHECK_FALSE(chooseAvailableLinearMipBands(
+	    crossfading, kNumBands, getCycleSize, [](int32_t b) { return b != 2; }, getCycleSizeMagnitude, &choice));
+	CHECK_FALSE(chooseAvailableLinearMipBands(
+	    alone, kNumBands, getCycleSize, [](int32_t b) { return b != 0; }, getCycleSizeMagnitude, &choice));
+
+	// Bands the choice doesn't touch don't matter
+	CHECK(chooseAvailableLinearMipBands(
+	    crossfading, kNumBands, getCycleSize, [](int32_t b) { return b != 0; }, getCycleSizeMagnitude, &choice));
+}
+
+TEST(LinearMipChoiceTests, fallsBackToSincWhenBandsAreNotAnOctaveApart) {
+	LinearMipBands choice;
+	CHECK_FALSE(chooseAvailableLinearMipBands(
+	    phaseIncrementFor(1, kNyquist * 3 / 4), kNumBands, getCycleSize, [](int32_t b) { return true; },
+	    [](int32_t b) { return (b == 2) ? kFirstBandCycleSizeMagnitude - 3 : getCycleSizeMagnitude(b); }, &choice));
+}
+
+TEST_GROUP(LinearMipCycleTests){};
+
+TEST(LinearMipCycleTests, strideLeavesRoomForDuplicatesAndKeepsCacheLines) {
+	for (int32_t mipCycleSize = 8; mipCycleSize <= 4096; mipCycleSize <<= 1) {
+		int32_t stride = getLinearMipCycleStride(mipCycleSize);
+		CHECK(stride >= mipCycleSize + kLinearMipNumDuplicateSamplesAtEndOfCycle);
+		LONGS_EQUAL(0, (stride * sizeof(int16_t)) % CACHE_LINE_SIZE);
+		CHECK(stride * sizeof(int16_t) < (mipCycleSize + kLinearMipNumDuplicateSamplesAtEndOfCycle) * sizeof(int16_t)
+		                                      + CACHE_LINE_SIZE);
+	}
+}
+
+TEST(LinearMipCycleTests, keepsTheSameHarmonicsAtTwiceTheLength) {
+	constexpr int32_t kMagnitude = 8;
+	constexpr int32_t kNumHarmonics = 60;
+	auto cycle = makeCycle(kMagnitude, kNumHarmonics);
+	auto mip = renderMip(cycle, kMagnitude);
+	auto expected = makeCycle(kMagnitude + 1, kNumHarmonics);
+
+	for (int32_t i = 0; i < (2 << kMagnitude); i++) {
+		if (i % 2 == 0) {
+			CHECK(std::abs(mip[i] - cycle[i >> 1]) < 64);
+		}
+		CHECK(std::abs(mip[i] - expected[i]) < 64);
+	}
+}
+
+TEST(LinearMipCycleTests, duplicatedSamplesContinueTheCycle) {
+	constexpr int32_t kMagnitude = 7;
+	auto mip = renderMip(makeCycle(kMagnitude, 30), kMagnitude);
+	int32_t mipCycleSize = 2 << kMagnitude;
+	for (int32_t i = 0; i < kLinearMipNumDuplicateSamplesAtEndOfCycle; i++) {
+		LONGS_EQUAL(mip[i], mip[mipCycleSize + i]);
+	}
+}
+
+// Reading through the end of the cycle and back round to its start should be as smooth as anywhere else in it
+TEST(LinearMipCycleTests, readingIsContinuousAcrossTheEndOfTheCycle) {
+	constexpr int32_t kMagnitude = 7;
+	constexpr int32_t kMipMagnitude = kMagnitude + 1;
+	auto mip = renderMip(makeCycle(kMagnitude, 1), kMagnitude);
+
+	constexpr uint32_t kPhaseIncrement = (uint32_t)1 << (32 - kMipMagnitude - 4); // 16 reads per sample
+	int32_t biggestStepInCycle = 0;
+	int32_t biggestStepAtEnd = 0;
+	uint32_t phase = 0;
+	int32_t lastValue = readLinearMip(mip.data(), phase, kMipMagnitude);
+	for (int32_t i = 0; i < (1 << (kMipMagnitude + 4)) + 64; i++) {
+		phase += kPhaseIncrement;
+		int32_t value = readLinearMip(mip.data(), phase, kMipMagnitude);
+		int32_t step = std::abs(value - lastValue);
+		bool nearEnd = phase < (kPhaseIncrement << 5) || phase > (uint32_t)-(kPhaseIncrement << 5);
+		int32_t& biggestStep = nearEnd ? biggestStepAtEnd : biggestStepInCycle;
+		biggestStep = std::max(biggestStep, step);
+		lastValue = value;
+	}
+	CHECK(biggestStepInCycle > 0);
+	CHECK(biggestStepAtEnd <= biggestStepInCycle + (biggestStepInCycle >> 4));
+
+	// And the sample straight after the end is the first one again
+	int32_t atEnd = readLinearMip(mip.data(), (uint32_t)-kPhaseIncrement, kMipMagnitude);
+	int32_t atStart = readLinearMip(mip.data(), 0, kMipMagnitude);
+	CHECK(std::abs(atEnd - atStart) <= biggestStepInCycle);
+}
@@ -0,0 +1,146 @@
+#include "CppUTest/TestHarness.h"
+#include "dsp/osc_kernels.h"
+#include "util/fixedpoint.h"
+#include "util/waves.h"
+#include <array>
+#include <vector>
+
+using deluge::dsp::DirectOscParams;
+using deluge::dsp::getOscKernels;
+using deluge::dsp::OscKernels;
+
+namespace {
+
+constexpr int32_t kNumSamples = 128;
+constexpr std::array kDirectTypes{OscType::TRIANGLE, OscType::SAW, OscType::SQUARE};
+
+// What Voice::renderOsc() used to do for these waves, deciding sync and amplitude as it goes
+uint32_t renderReference(OscType type, bool sync, bool applyAmplitude, int32_t* buffer, uint32_t phase,
+                         DirectOscParams const& params) {
+	int32_t amplitude = params.amplitude;
+	int32_t amplitudeIncrement = params.amplitudeIncrement;
+	if (type == OscType::TRIANGLE) {
+		amplitude <<= 1;
+		amplitudeIncrement <<= 1;
+	}
+	uint32_t resetterPhase = params.resetterPhase;
+	for (int32_t i = 0; i < kNumSamples; i++) {
+		phase += params.phaseIncrement;
+		if (sync) {
+			resetterPhase += params.resetterPhaseIncrement;
+			if (resetterPhase < params.resetterPhaseIncrement) {
+				phase = (multiply_32x32_rshift32(multiply_32x32_rshift32(resetterPhase, params.phaseIncrement),
+				                                 params.resetterDivideByPhaseIncrement)
+				         << 17)
+				        + 1 + params.retriggerPhase;
+			}
+		}
+		if (applyAmplitude) {
+			amplitude += amplitudeIncrement;
+			int32_t value = (type == OscType::TRIANGLE) ? getTriangleSmall(phase)
+			                : (type == OscType::SAW)    ? (int32_t)phase
+			                                            : getSquare(phase, params.pulseWidth);
+			buffer[i] = multiply_accumulate_32x32_rshift32_rounded(buffer[i], value, amplitude);
+		}
+		else {
+			buffer[i] = (type == OscType::TRIANGLE) ? getTriangleSmall(phase) << 1
+			            : (type == OscType::SAW)    ? (int32_t)phase >> 1
+			                                        : getSquareSmall(phase, params.pulseWidth);
+		}
+	}
+	return phase;
+}
+
+DirectOscParams makeParams() {
+	uint32_t resetterPhaseIncrement = 3000000;
+	return {
+	    .phaseIncrement = 7654321,
+	    .pulseWidth = 2147483648u + 300000000,
+	    .amplitude = 1 << 26,
+	    .amplitudeIncrement = 12345,
+	    .resetterPhase = 4000000000u,
+	    .resetterPhaseIncrement = resetterPhaseIncrement,
+	    .resetterDivideByPhaseIncrement = (int32_t)(2147483648u / (uint16_t)((resetterPhaseIncrement + 65535) >> 16)),
+	    .retriggerPhase = 2147483648u,
+	};
+}
+
+std::vector<int32_t> makeExistingMix() {
+	std::vector<int32_t> buffer(kNumSamples);
+	uint32_t seed = 1;
+	for (int32_t& sample : buffer) {
+		seed = seed * 1664525 + 1013904223;
+		sample = (int32_t)seed >> 3;
+	}
+	return buffer;
+}
+
+} // namespace
+
+TEST_GROUP(OscKernelTests){};
+
+TEST(OscKernelTests, directKernelsMatchTheBranchingLoop) {
+	DirectOscParams params = makeParams();
+	for (OscType type : kDirectTypes) {
+		for (bool applyAmplitude : {false, true}) {
+			OscKernels kernels = getOscKernels(type, applyAmplitude, 1);
+			for (bool sync : {false, true}) {
+				std::vector<int32_t> expected = makeExistingMix();
+				std::vector<int32_t> actual = expected;
+
+				uint32_t expectedPhase = renderReference(type, sync, applyAmplitude, expected.data(), 123456, params);
+				uint32_t actualPhase = kernels.direct[sync](actual.data(), kNumSamples, 123456, params);
+
+				CHECK_EQUAL(expectedPhase, actualPhase);
+				for (int32_t i = 0; i < kNumSamples; i++) {
+					CHECK_EQUAL(expected[i], actual[i]);
+				}
+			}
+		}
+	}
+}
+
+TEST(OscKernelTests, syncActuallyResetsThePhase) {
+	DirectOscParams params = makeParams();
+	OscKernels kernels = getOscKernels(OscType::SAW, false, 1);
+	std::vector<int32_t> synced(kNumSamples);
+	std::vector<int32_t> unsynced(kNumSamples);
+	uint32_t syncedPhase = kernels.direct[true](synced.data(), kNumSamples, 0, params);
+	uint32_t unsyncedPhase = kernels.direct[false](unsynced.data(), kNumSamples, 0, params);
+	CHECK(syncedPhase != unsyncedPhase);
+	CHECK_EQUAL(params.phaseIncrement * kNumSamples, unsyncedPhase);
+}
+
+TEST(OscKernelTests, analogSawFallsBackToTheDigitalSaw) {
+	for (bool applyAmplitude : {false, true}) {
+		OscKernels saw = getOscKernels(OscType::SAW, applyAmplitude, 1);
+		OscKernels analogSaw = getOscKernels(OscType::ANALOG_SAW_2, applyAmplitude, 1);
+		POINTERS_EQUAL(saw.direct[0], analogSaw.direct[0]);
+		POINTERS_EQUAL(saw.direct[1], analogSaw.direct[1]);
+		CHECK(analogSaw.type == OscType::ANALOG_SAW_2);
+	}
+}
+
+TEST(OscKernelTests, tableOnlyWavesHaveNoDirectKernel) {
+	for (OscType type : {OscType::SINE, OscType::ANALOG_SQUARE, OscType::WAVETABLE, OscType::SAMPLE}) {
+		OscKernels kernels = getOscKernels(type, true, 1);
+		POINTERS_EQUAL(nullptr, kernels.direct[0]);
+		POINTERS_EQUAL(nullptr, kernels.direct[1]);
+	}
+}
+
+TEST(OscKernelTests, kernelsDependOnAmplitudeAndSync) {
+	OscKernels withAmplitude = getOscKernels(OscType::SQUARE, true, 1);
+	OscKernels ringMod = getOscKernels(OscType::SQUARE, false, 1);
+	CHECK(withAmplitude.direct[0] != ringMod.direct[0]);
+	CHECK(withAmplitude.direct[0] != withAmplitude.direct[1]);
+}
+
+TEST(OscKernelTests, unisonWaveOnlyForStacksOfSawsAndSquares) {
+	CHECK(getOscKernels(OscType::SAW, true, 4).unisonWave);
+	CHECK(getOscKernels(OscType::ANALOG_SQUARE, true, 2).unisonWave);
+	CHECK_FALSE(getOscKernels(OscType::SAW, true, 1).unisonWave);
+	CHECK_FALSE(getOscKernels(OscType::TRIANGLE, true, 4).unisonWave);
+	// Ring modulation renders each part itself
+	CHECK_FALSE(getOscKernels(OscType::SAW, false, 4).unisonWave);
+}
@@ -0,0 +1,135 @@
+#include "CppUTest/TestHarness.h"
+#include "dsp/oversampling/oversampler.h"
+#include <cmath>
+#include <vector>
+
+using deluge::dsp::Oversampler;
+
+namespace {
+
+// Interleaved, with each channel at its own frequency and phase
+std::vector<q31_t> makeSines(int32_t numSamples, int32_t numChannels, double cyclesPerSample, double amplitude) {
+	std::vector<q31_t> samples(numSamples * numChannels);
+	for (int32_t n = 0; n < numSamples; n++) {
+		for (int32_t c = 0; c < numChannels; c++) {
+			double phase = 2 * M_PI * n * cyclesPerSample * (c + 1) + c;
+			samples[n * numChannels + c] = (q31_t)(std::sin(phase) * amplitude * 2147483647.0);
+		}
+	}
+	return samples;
+}
+
+// What's left after the best fitting sine at that frequency is taken away, relative to that sine's amplitude
+double getResidual(std::vector<q31_t> const& samples, int32_t numChannels, int32_t channel, int32_t start,
+                   double cyclesPerSample, double* amplitude) {
+	double sinSum = 0;
+	double cosSum = 0;
+	int32_t numSamples = samples.size() / numChannels - start;
+	for (int32_t n = 0; n < numSamples; n++) {
+		double phase = 2 * M_PI * n * cyclesPerSample;
+		sinSum += samples[(start + n) * numChannels + channel] * std::sin(phase);
+		cosSum += samples[(start + n) * numChannels + channel] * std::cos(phase);
+	}
+	double sinPart = sinSum * 2 / numSamples;
+	double cosPart = cosSum * 2 / numSamples;
+	*amplitude = std::hypot(sinPart, cosPart) / 2147483647.0;
+
+	double residual = 0;
+	for (int32_t n = 0; n < numSamples; n++) {
+		double phase = 2 * M_PI * n * cyclesPerSample;
+		double fitted = sinPart * std::sin(phase) + cosPart * std::cos(phase);
+		residual = std::max(residual, std::abs(samples[(start + n) * numChannels + channel] - fitted));
+	}
+	return residual / 2147483647.0 / *amplitude;
+}
+
+// Up and back down again, a chunk at a time
+std::vector<q31_t> roundTrip(Oversampler& oversampler, std::vector<q31_t> const& input, int32_t numChannels,
+                             int32_t magnitude) {
+	int32_t numSamples = input.size() / numChannels;
+	std::vector<q31_t> output(input.size());
+	std::vector<q31_t> oversampled(SSI_TX_BUFFER_NUM_SAMPLES * numChannels);
+	for (int32_t pos = 0; pos < numSamples;) {
+		int32_t chunk = std::min(Oversampler::getMaxNumSamples(magnitude), numSamples - pos);
+		oversampler.upsample(&input[pos * numChannels], chunk, numChannels, magnitude, oversampled.data());
+		oversampler.downsample(oversampled.data(), chunk, numChannels, magnitude, &output[pos * numChannels]);
+		pos += chunk;
+	}
+	return output;
+}
+
+} // namespace
+
+TEST_GROUP(OversamplerTest){};
+
+TEST(OversamplerTest, passbandSurvivesRoundTrip) {
+	for (int32_t magnitude = 1; magnitude <= Oversampler::kMaxMagnitude; magnitude++) {
+		for (int32_t numChannels = 1; numChannels <= Oversampler::kMaxNumChannels; numChannels++) {
+			Oversampler oversampler;
+			oversampler.reset();
+			double cyclesPerSample = 1000.0 / 44100;
+			std::vector<q31_t> output =
+			    roundTrip(oversampler, makeSines(2048, numChannels, cyclesPerSample, 0.5), numChannels, magnitude);
+
+			for (int32_t c = 0; c < numChannels; c++) {
+				double amplitude;
+				double residual = getResidual(output, numChannels, c, 256, cyclesPerSample * (c + 1), &amplitude);
+				DOUBLES_EQUAL(0.5, amplitude, 0.01);
+				CHECK(residual < 0.01);
+			}
+		}
+	}
+}
+
+TEST(OversamplerTest, upsamplingRejectsImages) {
+	// A 5kHz tone, upsampled, should have next to nothing left at its image, 44.1kHz - 5kHz
+	for (int32_t magnitude = 1; magnitude <= Oversampler::kMaxMagnitude; magnitude++) {
+		Oversampler oversampler;
+		oversampler.reset();
+		double cyclesPerSample = 5000.0 / 44100;
+		std::vector<q31_t> input = makeSines(1024, 1, cyclesPerSample, 0.5);
+		std::vector<q31_t> oversampled(input.size() << magnitude);
+		for (int32_t pos = 0; pos < (int32_t)input.size(); pos += Oversampler::getMaxNumSamples(magnitude)) {
+			oversampler.upsample(&input[pos], Oversampler::getMaxNumSamples(magnitude), 1, magnitude,
+			                     &oversampled[pos << magnitude]);
+		}
+
+		double imageCyclesPerSample = (1 - cyclesPerSample) / (1 << magnitude);
+		double amplitude;
+		getResidual(oversampled, 1, 0, 256, imageCyclesPerSample, &amplitude);
+		CHECK(20 * std::log10(amplitude / 0.5) < -55);
+	}
+}
+
+TEST(OversamplerTest, downsamplingRejectsAliases) {
+	// 30kHz would alias down to 14.1kHz if it wasn't filtered out first
+	for (int32_t magnitude = 1; magnitude <= Oversampler::kMaxMagnitude; magnitude++) {
+		Oversampler oversampler;
+		oversampler.reset();
+		double cyclesPerSample = 30000.0 / (44100 << magnitude);
+		std::vector<q31_t> oversampled = makeSines(4096, 1, cyclesPerSample, 0.5);
+		int32_t numSamples = oversampled.size() >> magnitude;
+		std::vector<q31_t> output(numSamples);
+		for (int32_t pos = 0; pos < numSamples; pos += Oversampler::getMaxNumSamples(magnitude)) {
+			oversampler.downsample(&oversampled[pos << magnitude], Oversampler::getMaxNumSamples(magnitude), 1,
+			                       magnitude, &output[pos]);
+		}
+
+		double amplitude;
+		getResidual(output, 1, 0, 64, 1 - cyclesPerSample * (1 << magnitude), &amplitude);
+		CHECK(20 * std::log10(amplitude / 0.5) < -55);
+	}
+}
+
+TEST(OversamplerTest, resetForgetsHistory) {
+	Oversampler oversampler;
+	oversampler.reset();
+	std::vector<q31_t> loud = makeSines(64, 2, 0.01, 0.9);
+	roundTrip(oversampler, loud, 2, 2);
+	oversampler.reset();
+
+	std::vector<q31_t> silence = roundTrip(oversampler, std::vector<q31_t>(128, 0), 2, 2);
+	for (q31_t sample : silence) {
+		CHECK_EQUAL(0, sample);
+	}
+}
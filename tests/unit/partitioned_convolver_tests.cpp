@@ -0,0 +1,166 @@
+#include "CppUTest/TestHarness.h"
+#include "dsp/convolution/partitioned_convolver.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// What the convolver and NE10 need from the firmware
+void* allocLowSpeed(uint32_t requiredSize, void* thingNotToStealFrom) {
+	return malloc(requiredSize);
+}
+extern "C" {
+void* delugeAlloc(unsigned int requiredSize, bool mayUseOnChipRam) {
+	return malloc(requiredSize);
+}
+void delugeDealloc(void* address) {
+	free(address);
+}
+void routineWithClusterLoading() {
+}
+// Only NE10's int32 FFTs are built
+ne10_fft_cfg_float32_t ne10_fft_alloc_c2c_float32_c(ne10_int32_t nfft) {
+	return nullptr;
+}
+}
+
+namespace {
+
+constexpr int32_t kPartitionSize = PartitionedConvolver::kPartitionSize;
+
+std::vector<int32_t> makeImpulseResponse(size_t length, uint32_t seed) {
+	std::vector<int32_t> impulseResponse(length);
+	for (size_t n = 0; n < length; n++) {
+		seed = seed * 1664525 + 1013904223;
+		float decay = std::exp(-4.f * n / length);
+		impulseResponse[n] = (int32_t)((int32_t)seed * decay);
+	}
+	return impulseResponse;
+}
+
+// The same normalisation the convolver does, the slow way
+double getPeakGain(std::vector<int32_t> const& impulseResponse) {
+	size_t fftSize = PartitionedConvolver::kFFTSize;
+	while (fftSize < impulseResponse.size()) {
+		fftSize <<= 1;
+	}
+	double peak = 0;
+	for (size_t k = 0; k <= fftSize / 2; k++) {
+		double real = 0;
+		double imaginary = 0;
+		for (size_t n = 0; n < impulseResponse.size(); n++) {
+			double angle = -2 * M_PI * k * n / fftSize;
+			real += impulseResponse[n] * std::cos(angle);
+			imaginary += impulseResponse[n] * std::sin(angle);
+		}
+		peak = std::max(peak, std::hypot(real, imaginary));
+	}
+	return peak / 2147483648.0;
+}
+
+// Sends noise through in windows of the given sizes, and checks the wet signal matches convolving directly, a
+// partition later
+void checkMatchesDirectConvolution(std::vector<int32_t> const& left, std::vector<int32_t> const& right,
+                                   std::span<size_t const> windowSizes, size_t totalLength) {
+	auto convolver = std::make_unique<PartitionedConvolver>();
+	CHECK(convolver->setImpulseResponse(left, right) == Error::NONE);
+	std::vector<int32_t> const& rightOrLeft = right.empty() ? left : right;
+	double peakGain = std::max(getPeakGain(left), right.empty() ? 0 : getPeakGain(right));
+
+	std::vector<StereoSample> input(totalLength);
+	uint32_t seed = 12345;
+	for (StereoSample& sample : input) {
+		seed = seed * 1664525 + 1013904223;
+		sample.l = (int32_t)seed >> 2;
+		seed = seed * 1664525 + 1013904223;
+		sample.r = (int32_t)seed >> 2;
+	}
+
+	std::vector<StereoSample> output = input;
+	size_t pos = 0;
+	for (size_t w = 0; pos < totalLength; w++) {
+		size_t windowSize = std::min(windowSizes[w % windowSizes.size()], totalLength - pos);
+		convolver->process({&output[pos], windowSize}, ONE_Q31, ONE_Q31);
+		pos += windowSize;
+	}
+
+	double maxError = 0;
+	for (size_t n = 0; n < totalLength; n++) {
+		double expectedL = 0;
+		double expectedR = 0;
+		for (size_t j = 0; j < left.size() && j + kPartitionSize <= n; j++) {
+			expectedL += (double)input[n - kPartitionSize - j].l * left[j];
+		}
+		for (size_t j = 0; j < rightOrLeft.size() && j + kPartitionSize <= n; j++) {
+			expectedR += (double)input[n - kPartitionSize - j].r * rightOrLeft[j];
+		}
+		expectedL /= 2147483648.0 * peakGain;
+		expectedR /= 2147483648.0 * peakGain;
+
+		maxError = std::max(maxError, std::abs(expectedL - ((double)output[n].l - input[n].l)));
+		maxError = std::max(maxError, std::abs(expectedR - ((double)output[n].r - input[n].r)));
+	}
+
+	// Relative to full scale, that's about -100dB
+	CHECK(maxError < 20000);
+}
+
+} // namespace
+
+TEST_GROUP(PartitionedConvolverTest){};
+
+TEST(PartitionedConvolverTest, monoMatchesDirectConvolution) {
+	constexpr size_t windowSizes[] = {kPartitionSize};
+	checkMatchesDirectConvolution(makeImpulseResponse(1000, 1), {}, windowSizes, 4000);
+}
+
+TEST(PartitionedConvolverTest, stereoWithUnevenWindows) {
+	constexpr size_t windowSizes[] = {1, 37, 128, 5, 64, 127, 3};
+	checkMatchesDirectConvolution(makeImpulseResponse(700, 2), makeImpulseResponse(450, 3), windowSizes, 3000);
+}
+
+TEST(PartitionedConvolverTest, lengthIsCapped) {
+	PartitionedConvolver convolver;
+	CHECK(convolver.setImpulseResponse(makeImpulseResponse(PartitionedConvolver::kMaxLength + 500, 4)) == Error::NONE);
+	CHECK_EQUAL(PartitionedConvolver::kMaxNumPartitions, convolver.getNumPartitions());
+
+	CHECK(convolver.setImpulseResponse(makeImpulseResponse(kPartitionSize + 1, 5)) == Error::NONE);
+	CHECK_EQUAL(2, convolver.getNumPartitions());
+
+	CHECK(convolver.setImpulseResponse({}) == Error::NONE);
+	CHECK_FALSE(convolver.hasImpulseResponse());
+}
+
+TEST(PartitionedConvolverTest, copyAndReset) {
+	std::vector<int32_t> impulseResponse = makeImpulseResponse(300, 6);
+	PartitionedConvolver original;
+	PartitionedConvolver copy;
+	CHECK(original.setImpulseResponse(impulseResponse) == Error::NONE);
+	CHECK(copy.copyImpulseResponseFrom(original) == Error::NONE);
+	CHECK_EQUAL(original.getNumPartitions(), copy.getNumPartitions());
+
+	std::vector<StereoSample> fromOriginal(200);
+	fromOriginal[0] = {1 << 30, -(1 << 29)};
+	std::vector<StereoSample> fromCopy = fromOriginal;
+	original.process(fromOriginal, ONE_Q31, ONE_Q31);
+	copy.process(fromCopy, ONE_Q31, ONE_Q31);
+	MEMCMP_EQUAL(fromOriginal.data(), fromCopy.data(), fromOriginal.size() * sizeof(StereoSample));
+
+	// Nothing comes out until a partition later
+	for (int32_t n = 1; n < kPartitionSize; n++) {
+		CHECK_EQUAL(0, fromOriginal[n].l);
+	}
+
+	// Silence in, but the impulse response is still ringing - until it's reset
+	std::vector<StereoSample> silence(kPartitionSize);
+	copy.process({silence.data(), 10}, ONE_Q31, ONE_Q31);
+	CHECK(silence[0].l != 0);
+	std::fill(silence.begin(), silence.end(), StereoSample{0, 0});
+	copy.reset();
+	copy.process(silence, ONE_Q31, ONE_Q31);
+	for (StereoSample sample : silence) {
+		CHECK_EQUAL(0, sample.l);
+		CHECK_EQUAL(0, sample.r);
+	}
+}
@@ -0,0 +1,55 @@
+#include "CppUTest/TestHarness.h"
+#include "processing/engines/render_cost_model.h"
+
+TEST_GROUP(RenderCostModelTest){};
+
+TEST(RenderCostModelTest, voiceCostStartsAtPrior) {
+	VoiceCostEstimate estimate;
+	CHECK_EQUAL(VoiceCostEstimate::kInitialCyclesPerVoiceSample, estimate.cyclesPerVoiceSample());
+}
+
+TEST(RenderCostModelTest, voiceCostConvergesOnMeasurement) {
+	VoiceCostEstimate estimate;
+	// 4 voices, 128 samples, 300 cycles per voice-sample
+	for (int32_t i = 0; i < 100; i++) {
+		estimate.noteRender(300 * 4 * 128, 4, 128);
+	}
+	CHECK_EQUAL(300, estimate.cyclesPerVoiceSample());
+
+	// and back down again
+	for (int32_t i = 0; i < 100; i++) {
+		estimate.noteRender(50 * 2 * 64, 2, 64);
+	}
+	CHECK_EQUAL(50, estimate.cyclesPerVoiceSample());
+}
+
+TEST(RenderCostModelTest, voiceCostIgnoresEmptyRenders) {
+	VoiceCostEstimate estimate;
+	estimate.noteRender(12345, 0, 128);
+	estimate.noteRender(12345, 4, 0);
+	CHECK_EQUAL(VoiceCostEstimate::kInitialCyclesPerVoiceSample, estimate.cyclesPerVoiceSample());
+}
+
+TEST(RenderCostModelTest, predictorLearnsOverhead) {
+	RenderCostPredictor predictor{1000, 1500};
+	CHECK_EQUAL(0, predictor.overheadCyclesPerSample());
+	for (int32_t i = 0; i < 200; i++) {
+		// 128 samples, 200 cycles per sample in total of which 150 were voices
+		predictor.noteWindow(200 * 128, 150 * 128, 128);
+	}
+	CHECK_EQUAL(50, predictor.overheadCyclesPerSample());
+	CHECK_EQUAL(550, predictor.predictCyclesPerSample(500));
+}
+
+TEST(RenderCostModelTest, predictorLimits) {
+	RenderCostPredictor predictor{1000, 1500};
+	for (int32_t i = 0; i < 200; i++) {
+		predictor.noteWindow(100 * 128, 0, 128);
+	}
+	CHECK_EQUAL(0, predictor.cyclesPerSampleOverSoftLimit(800));
+	CHECK_EQUAL(100, predictor.cyclesPerSampleOverSoftLimit(1000));
+	CHECK_FALSE(predictor.wouldExceedSoftLimit(800, 100));
+	CHECK_TRUE(predictor.wouldExceedSoftLimit(800, 200));
+	CHECK_FALSE(predictor.wouldExceedHardLimit(800, 200));
+	CHECK_TRUE(predictor.wouldExceedHardLimit(1300, 200));
+}
@@ -0,0 +1,139 @@
+#include "CppUTest/TestHarness.h"
+#include "dsp/interpolation/sinc_resampler.h"
+#include "util/lookuptables/lookuptables.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+using deluge::dsp::SincResampler;
+
+namespace {
+
+constexpr int32_t kNumTaps = SincResampler::kNumTaps;
+
+// What SampleLowLevelReader::readSamplesResampled() did before: a window of the newest kNumTaps samples, shifted along
+// for every source sample, and interpolate.h's kernel applied to it for every output sample
+class ReferenceResampler {
+public:
+	void push(int32_t channel, int16_t sample) {
+		std::memmove(&window[channel][1], &window[channel][0], (kNumTaps - 1) * sizeof(int16_t));
+		window[channel][0] = sample;
+	}
+
+	int32_t interpolate(int32_t channel, uint32_t oscPos, int32_t whichKernel) {
+		int16_t strength2 = (oscPos >> 5) & 32767;
+		int32_t progressSmall = oscPos >> 20;
+		int32_t sum = 0;
+		for (int32_t i = 0; i < kNumTaps; i++) {
+			int16_t value1 = windowedSincKernel[whichKernel][progressSmall][i];
+			int16_t value2 = windowedSincKernel[whichKernel][progressSmall + 1][i];
+			int16_t difference = value2 - value1;
+			int16_t kernel = value1 + (int16_t)((difference * strength2 * 2) >> 16); // vqdmulhq_n_s16
+			sum += kernel * window[channel][i];
+		}
+		return sum;
+	}
+
+	std::array<std::array<int16_t, kNumTaps>, 2> window{};
+};
+
+std::vector<int16_t> makeSource(int32_t numFrames, int32_t numChannels) {
+	std::vector<int16_t> source(numFrames * numChannels);
+	uint32_t seed = 12345;
+	for (int16_t& sample : source) {
+		seed = seed * 1664525 + 1013904223;
+		sample = (int16_t)(seed >> 16);
+	}
+	return source;
+}
+
+// Reads the source the way SampleLowLevelReader does, through both resamplers, and checks they agree on every output
+void checkMatches(int32_t numChannels, uint32_t phaseIncrement, int32_t whichKernel, int32_t numOutputs) {
+	std::vector<int16_t> source = makeSource(numOutputs * ((phaseIncrement >> 24) + 2) + 64, numChannels);
+
+	ReferenceResampler reference;
+	SincResampler resampler;
+	int16_t history[2][kNumTaps];
+	for (int32_t c = 0; c < numChannels; c++) {
+		for (int32_t i = 0; i < kNumTaps; i++) {
+			history[c][i] = source[i * numChannels + c];
+			reference.window[c][i] = history[c][i];
+		}
+		resampler.loadHistory(history[c], c);
+	}
+
+	uint32_t oscPos = 0x123456;
+	int32_t readPos = kNumTaps;
+	bool first = true;
+
+	for (int32_t done = 0; done < numOutputs; done += SincResampler::kBlockSize) {
+		int32_t numThisBlock = std::min<int32_t>(numOutputs - done, SincResampler::kBlockSize);
+		int32_t expected[2][SincResampler::kBlockSize];
+
+		resampler.beginBlock();
+		for (int32_t k = 0; k < numThisBlock; k++) {
+			if (!first) {
+				oscPos += phaseIncrement;
+				int32_t numSamplesToJumpForward = oscPos >> 24;
+				oscPos &= 16777215;
+				if (numSamplesToJumpForward > kNumTaps) {
+					readPos += numSamplesToJumpForward - kNumTaps;
+					numSamplesToJumpForward = kNumTaps;
+				}
+				for (; numSamplesToJumpForward; numSamplesToJumpForward--) {
+					int16_t const* frame = &source[readPos * numChannels];
+					if (numChannels == 2) {
+						resampler.pushSample(frame[0], frame[1]);
+					}
+					else {
+						resampler.pushSample(frame[0]);
+					}
+					for (int32_t c = 0; c < numChannels; c++) {
+						reference.push(c, frame[c]);
+					}
+					readPos++;
+				}
+			}
+			first = false;
+			resampler.markOutput(oscPos);
+			for (int32_t c = 0; c < numChannels; c++) {
+				expected[c][k] = reference.interpolate(c, oscPos, whichKernel);
+			}
+		}
+
+		int32_t output[2][SincResampler::kBlockSize];
+		resampler.renderBlock(output, numChannels, whichKernel);
+		for (int32_t c = 0; c < numChannels; c++) {
+			for (int32_t k = 0; k < numThisBlock; k++) {
+				CHECK_EQUAL(expected[c][k], output[c][k]);
+			}
+		}
+	}
+
+	for (int32_t c = 0; c < numChannels; c++) {
+		resampler.storeHistory(history[c], c);
+		MEMCMP_EQUAL(reference.window[c].data(), history[c], sizeof(history[c]));
+	}
+}
+
+} // namespace
+
+TEST_GROUP(SincResamplerTests){};
+
+TEST(SincResamplerTests, matchesPerSampleWindowMono) {
+	checkMatches(1, 0x01000000, 0, 128);
+	checkMatches(1, 0x005F1234, 0, 127);
+	checkMatches(1, 0x01B00000, 3, 126);
+}
+
+TEST(SincResamplerTests, matchesPerSampleWindowStereo) {
+	checkMatches(2, 0x00A00000, 1, 128);
+	checkMatches(2, 0x02345678, 5, 125);
+}
+
+// Jumps of more than the kernel's width skip source samples, and still need the buffer to stay in step
+TEST(SincResamplerTests, matchesPerSampleWindowWithBigJumps) {
+	checkMatches(1, 0x17800000, 6, 64);
+	checkMatches(2, 0x0C000001, 6, 65);
+}
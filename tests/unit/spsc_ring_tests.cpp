@@ -0,0 +1,73 @@
+#include "CppUTest/TestHarness.h"
+#include "util/container/spsc_ring.hpp"
+
+namespace {
+
+using Ring = deluge::SPSCRing<int32_t, 4>;
+
+TEST_GROUP(SPSCRingTests){};
+
+TEST(SPSCRingTests, startsEmpty) {
+	Ring ring;
+	CHECK(ring.empty());
+	CHECK(!ring.full());
+	CHECK_EQUAL(0, ring.size());
+	CHECK(!ring.pop().has_value());
+}
+
+TEST(SPSCRingTests, popsInPushOrder) {
+	Ring ring;
+	for (int32_t i = 0; i < 3; i++) {
+		CHECK(ring.push(i * 10));
+	}
+	CHECK_EQUAL(3, ring.size());
+	for (int32_t i = 0; i < 3; i++) {
+		std::optional<int32_t> value = ring.pop();
+		CHECK(value.has_value());
+		CHECK_EQUAL(i * 10, *value);
+	}
+	CHECK(ring.empty());
+}
+
+TEST(SPSCRingTests, refusesPushWhenFull) {
+	Ring ring;
+	for (int32_t i = 0; i < 4; i++) {
+		CHECK(ring.push(i));
+	}
+	CHECK(ring.full());
+	CHECK(!ring.push(99));
+
+	// The refused value mustn't have overwritten anything
+	CHECK_EQUAL(0, *ring.pop());
+	CHECK(ring.push(4));
+	for (int32_t i = 1; i <= 4; i++) {
+		CHECK_EQUAL(i, *ring.pop());
+	}
+	CHECK(ring.empty());
+}
+
+TEST(SPSCRingTests, keepsOrderAcrossManyWraps) {
+	Ring ring;
+	int32_t nextToPush = 0;
+	int32_t nextToPop = 0;
+	// Uneven bursts, so the indices wrap at every possible offset
+	for (int32_t round = 0; round < 1000; round++) {
+		int32_t numToPush = round % 5;
+		for (int32_t i = 0; i < numToPush && ring.push(nextToPush); i++) {
+			nextToPush++;
+		}
+		int32_t numToPop = (round * 3) % 4;
+		for (int32_t i = 0; i < numToPop; i++) {
+			std::optional<int32_t> value = ring.pop();
+			if (!value) {
+				break;
+			}
+			CHECK_EQUAL(nextToPop, *value);
+			nextToPop++;
+		}
+		CHECK_EQUAL(nextToPush - nextToPop, ring.size());
+	}
+	CHECK(nextToPop > 1000);
+}
+
+} // namespace
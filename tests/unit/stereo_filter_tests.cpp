@@ -0,0 +1,95 @@
+#include "CppUTest/TestHarness.h"
+#include "dsp/filter/lpladder.h"
+#include "dsp/filter/svf.h"
+#include "processing/engines/audio_engine.h"
+#include <vector>
+
+using namespace deluge::dsp::filter;
+
+// What the filters need from the firmware. The real tan only changes which frequency we end up at
+int32_t instantTan(int32_t input) {
+	return input;
+}
+int32_t quickLog(uint32_t input) {
+	return (32 - __builtin_clz(input | 1)) << 25;
+}
+namespace AudioEngine {
+int32_t cpuDireness = 0;
+}
+q31_t blendBuffer[SSI_TX_BUFFER_NUM_SAMPLES * 2];
+
+namespace {
+
+std::vector<q31_t> makeStereoNoise(size_t numSamples, uint32_t seed) {
+	std::vector<q31_t> samples(numSamples * 2);
+	for (q31_t& sample : samples) {
+		seed = seed * 1664525 + 1013904223;
+		sample = (q31_t)seed >> 3;
+	}
+	return samples;
+}
+
+// Runs the stereo kernel on one copy of the filter, and the mono one on two more copies - one per channel, taking turns
+// a sample at a time so the noise gets drawn in the same order - and checks they all come out identical
+template <typename F>
+void checkStereoMatchesMono(q31_t frequency, q31_t resonance, FilterMode mode, q31_t morph) {
+	// Zeroed, like FilterSet::reset() does
+	F stereo{};
+	F left{};
+	F right{};
+	for (F* filter : {&stereo, &left, &right}) {
+		filter->reset();
+		filter->configure(frequency, resonance, mode, morph, ONE_Q31 >> 2);
+		filter->dryFade = 0;
+	}
+
+	std::vector<q31_t> input = makeStereoNoise(SSI_TX_BUFFER_NUM_SAMPLES * 4, frequency);
+	std::vector<q31_t> fromStereo = input;
+	std::vector<q31_t> fromMono = input;
+
+	jcong = 12345;
+	// Uneven windows, so the state has to carry over properly from one to the next
+	for (size_t pos = 0, window = 1; pos < input.size(); pos += window * 2, window = window * 3 % 97 + 1) {
+		window = std::min(window, (input.size() - pos) / 2);
+		stereo.doFilterStereo(&fromStereo[pos], &fromStereo[pos + window * 2]);
+	}
+
+	jcong = 12345;
+	for (size_t pos = 0; pos < input.size(); pos += 2) {
+		left.doFilter(&fromMono[pos], &fromMono[pos + 1], 1);
+		right.doFilter(&fromMono[pos + 1], &fromMono[pos + 2], 1);
+	}
+
+	MEMCMP_EQUAL(fromMono.data(), fromStereo.data(), input.size() * sizeof(q31_t));
+
+	// And the filter did actually do something
+	CHECK(memcmp(input.data(), fromStereo.data(), input.size() * sizeof(q31_t)) != 0);
+}
+
+} // namespace
+
+TEST_GROUP(StereoFilterTest){};
+
+TEST(StereoFilterTest, svfLowpass) {
+	checkStereoMatchesMono<SVFilter>(200000000, 300000000, FilterMode::SVF_NOTCH, 0);
+}
+
+TEST(StereoFilterTest, svfBandMorphed) {
+	checkStereoMatchesMono<SVFilter>(400000000, 500000000, FilterMode::SVF_BAND, 300000000);
+	checkStereoMatchesMono<SVFilter>(400000000, 100000000, FilterMode::SVF_BAND, 100000000);
+}
+
+TEST(StereoFilterTest, ladder12dB) {
+	checkStereoMatchesMono<LpLadderFilter>(150000000, 400000000, FilterMode::TRANSISTOR_12DB, 0);
+}
+
+TEST(StereoFilterTest, ladder24dB) {
+	checkStereoMatchesMono<LpLadderFilter>(150000000, 200000000, FilterMode::TRANSISTOR_24DB, 0);
+	checkStereoMatchesMono<LpLadderFilter>(300000000, 530000000, FilterMode::TRANSISTOR_24DB, 100000000);
+}
+
+TEST(StereoFilterTest, ladderDrive) {
+	checkStereoMatchesMono<LpLadderFilter>(150000000, 300000000, FilterMode::TRANSISTOR_24DB_DRIVE, 0);
+	// High enough, with enough resonance, that it oversamples
+	checkStereoMatchesMono<LpLadderFilter>(1500000000, 530000000, FilterMode::TRANSISTOR_24DB_DRIVE, 0);
+}
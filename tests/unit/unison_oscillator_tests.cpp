@@ -0,0 +1,149 @@
+#include "CppUTest/TestHarness.h"
+#include "dsp/unison_oscillator.h"
+#include "util/fixedpoint.h"
+#include "util/waves.h"
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using deluge::dsp::UnisonOscillator;
+using Wave = UnisonOscillator::Wave;
+
+namespace {
+
+constexpr int32_t kNumSamples = 128;
+
+struct Part {
+	uint32_t phase;
+	uint32_t phaseIncrement;
+	int16_t const* table;
+	int32_t tableSizeMagnitude;
+	// As shouldDoPanning() gives them
+	int32_t amplitudeL;
+	int32_t amplitudeR;
+};
+
+constexpr int32_t kCentre = 1073741823;
+
+// A table as Voice::renderOsc() expects: one cycle of (1 << tableSizeMagnitude) values, plus the first again
+std::vector<int16_t> makeTable(int32_t tableSizeMagnitude, int32_t numHarmonics) {
+	int32_t size = 1 << tableSizeMagnitude;
+	std::vector<int16_t> table(size + 1);
+	for (int32_t i = 0; i <= size; i++) {
+		double value = 0;
+		for (int32_t h = 1; h <= numHarmonics; h++) {
+			value += std::sin(2 * M_PI * h * (i % size) / size) / h;
+		}
+		table[i] = (int16_t)(value * 16000); // Stays well clear of the int16 limits for a saw's Gibbs overshoot
+	}
+	return table;
+}
+
+// What Voice::renderBasicSource() does for each unison part on its own: renderOsc() into a zeroed buffer, and then, for
+// a stereo buffer, that mixed in panned
+void renderReference(Wave wave, std::vector<Part> const& parts, int32_t* buffer, bool stereo, int32_t amplitude,
+                     int32_t amplitudeIncrement) {
+	for (Part const& part : parts) {
+		uint32_t phase = part.phase;
+		int32_t amplitudeNow = amplitude;
+		for (int32_t i = 0; i < kNumSamples; i++) {
+			phase += part.phaseIncrement;
+			amplitudeNow += amplitudeIncrement;
+			int32_t value;
+			if (wave == Wave::TABLE) {
+				int32_t whichValue = phase >> (32 - part.tableSizeMagnitude);
+				int32_t strength2 = (uint16_t)(phase >> (16 - part.tableSizeMagnitude)) >> 1;
+				int32_t value1 = part.table[whichValue];
+				int16_t difference = part.table[whichValue + 1] - value1;
+				value = (value1 << 16) + 2 * difference * strength2;
+				value = ((int64_t)value * amplitudeNow) >> 31;
+			}
+			else if (wave == Wave::CRUDE_SAW) {
+				value = multiply_32x32_rshift32_rounded((int32_t)phase, amplitudeNow);
+			}
+			else {
+				value = multiply_32x32_rshift32_rounded(getSquare(phase), amplitudeNow);
+			}
+
+			if (stereo) {
+				buffer[i << 1] += multiply_32x32_rshift32(value, part.amplitudeL) << 2;
+				buffer[(i << 1) + 1] += multiply_32x32_rshift32(value, part.amplitudeR) << 2;
+			}
+			else {
+				buffer[i] += value;
+			}
+		}
+	}
+}
+
+void checkMatches(Wave wave, std::vector<Part> const& parts, bool stereo) {
+	int32_t numChannels = stereo ? 2 : 1;
+	int32_t amplitude = 1 << 26;
+	int32_t amplitudeIncrement = 1 << 17;
+
+	std::vector<int32_t> expected(kNumSamples * numChannels, 1000);
+	renderReference(wave, parts, expected.data(), stereo, amplitude, amplitudeIncrement);
+
+	UnisonOscillator unison;
+	std::vector<int32_t> indexes;
+	for (Part const& part : parts) {
+		indexes.push_back(unison.addPart(part.phase, part.phaseIncrement, part.table, part.tableSizeMagnitude,
+		                                 part.amplitudeL, part.amplitudeR));
+	}
+	std::vector<int32_t> actual(kNumSamples * numChannels, 1000);
+	unison.render(wave, actual.data(), kNumSamples, stereo, amplitude, amplitudeIncrement);
+
+	// Only the rounding of each part's multiplies differs
+	int32_t tolerance = 4 * parts.size();
+	for (size_t i = 0; i < actual.size(); i++) {
+		CHECK(std::abs(actual[i] - expected[i]) <= tolerance);
+	}
+	for (size_t p = 0; p < parts.size(); p++) {
+		CHECK_EQUAL(parts[p].phase + parts[p].phaseIncrement * kNumSamples, unison.getPhase(indexes[p]));
+	}
+}
+
+} // namespace
+
+TEST_GROUP(UnisonOscillatorTests){};
+
+TEST(UnisonOscillatorTests, tableWavesMatchRenderingEachPart) {
+	std::vector<int16_t> table9 = makeTable(9, 40);
+	std::vector<int16_t> table8 = makeTable(8, 20);
+	std::vector<Part> parts;
+	for (int32_t p = 0; p < UnisonOscillator::kMaxNumParts; p++) {
+		bool higher = p >= 5; // Detuned up into the next band
+		parts.push_back({(uint32_t)p * 0x2345678u, 20000000u + p * 150000u, higher ? table8.data() : table9.data(),
+		                 higher ? 8 : 9, kCentre, kCentre});
+	}
+	checkMatches(Wave::TABLE, parts, false);
+}
+
+TEST(UnisonOscillatorTests, stereoSpreadMatchesPanningEachPart) {
+	std::vector<int16_t> table = makeTable(10, 60);
+	std::vector<Part> parts;
+	for (int32_t p = 0; p < 5; p++) { // Leaves most of the second vector unused
+		parts.push_back({(uint32_t)p * 0x31234567u, 9000000u + p * 70000u, table.data(), 10, kCentre - p * 200000000,
+		                 kCentre - (4 - p) * 200000000});
+	}
+	checkMatches(Wave::TABLE, parts, true);
+}
+
+TEST(UnisonOscillatorTests, crudeSawMatchesRenderingEachPart) {
+	std::vector<Part> parts;
+	for (int32_t p = 0; p < 7; p++) {
+		parts.push_back({0x80000000u + p * 0x11111111u, 3000000u - p * 20000u, nullptr, 0, kCentre - p * 150000000,
+		                 kCentre - (6 - p) * 150000000});
+	}
+	checkMatches(Wave::CRUDE_SAW, parts, false);
+	checkMatches(Wave::CRUDE_SAW, parts, true);
+}
+
+TEST(UnisonOscillatorTests, crudeSquareMatchesRenderingEachPart) {
+	std::vector<Part> parts;
+	for (int32_t p = 0; p < 3; p++) {
+		parts.push_back({p * 0x40000000u, 2500000u + p * 30000u, nullptr, 0, kCentre, kCentre - p * 500000000});
+	}
+	checkMatches(Wave::CRUDE_SQUARE, parts, false);
+	checkMatches(Wave::CRUDE_SQUARE, parts, true);
+}
@@ -0,0 +1,135 @@
+#include "CppUTest/TestHarness.h"
+#include "dsp/voice_batch.h"
+#include <array>
+#include <cstring>
+
+namespace {
+
+constexpr int32_t kNumSamples = 128;
+
+int32_t laneBuffers[deluge::dsp::VoiceBatch::kNumLanes][kNumSamples];
+
+// What Voice::render() does for a plain mono voice when it mixes itself
+void renderVoiceReference(const int32_t* voiceBuffer, int32_t amplitude, int32_t amplitudeIncrement, int32_t* output,
+                          int32_t numSamples, bool outputIsStereo) {
+	for (int32_t i = 0; i < numSamples; i++) {
+		amplitude += amplitudeIncrement;
+		int32_t sample = multiply_32x32_rshift32_rounded(voiceBuffer[i], amplitude) << 1;
+		if (outputIsStereo) {
+			output[(i << 1)] += sample;
+			output[(i << 1) + 1] += sample;
+		}
+		else {
+			output[i] += sample;
+		}
+	}
+}
+
+void fillVoice(int32_t* buffer, uint32_t seed) {
+	for (int32_t i = 0; i < kNumSamples; i++) {
+		seed = seed * 1664525 + 1013904223;
+		buffer[i] = (int32_t)seed >> 2;
+	}
+}
+
+void checkAgainstReference(int32_t numVoices, int32_t numSamples, bool outputIsStereo) {
+	int32_t amplitudes[] = {1 << 28, 12345678, (1 << 30) - 1, 0};
+	int32_t increments[] = {1000, -2000, -(1 << 20), 1 << 22};
+
+	static int32_t expected[kNumSamples * 2];
+	static int32_t actual[kNumSamples * 2];
+	for (int32_t i = 0; i < kNumSamples * 2; i++) {
+		expected[i] = actual[i] = i * 1000;
+	}
+
+	deluge::dsp::VoiceBatch batch{{laneBuffers[0], laneBuffers[1], laneBuffers[2], laneBuffers[3]}};
+	for (int32_t v = 0; v < numVoices; v++) {
+		fillVoice(batch.buffer(), v + 1);
+		renderVoiceReference(batch.buffer(), amplitudes[v], increments[v], expected, numSamples, outputIsStereo);
+		batch.commit(amplitudes[v], increments[v]);
+	}
+	CHECK_EQUAL(numVoices, batch.size());
+
+	batch.render(actual, numSamples, outputIsStereo);
+	CHECK(batch.empty());
+	MEMCMP_EQUAL(expected, actual, sizeof(expected));
+}
+
+// Three voices with an SVF for the batch to run, and one without. The first and third get paired up, so if
+// thirdVoiceMode isn't notch as well, they have to take turns instead
+void checkFiltersAgainstReference(int32_t numSamples, FilterMode thirdVoiceMode) {
+	using deluge::dsp::filter::SVFilter;
+	int32_t amplitudes[] = {1 << 28, 12345678, (1 << 30) - 1, 1 << 27};
+	int32_t increments[] = {1000, -2000, -(1 << 20), 1 << 22};
+	FilterMode modes[] = {FilterMode::SVF_NOTCH, FilterMode::SVF_NOTCH, thirdVoiceMode, FilterMode::SVF_BAND};
+	bool filtered[] = {true, false, true, true};
+
+	std::array<SVFilter, 4> batchFilters{};
+	std::array<SVFilter, 4> referenceFilters{};
+	for (int32_t v = 0; v < 4; v++) {
+		for (SVFilter* filter : {&batchFilters[v], &referenceFilters[v]}) {
+			filter->reset();
+			filter->configure(100000000 * (v + 1), 200000000, modes[v], 50000000 * v, ONE_Q31 >> 2);
+			filter->dryFade = 0;
+		}
+	}
+
+	static int32_t expected[kNumSamples];
+	static int32_t actual[kNumSamples];
+	memset(expected, 0, sizeof(expected));
+	memset(actual, 0, sizeof(actual));
+
+	// Two windows, so the filters' state has to have been left as the voices would have left it
+	deluge::dsp::VoiceBatch batch{{laneBuffers[0], laneBuffers[1], laneBuffers[2], laneBuffers[3]}};
+	for (int32_t window = 0; window < 2; window++) {
+		for (int32_t v = 0; v < 4; v++) {
+			fillVoice(batch.buffer(), v + 1 + window * 10);
+			int32_t reference[kNumSamples];
+			memcpy(reference, batch.buffer(), sizeof(reference));
+			if (filtered[v]) {
+				referenceFilters[v].doFilter(reference, reference + numSamples, 1);
+			}
+			renderVoiceReference(reference, amplitudes[v], increments[v], expected, numSamples, false);
+			batch.commit(amplitudes[v], increments[v], filtered[v] ? &batchFilters[v] : nullptr);
+		}
+		batch.render(actual, numSamples, false);
+		MEMCMP_EQUAL(expected, actual, sizeof(expected));
+	}
+}
+
+} // namespace
+
+TEST_GROUP(VoiceBatchTest){};
+
+TEST(VoiceBatchTest, filtersMatchVoicesFilteringThemselves) {
+	checkFiltersAgainstReference(kNumSamples, FilterMode::SVF_NOTCH);
+	checkFiltersAgainstReference(37, FilterMode::SVF_NOTCH);
+	checkFiltersAgainstReference(kNumSamples, FilterMode::SVF_BAND);
+}
+
+TEST(VoiceBatchTest, fullBatchMatchesVoicesMixedIndividually) {
+	checkAgainstReference(4, kNumSamples, false);
+}
+
+TEST(VoiceBatchTest, stereoOutput) {
+	checkAgainstReference(4, kNumSamples, true);
+}
+
+TEST(VoiceBatchTest, partialBatch) {
+	checkAgainstReference(1, kNumSamples, false);
+	checkAgainstReference(3, kNumSamples, true);
+}
+
+TEST(VoiceBatchTest, windowNotMultipleOfFour) {
+	checkAgainstReference(4, 37, false);
+	checkAgainstReference(2, 3, true);
+}
+
+TEST(VoiceBatchTest, emptyBatchLeavesOutputAlone) {
+	int32_t output[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+	deluge::dsp::VoiceBatch batch{{laneBuffers[0], laneBuffers[1], laneBuffers[2], laneBuffers[3]}};
+	batch.render(output, 8, false);
+	for (int32_t i = 0; i < 8; i++) {
+		CHECK_EQUAL(i + 1, output[i]);
+	}
+}